@@ -0,0 +1,403 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2025, CEA-List
+//
+// All rights reserved.
+//
+// Author TPOC: jules.dumezy@cea.fr
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+ * Benchmarks of the CKKS functional bootstrapping. Each benchmark attaches a BootstrapStats sink to the
+ * crypto context and reports the average time of every bootstrapping stage per iteration as a counter
+ * (<stage>_ms), next to the total time, as well as the average numbers of key switches, NTTs and
+ * rescales and the peak tower count of a bootstrap. The sweeps cover the ring dimension, the level budget, the
+ * number of LUT bits, the Hermite interpolation order, the number of multi-value functions, the number of
+ * points of the two-digit tree bootstrapping, the digit decomposition of the general tree bootstrapping and
+ * the number of threads.
+ */
+
+#define _USE_MATH_DEFINES
+#include "benchmark/benchmark.h"
+
+#include "scheme/ckksrns/gen-cryptocontext-ckksrns.h"
+#include "scheme/ckksrns/ckksrns-fhe.h"
+#include "gen-cryptocontext.h"
+#include "cryptocontext.h"
+#include "utils/parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace lbcrypto;
+
+/*
+ * Context generation
+ */
+
+struct FBTContext {
+    CryptoContext<DCRTPoly> cc;
+    KeyPair<DCRTPoly> keys;
+    uint32_t numSlots;
+    uint32_t inLevel;
+};
+
+// Generates a sparse-secret context with enough levels for a functional bootstrapping of bits bits
+// (plus extraLevels levels spent after it) and all the keys it needs.
+static FBTContext GenerateFBTContext(uint32_t logN, uint32_t levelBudget, uint32_t bits, uint32_t extraLevels) {
+    std::vector<uint32_t> levelBudgetVec = {levelBudget, levelBudget};
+    std::vector<uint32_t> bsgsDim        = {0, 0};
+    uint32_t depth                       = 2 * levelBudget + 1 + 5 + 4 + bits + extraLevels;
+
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetSecretKeyDist(SPARSE_TERNARY);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetRingDim(1 << logN);
+    parameters.SetNumLargeDigits(3);
+    parameters.SetKeySwitchTechnique(HYBRID);
+    parameters.SetScalingModSize(48);
+    parameters.SetScalingTechnique(FIXEDMANUAL);
+    parameters.SetFirstModSize(49);
+    parameters.SetMultiplicativeDepth(depth);
+
+    FBTContext ctx;
+    ctx.cc = GenCryptoContext(parameters);
+    ctx.cc->Enable(PKE);
+    ctx.cc->Enable(KEYSWITCH);
+    ctx.cc->Enable(LEVELEDSHE);
+    ctx.cc->Enable(ADVANCEDSHE);
+    ctx.cc->Enable(FHE);
+    ctx.cc->Enable(FBTS);
+
+    ctx.numSlots = ctx.cc->GetRingDimension() / 2;
+    ctx.inLevel  = depth - levelBudget;
+
+    ctx.cc->EvalFuncBootstrapSetup(levelBudgetVec, bsgsDim, ctx.numSlots, bits);
+    ctx.keys = ctx.cc->KeyGen();
+    ctx.cc->EvalMultKeyGen(ctx.keys.secretKey);
+    ctx.cc->EvalBootstrapKeyGen(ctx.keys.secretKey, ctx.numSlots);
+
+    return ctx;
+}
+
+// Generates a regular CKKS bootstrapping context with the same ring dimension and level budget, as a
+// baseline for the functional bootstrapping.
+static FBTContext GenerateBootstrapContext(uint32_t logN, uint32_t levelBudget) {
+    std::vector<uint32_t> levelBudgetVec = {levelBudget, levelBudget};
+    uint32_t depth = 1 + FHECKKSRNS::GetBootstrapDepth(levelBudgetVec, SPARSE_TERNARY);
+
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetSecretKeyDist(SPARSE_TERNARY);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetRingDim(1 << logN);
+    parameters.SetNumLargeDigits(3);
+    parameters.SetKeySwitchTechnique(HYBRID);
+    parameters.SetScalingModSize(48);
+    parameters.SetScalingTechnique(FIXEDMANUAL);
+    parameters.SetFirstModSize(49);
+    parameters.SetMultiplicativeDepth(depth);
+
+    FBTContext ctx;
+    ctx.cc = GenCryptoContext(parameters);
+    ctx.cc->Enable(PKE);
+    ctx.cc->Enable(KEYSWITCH);
+    ctx.cc->Enable(LEVELEDSHE);
+    ctx.cc->Enable(ADVANCEDSHE);
+    ctx.cc->Enable(FHE);
+
+    ctx.numSlots = ctx.cc->GetRingDimension() / 2;
+    ctx.inLevel  = depth - 1;
+
+    ctx.cc->EvalBootstrapSetup(levelBudgetVec, {0, 0}, ctx.numSlots);
+    ctx.keys = ctx.cc->KeyGen();
+    ctx.cc->EvalMultKeyGen(ctx.keys.secretKey);
+    ctx.cc->EvalBootstrapKeyGen(ctx.keys.secretKey, ctx.numSlots);
+
+    return ctx;
+}
+
+// Encrypts integers modulo p in both the real and the imaginary parts of the slots.
+static Ciphertext<DCRTPoly> EncryptFBTInput(const FBTContext& ctx, uint64_t p) {
+    std::vector<std::complex<double>> x(ctx.numSlots);
+    for (uint32_t i = 0; i < ctx.numSlots; ++i)
+        x[i] = std::complex<double>(i % p, (3 * i + 1) % p);
+    Plaintext ptxt = ctx.cc->MakeCKKSPackedPlaintext(x, 1, ctx.inLevel, nullptr, ctx.numSlots);
+    return ctx.cc->Encrypt(ctx.keys.publicKey, ptxt);
+}
+
+static std::function<double(double)> MakeLUT(uint64_t p, uint64_t a, uint64_t b) {
+    return [p, a, b](double x) -> double {
+        return static_cast<double>((a * static_cast<uint64_t>(std::llround(x)) + b) % p);
+    };
+}
+
+// Runs a benchmark on the given number of threads: the OpenMP thread count and the thread cap of every
+// ParallelOpType, so that the coefficient loops sized with GetThreadLimit follow it too. Both are restored
+// when the benchmark ends.
+class ScopedThreads {
+public:
+    explicit ScopedThreads(int threads) : m_threads(OpenFHEParallelControls.GetNumThreads()) {
+        for (int op = 0; op < NUM_PARALLEL_OPS; ++op) {
+            m_caps[op] = OpenFHEParallelControls.GetThreadCap(static_cast<ParallelOpType>(op));
+            OpenFHEParallelControls.SetThreadCap(static_cast<ParallelOpType>(op), threads);
+        }
+        OpenFHEParallelControls.SetNumThreads(threads);
+    }
+
+    ~ScopedThreads() {
+        for (int op = 0; op < NUM_PARALLEL_OPS; ++op)
+            OpenFHEParallelControls.SetThreadCap(static_cast<ParallelOpType>(op), m_caps[op]);
+        OpenFHEParallelControls.SetNumThreads(m_threads);
+    }
+
+private:
+    int m_threads;
+    uint32_t m_caps[NUM_PARALLEL_OPS];
+};
+
+// Attaches a fresh stats sink to the context for the duration of a benchmark and reports the
+// per-iteration stage times as counters when the benchmark ends.
+class ScopedBootstrapStats {
+public:
+    ScopedBootstrapStats(benchmark::State& state, const CryptoContext<DCRTPoly>& cc)
+        : m_state(state), m_cc(cc), m_stats(std::make_shared<BootstrapStats>()) {
+        m_cc->SetBootstrapStats(m_stats);
+    }
+
+    ~ScopedBootstrapStats() {
+        m_cc->SetBootstrapStats(nullptr);
+        if (m_state.iterations() == 0)
+            return;
+        for (const auto& stage : m_stats->GetStages())
+            m_state.counters[stage.first + "_ms"] = stage.second.time / m_state.iterations();
+
+        auto runs = m_stats->GetRuns();
+        if (runs.empty())
+            return;
+        double keySwitches = 0, ntts = 0, rescales = 0, peakTowers = 0;
+        for (const auto& run : runs) {
+            keySwitches += run.keySwitches;
+            ntts += run.ntts;
+            rescales += run.rescales;
+            peakTowers = std::max<double>(peakTowers, run.peakTowers);
+        }
+        m_state.counters["KeySwitches"] = keySwitches / runs.size();
+        m_state.counters["NTTs"]        = ntts / runs.size();
+        m_state.counters["Rescales"]    = rescales / runs.size();
+        m_state.counters["PeakTowers"]  = peakTowers;
+    }
+
+private:
+    benchmark::State& m_state;
+    CryptoContext<DCRTPoly> m_cc;
+    std::shared_ptr<BootstrapStats> m_stats;
+};
+
+static void ReleaseFBTContext(FBTContext& ctx) {
+    ctx.cc->ClearEvalMultKeys();
+    ctx.cc->ClearEvalAutomorphismKeys();
+    CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+}
+
+/*
+ * Benchmarks
+ *
+ * Arguments common to all benchmarks: logN (ring dimension), lb (level budget of both linear
+ * transforms) and threads (number of OpenMP threads).
+ */
+
+static void CKKS_EvalBootstrap(benchmark::State& state) {
+    uint32_t logN        = state.range(0);
+    uint32_t levelBudget = state.range(1);
+    ScopedThreads threads(state.range(2));
+
+    auto ctx   = GenerateBootstrapContext(logN, levelBudget);
+    auto ctxt  = EncryptFBTInput(ctx, 2);
+    {
+        ScopedBootstrapStats stats(state, ctx.cc);
+        for (auto _ : state) {
+            auto res = ctx.cc->EvalBootstrap(ctxt);
+            benchmark::DoNotOptimize(res);
+        }
+    }
+
+    ReleaseFBTContext(ctx);
+}
+
+static void CKKS_EvalFuncBootstrap(benchmark::State& state) {
+    uint32_t logN        = state.range(0);
+    uint32_t levelBudget = state.range(1);
+    uint32_t bits        = state.range(2);
+    uint32_t order       = state.range(3);
+    ScopedThreads threads(state.range(4));
+
+    uint64_t p = 1ull << bits;
+    auto ctx   = GenerateFBTContext(logN, levelBudget, bits, order + 3);
+    auto ctxt  = EncryptFBTInput(ctx, p);
+    HermiteLUT lut(MakeLUT(p, 3, 1), p, order);
+    {
+        ScopedBootstrapStats stats(state, ctx.cc);
+        for (auto _ : state) {
+            auto res = ctx.cc->EvalFuncBootstrap(ctxt, lut);
+            benchmark::DoNotOptimize(res);
+        }
+    }
+
+    ReleaseFBTContext(ctx);
+}
+
+static void CKKS_EvalFuncMVBootstrap(benchmark::State& state) {
+    uint32_t logN        = state.range(0);
+    uint32_t levelBudget = state.range(1);
+    uint32_t bits        = state.range(2);
+    uint32_t numFunc     = state.range(3);
+    ScopedThreads threads(state.range(4));
+
+    uint64_t p = 1ull << bits;
+    auto ctx   = GenerateFBTContext(logN, levelBudget, bits, 4);
+    auto ctxt  = EncryptFBTInput(ctx, p);
+    std::vector<HermiteLUT> luts;
+    for (uint32_t i = 0; i < numFunc; ++i)
+        luts.emplace_back(MakeLUT(p, 2 * i + 1, i), p, 1);
+    {
+        ScopedBootstrapStats stats(state, ctx.cc);
+        for (auto _ : state) {
+            auto res = ctx.cc->EvalFuncMVBootstrap(ctxt, luts);
+            benchmark::DoNotOptimize(res);
+        }
+    }
+
+    ReleaseFBTContext(ctx);
+}
+
+static void CKKS_EvalFuncSimpleTreeMVB(benchmark::State& state) {
+    uint32_t logN        = state.range(0);
+    uint32_t levelBudget = state.range(1);
+    uint32_t numPoints   = state.range(2);
+    ScopedThreads threads(state.range(3));
+
+    // the input is split into two digits of equal size, one in each part of the slots
+    uint32_t digitBits = std::log2(numPoints) / 2;
+    auto ctx           = GenerateFBTContext(logN, levelBudget, digitBits, 4);
+    auto ctxt          = EncryptFBTInput(ctx, 1ull << digitBits);
+    auto func          = MakeLUT(numPoints, 7, 3);
+    {
+        ScopedBootstrapStats stats(state, ctx.cc);
+        for (auto _ : state) {
+            auto res = ctx.cc->EvalFuncSimpleTreeMVB(ctxt, func, numPoints, 1);
+            benchmark::DoNotOptimize(res);
+        }
+    }
+
+    ReleaseFBTContext(ctx);
+}
+
+static void CKKS_EvalFuncTreeMVB(benchmark::State& state) {
+    uint32_t logN        = state.range(0);
+    uint32_t levelBudget = state.range(1);
+    uint32_t digitBits   = state.range(2);
+    uint32_t numDigits   = state.range(3);
+    ScopedThreads threads(state.range(4));
+
+    auto ctx = GenerateFBTContext(logN, levelBudget, digitBits, 4);
+    std::vector<ConstCiphertext<DCRTPoly>> ctxts;
+    for (uint32_t i = 0; i < (numDigits + 1) / 2; ++i)
+        ctxts.push_back(EncryptFBTInput(ctx, 1ull << digitBits));
+    auto func = MakeLUT(1ull << (digitBits * numDigits), 7, 3);
+    {
+        ScopedBootstrapStats stats(state, ctx.cc);
+        for (auto _ : state) {
+            auto res = ctx.cc->EvalFuncTreeMVB(ctxts, func, digitBits, numDigits);
+            benchmark::DoNotOptimize(res);
+        }
+    }
+
+    ReleaseFBTContext(ctx);
+}
+
+/*
+ * Sweeps
+ */
+
+static int MaxThreads() {
+    return OpenFHEParallelControls.GetMachineThreads();
+}
+
+static void ThreadArgs(std::vector<int64_t>& threads) {
+    for (int t = 1; t < MaxThreads(); t *= 2)
+        threads.push_back(t);
+    threads.push_back(MaxThreads());
+}
+
+static void BootstrapArgs(benchmark::internal::Benchmark* b) {
+    std::vector<int64_t> threads;
+    ThreadArgs(threads);
+    b->ArgNames({"logN", "lb", "threads"});
+    b->ArgsProduct({{12, 13, 14}, {1, 2, 3}, threads});
+}
+
+static void FuncBootstrapArgs(benchmark::internal::Benchmark* b) {
+    std::vector<int64_t> threads;
+    ThreadArgs(threads);
+    b->ArgNames({"logN", "lb", "bits", "order", "threads"});
+    // LUT size and Hermite order at a fixed ring dimension and level budget
+    b->ArgsProduct({{12}, {3}, {1, 2, 3, 4, 5, 6, 7, 8}, {1, 2, 3}, {MaxThreads()}});
+    // ring dimension, level budget and threads for a 4-bit LUT
+    b->ArgsProduct({{12, 13, 14}, {1, 2, 3}, {4}, {1}, threads});
+}
+
+static void FuncMVBootstrapArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"logN", "lb", "bits", "nfunc", "threads"});
+    b->ArgsProduct({{12}, {3}, {2, 4, 6}, {1, 2, 4, 8}, {MaxThreads()}});
+}
+
+static void FuncSimpleTreeMVBArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"logN", "lb", "npoi", "threads"});
+    b->ArgsProduct({{12}, {3}, {16, 64, 256}, {MaxThreads()}});
+}
+
+static void FuncTreeMVBArgs(benchmark::internal::Benchmark* b) {
+    // the tree evaluation needs ndigits * 2^(digitBits * (ndigits - 1)) LUTs and rejects more than 1024
+    const uint64_t maxTreeLUTs = 1024;
+    b->ArgNames({"logN", "lb", "digitBits", "ndigits", "threads"});
+    for (int64_t digitBits : {2, 3, 4}) {
+        for (int64_t numDigits : {2, 3, 4}) {
+            if (numDigits * (uint64_t(1) << (digitBits * (numDigits - 1))) <= maxTreeLUTs)
+                b->Args({12, 3, digitBits, numDigits, MaxThreads()});
+        }
+    }
+}
+
+BENCHMARK(CKKS_EvalBootstrap)->Unit(benchmark::kMillisecond)->Iterations(3)->Apply(BootstrapArgs);
+BENCHMARK(CKKS_EvalFuncBootstrap)->Unit(benchmark::kMillisecond)->Iterations(3)->Apply(FuncBootstrapArgs);
+BENCHMARK(CKKS_EvalFuncMVBootstrap)->Unit(benchmark::kMillisecond)->Iterations(3)->Apply(FuncMVBootstrapArgs);
+BENCHMARK(CKKS_EvalFuncSimpleTreeMVB)->Unit(benchmark::kMillisecond)->Iterations(1)->Apply(FuncSimpleTreeMVBArgs);
+BENCHMARK(CKKS_EvalFuncTreeMVB)->Unit(benchmark::kMillisecond)->Iterations(1)->Apply(FuncTreeMVBArgs);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,269 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2025, CEA-List
+//
+// All rights reserved.
+//
+// Author TPOC: jules.dumezy@cea.fr
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+ * Scaling of the coefficient-parallel loops of DCRTPoly with the number of threads, at N = 2^16 and 30+ towers:
+ * the hybrid key-switching basis switches (ApproxSwitchCRTBasis and ApproxSwitchCRTBasisEval from P to Q,
+ * ApproxModDown from QP to Q), the digit decomposition of a hoisted rotation and the BFV multiplication, whose
+ * ScaleAndRound and basis expansion are the remaining coefficient-parallel loops. Every benchmark caps the
+ * parallel policy of ParallelControls at threads threads for all operations and sets the OpenMP team size
+ * accordingly; the counts above the number of machine threads are skipped, so run on a 64-core host to get
+ * the full sweep.
+ */
+
+#define _USE_MATH_DEFINES
+#include "benchmark/benchmark.h"
+
+#include "scheme/ckksrns/gen-cryptocontext-ckksrns.h"
+#include "scheme/ckksrns/ckksrns-cryptoparameters.h"
+#include "scheme/bfvrns/gen-cryptocontext-bfvrns.h"
+#include "gen-cryptocontext.h"
+#include "cryptocontext.h"
+
+#include <memory>
+#include <vector>
+
+using namespace lbcrypto;
+
+constexpr uint32_t RING_DIM   = 1 << 16;
+constexpr uint32_t CKKS_DEPTH = 32;
+constexpr uint32_t BFV_DEPTH  = 40;
+
+/*
+ * Context generation
+ */
+
+static CryptoContext<DCRTPoly> GenerateCKKSContext() {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetRingDim(RING_DIM);
+    parameters.SetMultiplicativeDepth(CKKS_DEPTH);
+    parameters.SetScalingModSize(50);
+    parameters.SetFirstModSize(60);
+    parameters.SetNumLargeDigits(3);
+    parameters.SetKeySwitchTechnique(HYBRID);
+    parameters.SetScalingTechnique(FIXEDMANUAL);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+    return cc;
+}
+
+static CryptoContext<DCRTPoly> GenerateBFVContext() {
+    CCParams<CryptoContextBFVRNS> parameters;
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetRingDim(RING_DIM);
+    parameters.SetPlaintextModulus(65537);
+    parameters.SetMultiplicativeDepth(BFV_DEPTH);
+    parameters.SetScalingModSize(45);
+    parameters.SetMultiplicationTechnique(HPS);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+    return cc;
+}
+
+static std::shared_ptr<CryptoParametersCKKSRNS> GetCKKSParams(const CryptoContext<DCRTPoly>& cc) {
+    return std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(cc->GetCryptoParameters());
+}
+
+static Ciphertext<DCRTPoly> EncryptRandom(const CryptoContext<DCRTPoly>& cc, const KeyPair<DCRTPoly>& keys) {
+    std::vector<int64_t> x(cc->GetRingDimension());
+    for (size_t i = 0; i < x.size(); ++i)
+        x[i] = (7 * i + 3) % 65537;
+    return cc->Encrypt(keys.publicKey, cc->MakePackedPlaintext(x));
+}
+
+/*
+ * Thread policy
+ */
+
+// Caps every parallel operation at threads threads for the lifetime of the object and reports the cap as a
+// counter.
+class ScopedThreadCap {
+public:
+    ScopedThreadCap(benchmark::State& state, int threads) : m_state(state) {
+        for (uint32_t op = 0; op < NUM_PARALLEL_OPS; ++op)
+            OpenFHEParallelControls.SetThreadCap(static_cast<ParallelOpType>(op), threads);
+        OpenFHEParallelControls.SetNumThreads(threads);
+        m_state.counters["threads"] = threads;
+    }
+
+    ~ScopedThreadCap() {
+        for (uint32_t op = 0; op < NUM_PARALLEL_OPS; ++op)
+            OpenFHEParallelControls.SetThreadCap(static_cast<ParallelOpType>(op), 0);
+        OpenFHEParallelControls.Enable();
+    }
+
+private:
+    benchmark::State& m_state;
+};
+
+static bool SkipUnavailableThreads(benchmark::State& state, int threads) {
+    if (threads <= OpenFHEParallelControls.GetMachineThreads())
+        return false;
+    state.SkipWithError("not enough machine threads");
+    return true;
+}
+
+/*
+ * Benchmarks
+ *
+ * Argument common to all benchmarks: threads (thread cap of the parallel policy).
+ */
+
+static void DCRT_ApproxSwitchCRTBasis(benchmark::State& state) {
+    int threads = state.range(0);
+    if (SkipUnavailableThreads(state, threads))
+        return;
+
+    auto cc           = GenerateCKKSContext();
+    auto cryptoParams = GetCKKSParams(cc);
+    auto paramsP      = cryptoParams->GetParamsP();
+    auto paramsQ      = cc->GetElementParams();
+
+    DCRTPoly::DugType dug;
+    DCRTPoly x(dug, paramsP, Format::COEFFICIENT);
+
+    ScopedThreadCap cap(state, threads);
+    for (auto _ : state) {
+        auto res = x.ApproxSwitchCRTBasis(paramsP, paramsQ, cryptoParams->GetPHatInvModp(),
+                                          cryptoParams->GetPHatInvModpPrecon(), cryptoParams->GetPHatModq(),
+                                          cryptoParams->GetModqBarrettMu());
+        benchmark::DoNotOptimize(res);
+    }
+    state.counters["towers"] = paramsQ->GetParams().size();
+}
+
+static void DCRT_ApproxSwitchCRTBasisEval(benchmark::State& state) {
+    int threads = state.range(0);
+    if (SkipUnavailableThreads(state, threads))
+        return;
+
+    auto cc           = GenerateCKKSContext();
+    auto cryptoParams = GetCKKSParams(cc);
+    auto paramsP      = cryptoParams->GetParamsP();
+    auto paramsQ      = cc->GetElementParams();
+
+    DCRTPoly::DugType dug;
+    DCRTPoly x(dug, paramsP, Format::EVALUATION);
+
+    ScopedThreadCap cap(state, threads);
+    for (auto _ : state) {
+        auto res = x.ApproxSwitchCRTBasisEval(paramsP, paramsQ, cryptoParams->GetPHatInvModp(),
+                                              cryptoParams->GetPHatInvModpPrecon(), cryptoParams->GetPHatModq(),
+                                              cryptoParams->GetModqBarrettMu());
+        benchmark::DoNotOptimize(res);
+    }
+    state.counters["towers"] = paramsQ->GetParams().size();
+}
+
+static void DCRT_ApproxModDown(benchmark::State& state) {
+    int threads = state.range(0);
+    if (SkipUnavailableThreads(state, threads))
+        return;
+
+    auto cc           = GenerateCKKSContext();
+    auto cryptoParams = GetCKKSParams(cc);
+    auto paramsQ      = cc->GetElementParams();
+
+    DCRTPoly::DugType dug;
+    DCRTPoly x(dug, cryptoParams->GetParamsQP(), Format::EVALUATION);
+
+    ScopedThreadCap cap(state, threads);
+    for (auto _ : state) {
+        auto res = x.ApproxModDown(paramsQ, cryptoParams->GetParamsP(), cryptoParams->GetPInvModq(),
+                                   cryptoParams->GetPInvModqPrecon(), cryptoParams->GetPHatInvModp(),
+                                   cryptoParams->GetPHatInvModpPrecon(), cryptoParams->GetPHatModq(),
+                                   cryptoParams->GetModqBarrettMu(), cryptoParams->GettInvModp(),
+                                   cryptoParams->GettInvModpPrecon(), 0, cryptoParams->GettModqPrecon());
+        benchmark::DoNotOptimize(res);
+    }
+    state.counters["towers"] = paramsQ->GetParams().size();
+}
+
+static void CKKS_EvalFastRotationPrecompute(benchmark::State& state) {
+    int threads = state.range(0);
+    if (SkipUnavailableThreads(state, threads))
+        return;
+
+    auto cc   = GenerateCKKSContext();
+    auto keys = cc->KeyGen();
+    std::vector<double> x(cc->GetRingDimension() / 2, 0.5);
+    auto ctxt = cc->Encrypt(keys.publicKey, cc->MakeCKKSPackedPlaintext(x));
+
+    ScopedThreadCap cap(state, threads);
+    for (auto _ : state) {
+        auto digits = cc->EvalFastRotationPrecompute(ctxt);
+        benchmark::DoNotOptimize(digits);
+    }
+    state.counters["towers"] = ctxt->GetElements()[0].GetNumOfElements();
+}
+
+static void BFV_EvalMultNoRelin(benchmark::State& state) {
+    int threads = state.range(0);
+    if (SkipUnavailableThreads(state, threads))
+        return;
+
+    auto cc    = GenerateBFVContext();
+    auto keys  = cc->KeyGen();
+    auto ctxt1 = EncryptRandom(cc, keys);
+    auto ctxt2 = EncryptRandom(cc, keys);
+
+    ScopedThreadCap cap(state, threads);
+    for (auto _ : state) {
+        auto res = cc->EvalMultNoRelin(ctxt1, ctxt2);
+        benchmark::DoNotOptimize(res);
+    }
+    state.counters["towers"] = ctxt1->GetElements()[0].GetNumOfElements();
+}
+
+/*
+ * Sweeps
+ */
+
+static void ThreadArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"threads"});
+    for (int64_t t = 1; t <= 64; t *= 2)
+        b->Args({t});
+}
+
+BENCHMARK(DCRT_ApproxSwitchCRTBasis)->Unit(benchmark::kMillisecond)->Apply(ThreadArgs);
+BENCHMARK(DCRT_ApproxSwitchCRTBasisEval)->Unit(benchmark::kMillisecond)->Apply(ThreadArgs);
+BENCHMARK(DCRT_ApproxModDown)->Unit(benchmark::kMillisecond)->Apply(ThreadArgs);
+BENCHMARK(CKKS_EvalFastRotationPrecompute)->Unit(benchmark::kMillisecond)->Apply(ThreadArgs);
+BENCHMARK(BFV_EvalMultNoRelin)->Unit(benchmark::kMillisecond)->Apply(ThreadArgs);
+
+BENCHMARK_MAIN();
@@ -499,6 +499,19 @@ public:
    */
     DerivedType AutomorphismTransform(uint32_t i, const std::vector<uint32_t>& vec) const override = 0;
 
+    /**
+   * @brief Performs the automorphism transform of the sum of this element and
+   * rhs, in EVALUATION format, in a single pass over each tower. rhs may have
+   * fewer towers than this element, its missing towers are treated as zero.
+   *
+   * @param &rhs is the element to add before the transform.
+   * @param &i is the element to perform the automorphism transform with.
+   * @param &vec a vector with precomputed indices
+   * @return is the result of the automorphism transform of the sum.
+   */
+    virtual DerivedType AutomorphismTransformOfSum(const DerivedType& rhs, uint32_t i,
+                                                   const std::vector<uint32_t>& vec) const = 0;
+
     /**
    * @brief Transpose the ring element using the automorphism operation
    *
@@ -929,6 +942,27 @@ public:
                                              const std::vector<std::vector<NativeInteger>>& QHatModp,
                                              const std::vector<DoubleNativeInt>& modpBarrettMu) const = 0;
 
+    /**
+   * @brief Same as ApproxSwitchCRTBasis, but the result is returned in
+   * EVALUATION format and the input may be in either format. The inverse NTT
+   * of each input tower and the forward NTT of each output tower are done in
+   * the same pass as the basis extension, one output tower per thread.
+   *
+   * @param &paramsQ parameters for the CRT basis {q_1,...,q_l}
+   * @param &paramsP parameters for the CRT basis {p_1,...,p_k}
+   * @param &QHatinvModq precomputed values for [(Q/q_i)^{-1}]_{q_i}
+   * @param &QHatinvModqPrecon NTL-specific precomputations
+   * @param &QHatModp precomputed values for [Q/q_i]_{p_j}
+   * @param &modpBarrettMu 128-bit Barrett reduction precomputed values
+   * @return the representation of {X + alpha*Q} in basis {P}, in EVALUATION format.
+   */
+    virtual DerivedType ApproxSwitchCRTBasisEval(const std::shared_ptr<Params>& paramsQ,
+                                                 const std::shared_ptr<Params>& paramsP,
+                                                 const std::vector<NativeInteger>& QHatInvModq,
+                                                 const std::vector<NativeInteger>& QHatInvModqPrecon,
+                                                 const std::vector<std::vector<NativeInteger>>& QHatModp,
+                                                 const std::vector<DoubleNativeInt>& modpBarrettMu) const = 0;
+
     /**
    * @brief Performs approximate modulus raising:
    * {X}_{Q} -> {X'}_{Q,P}.
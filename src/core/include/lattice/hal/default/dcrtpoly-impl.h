@@ -348,9 +348,43 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::AutomorphismTransform(uint32_t i, c
     DCRTPolyImpl<VecType> result;
     result.m_params = m_params;
     result.m_format = m_format;
-    result.m_vectors.reserve(m_vectors.size());
-    for (const auto& v : m_vectors)
-        result.m_vectors.emplace_back(v.AutomorphismTransform(i, vec));
+    size_t size{m_vectors.size()};
+    result.m_vectors.resize(size);
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+    for (size_t k = 0; k < size; ++k)
+        result.m_vectors[k] = m_vectors[k].AutomorphismTransform(i, vec);
+    return result;
+}
+
+template <typename VecType>
+DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::AutomorphismTransformOfSum(const DCRTPolyImpl& rhs, uint32_t i,
+                                                                        const std::vector<uint32_t>& vec) const {
+    if (m_format != Format::EVALUATION || rhs.m_format != Format::EVALUATION)
+        OPENFHE_THROW("Automorphism Poly Format not EVALUATION");
+    if (i % 2 == 0)
+        OPENFHE_THROW("Automorphism index not odd");
+    size_t size{m_vectors.size()};
+    size_t sizeRhs{rhs.m_vectors.size()};
+    if (sizeRhs > size)
+        OPENFHE_THROW("The added element has more towers than this element");
+
+    DCRTPolyImpl<VecType> result(m_params, m_format, false);
+    // the sum is never stored: each tower reads both operands through the permutation and is written once
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+    for (size_t k = 0; k < size; ++k) {
+        if (k >= sizeRhs) {
+            result.m_vectors[k] = m_vectors[k].AutomorphismTransform(i, vec);
+            continue;
+        }
+        const auto& a{m_vectors[k].GetValues()};
+        const auto& b{rhs.m_vectors[k].GetValues()};
+        const auto& q{a.GetModulus()};
+        uint32_t n{m_params->GetRingDimension()};
+        NativeVector values(n, q);
+        for (uint32_t j = 0; j < n; ++j)
+            values[j] = a[vec[j]].ModAddFast(b[vec[j]], q);
+        result.m_vectors[k].SetValues(std::move(values), m_format);
+    }
     return result;
 }
 
@@ -805,7 +839,7 @@ typename DCRTPolyImpl<VecType>::PolyLargeType DCRTPolyImpl<VecType>::CRTInterpol
 
     VecType V(r, qt);
 
-#pragma omp parallel for private(tmp1) num_threads(OpenFHEParallelControls.GetThreadLimit(8))
+#pragma omp parallel for private(tmp1) num_threads(OpenFHEParallelControls.GetThreadLimit(INTERPOLATE_OP, r, t))
     for (uint32_t j = 0; j < r; ++j) {
         for (uint32_t i = 0; i < t; ++i)
             V[j] += (tmp1 = m_vectors[i].GetValues()[j].ConvertToInt()) * multiplier[i];
@@ -917,7 +951,8 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxSwitchCRTBasis(
 #if defined(HAVE_INT128) && NATIVEINT == 64
     uint32_t ringDim = m_params->GetRingDimension();
     std::vector<DoubleNativeInt> sum(sizeP);
-    #pragma omp parallel for firstprivate(sum) num_threads(OpenFHEParallelControls.GetThreadLimit(8))
+    [[maybe_unused]] int threads = OpenFHEParallelControls.GetThreadLimit(BASIS_SWITCH_OP, ringDim, sizeQ * sizeP);
+    #pragma omp parallel for firstprivate(sum) num_threads(threads)
     for (uint32_t ri = 0; ri < ringDim; ++ri) {
         std::fill(sum.begin(), sum.end(), 0);
         for (uint32_t i = 0; i < sizeQ; ++i) {
@@ -947,6 +982,92 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxSwitchCRTBasis(
     return ans;
 }
 
+template <typename VecType>
+DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxSwitchCRTBasisEval(
+    const std::shared_ptr<Params>& paramsQ, const std::shared_ptr<Params>& paramsP,
+    const std::vector<NativeInteger>& QHatInvModq, const std::vector<NativeInteger>& QHatInvModqPrecon,
+    const std::vector<std::vector<NativeInteger>>& QHatModp, const std::vector<DoubleNativeInt>& modpBarrettMu) const {
+#if defined(HAVE_INT128) && NATIVEINT == 64
+    // Number of coefficients extended at a time: the 128-bit partial sums of a block stay in L1 while
+    // the input towers are streamed through it
+    constexpr uint32_t BLOCK = 256;
+
+    uint32_t sizeQ   = std::min<uint32_t>(m_vectors.size(), paramsQ->GetParams().size());
+    uint32_t sizeP   = paramsP->GetParams().size();
+    uint32_t ringDim = m_params->GetRingDimension();
+
+    // inverse NTT of each input tower followed by the scaling by [(Q/q_i)^{-1}]_{q_i} while it is in cache
+    std::vector<PolyType> xQHatInvModq(m_vectors.begin(), m_vectors.begin() + sizeQ);
+    #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQ))
+    for (uint32_t i = 0; i < sizeQ; ++i) {
+        auto& xi{xQHatInvModq[i]};
+        if (m_format == Format::EVALUATION)
+            xi.SetFormat(Format::COEFFICIENT);
+        const auto& qi{xi.GetModulus()};
+        for (uint32_t ri = 0; ri < ringDim; ++ri)
+            xi[ri].ModMulFastConstEq(QHatInvModq[i], qi, QHatInvModqPrecon[i]);
+    }
+
+    // Each output tower is extended block by block. When there are at least as many output towers as threads,
+    // a thread transforms its tower to EVALUATION right after extending it; otherwise the extension is also
+    // split over ranges of coefficients, and the towers are transformed in a second pass
+    int threads     = OpenFHEParallelControls.GetThreadLimit(BASIS_SWITCH_OP, ringDim, sizeQ * sizeP);
+    uint32_t blocks = ParallelControls::GetCoefficientBlocks(threads, sizeP);
+    uint32_t chunk  = std::max(BLOCK, (ringDim / blocks + BLOCK - 1) / BLOCK * BLOCK);
+    blocks          = (ringDim + chunk - 1) / chunk;
+
+    std::vector<NativeVector> values;
+    values.reserve(sizeP);
+    for (uint32_t j = 0; j < sizeP; ++j)
+        values.emplace_back(ringDim, paramsP->GetParams()[j]->GetModulus());
+
+    auto extend = [&](uint32_t j, uint32_t begin, uint32_t end) {
+        const uint64_t p{values[j].GetModulus().ConvertToInt<uint64_t>()};
+        DoubleNativeInt sum[BLOCK];
+        for (uint32_t r0 = begin; r0 < end; r0 += BLOCK) {
+            uint32_t len = std::min(BLOCK, end - r0);
+            std::fill(sum, sum + len, 0);
+            for (uint32_t i = 0; i < sizeQ; ++i) {
+                const auto& xi{xQHatInvModq[i].GetValues()};
+                const uint64_t QHatModpij{QHatModp[i][j].ConvertToInt<uint64_t>()};
+                for (uint32_t k = 0; k < len; ++k)
+                    sum[k] += Mul128(xi[r0 + k].ConvertToInt<uint64_t>(), QHatModpij);
+            }
+            for (uint32_t k = 0; k < len; ++k)
+                values[j][r0 + k] = BarrettUint128ModUint64(sum[k], p, modpBarrettMu[j]);
+        }
+    };
+
+    DCRTPolyImpl<VecType> ans(paramsP, Format::EVALUATION, false);
+    if (blocks == 1) {
+    #pragma omp parallel for num_threads(threads)
+        for (uint32_t j = 0; j < sizeP; ++j) {
+            extend(j, 0, ringDim);
+            ans.m_vectors[j].SetValues(std::move(values[j]), Format::COEFFICIENT);
+            ans.m_vectors[j].SetFormat(Format::EVALUATION);
+        }
+    }
+    else {
+    #pragma omp parallel for collapse(2) num_threads(threads)
+        for (uint32_t j = 0; j < sizeP; ++j)
+            for (uint32_t b = 0; b < blocks; ++b)
+                extend(j, b * chunk, std::min(ringDim, (b + 1) * chunk));
+    #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeP))
+        for (uint32_t j = 0; j < sizeP; ++j) {
+            ans.m_vectors[j].SetValues(std::move(values[j]), Format::COEFFICIENT);
+            ans.m_vectors[j].SetFormat(Format::EVALUATION);
+        }
+    }
+    return ans;
+#else
+    auto x{*this};
+    x.SetFormat(Format::COEFFICIENT);
+    auto ans{x.ApproxSwitchCRTBasis(paramsQ, paramsP, QHatInvModq, QHatInvModqPrecon, QHatModp, modpBarrettMu)};
+    ans.SetFormat(Format::EVALUATION);
+    return ans;
+#endif
+}
+
 template <typename VecType>
 void DCRTPolyImpl<VecType>::ApproxModUp(const std::shared_ptr<Params>& paramsQ, const std::shared_ptr<Params>& paramsP,
                                         const std::shared_ptr<Params>& paramsQP,
@@ -954,26 +1075,20 @@ void DCRTPolyImpl<VecType>::ApproxModUp(const std::shared_ptr<Params>& paramsQ,
                                         const std::vector<NativeInteger>& QHatInvModqPrecon,
                                         const std::vector<std::vector<NativeInteger>>& QHatModp,
                                         const std::vector<DoubleNativeInt>& modpBarrettMu) {
-    // if input polynomial in evaluation representation, store for later use to reduce number of NTTs
-    std::vector<DCRTPolyImpl::PolyType> polyInNTT;
-    if (m_format == Format::EVALUATION) {
-        polyInNTT = m_vectors;
-        this->SetFormat(Format::COEFFICIENT);
-    }
-
-    auto partP = ApproxSwitchCRTBasis(paramsQ, paramsP, QHatInvModq, QHatInvModqPrecon, QHatModp, modpBarrettMu);
+    // the towers of P are returned in evaluation representation, whatever the format of the input
+    auto partP = ApproxSwitchCRTBasisEval(paramsQ, paramsP, QHatInvModq, QHatInvModqPrecon, QHatModp, modpBarrettMu);
 
-    if (polyInNTT.size() > 0)
-        m_vectors = std::move(polyInNTT);
+    if (m_format == Format::COEFFICIENT) {
+        size_t sizeQ = m_vectors.size();
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQ))
+        for (size_t i = 0; i < sizeQ; ++i)
+            m_vectors[i].SetFormat(Format::EVALUATION);
+    }
 
     size_t sizeQP = paramsQP->GetParams().size();
     m_vectors.reserve(sizeQP);
     m_vectors.insert(m_vectors.end(), std::make_move_iterator(partP.m_vectors.begin()),
                      std::make_move_iterator(partP.m_vectors.end()));
-
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQP))
-    for (size_t i = 0; i < sizeQP; ++i)
-        m_vectors[i].SetFormat(Format::EVALUATION);
     m_format = Format::EVALUATION;
     m_params = paramsQP;
 }
@@ -993,15 +1108,14 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxModDown(
 #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeP))
     for (size_t j = 0; j < sizeP; ++j) {
         partP.m_vectors[j] = m_vectors[sizeQ + j];
-        partP.m_vectors[j].SetFormat(Format::COEFFICIENT);
         // Multiply everything by -t^(-1) mod P (BGVrns only)
         if (t > 0)
             partP.m_vectors[j] *= tInvModp[j];
     }
-    partP.OverrideFormat(Format::COEFFICIENT);
 
+    // the inverse NTT of P and the NTT of the switched towers are fused with the basis extension
     auto partPSwitchedToQ =
-        partP.ApproxSwitchCRTBasis(paramsP, paramsQ, PHatInvModp, PHatInvModpPrecon, PHatModq, modqBarrettMu);
+        partP.ApproxSwitchCRTBasisEval(paramsP, paramsQ, PHatInvModp, PHatInvModpPrecon, PHatModq, modqBarrettMu);
 
     // Combine the switched DCRTPoly with the Q part of this to get the result
     DCRTPolyImpl<VecType> ans(paramsQ, Format::EVALUATION, true);
@@ -1014,7 +1128,6 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxModDown(
         // Multiply everything by t mod Q (BGVrns only)
         if (t > 0)
             partPSwitchedToQ.m_vectors[i] *= t;
-        partPSwitchedToQ.m_vectors[i].SetFormat(Format::EVALUATION);
         ans.m_vectors[i] = (m_vectors[i] - partPSwitchedToQ.m_vectors[i]) * PInvModq[i];
     }
     return ans;
@@ -1067,7 +1180,8 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::SwitchCRTBasis(const std::shared_pt
     DCRTPolyImpl<VecType> ans(paramsP, m_format, true);
     uint32_t ringDim = m_params->GetRingDimension();
 
-#pragma omp parallel for firstprivate(xQHatInvModq) num_threads(OpenFHEParallelControls.GetThreadLimit(8))
+    [[maybe_unused]] int threads = OpenFHEParallelControls.GetThreadLimit(BASIS_SWITCH_OP, ringDim, sizeQ * sizeP);
+#pragma omp parallel for firstprivate(xQHatInvModq) num_threads(threads)
     for (uint32_t ri = 0; ri < ringDim; ++ri) {
         double nu{0.5};
         for (size_t i = 0; i < sizeQ; ++i) {
@@ -1188,7 +1302,9 @@ void DCRTPolyImpl<VecType>::FastExpandCRTBasisPloverQ(const Precomputations& pre
         mu.push_back(p->GetModulus().ComputeMu());
 
     uint32_t ringDim = m_params->GetRingDimension();
-        #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(8))
+
+    [[maybe_unused]] int threads = OpenFHEParallelControls.GetThreadLimit(BASIS_SWITCH_OP, ringDim, sizeQ * sizePl);
+        #pragma omp parallel for num_threads(threads)
     for (uint32_t ri = 0; ri < ringDim; ++ri) {
         for (size_t i = 0; i < sizeQ; ++i) {
             const auto& qInvModpi = precomputed.qInvModp[i];
@@ -1268,7 +1384,7 @@ typename DCRTPolyImpl<VecType>::PolyType DCRTPolyImpl<VecType>::ScaleAndRound(
                 // we fit in 63 bits, so we can do multiplications and
                 // additions without modulo reduction, and do modulo reduction
                 // only once
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(4))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(SCALE_AND_ROUND_OP, ringDim, sizeQ))
                 for (usint ri = 0; ri < ringDim; ri++) {
                     double floatSum      = 0.5;
                     NativeInteger intSum = 0, tmp;
@@ -1296,7 +1412,7 @@ typename DCRTPolyImpl<VecType>::PolyType DCRTPolyImpl<VecType>::ScaleAndRound(
                 // is bounded by 2^{-53}. Thus the floating point error is bounded by
                 // sizeQ * 2^30 * 2^{-53}. We always have sizeQ < 2^11, which means the
                 // error is bounded by 1/4, and the rounding will be correct.
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(4))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(SCALE_AND_ROUND_OP, ringDim, sizeQ))
                 for (usint ri = 0; ri < ringDim; ri++) {
                     double floatSum      = 0.5;
                     NativeInteger intSum = 0, tmp;
@@ -1321,7 +1437,7 @@ typename DCRTPolyImpl<VecType>::PolyType DCRTPolyImpl<VecType>::ScaleAndRound(
                 // we fit in 62 bits, so we can do multiplications and
                 // additions without modulo reduction, and do modulo reduction
                 // only once
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(4))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(SCALE_AND_ROUND_OP, ringDim, sizeQ))
                 for (usint ri = 0; ri < ringDim; ri++) {
                     double floatSum      = 0.5;
                     NativeInteger intSum = 0;
@@ -1346,7 +1462,7 @@ typename DCRTPolyImpl<VecType>::PolyType DCRTPolyImpl<VecType>::ScaleAndRound(
                 }
             }
             else {
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(4))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(SCALE_AND_ROUND_OP, ringDim, sizeQ))
                 for (usint ri = 0; ri < ringDim; ri++) {
                     double floatSum      = 0.5;
                     NativeInteger intSum = 0;
@@ -1387,7 +1503,7 @@ typename DCRTPolyImpl<VecType>::PolyType DCRTPolyImpl<VecType>::ScaleAndRound(
                 // we fit in 52 bits, so we can do multiplications and
                 // additions without modulo reduction, and do modulo reduction
                 // only once using floating point techniques
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(4))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(SCALE_AND_ROUND_OP, ringDim, sizeQ))
                 for (usint ri = 0; ri < ringDim; ri++) {
                     double floatSum      = 0.0;
                     NativeInteger intSum = 0, tmp;
@@ -1419,7 +1535,7 @@ typename DCRTPolyImpl<VecType>::PolyType DCRTPolyImpl<VecType>::ScaleAndRound(
                 // is bounded by 2^{-53}. Thus the floating point error is bounded by
                 // sizeQ * 2^30 * 2^{-53}. We always have sizeQ < 2^11, which means the
                 // error is bounded by 1/4, and the rounding will be correct.
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(4))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(SCALE_AND_ROUND_OP, ringDim, sizeQ))
                 for (usint ri = 0; ri < ringDim; ri++) {
                     double floatSum{0.0};
                     NativeInteger intSum{0};
@@ -1446,7 +1562,7 @@ typename DCRTPolyImpl<VecType>::PolyType DCRTPolyImpl<VecType>::ScaleAndRound(
                 // we fit in 52 bits, so we can do multiplications and
                 // additions without modulo reduction, and do modulo reduction
                 // only once using floating point techniques
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(4))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(SCALE_AND_ROUND_OP, ringDim, sizeQ))
                 for (usint ri = 0; ri < ringDim; ri++) {
                     double floatSum      = 0.0;
                     NativeInteger intSum = 0;
@@ -1475,7 +1591,7 @@ typename DCRTPolyImpl<VecType>::PolyType DCRTPolyImpl<VecType>::ScaleAndRound(
                 }
             }
             else {
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(4))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(SCALE_AND_ROUND_OP, ringDim, sizeQ))
                 for (usint ri = 0; ri < ringDim; ri++) {
                     double floatSum      = 0.0;
                     NativeInteger intSum = 0;
@@ -1530,7 +1646,7 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxScaleAndRound(
         mu.push_back(p->GetModulus().ComputeMu());
 
     uint32_t ringDim = m_params->GetRingDimension();
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(8))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(SCALE_AND_ROUND_OP, ringDim, sizeQ * sizeP))
     for (uint32_t ri = 0; ri < ringDim; ++ri) {
         for (size_t j = 0; j < sizeP; ++j) {
             const auto& pj                     = ans.m_vectors[j].GetModulus();
@@ -1587,7 +1703,7 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ScaleAndRound(
     for (const auto& p : paramsOutput->GetParams())
         mu.push_back(p->GetModulus().ComputeMu());
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(8))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(SCALE_AND_ROUND_OP, ringDim, sizeI * sizeO))
     for (uint32_t ri = 0; ri < ringDim; ++ri) {
         double nu = 0.5;
         for (size_t i = 0; i < sizeI; ++i) {
@@ -1688,7 +1804,7 @@ typename DCRTPolyImpl<VecType>::PolyType DCRTPolyImpl<VecType>::ScaleAndRound(
     uint32_t sizeQ   = m_vectors.size();
     DCRTPolyImpl::PolyType::Vector coefficients(ringDim, t.ConvertToInt());
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(8))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(SCALE_AND_ROUND_OP, ringDim, sizeQ))
     for (uint32_t k = 0; k < ringDim; ++k) {
         // TODO: use 64 bit words in case NativeInteger uses smaller word size
         NativeInteger s = 0;
@@ -138,6 +138,22 @@ public:
     DCRTPolyType& operator*=(const Integer& rhs) override;
     DCRTPolyType& operator*=(const NativeInteger& rhs) override;
 
+    /**
+     * Fused multiply-add: adds a * b to the current polynomial tower by tower, without the temporary product.
+     * All polynomials are in Format::EVALUATION with the same towers.
+     */
+    DCRTPolyType& MultAddEq(const DCRTPolyType& a, const DCRTPolyType& b) {
+        if (m_format != Format::EVALUATION || a.m_format != Format::EVALUATION || b.m_format != Format::EVALUATION)
+            OPENFHE_THROW("MultAddEq for DCRTPolyImpl supported only in Format::EVALUATION");
+        size_t size{m_vectors.size()};
+        if (size != a.m_vectors.size() || size != b.m_vectors.size())
+            OPENFHE_THROW("tower size mismatch; cannot multiply-add");
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+        for (size_t i = 0; i < size; ++i)
+            m_vectors[i].MultAddNoCheckEq(a.m_vectors[i], b.m_vectors[i]);
+        return *this;
+    }
+
     DCRTPolyType Negate() const override;
     DCRTPolyType operator-() const override;
 
@@ -147,6 +163,8 @@ public:
 
     DCRTPolyType AutomorphismTransform(uint32_t i) const override;
     DCRTPolyType AutomorphismTransform(uint32_t i, const std::vector<uint32_t>& vec) const override;
+    DCRTPolyType AutomorphismTransformOfSum(const DCRTPolyType& rhs, uint32_t i,
+                                            const std::vector<uint32_t>& vec) const override;
 
     DCRTPolyType Plus(const Integer& rhs) const override;
     DCRTPolyType Plus(const std::vector<Integer>& rhs) const;
@@ -234,6 +252,13 @@ public:
                                       const std::vector<std::vector<NativeInteger>>& QHatModp,
                                       const std::vector<DoubleNativeInt>& modpBarrettMu) const override;
 
+    DCRTPolyType ApproxSwitchCRTBasisEval(const std::shared_ptr<Params>& paramsQ,
+                                          const std::shared_ptr<Params>& paramsP,
+                                          const std::vector<NativeInteger>& QHatInvModq,
+                                          const std::vector<NativeInteger>& QHatInvModqPrecon,
+                                          const std::vector<std::vector<NativeInteger>>& QHatModp,
+                                          const std::vector<DoubleNativeInt>& modpBarrettMu) const override;
+
     void ApproxModUp(const std::shared_ptr<Params>& paramsQ, const std::shared_ptr<Params>& paramsP,
                      const std::shared_ptr<Params>& paramsQP, const std::vector<NativeInteger>& QHatInvModq,
                      const std::vector<NativeInteger>& QHatInvModqPrecon,
@@ -0,0 +1,125 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2025, CEA-List
+//
+// All rights reserved.
+//
+// Author TPOC: jules.dumezy@cea.fr
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Lazily reduced sums of products of double-CRT polynomials
+ */
+
+#ifndef LBCRYPTO_INC_LATTICE_HAL_DEFAULT_DCRTPOLYACCUMULATOR_H
+#define LBCRYPTO_INC_LATTICE_HAL_DEFAULT_DCRTPOLYACCUMULATOR_H
+
+#include "lattice/hal/default/dcrtpoly.h"
+
+#include "math/hal/intnat/accumulatornat.h"
+
+#include "utils/exception.h"
+#include "utils/parallel.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace lbcrypto {
+
+/**
+ * @brief Sum of products of polynomials in Format::EVALUATION, e.g., the plaintext-ciphertext products of a
+ * baby-step giant-step linear transform, accumulated by a NativeVectorAccumulator per tower: the coefficients are
+ * reduced once, by GetElement, rather than after every multiplication and addition.
+ */
+template <typename VecType>
+class DCRTPolyAccumulatorImpl {
+public:
+    using DCRTPolyType = DCRTPolyImpl<VecType>;
+    using Integer      = typename DCRTPolyType::Integer;
+    using Params       = typename DCRTPolyType::Params;
+    using PolyType     = typename DCRTPolyType::PolyType;
+
+    explicit DCRTPolyAccumulatorImpl(const std::shared_ptr<Params>& params) : m_params(params) {
+        m_towers.reserve(m_params->GetParams().size());
+        for (const auto& p : m_params->GetParams())
+            m_towers.emplace_back(p->GetRingDimension(), p->GetModulus());
+    }
+
+    /**
+   * Adds the product a * b of polynomials in Format::EVALUATION with the towers of the accumulator.
+   */
+    void AddProduct(const DCRTPolyType& a, const DCRTPolyType& b) {
+        CheckOperand(a);
+        CheckOperand(b);
+        size_t size{m_towers.size()};
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+        for (size_t i = 0; i < size; ++i)
+            m_towers[i].AddProduct(a.GetElementAtIndex(i).GetValues(), b.GetElementAtIndex(i).GetValues());
+    }
+
+    /**
+   * Adds the product of a polynomial in Format::EVALUATION by a constant given by its CRT residues.
+   */
+    void AddProduct(const DCRTPolyType& a, const std::vector<Integer>& crtConstant) {
+        CheckOperand(a);
+        size_t size{m_towers.size()};
+        if (crtConstant.size() != size)
+            OPENFHE_THROW("tower size mismatch; cannot accumulate");
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+        for (size_t i = 0; i < size; ++i)
+            m_towers[i].AddProduct(a.GetElementAtIndex(i).GetValues(), NativeInteger(crtConstant[i]));
+    }
+
+    /**
+   * @return the accumulated sum, in Format::EVALUATION.
+   */
+    DCRTPolyType GetElement() const {
+        DCRTPolyType result(m_params, Format::EVALUATION);
+        size_t size{m_towers.size()};
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+        for (size_t i = 0; i < size; ++i) {
+            PolyType tower(m_params->GetParams()[i], Format::EVALUATION);
+            tower.SetValues(m_towers[i].GetValues(), Format::EVALUATION);
+            result.SetElementAtIndex(i, std::move(tower));
+        }
+        return result;
+    }
+
+private:
+    void CheckOperand(const DCRTPolyType& a) const {
+        if (a.GetFormat() != Format::EVALUATION)
+            OPENFHE_THROW("DCRTPolyAccumulatorImpl supported only in Format::EVALUATION");
+        if (a.GetNumOfElements() != m_towers.size())
+            OPENFHE_THROW("tower size mismatch; cannot accumulate");
+    }
+
+    std::shared_ptr<Params> m_params;
+    std::vector<NativeVectorAccumulator> m_towers;
+};
+
+}  // namespace lbcrypto
+
+#endif
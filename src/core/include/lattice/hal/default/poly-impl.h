@@ -41,6 +41,7 @@
 #include "utils/debug.h"
 #include "utils/exception.h"
 #include "utils/inttypes.h"
+#include "utils/opcounters.h"
 
 #include <cmath>
 #include <iostream>
@@ -420,6 +421,8 @@ void PolyImpl<VecType>::SwitchFormat() {
     if (!m_values)
         OPENFHE_THROW("Poly switch format to empty values");
 
+    OpCounters::Add(NTT_COUNTER);
+
     if (m_format != Format::COEFFICIENT) {
         m_format = Format::COEFFICIENT;
         ChineseRemainderTransformFTT<VecType>().InverseTransformFromBitReverseInPlace(ru, co, &(*m_values));
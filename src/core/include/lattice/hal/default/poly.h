@@ -282,6 +282,18 @@ public:
         return *this;
     }
 
+    /**
+     * Adds a * b to the current polynomial, with a single modular reduction for the native vectors. The operands
+     * are in Format::EVALUATION and have the parameters of the current polynomial, which is not checked.
+     */
+    PolyImpl& MultAddNoCheckEq(const PolyImpl& a, const PolyImpl& b) {
+        if constexpr (std::is_same_v<VecType, NativeVector>)
+            m_values->ModMulAddNoCheckEq(*a.m_values, *b.m_values);
+        else
+            m_values->ModAddEq(a.m_values->ModMul(*b.m_values));
+        return *this;
+    }
+
     PolyImpl Times(const Integer& element) const override;
     PolyImpl& operator*=(const Integer& element) override {
         m_values->ModMulEq(element);
@@ -50,14 +50,16 @@
 #include "lattice/hal/default/ildcrtparams.h"
 #include "lattice/hal/default/poly.h"
 #include "lattice/hal/default/dcrtpoly.h"
+#include "lattice/hal/default/dcrtpolyaccumulator.h"
 
 namespace lbcrypto {
 
-using ILNativeParams = ILParamsImpl<NativeInteger>;
-using ILParams       = ILParamsImpl<BigInteger>;
-using Poly           = PolyImpl<BigVector>;
-using NativePoly     = PolyImpl<NativeVector>;
-using DCRTPoly       = DCRTPolyImpl<BigVector>;
+using ILNativeParams      = ILParamsImpl<NativeInteger>;
+using ILParams            = ILParamsImpl<BigInteger>;
+using Poly                = PolyImpl<BigVector>;
+using NativePoly          = PolyImpl<NativeVector>;
+using DCRTPoly            = DCRTPolyImpl<BigVector>;
+using DCRTPolyAccumulator = DCRTPolyAccumulatorImpl<BigVector>;
 
 #ifdef WITH_BE2
 using M2Params     = ILParamsImpl<M2Integer>;
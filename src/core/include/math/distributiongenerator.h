@@ -41,6 +41,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 
 namespace lbcrypto {
 
@@ -65,6 +66,14 @@ public:
      */
     static PRNG& GetPRNG();
 
+    /**
+     * @brief Replaces the PRNG engine of the calling thread
+     * @param prng the new engine, nullptr to create a default one on the next call to GetPRNG()
+     * @return the previous engine
+     * @note the engine is shared by all threads when FIXED_SEED is defined
+     */
+    static std::shared_ptr<PRNG> SetPRNG(std::shared_ptr<PRNG> prng);
+
 private:
     using GenPRNGEngineFuncPtr = PRNG* (*)();
 
@@ -79,6 +88,25 @@ private:
 #endif
 };
 
+/**
+ * @brief ScopedPRNG makes the calling thread draw its randomness from a given PRNG engine for the lifetime of the
+ * object, e.g. a stream seeded deterministically, and restores the previous engine on destruction.
+ */
+class ScopedPRNG {
+public:
+    explicit ScopedPRNG(std::shared_ptr<PRNG> prng) : m_prev(PseudoRandomNumberGenerator::SetPRNG(std::move(prng))) {}
+
+    ~ScopedPRNG() {
+        PseudoRandomNumberGenerator::SetPRNG(std::move(m_prev));
+    }
+
+    ScopedPRNG(const ScopedPRNG&)            = delete;
+    ScopedPRNG& operator=(const ScopedPRNG&) = delete;
+
+private:
+    std::shared_ptr<PRNG> m_prev;
+};
+
 }  // namespace lbcrypto
 
 #endif  // __DISTRIBUTIONGENERATOR_H__
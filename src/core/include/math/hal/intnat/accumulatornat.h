@@ -0,0 +1,214 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2025, CEA-List
+//
+// All rights reserved.
+//
+// Author TPOC: jules.dumezy@cea.fr
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Lazily reduced sums of products of native vectors
+ */
+
+#ifndef LBCRYPTO_MATH_HAL_INTNAT_ACCUMULATORNAT_H
+#define LBCRYPTO_MATH_HAL_INTNAT_ACCUMULATORNAT_H
+
+#include "math/hal/intnat/mubintvecnat.h"
+#include "math/hal/intnat/simdnat.h"
+
+#include "utils/exception.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace intnat {
+
+using NativeVectorAccumulator = NativeVectorAccumulatorT<NativeInteger>;
+
+/**
+ * @brief Sum of products of native vectors modulo q with lazy reduction. The products are added as unreduced
+ * double words hi * 2^s + lo, with s = 64, or s = 52 with the 52-bit multipliers of AVX-512 IFMA, and each
+ * coefficient is reduced once, when the sum is read. The values are folded back below q before the double words
+ * could overflow, i.e., every 2^(128 - 2k) products for a k-bit q, or 2^12 with IFMA.
+ *
+ * The moduli are below 2^63. Without 64-bit words and 128-bit products, the products are reduced as they are
+ * added.
+ */
+template <typename IntegerType>
+class NativeVectorAccumulatorT {
+    using VecType    = NativeVectorT<IntegerType>;
+    using DNativeInt = typename IntegerType::DNativeInt;
+
+    static constexpr bool LAZY{VecType::SIMD_WORDS && sizeof(DNativeInt) == 2 * sizeof(uint64_t)};
+
+public:
+    NativeVectorAccumulatorT(usint length, const IntegerType& modulus)
+        : m_length(length), m_modulus(modulus), m_sum(LAZY ? 0 : length, modulus) {
+        if constexpr (LAZY) {
+            m_hi.resize(length);
+            m_lo.resize(length);
+            uint64_t q{m_modulus.template ConvertToInt<uint64_t>()};
+            m_shift = SIMDAccumulatorShift(q);
+            uint32_t k{m_modulus.GetMSB()};
+            m_maxCount    = (m_shift == 52) ? (uint64_t(1) << 12) : (uint64_t(1) << std::min(128 - 2 * k, 32u));
+            m_shiftMod    = static_cast<uint64_t>((DNativeInt(1) << m_shift) % q);
+            m_shiftPrecon = static_cast<uint64_t>((DNativeInt(m_shiftMod) << 64) / q);
+            m_onePrecon   = static_cast<uint64_t>((DNativeInt(1) << 64) / q);
+        }
+    }
+
+    usint GetLength() const {
+        return m_length;
+    }
+
+    const IntegerType& GetModulus() const {
+        return m_modulus;
+    }
+
+    /**
+   * Adds the element-wise product b * c.
+   *
+   * @param &b, &c are vectors of the length and modulus of the accumulator, with values below the modulus.
+   */
+    void AddProduct(const VecType& b, const VecType& c) {
+        CheckOperand(b);
+        CheckOperand(c);
+        if constexpr (LAZY) {
+            Reserve();
+            const uint64_t* x{b.Words()};
+            const uint64_t* y{c.Words()};
+            if (!SIMDMulAccumulate(m_hi.data(), m_lo.data(), x, y, m_length, m_shift)) {
+                for (usint i = 0; i < m_length; ++i)
+                    Accumulate(i, DNativeInt(x[i]) * y[i]);
+            }
+        }
+        else {
+            m_sum.ModMulAddNoCheckEq(b, c);
+        }
+    }
+
+    /**
+   * Adds the product b * c by the constant c.
+   *
+   * @param &b is a vector of the length and modulus of the accumulator, with values below the modulus.
+   * @param &c is a constant below the modulus.
+   */
+    void AddProduct(const VecType& b, const IntegerType& c) {
+        CheckOperand(b);
+        if constexpr (LAZY) {
+            Reserve();
+            const uint64_t* x{b.Words()};
+            uint64_t y{c.template ConvertToInt<uint64_t>()};
+            if (!SIMDMulAccumulateConst(m_hi.data(), m_lo.data(), x, y, m_length, m_shift)) {
+                for (usint i = 0; i < m_length; ++i)
+                    Accumulate(i, DNativeInt(x[i]) * y);
+            }
+        }
+        else {
+            m_sum.ModAddNoCheckEq(b.ModMul(c));
+        }
+    }
+
+    /**
+   * @return the accumulated sum, reduced modulo q.
+   */
+    VecType GetValues() const {
+        if constexpr (LAZY) {
+            VecType result(m_length, m_modulus);
+            uint64_t* r{result.Words()};
+            for (usint i = 0; i < m_length; ++i)
+                r[i] = Reduce(m_hi[i], m_lo[i]);
+            return result;
+        }
+        else {
+            return m_sum;
+        }
+    }
+
+private:
+    void CheckOperand(const VecType& b) const {
+        if (b.GetLength() != m_length || b.GetModulus() != m_modulus)
+            OPENFHE_THROW("NativeVectorAccumulatorT operand of different parameters.");
+    }
+
+    // makes room for one more product, folding the values back below q when the double words could overflow
+    void Reserve() {
+        if (m_count == m_maxCount) {
+            for (usint i = 0; i < m_length; ++i) {
+                m_lo[i] = Reduce(m_hi[i], m_lo[i]);
+                m_hi[i] = 0;
+            }
+            m_count = 1;
+        }
+        ++m_count;
+    }
+
+    void Accumulate(usint i, DNativeInt p) {
+        if (m_shift == 52) {
+            m_lo[i] += static_cast<uint64_t>(p) & ((uint64_t(1) << 52) - 1);
+            m_hi[i] += static_cast<uint64_t>(p >> 52);
+        }
+        else {
+            uint64_t lo{m_lo[i] + static_cast<uint64_t>(p)};
+            m_hi[i] += static_cast<uint64_t>(p >> 64) + (lo < m_lo[i]);
+            m_lo[i] = lo;
+        }
+    }
+
+    // Shoup multiplication x * w mod q of any 64-bit x, wp = floor(w * 2^64 / q)
+    uint64_t MulModConst(uint64_t x, uint64_t w, uint64_t wp) const {
+        uint64_t q{m_modulus.template ConvertToInt<uint64_t>()};
+        uint64_t r{x * w - static_cast<uint64_t>((DNativeInt(x) * wp) >> 64) * q};
+        return (r >= q) ? r - q : r;
+    }
+
+    // hi * 2^s + lo mod q
+    uint64_t Reduce(uint64_t hi, uint64_t lo) const {
+        uint64_t q{m_modulus.template ConvertToInt<uint64_t>()};
+        uint64_t r{MulModConst(hi, m_shiftMod, m_shiftPrecon) + MulModConst(lo, 1, m_onePrecon)};
+        return (r >= q) ? r - q : r;
+    }
+
+    usint m_length;
+    IntegerType m_modulus;
+    // the sum of the products reduced as they are added, without lazy reduction
+    VecType m_sum;
+    std::vector<uint64_t> m_hi;
+    std::vector<uint64_t> m_lo;
+    uint32_t m_shift{64};
+    // number of products accumulated since the values were last below q, and its bound
+    uint64_t m_count{0};
+    uint64_t m_maxCount{1};
+    // 2^s mod q and the Shoup constants of the reduction
+    uint64_t m_shiftMod{0};
+    uint64_t m_shiftPrecon{0};
+    uint64_t m_onePrecon{0};
+};
+
+}  // namespace intnat
+
+#endif
@@ -37,18 +37,21 @@
 #define LBCRYPTO_INC_MATH_HAL_INTNAT_MUBINTVECNAT_H
 
 #include "math/hal/basicint.h"
+#include "math/hal/intnat/simdnat.h"
 #include "math/hal/intnat/ubintnat.h"
 #include "math/hal/vector.h"
 
 #include "utils/blockAllocator/xvector.h"
 #include "utils/exception.h"
 #include "utils/inttypes.h"
+#include "utils/polyarena.h"
 #include "utils/serializable.h"
 
 #include <algorithm>
 #include <initializer_list>
 #include <iostream>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -69,6 +72,9 @@ template <typename IntType>
 class NativeVectorT;
 using NativeVector = NativeVectorT<NativeInteger>;
 
+template <typename IntType>
+class NativeVectorAccumulatorT;
+
 /**
  * @brief The class for representing vectors of native integers.
  */
@@ -124,7 +130,8 @@ private:
     IntegerType m_modulus{0};
 
 #if BLOCK_VECTOR_ALLOCATION != 1
-    std::vector<IntegerType> m_data{};
+    // the storage is recycled by the PolyArena active on the allocating thread, if any
+    std::vector<IntegerType, lbcrypto::PolyArenaAllocator<IntegerType>> m_data{};
 #else
     xvector<IntegerType> m_data{};
 #endif
@@ -134,6 +141,20 @@ private:
         return length < m_data.size();
     }
 
+    // the element-wise kernels of simdnat.h work on the 64-bit words of the vectors
+    static constexpr bool SIMD_WORDS{std::is_same_v<typename IntegerType::Integer, uint64_t> &&
+                                     sizeof(IntegerType) == sizeof(uint64_t)};
+
+    uint64_t* Words() {
+        return reinterpret_cast<uint64_t*>(m_data.data());
+    }
+
+    const uint64_t* Words() const {
+        return reinterpret_cast<const uint64_t*>(m_data.data());
+    }
+
+    friend class NativeVectorAccumulatorT<IntegerType>;
+
 public:
     using BasicInt = typename IntegerType::Integer;
 
@@ -414,6 +435,10 @@ public:
     NativeVectorT& ModAddNoCheckEq(const NativeVectorT& b) {
         size_t size{m_data.size()};
         auto mv{m_modulus};
+        if constexpr (SIMD_WORDS) {
+            if (SIMDModAdd(Words(), b.Words(), size, mv.ConvertToInt()))
+                return *this;
+        }
         for (size_t i = 0; i < size; ++i)
             m_data[i].ModAddFastEq(b[i], mv);
         return *this;
@@ -491,6 +516,10 @@ public:
         auto mv{m_modulus};
 #ifdef NATIVEINT_BARRET_MOD
         auto mu{m_modulus.ComputeMu()};
+        if constexpr (SIMD_WORDS) {
+            if (SIMDModMul(Words(), b.Words(), size, mv.ConvertToInt(), mu.ConvertToInt()))
+                return *this;
+        }
         for (size_t i = 0; i < size; ++i)
             m_data[i].ModMulFastEq(b[i], mv, mu);
 #else
@@ -500,6 +529,32 @@ public:
         return *this;
     }
 
+    /**
+   * Fused vector modulus multiply-add: adds b * c to the current vector with a single reduction. In-place variant.
+   *
+   * @param &b is the first vector to multiply.
+   * @param &c is the second vector to multiply.
+   * @return is the result of the modulus multiply-add operation.
+   */
+    NativeVectorT& ModMulAddEq(const NativeVectorT& b, const NativeVectorT& c);
+    NativeVectorT& ModMulAddNoCheckEq(const NativeVectorT& b, const NativeVectorT& c) {
+        size_t size{m_data.size()};
+        auto mv{m_modulus};
+#ifdef NATIVEINT_BARRET_MOD
+        auto mu{m_modulus.ComputeMu()};
+        if constexpr (SIMD_WORDS) {
+            if (SIMDModMulAdd(Words(), b.Words(), c.Words(), size, mv.ConvertToInt(), mu.ConvertToInt()))
+                return *this;
+        }
+        for (size_t i = 0; i < size; ++i)
+            m_data[i].ModAddFastEq(b[i].ModMulFast(c[i], mv, mu), mv);
+#else
+        for (size_t i = 0; i < size; ++i)
+            m_data[i].ModAddFastEq(b[i].ModMulFast(c[i], mv), mv);
+#endif
+        return *this;
+    }
+
     /**
    * Vector multiplication without applying the modulus operation.
    *
@@ -0,0 +1,126 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2025, CEA-List
+//
+// All rights reserved.
+//
+// Author TPOC: jules.dumezy@cea.fr
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Runtime-dispatched SIMD kernels (AVX2, AVX-512 IFMA) for the native math backend: NTTs and element-wise modular
+  arithmetic
+ */
+
+#ifndef LBCRYPTO_MATH_HAL_INTNAT_SIMDNAT_H
+#define LBCRYPTO_MATH_HAL_INTNAT_SIMDNAT_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace intnat {
+
+/**
+ * Instruction sets of the SIMD kernels, in increasing order. AVX512IFMA uses 52-bit multipliers for the moduli
+ * below 2^50 and AVX2 for the others.
+ */
+enum class SIMDLevel { SCALAR = 0, AVX2, AVX512IFMA };
+
+/**
+ * @return the best instruction set supported by the processor (and the compiler).
+ */
+SIMDLevel GetSupportedSIMDLevel();
+
+/**
+ * @return the instruction set used by the kernels, the supported one by default.
+ */
+SIMDLevel GetSIMDLevel();
+
+/**
+ * Sets the instruction set used by the kernels, e.g. SCALAR to cross-check or benchmark them. It is capped to
+ * the supported one.
+ */
+void SetSIMDLevel(SIMDLevel level);
+
+/**
+ * In-place forward NTT (Cooley-Tukey, bit-reversed output) of n 64-bit values modulo q, with the same tables and
+ * the same fully reduced results as NumberTheoreticTransformNat::ForwardTransformToBitReverseInPlace.
+ *
+ * @return false if the transform was not done (scalar level, n < 16 or q >= 2^62), in which case the caller
+ * falls back to the scalar transform.
+ */
+bool SIMDForwardNTT(uint64_t* element, uint32_t n, uint64_t modulus, const uint64_t* rootOfUnityTable,
+                    const uint64_t* preconRootOfUnityTable);
+
+/**
+ * In-place inverse NTT (Gentleman-Sande, bit-reversed input), counterpart of
+ * NumberTheoreticTransformNat::InverseTransformFromBitReverseInPlace. omega1Inv is rootOfUnityInverseTable[1]
+ * times cycloOrderInv, applied in the last stage.
+ *
+ * @return false if the transform was not done, see SIMDForwardNTT.
+ */
+bool SIMDInverseNTT(uint64_t* element, uint32_t n, uint64_t modulus, const uint64_t* rootOfUnityInverseTable,
+                    const uint64_t* preconRootOfUnityInverseTable, uint64_t cycloOrderInv, uint64_t preconCycloOrderInv,
+                    uint64_t omega1Inv, uint64_t preconOmega1Inv);
+
+/**
+ * Element-wise kernels on the n 64-bit values of a, in place, with operands below q and fully reduced results, as
+ * the scalar loops of NativeVectorT:
+ * - SIMDModAdd, SIMDModSub: a + b and a - b, or with the constant b for the Const variants,
+ * - SIMDModMul: a * b with the Barrett reduction of NativeIntegerT::ModMulFastEq, mu being NativeIntegerT::ComputeMu,
+ * - SIMDModMulConst: a * b with the Shoup precomputation bPrecon = NativeIntegerT::PrepModMulConst,
+ * - SIMDModMulAdd: the fused a + b * c, with a single reduction.
+ *
+ * The multiplications are only vectorised with AVX-512: the 64-bit products of AVX2 are no faster than the scalar
+ * ones.
+ *
+ * @return false if the operation was not done (scalar level, n < 16 or not a multiple of 8, q >= 2^60), in which
+ * case the caller falls back to the scalar loop.
+ */
+bool SIMDModAdd(uint64_t* a, const uint64_t* b, size_t n, uint64_t modulus);
+bool SIMDModAddConst(uint64_t* a, uint64_t b, size_t n, uint64_t modulus);
+bool SIMDModSub(uint64_t* a, const uint64_t* b, size_t n, uint64_t modulus);
+bool SIMDModSubConst(uint64_t* a, uint64_t b, size_t n, uint64_t modulus);
+bool SIMDModMul(uint64_t* a, const uint64_t* b, size_t n, uint64_t modulus, uint64_t mu);
+bool SIMDModMulConst(uint64_t* a, uint64_t b, uint64_t bPrecon, size_t n, uint64_t modulus);
+bool SIMDModMulAdd(uint64_t* a, const uint64_t* b, const uint64_t* c, size_t n, uint64_t modulus, uint64_t mu);
+
+/**
+ * Lazy accumulation of products for NativeVectorAccumulatorT, without any reduction: each value is kept as the
+ * double word hi * 2^shift + lo, lo not being limited to shift bits.
+ * - SIMDAccumulatorShift: 52 when the products modulo q are accumulated with the 52-bit multipliers of IFMA
+ *   (q < 2^50), 64 otherwise,
+ * - SIMDMulAccumulate: (hi, lo) += b * c, or with the constant c for the Const variant.
+ *
+ * @return false if the operation was not done (not the AVX-512 level, n < 16 or not a multiple of 8), in which
+ * case the caller falls back to the scalar loop.
+ */
+uint32_t SIMDAccumulatorShift(uint64_t modulus);
+bool SIMDMulAccumulate(uint64_t* hi, uint64_t* lo, const uint64_t* b, const uint64_t* c, size_t n, uint32_t shift);
+bool SIMDMulAccumulateConst(uint64_t* hi, uint64_t* lo, const uint64_t* b, uint64_t c, size_t n, uint32_t shift);
+
+}  // namespace intnat
+
+#endif
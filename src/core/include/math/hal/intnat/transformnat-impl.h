@@ -40,6 +40,7 @@
 #include "math/hal/intnat/ubintnat.h"
 #include "math/hal/intnat/mubintvecnat.h"
 #include "math/hal/intnat/transformnat.h"
+#include "math/hal/intnat/simdnat.h"
 #include "math/nbtheory.h"
 
 #include "utils/exception.h"
@@ -47,6 +48,7 @@
 #include "utils/utilities.h"
 
 #include <map>
+#include <type_traits>
 #include <vector>
 
 namespace intnat {
@@ -122,6 +124,43 @@ std::map<typename VecType::Integer, typename VecType::Integer>
 template <typename VecType>
 std::map<usint, usint> ChineseRemainderTransformArbNat<VecType>::m_nttDivisionDim;
 
+// The vectorised transforms of simdnat.h work on the 64-bit words of the vectors. They return false when the
+// scalar loops are to be used.
+template <typename VecType>
+bool SIMDForwardTransformInPlace(const VecType& rootOfUnityTable, const VecType& preconRootOfUnityTable,
+                                 VecType* element) {
+    using IntType = typename VecType::Integer;
+    if constexpr (std::is_same_v<typename IntType::Integer, uint64_t> && sizeof(IntType) == sizeof(uint64_t)) {
+        return SIMDForwardNTT(reinterpret_cast<uint64_t*>(&(*element)[0]), element->GetLength(),
+                              element->GetModulus().ConvertToInt(),
+                              reinterpret_cast<const uint64_t*>(&rootOfUnityTable[0]),
+                              reinterpret_cast<const uint64_t*>(&preconRootOfUnityTable[0]));
+    }
+    else {
+        return false;
+    }
+}
+
+template <typename VecType>
+bool SIMDInverseTransformInPlace(const VecType& rootOfUnityInverseTable, const VecType& preconRootOfUnityInverseTable,
+                                 const typename VecType::Integer& cycloOrderInv,
+                                 const typename VecType::Integer& preconCycloOrderInv,
+                                 const typename VecType::Integer& omega1Inv,
+                                 const typename VecType::Integer& preconOmega1Inv, VecType* element) {
+    using IntType = typename VecType::Integer;
+    if constexpr (std::is_same_v<typename IntType::Integer, uint64_t> && sizeof(IntType) == sizeof(uint64_t)) {
+        return SIMDInverseNTT(reinterpret_cast<uint64_t*>(&(*element)[0]), element->GetLength(),
+                              element->GetModulus().ConvertToInt(),
+                              reinterpret_cast<const uint64_t*>(&rootOfUnityInverseTable[0]),
+                              reinterpret_cast<const uint64_t*>(&preconRootOfUnityInverseTable[0]),
+                              cycloOrderInv.ConvertToInt(), preconCycloOrderInv.ConvertToInt(),
+                              omega1Inv.ConvertToInt(), preconOmega1Inv.ConvertToInt());
+    }
+    else {
+        return false;
+    }
+}
+
 template <typename VecType>
 void NumberTheoreticTransformNat<VecType>::ForwardTransformIterative(const VecType& element,
                                                                      const VecType& rootOfUnityTable, VecType* result) {
@@ -318,6 +357,9 @@ void NumberTheoreticTransformNat<VecType>::ForwardTransformToBitReverseInPlace(c
     //             element[j1 + t] = (loVal - hiVal) mod modulus
     //
 
+    if (SIMDForwardTransformInPlace(rootOfUnityTable, preconRootOfUnityTable, element))
+        return;
+
     const auto modulus{element->GetModulus()};
     const uint32_t n(element->GetLength() >> 1);
     for (uint32_t m{1}, t{n}, logt{GetMSB(t)}; m < n; m <<= 1, t >>= 1, --logt) {
@@ -391,6 +433,9 @@ void NumberTheoreticTransformNat<VecType>::ForwardTransformToBitReverse(const Ve
         (*result)[i] = element[i];
     }
 
+    if (SIMDForwardTransformInPlace(rootOfUnityTable, preconRootOfUnityTable, result))
+        return;
+
     uint32_t indexOmega, indexHi;
     NativeInteger preconOmega;
     IntType omega, omegaFactor, loVal, hiVal, zero(0);
@@ -537,6 +582,10 @@ void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverseInPlace
     auto omega1Inv{rootOfUnityInverseTable[1].ModMulFastConst(cycloOrderInv, modulus, preconCycloOrderInv)};
     auto preconOmega1Inv{omega1Inv.PrepModMulConst(modulus)};
 
+    if (SIMDInverseTransformInPlace(rootOfUnityInverseTable, preconRootOfUnityInverseTable, cycloOrderInv,
+                                    preconCycloOrderInv, omega1Inv, preconOmega1Inv, element))
+        return;
+
     // peeled off first stage for performance
     for (uint32_t i{0}; i < n; i += 2) {
         auto omega{rootOfUnityInverseTable[(i + n) >> 1]};
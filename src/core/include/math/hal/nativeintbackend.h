@@ -35,12 +35,14 @@
 #include "math/hal/basicint.h"
 #include "math/hal/intnat/ubintnat.h"
 #include "math/hal/intnat/mubintvecnat.h"
+#include "math/hal/intnat/accumulatornat.h"
 #include "math/hal/intnat/transformnat.h"
 
 namespace lbcrypto {
 
-using NativeInteger = intnat::NativeInteger;
-using NativeVector  = intnat::NativeVector;
+using NativeInteger           = intnat::NativeInteger;
+using NativeVector            = intnat::NativeVector;
+using NativeVectorAccumulator = intnat::NativeVectorAccumulator;
 
 }  // namespace lbcrypto
 
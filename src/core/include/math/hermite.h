@@ -44,6 +44,8 @@ std::vector<std::complex<double>> hermiteInterpOrder2Coeff(std::function<double(
 
 std::vector<std::complex<double>> hermiteInterpOrder3Coeff(std::function<double(int)> f, int p);
 
+std::vector<std::complex<double>> hermiteInterpCoeff(std::function<double(double)> f, int p, int order);
+
 }  // namespace lbcrypto
 
 #endif
@@ -0,0 +1,111 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2025, CEA-List
+//
+// All rights reserved.
+//
+// Author TPOC: jules.dumezy@cea.fr
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Process-wide counters of the expensive lattice operations, used to attribute the cost of bootstrapping
+ */
+
+#ifndef LBCRYPTO_INC_UTILS_OPCOUNTERS_H
+#define LBCRYPTO_INC_UTILS_OPCOUNTERS_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace lbcrypto {
+
+enum OpCounterType {
+    NTT_COUNTER = 0,    // forward or inverse NTT of a single tower
+    KEYSWITCH_COUNTER,  // key switching (relinearization, rotation, conjugation)
+    RESCALE_COUNTER,    // dropped level in a CKKS rescale
+    NUM_OP_COUNTERS
+};
+
+/**
+ * Counters of the operations of one computation (e.g. a bootstrap), filled while the sink is attached.
+ */
+struct OpCounterSink {
+    std::atomic<uint64_t> counters[NUM_OP_COUNTERS]{};
+
+    uint64_t Get(OpCounterType type) const {
+        return counters[type].load(std::memory_order_relaxed);
+    }
+};
+
+/**
+ * The counters are only incremented while at least one client has enabled them, so that the hot paths
+ * pay a single relaxed atomic load otherwise. The process-wide counters are shared by all the threads of
+ * the process: the difference of two snapshots only attributes the operations to a computation if it is
+ * the only one running meanwhile. A sink attached by a thread instead only receives the operations of that
+ * thread and of the OpenMP threads of the parallel regions it opens, so that computations running
+ * concurrently on the threads of an enclosing parallel region are counted separately. The OpenMP threads
+ * of computations started outside of any parallel region (e.g. on several std::threads) can not be told
+ * apart: their operations are only added to a sink if it is the single one attached at that level.
+ */
+class OpCounters {
+public:
+    // @Brief enables counting, calls must be balanced by calls to Disable()
+    static void Enable() {
+        s_enabled.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void Disable() {
+        s_enabled.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    static bool IsEnabled() {
+        return s_enabled.load(std::memory_order_relaxed) > 0;
+    }
+
+    static void Add(OpCounterType type, uint64_t count = 1) {
+        if (IsEnabled())
+            AddEnabled(type, count);
+    }
+
+    static uint64_t Get(OpCounterType type) {
+        return s_counters[type].load(std::memory_order_relaxed);
+    }
+
+    // @Brief attaches sink to the calling thread and enables counting until the matching Detach()
+    static void Attach(OpCounterSink* sink);
+
+    // @Brief detaches sink from the calling thread, which must be the one that attached it
+    static void Detach(OpCounterSink* sink);
+
+private:
+    static void AddEnabled(OpCounterType type, uint64_t count);
+
+    static std::atomic<int32_t> s_enabled;
+    static std::atomic<uint64_t> s_counters[NUM_OP_COUNTERS];
+};
+
+}  // namespace lbcrypto
+
+#endif
@@ -40,8 +40,24 @@
     #include <omp.h>
 #endif
 
+#include <cstdint>
+
 namespace lbcrypto {
 
+enum ParallelOpType {
+    BASIS_SWITCH_OP = 0,  // CRT basis switching and extension, coefficient by coefficient
+    SCALE_AND_ROUND_OP,   // scaling and rounding of CRT representations (BFV multiplication and decryption)
+    INTERPOLATE_OP,       // CRT interpolation to a multiprecision polynomial
+    NUM_PARALLEL_OPS
+};
+
+/**
+ * The loops over the coefficients of a DCRTPoly size their thread teams with GetThreadLimit(op, n, cost):
+ * one thread per grain size of work, where the work is n iterations of cost tower operations each, but no
+ * more than the thread cap of the operation (none by default) and than the threads left at the current
+ * nesting level, i.e., the threads set with SetNumThreads() (1 after Disable()) divided by the sizes of the
+ * enclosing teams.
+ */
 class ParallelControls {
 public:
     // @Brief CTOR, enables parallel operations as default
@@ -117,6 +133,66 @@ public:
 #endif
     }
 
+    // @Brief returns the number of threads for a loop of n iterations of op costing cost tower operations each
+    int GetThreadLimit(ParallelOpType op, uint64_t n, uint64_t cost) const {
+#ifdef PARALLEL
+        uint64_t threads = n * cost / grainSize[op];
+        uint64_t limit   = GetAvailableThreads();
+        if (threadCap[op] > 0 && threadCap[op] < limit)
+            limit = threadCap[op];
+        if (threads > limit)
+            threads = limit;
+        return threads > 0 ? static_cast<int>(threads) : 1;
+#else
+        return 1;
+#endif
+    }
+
+    // @Brief returns the threads left for a team opened at the current nesting level
+    int GetAvailableThreads() const {
+#ifdef PARALLEL
+        int level = omp_get_level();
+        if (level > 0 && omp_get_active_level() >= omp_get_max_active_levels())
+            return 1;
+        // omp_get_max_threads() follows Enable(), Disable() and SetNumThreads()
+        int threads = omp_get_max_threads();
+        for (int l = 1; l <= level; ++l) {
+            int size = omp_get_team_size(l);
+            if (size > 1)
+                threads /= size;
+        }
+        return threads > 0 ? threads : 1;
+#else
+        return 1;
+#endif
+    }
+
+    // @Brief returns the number of coefficient blocks each of towers towers is split into so that a loop over
+    // towers x blocks keeps threads threads busy: 1 if there are at least as many towers as threads
+    static uint32_t GetCoefficientBlocks(int threads, uint32_t towers) {
+        if (towers == 0 || static_cast<uint32_t>(threads) <= towers)
+            return 1;
+        return (threads + towers - 1) / towers;
+    }
+
+    // @Brief sets the minimum work, in tower operations, per thread of op
+    void SetGrainSize(ParallelOpType op, uint64_t grain) {
+        grainSize[op] = grain > 0 ? grain : 1;
+    }
+
+    uint64_t GetGrainSize(ParallelOpType op) const {
+        return grainSize[op];
+    }
+
+    // @Brief caps the number of threads of op, 0 lifts the cap
+    void SetThreadCap(ParallelOpType op, uint32_t cap) {
+        threadCap[op] = cap;
+    }
+
+    uint32_t GetThreadCap(ParallelOpType op) const {
+        return threadCap[op];
+    }
+
     // @Brief sets number of threads to use (limited by system value)
     void SetNumThreads(int nthreads) {
 #ifdef PARALLEL
@@ -127,6 +203,8 @@ public:
 
 private:
     int machineThreads{1};
+    uint64_t grainSize[NUM_PARALLEL_OPS]{1 << 14, 1 << 14, 1 << 14};
+    uint32_t threadCap[NUM_PARALLEL_OPS]{};
 };
 
 extern ParallelControls OpenFHEParallelControls;
@@ -0,0 +1,158 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2025, CEA-List
+//
+// All rights reserved.
+//
+// Author TPOC: jules.dumezy@cea.fr
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Scoped arena recycling the storage of the native vectors of polynomials
+ */
+
+#ifndef LBCRYPTO_INC_UTILS_POLYARENA_H
+#define LBCRYPTO_INC_UTILS_POLYARENA_H
+
+#include <cstddef>
+#include <memory>
+
+namespace lbcrypto {
+
+/**
+ * A PolyArena keeps the buffers released by the native vectors allocated while it is active, and hands them out
+ * again to the next allocations of the same size, e.g. the towers of the temporaries of the next stage of
+ * bootstrapping. The cached buffers are all freed when the arena is destroyed. Buffers still in use at that time,
+ * such as the ones of a returned ciphertext, stay valid and go back to the heap when they are released.
+ *
+ * An arena is activated for the calling thread by a PolyArenaScope. The allocations made by other threads, e.g.
+ * the workers of a parallel region, use the heap, but any thread may release a buffer of the arena.
+ */
+class PolyArena {
+public:
+    /**
+   * @param maxCachedBytes bound on the size of the cached buffers, 0 for no bound.
+   */
+    explicit PolyArena(size_t maxCachedBytes = 0);
+
+    PolyArena(const PolyArena&)            = delete;
+    PolyArena& operator=(const PolyArena&) = delete;
+
+    ~PolyArena();
+
+    /**
+   * Frees the cached buffers.
+   */
+    void Release();
+
+    /**
+   * @return the size of the cached buffers, in bytes.
+   */
+    size_t GetCachedBytes() const;
+
+    /**
+   * @return the number of allocations served from the cache.
+   */
+    size_t GetNumReused() const;
+
+    /**
+   * @return the number of allocations made on the heap.
+   */
+    size_t GetNumAllocated() const;
+
+    /**
+   * Allocates a buffer from the arena active on the calling thread, or from the heap if there is none.
+   */
+    static void* Allocate(size_t bytes);
+
+    /**
+   * Releases a buffer returned by Allocate, to its arena if it is still alive.
+   */
+    static void Deallocate(void* ptr) noexcept;
+
+    struct State;
+
+private:
+    friend class PolyArenaScope;
+
+    State* m_state;
+};
+
+/**
+ * Activates an arena on the calling thread until the end of the scope, the previous one being restored
+ * afterwards. Without argument, the arena already active is kept, and a new one is created for the scope if there
+ * is none: nested scopes share the arena of the outermost one.
+ */
+class PolyArenaScope {
+public:
+    PolyArenaScope();
+
+    explicit PolyArenaScope(PolyArena& arena);
+
+    PolyArenaScope(const PolyArenaScope&)            = delete;
+    PolyArenaScope& operator=(const PolyArenaScope&) = delete;
+
+    ~PolyArenaScope();
+
+private:
+    std::unique_ptr<PolyArena> m_owned;
+    PolyArena::State* m_prev;
+};
+
+/**
+ * Stateless allocator of the native vectors, serving their storage through PolyArena.
+ */
+template <typename T>
+class PolyArenaAllocator {
+public:
+    using value_type = T;
+
+    PolyArenaAllocator() noexcept = default;
+
+    template <typename U>
+    PolyArenaAllocator(const PolyArenaAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(PolyArena::Allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t) noexcept {
+        PolyArena::Deallocate(ptr);
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const PolyArenaAllocator<T>&, const PolyArenaAllocator<U>&) noexcept {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const PolyArenaAllocator<T>&, const PolyArenaAllocator<U>&) noexcept {
+    return false;
+}
+
+}  // namespace lbcrypto
+
+#endif
@@ -105,4 +105,9 @@ PRNG& PseudoRandomNumberGenerator::GetPRNG() {
     return *m_prng;
 }
 
+std::shared_ptr<PRNG> PseudoRandomNumberGenerator::SetPRNG(std::shared_ptr<PRNG> prng) {
+    std::swap(m_prng, prng);
+    return prng;
+}
+
 }  // namespace lbcrypto
@@ -199,6 +199,10 @@ NativeVectorT<IntegerType> NativeVectorT<IntegerType>::ModAdd(const IntegerType&
     auto bv{b};
     if (bv.m_value >= mv.m_value)
         bv.ModEq(mv);
+    if constexpr (SIMD_WORDS) {
+        if (SIMDModAddConst(ans.Words(), bv.ConvertToInt(), ans.m_data.size(), mv.ConvertToInt()))
+            return ans;
+    }
     for (size_t i = 0; i < ans.m_data.size(); ++i)
         ans.m_data[i] = ans.m_data[i].ModAddFast(bv, mv);
     return ans;
@@ -210,6 +214,10 @@ NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ModAddEq(const IntegerTy
     auto bv{b};
     if (bv.m_value >= mv.m_value)
         bv.ModEq(mv);
+    if constexpr (SIMD_WORDS) {
+        if (SIMDModAddConst(Words(), bv.ConvertToInt(), m_data.size(), mv.ConvertToInt()))
+            return *this;
+    }
     for (size_t i = 0; i < m_data.size(); ++i)
         m_data[i] = m_data[i].ModAddFast(bv, mv);
     return *this;
@@ -234,6 +242,10 @@ NativeVectorT<IntegerType> NativeVectorT<IntegerType>::ModAdd(const NativeVector
         OPENFHE_THROW("ModAdd called on NativeVectorT's with different parameters.");
     auto mv{m_modulus};
     auto ans(*this);
+    if constexpr (SIMD_WORDS) {
+        if (SIMDModAdd(ans.Words(), b.Words(), ans.m_data.size(), mv.ConvertToInt()))
+            return ans;
+    }
     for (size_t i = 0; i < ans.m_data.size(); ++i)
         ans.m_data[i].ModAddFastEq(b[i], mv);
     return ans;
@@ -244,6 +256,10 @@ NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ModAddEq(const NativeVec
     if (m_data.size() != b.m_data.size() || m_modulus != b.m_modulus)
         OPENFHE_THROW("ModAddEq called on NativeVectorT's with different parameters.");
     auto mv{m_modulus};
+    if constexpr (SIMD_WORDS) {
+        if (SIMDModAdd(Words(), b.Words(), m_data.size(), mv.ConvertToInt()))
+            return *this;
+    }
     for (size_t i = 0; i < m_data.size(); ++i)
         m_data[i].ModAddFastEq(b[i], mv);
     return *this;
@@ -256,6 +272,10 @@ NativeVectorT<IntegerType> NativeVectorT<IntegerType>::ModSub(const IntegerType&
     auto ans(*this);
     if (bv.m_value >= mv.m_value)
         bv.ModEq(mv);
+    if constexpr (SIMD_WORDS) {
+        if (SIMDModSubConst(ans.Words(), bv.ConvertToInt(), ans.m_data.size(), mv.ConvertToInt()))
+            return ans;
+    }
     for (size_t i = 0; i < ans.m_data.size(); ++i)
         ans[i].ModSubFastEq(bv, mv);
     return ans;
@@ -267,6 +287,10 @@ NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ModSubEq(const IntegerTy
     auto bv{b};
     if (bv.m_value >= mv.m_value)
         bv.ModEq(mv);
+    if constexpr (SIMD_WORDS) {
+        if (SIMDModSubConst(Words(), bv.ConvertToInt(), m_data.size(), mv.ConvertToInt()))
+            return *this;
+    }
     for (size_t i = 0; i < m_data.size(); ++i)
         m_data[i].ModSubFastEq(bv, mv);
     return *this;
@@ -278,6 +302,10 @@ NativeVectorT<IntegerType> NativeVectorT<IntegerType>::ModSub(const NativeVector
         OPENFHE_THROW("ModSub called on NativeVectorT's with different parameters.");
     auto mv{m_modulus};
     auto ans(*this);
+    if constexpr (SIMD_WORDS) {
+        if (SIMDModSub(ans.Words(), b.Words(), ans.m_data.size(), mv.ConvertToInt()))
+            return ans;
+    }
     for (size_t i = 0; i < ans.m_data.size(); ++i)
         ans[i].ModSubFastEq(b[i], mv);
     return ans;
@@ -287,6 +315,10 @@ template <class IntegerType>
 NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ModSubEq(const NativeVectorT& b) {
     if (m_data.size() != b.m_data.size() || m_modulus != b.m_modulus)
         OPENFHE_THROW("ModSubEq called on NativeVectorT's with different parameters.");
+    if constexpr (SIMD_WORDS) {
+        if (SIMDModSub(Words(), b.Words(), m_data.size(), m_modulus.ConvertToInt()))
+            return *this;
+    }
     for (size_t i = 0; i < m_data.size(); ++i)
         m_data[i].ModSubFastEq(b[i], m_modulus);
     return *this;
@@ -300,6 +332,11 @@ NativeVectorT<IntegerType> NativeVectorT<IntegerType>::ModMul(const IntegerType&
     if (bv.m_value >= mv.m_value)
         bv.ModEq(mv);
     auto bconst{bv.PrepModMulConst(mv)};
+    if constexpr (SIMD_WORDS) {
+        if (SIMDModMulConst(ans.Words(), bv.ConvertToInt(), bconst.ConvertToInt(), ans.m_data.size(),
+                            mv.ConvertToInt()))
+            return ans;
+    }
     for (size_t i = 0; i < ans.m_data.size(); ++i)
         ans[i].ModMulFastConstEq(bv, mv, bconst);
     return ans;
@@ -312,6 +349,10 @@ NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ModMulEq(const IntegerTy
     if (bv.m_value >= mv.m_value)
         bv.ModEq(mv);
     auto bconst{bv.PrepModMulConst(mv)};
+    if constexpr (SIMD_WORDS) {
+        if (SIMDModMulConst(Words(), bv.ConvertToInt(), bconst.ConvertToInt(), m_data.size(), mv.ConvertToInt()))
+            return *this;
+    }
     for (size_t i = 0; i < m_data.size(); ++i)
         m_data[i].ModMulFastConstEq(bv, mv, bconst);
     return *this;
@@ -326,6 +367,10 @@ NativeVectorT<IntegerType> NativeVectorT<IntegerType>::ModMul(const NativeVector
     auto mv{m_modulus};
 #ifdef NATIVEINT_BARRET_MOD
     auto mu{m_modulus.ComputeMu()};
+    if constexpr (SIMD_WORDS) {
+        if (SIMDModMul(ans.Words(), b.Words(), size, mv.ConvertToInt(), mu.ConvertToInt()))
+            return ans;
+    }
     for (uint32_t i = 0; i < size; ++i)
         ans[i].ModMulFastEq(b[i], mv, mu);
 #else
@@ -343,6 +388,10 @@ NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ModMulEq(const NativeVec
     size_t size{m_data.size()};
 #ifdef NATIVEINT_BARRET_MOD
     auto mu{m_modulus.ComputeMu()};
+    if constexpr (SIMD_WORDS) {
+        if (SIMDModMul(Words(), b.Words(), size, mv.ConvertToInt(), mu.ConvertToInt()))
+            return *this;
+    }
     for (size_t i = 0; i < size; ++i)
         m_data[i].ModMulFastEq(b[i], mv, mu);
 #else
@@ -352,6 +401,14 @@ NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ModMulEq(const NativeVec
     return *this;
 }
 
+template <class IntegerType>
+NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ModMulAddEq(const NativeVectorT& b, const NativeVectorT& c) {
+    if (m_data.size() != b.m_data.size() || m_data.size() != c.m_data.size() || m_modulus != b.m_modulus ||
+        m_modulus != c.m_modulus)
+        OPENFHE_THROW("ModMulAddEq called on NativeVectorT's with different parameters.");
+    return ModMulAddNoCheckEq(b, c);
+}
+
 template <class IntegerType>
 NativeVectorT<IntegerType> NativeVectorT<IntegerType>::ModByTwo() const {
     auto ans(*this);
@@ -0,0 +1,783 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2025, CEA-List
+//
+// All rights reserved.
+//
+// Author TPOC: jules.dumezy@cea.fr
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  The kernels are compiled with function-level target attributes, so that the library does not need to be built
+  with -march flags, and are selected at runtime from the features of the processor
+ */
+
+#include "math/hal/intnat/simdnat.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__))
+    #define OPENFHE_SIMD_X86
+    #include <immintrin.h>
+    #define AVX2_TARGET __attribute__((target("avx2")))
+    #define AVX512_TARGET __attribute__((target("avx2,avx512f,avx512dq,avx512ifma")))
+    // false positives of GCC on the undefined vectors of the AVX-512 intrinsics
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    #endif
+#endif
+
+namespace intnat {
+
+namespace {
+
+SIMDLevel DetectSIMDLevel() {
+#ifdef OPENFHE_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512ifma"))
+        return SIMDLevel::AVX512IFMA;
+    if (__builtin_cpu_supports("avx2"))
+        return SIMDLevel::AVX2;
+#endif
+    return SIMDLevel::SCALAR;
+}
+
+std::atomic<SIMDLevel>& CurrentSIMDLevel() {
+    static std::atomic<SIMDLevel> level{GetSupportedSIMDLevel()};
+    return level;
+}
+
+// the 64-bit lanes hold values below 2q, compared as signed integers
+constexpr uint64_t MAX_SIMD_MODULUS = uint64_t(1) << 62;
+// the 52-bit multipliers of IFMA need the products of values below q to be reduced to [0, 2q), with 2q < 2^52
+constexpr uint64_t MAX_IFMA_MODULUS = uint64_t(1) << 50;
+constexpr uint32_t MIN_SIMD_LENGTH  = 16;
+// the Barrett constant of NativeIntegerT::ComputeMu, floor(2^(2k+3) / q) for a k-bit q, fits in 64 bits
+constexpr uint64_t MAX_ELEMENTWISE_MODULUS = uint64_t(1) << 60;
+
+#ifdef OPENFHE_SIMD_X86
+
+//
+// AVX2: 4 lanes, 64x64-bit products built from 32x32-bit ones
+//
+
+AVX2_TARGET inline __m256i MulHi64(__m256i a, __m256i b) {
+    const __m256i lo32 = _mm256_set1_epi64x(0xffffffff);
+    __m256i ah         = _mm256_srli_epi64(a, 32);
+    __m256i bh         = _mm256_srli_epi64(b, 32);
+    __m256i ll         = _mm256_mul_epu32(a, b);
+    __m256i lh         = _mm256_mul_epu32(a, bh);
+    __m256i hl         = _mm256_mul_epu32(ah, b);
+    __m256i hh         = _mm256_mul_epu32(ah, bh);
+    __m256i mid        = _mm256_add_epi64(_mm256_srli_epi64(ll, 32), _mm256_and_si256(lh, lo32));
+    mid                = _mm256_add_epi64(mid, _mm256_and_si256(hl, lo32));
+    __m256i hi         = _mm256_add_epi64(hh, _mm256_srli_epi64(lh, 32));
+    hi                 = _mm256_add_epi64(hi, _mm256_srli_epi64(hl, 32));
+    return _mm256_add_epi64(hi, _mm256_srli_epi64(mid, 32));
+}
+
+AVX2_TARGET inline __m256i MulLo64(__m256i a, __m256i b) {
+    __m256i ll    = _mm256_mul_epu32(a, b);
+    __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)),
+                                     _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b));
+    return _mm256_add_epi64(ll, _mm256_slli_epi64(cross, 32));
+}
+
+// x in [0, 2q) -> [0, q)
+AVX2_TARGET inline __m256i ReduceOnce(__m256i x, __m256i q) {
+    __m256i r = _mm256_sub_epi64(x, q);
+    return _mm256_add_epi64(r, _mm256_and_si256(_mm256_cmpgt_epi64(_mm256_setzero_si256(), r), q));
+}
+
+// Shoup multiplication x * w mod q, wp = floor(w * 2^64 / q)
+AVX2_TARGET inline __m256i MulModConst(__m256i x, __m256i w, __m256i wp, __m256i q) {
+    __m256i qhat = MulHi64(x, wp);
+    return ReduceOnce(_mm256_sub_epi64(MulLo64(x, w), MulLo64(qhat, q)), q);
+}
+
+AVX2_TARGET inline void ButterflyCT(__m256i& lo, __m256i& hi, __m256i w, __m256i wp, __m256i q) {
+    __m256i wf = MulModConst(hi, w, wp, q);
+    hi         = ReduceOnce(_mm256_sub_epi64(_mm256_add_epi64(lo, q), wf), q);
+    lo         = ReduceOnce(_mm256_add_epi64(lo, wf), q);
+}
+
+AVX2_TARGET inline void ButterflyGS(__m256i& lo, __m256i& hi, __m256i w, __m256i wp, __m256i q) {
+    __m256i diff = ReduceOnce(_mm256_sub_epi64(_mm256_add_epi64(lo, q), hi), q);
+    lo           = ReduceOnce(_mm256_add_epi64(lo, hi), q);
+    hi           = MulModConst(diff, w, wp, q);
+}
+
+AVX2_TARGET inline __m256i LoadU(const uint64_t* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+AVX2_TARGET inline void StoreU(uint64_t* p, __m256i v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+
+// roots of the butterflies (i, i + 2, i + 1, i + 3), in the lane order of the unpacked pairs
+AVX2_TARGET inline __m256i PairRoots(const uint64_t* w) {
+    return _mm256_set_epi64x(w[3], w[1], w[2], w[0]);
+}
+
+// roots of the butterflies (i, i, i + 1, i + 1)
+AVX2_TARGET inline __m256i QuadRoots(const uint64_t* w) {
+    return _mm256_set_epi64x(w[1], w[1], w[0], w[0]);
+}
+
+// forward stages with half-size t = tStart, tStart / 2, ..., 1
+AVX2_TARGET void ForwardAVX2(uint64_t* a, uint32_t n, uint64_t modulus, const uint64_t* w, const uint64_t* wp,
+                             uint32_t tStart) {
+    const __m256i q = _mm256_set1_epi64x(modulus);
+    uint32_t t      = tStart;
+    uint32_t m      = n / (2 * tStart);
+    for (; t >= 4; t >>= 1, m <<= 1) {
+        for (uint32_t i = 0; i < m; ++i) {
+            const __m256i omega       = _mm256_set1_epi64x(w[m + i]);
+            const __m256i preconOmega = _mm256_set1_epi64x(wp[m + i]);
+            uint64_t* x               = a + 2 * i * t;
+            for (uint32_t j = 0; j < t; j += 4) {
+                __m256i lo = LoadU(x + j);
+                __m256i hi = LoadU(x + j + t);
+                ButterflyCT(lo, hi, omega, preconOmega, q);
+                StoreU(x + j, lo);
+                StoreU(x + j + t, hi);
+            }
+        }
+    }
+    // t = 2: the two halves of each block of 4 are gathered from 2 blocks
+    for (uint32_t i = 0; i < m; i += 2) {
+        uint64_t* x = a + 4 * i;
+        __m256i v0  = LoadU(x);
+        __m256i v1  = LoadU(x + 4);
+        __m256i lo  = _mm256_permute2x128_si256(v0, v1, 0x20);
+        __m256i hi  = _mm256_permute2x128_si256(v0, v1, 0x31);
+        ButterflyCT(lo, hi, QuadRoots(w + m + i), QuadRoots(wp + m + i), q);
+        StoreU(x, _mm256_permute2x128_si256(lo, hi, 0x20));
+        StoreU(x + 4, _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+    m <<= 1;
+    // t = 1: the pairs are unpacked from 2 blocks of 4
+    for (uint32_t i = 0; i < m; i += 4) {
+        uint64_t* x = a + 2 * i;
+        __m256i v0  = LoadU(x);
+        __m256i v1  = LoadU(x + 4);
+        __m256i lo  = _mm256_unpacklo_epi64(v0, v1);
+        __m256i hi  = _mm256_unpackhi_epi64(v0, v1);
+        ButterflyCT(lo, hi, PairRoots(w + m + i), PairRoots(wp + m + i), q);
+        StoreU(x, _mm256_unpacklo_epi64(lo, hi));
+        StoreU(x + 4, _mm256_unpackhi_epi64(lo, hi));
+    }
+}
+
+// inverse stages with half-size t = 1, 2, ..., up to tEnd (excluded)
+AVX2_TARGET void InverseAVX2(uint64_t* a, uint32_t n, uint64_t modulus, const uint64_t* w, const uint64_t* wp,
+                             uint32_t tEnd) {
+    const __m256i q = _mm256_set1_epi64x(modulus);
+    uint32_t m      = n >> 1;
+    for (uint32_t i = 0; i < m; i += 4) {
+        uint64_t* x = a + 2 * i;
+        __m256i v0  = LoadU(x);
+        __m256i v1  = LoadU(x + 4);
+        __m256i lo  = _mm256_unpacklo_epi64(v0, v1);
+        __m256i hi  = _mm256_unpackhi_epi64(v0, v1);
+        ButterflyGS(lo, hi, PairRoots(w + m + i), PairRoots(wp + m + i), q);
+        StoreU(x, _mm256_unpacklo_epi64(lo, hi));
+        StoreU(x + 4, _mm256_unpackhi_epi64(lo, hi));
+    }
+    m >>= 1;
+    for (uint32_t i = 0; i < m; i += 2) {
+        uint64_t* x = a + 4 * i;
+        __m256i v0  = LoadU(x);
+        __m256i v1  = LoadU(x + 4);
+        __m256i lo  = _mm256_permute2x128_si256(v0, v1, 0x20);
+        __m256i hi  = _mm256_permute2x128_si256(v0, v1, 0x31);
+        ButterflyGS(lo, hi, QuadRoots(w + m + i), QuadRoots(wp + m + i), q);
+        StoreU(x, _mm256_permute2x128_si256(lo, hi, 0x20));
+        StoreU(x + 4, _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+    m >>= 1;
+    for (uint32_t t = 4; t < tEnd; t <<= 1, m >>= 1) {
+        for (uint32_t i = 0; i < m; ++i) {
+            const __m256i omega       = _mm256_set1_epi64x(w[m + i]);
+            const __m256i preconOmega = _mm256_set1_epi64x(wp[m + i]);
+            uint64_t* x               = a + 2 * i * t;
+            for (uint32_t j = 0; j < t; j += 4) {
+                __m256i lo = LoadU(x + j);
+                __m256i hi = LoadU(x + j + t);
+                ButterflyGS(lo, hi, omega, preconOmega, q);
+                StoreU(x + j, lo);
+                StoreU(x + j + t, hi);
+            }
+        }
+    }
+}
+
+// last inverse stage, scaled by n^{-1}
+AVX2_TARGET void InverseLastAVX2(uint64_t* a, uint32_t n, uint64_t modulus, uint64_t nInv, uint64_t preconNInv,
+                                 uint64_t omega1Inv, uint64_t preconOmega1Inv) {
+    const __m256i q           = _mm256_set1_epi64x(modulus);
+    const __m256i scale       = _mm256_set1_epi64x(nInv);
+    const __m256i preconScale = _mm256_set1_epi64x(preconNInv);
+    const __m256i omega       = _mm256_set1_epi64x(omega1Inv);
+    const __m256i preconOmega = _mm256_set1_epi64x(preconOmega1Inv);
+    const uint32_t t          = n >> 1;
+    for (uint32_t j = 0; j < t; j += 4) {
+        __m256i lo   = LoadU(a + j);
+        __m256i hi   = LoadU(a + j + t);
+        __m256i diff = ReduceOnce(_mm256_sub_epi64(_mm256_add_epi64(lo, q), hi), q);
+        __m256i sum  = ReduceOnce(_mm256_add_epi64(lo, hi), q);
+        StoreU(a + j, MulModConst(sum, scale, preconScale, q));
+        StoreU(a + j + t, MulModConst(diff, omega, preconOmega, q));
+    }
+}
+
+//
+// AVX2 element-wise kernels: the multiplications are left to the scalar loops, the 64x64-bit products built from
+// 32x32-bit ones being no faster than the scalar ones on 4 lanes
+//
+
+template <bool BROADCAST>
+AVX2_TARGET inline __m256i LoadOperand(const uint64_t* b, size_t i) {
+    return BROADCAST ? _mm256_set1_epi64x(static_cast<int64_t>(b[0])) : LoadU(b + i);
+}
+
+template <bool BROADCAST>
+AVX2_TARGET void AddAVX2(uint64_t* a, const uint64_t* b, size_t n, uint64_t modulus) {
+    const __m256i q = _mm256_set1_epi64x(modulus);
+    for (size_t i = 0; i < n; i += 4)
+        StoreU(a + i, ReduceOnce(_mm256_add_epi64(LoadU(a + i), LoadOperand<BROADCAST>(b, i)), q));
+}
+
+template <bool BROADCAST>
+AVX2_TARGET void SubAVX2(uint64_t* a, const uint64_t* b, size_t n, uint64_t modulus) {
+    const __m256i q    = _mm256_set1_epi64x(modulus);
+    const __m256i zero = _mm256_setzero_si256();
+    for (size_t i = 0; i < n; i += 4) {
+        __m256i r = _mm256_sub_epi64(LoadU(a + i), LoadOperand<BROADCAST>(b, i));
+        StoreU(a + i, _mm256_add_epi64(r, _mm256_and_si256(_mm256_cmpgt_epi64(zero, r), q)));
+    }
+}
+
+//
+// AVX-512: 8 lanes, with the 52x52-bit multipliers of IFMA for the moduli below 2^50, and 64x64-bit products built
+// from 32x32-bit ones otherwise
+//
+
+// x in [0, 2q) -> [0, q)
+AVX512_TARGET inline __m512i ReduceOnce512(__m512i x, __m512i q) {
+    return _mm512_mask_sub_epi64(x, _mm512_cmpge_epu64_mask(x, q), x, q);
+}
+
+AVX512_TARGET inline __m512i MulHi64(__m512i a, __m512i b) {
+    const __m512i lo32 = _mm512_set1_epi64(0xffffffff);
+    __m512i ah         = _mm512_srli_epi64(a, 32);
+    __m512i bh         = _mm512_srli_epi64(b, 32);
+    __m512i ll         = _mm512_mul_epu32(a, b);
+    __m512i lh         = _mm512_mul_epu32(a, bh);
+    __m512i hl         = _mm512_mul_epu32(ah, b);
+    __m512i hh         = _mm512_mul_epu32(ah, bh);
+    __m512i mid        = _mm512_add_epi64(_mm512_srli_epi64(ll, 32), _mm512_and_si512(lh, lo32));
+    mid                = _mm512_add_epi64(mid, _mm512_and_si512(hl, lo32));
+    __m512i hi         = _mm512_add_epi64(hh, _mm512_srli_epi64(lh, 32));
+    hi                 = _mm512_add_epi64(hi, _mm512_srli_epi64(hl, 32));
+    return _mm512_add_epi64(hi, _mm512_srli_epi64(mid, 32));
+}
+
+// Shoup multiplication x * w mod q, wp = floor(w * 2^52 / q) with IFMA and floor(w * 2^64 / q) otherwise
+template <bool IFMA>
+AVX512_TARGET inline __m512i MulModConst512(__m512i x, __m512i w, __m512i wp, __m512i q) {
+    if constexpr (IFMA) {
+        const __m512i zero   = _mm512_setzero_si512();
+        const __m512i mask52 = _mm512_set1_epi64((uint64_t(1) << 52) - 1);
+        __m512i qhat         = _mm512_madd52hi_epu64(zero, x, wp);
+        __m512i r = _mm512_sub_epi64(_mm512_madd52lo_epu64(zero, x, w), _mm512_madd52lo_epu64(zero, qhat, q));
+        return ReduceOnce512(_mm512_and_si512(r, mask52), q);
+    }
+    else {
+        __m512i qhat = MulHi64(x, wp);
+        return ReduceOnce512(_mm512_sub_epi64(_mm512_mullo_epi64(x, w), _mm512_mullo_epi64(qhat, q)), q);
+    }
+}
+
+// the 52-bit Shoup constant floor(w * 2^52 / q) is the 64-bit one shifted
+template <bool IFMA>
+AVX512_TARGET inline __m512i PreconConst512(uint64_t wp) {
+    return _mm512_set1_epi64(IFMA ? (wp >> 12) : wp);
+}
+
+// forward stages with half-size t >= 8
+template <bool IFMA>
+AVX512_TARGET void ForwardAVX512(uint64_t* a, uint32_t n, uint64_t modulus, const uint64_t* w, const uint64_t* wp) {
+    const __m512i q = _mm512_set1_epi64(modulus);
+    for (uint32_t m = 1, t = n >> 1; t >= 8; t >>= 1, m <<= 1) {
+        for (uint32_t i = 0; i < m; ++i) {
+            const __m512i omega       = _mm512_set1_epi64(w[m + i]);
+            const __m512i preconOmega = PreconConst512<IFMA>(wp[m + i]);
+            uint64_t* x               = a + 2 * i * t;
+            for (uint32_t j = 0; j < t; j += 8) {
+                __m512i lo = _mm512_loadu_si512(x + j);
+                __m512i hi = _mm512_loadu_si512(x + j + t);
+                __m512i wf = MulModConst512<IFMA>(hi, omega, preconOmega, q);
+                _mm512_storeu_si512(x + j, ReduceOnce512(_mm512_add_epi64(lo, wf), q));
+                _mm512_storeu_si512(x + j + t, ReduceOnce512(_mm512_sub_epi64(_mm512_add_epi64(lo, q), wf), q));
+            }
+        }
+    }
+}
+
+// inverse stages with half-size 8 <= t < n / 2, then the last one scaled by n^{-1}
+template <bool IFMA>
+AVX512_TARGET void InverseAVX512(uint64_t* a, uint32_t n, uint64_t modulus, const uint64_t* w, const uint64_t* wp,
+                                 uint64_t nInv, uint64_t preconNInv, uint64_t omega1Inv, uint64_t preconOmega1Inv) {
+    const __m512i q = _mm512_set1_epi64(modulus);
+    for (uint32_t m = n >> 4, t = 8; t < (n >> 1); t <<= 1, m >>= 1) {
+        for (uint32_t i = 0; i < m; ++i) {
+            const __m512i omega       = _mm512_set1_epi64(w[m + i]);
+            const __m512i preconOmega = PreconConst512<IFMA>(wp[m + i]);
+            uint64_t* x               = a + 2 * i * t;
+            for (uint32_t j = 0; j < t; j += 8) {
+                __m512i lo   = _mm512_loadu_si512(x + j);
+                __m512i hi   = _mm512_loadu_si512(x + j + t);
+                __m512i diff = ReduceOnce512(_mm512_sub_epi64(_mm512_add_epi64(lo, q), hi), q);
+                _mm512_storeu_si512(x + j, ReduceOnce512(_mm512_add_epi64(lo, hi), q));
+                _mm512_storeu_si512(x + j + t, MulModConst512<IFMA>(diff, omega, preconOmega, q));
+            }
+        }
+    }
+
+    const __m512i scale       = _mm512_set1_epi64(nInv);
+    const __m512i preconScale = PreconConst512<IFMA>(preconNInv);
+    const __m512i omega       = _mm512_set1_epi64(omega1Inv);
+    const __m512i preconOmega = PreconConst512<IFMA>(preconOmega1Inv);
+    const uint32_t t          = n >> 1;
+    for (uint32_t j = 0; j < t; j += 8) {
+        __m512i lo   = _mm512_loadu_si512(a + j);
+        __m512i hi   = _mm512_loadu_si512(a + j + t);
+        __m512i diff = ReduceOnce512(_mm512_sub_epi64(_mm512_add_epi64(lo, q), hi), q);
+        __m512i sum  = ReduceOnce512(_mm512_add_epi64(lo, hi), q);
+        _mm512_storeu_si512(a + j, MulModConst512<IFMA>(sum, scale, preconScale, q));
+        _mm512_storeu_si512(a + j + t, MulModConst512<IFMA>(diff, omega, preconOmega, q));
+    }
+}
+
+//
+// AVX-512 element-wise kernels
+//
+
+// shift counts of a 128-bit right shift by s < 128, the shifts by 64 or more zeroing the lanes
+struct Shift128 {
+    __m128i right;
+    __m128i left;
+    __m128i rightHi;
+
+    explicit Shift128(uint64_t s)
+        : right{_mm_cvtsi64_si128(static_cast<int64_t>(s))},
+          left{_mm_cvtsi64_si128(static_cast<int64_t>(64 - s))},
+          rightHi{_mm_cvtsi64_si128(static_cast<int64_t>(s - 64))} {}
+};
+
+// full products a * b = hi * 2^64 + lo
+AVX512_TARGET inline void MulWide(__m512i a, __m512i b, __m512i& hi, __m512i& lo) {
+    const __m512i lo32 = _mm512_set1_epi64(0xffffffff);
+    __m512i ah         = _mm512_srli_epi64(a, 32);
+    __m512i bh         = _mm512_srli_epi64(b, 32);
+    __m512i ll         = _mm512_mul_epu32(a, b);
+    __m512i lh         = _mm512_mul_epu32(a, bh);
+    __m512i hl         = _mm512_mul_epu32(ah, b);
+    __m512i hh         = _mm512_mul_epu32(ah, bh);
+    __m512i mid        = _mm512_add_epi64(_mm512_srli_epi64(ll, 32), _mm512_and_si512(lh, lo32));
+    mid                = _mm512_add_epi64(mid, _mm512_and_si512(hl, lo32));
+    hi                 = _mm512_add_epi64(hh, _mm512_srli_epi64(lh, 32));
+    hi                 = _mm512_add_epi64(hi, _mm512_srli_epi64(hl, 32));
+    hi                 = _mm512_add_epi64(hi, _mm512_srli_epi64(mid, 32));
+    lo                 = _mm512_or_si512(_mm512_slli_epi64(mid, 32), _mm512_and_si512(ll, lo32));
+}
+
+AVX512_TARGET inline __m512i ShiftRight128(__m512i hi, __m512i lo, const Shift128& s) {
+    __m512i r = _mm512_or_si512(_mm512_srl_epi64(lo, s.right), _mm512_sll_epi64(hi, s.left));
+    return _mm512_or_si512(r, _mm512_srl_epi64(hi, s.rightHi));
+}
+
+// Barrett multiplication a * b (+ c) mod q of NativeIntegerT::ModMulFastEq, with the shifts by k - 2 and k + 5 of a
+// k-bit q. The accumulated value stays below 2^(2k), for which the quotient is underestimated by at most 2.
+template <bool ACC>
+AVX512_TARGET inline __m512i MulModBarrett512(__m512i a, __m512i b, __m512i c, __m512i q, __m512i mu,
+                                              const Shift128& s1, const Shift128& s2) {
+    __m512i hi, lo;
+    MulWide(a, b, hi, lo);
+    if constexpr (ACC) {
+        __m512i sum = _mm512_add_epi64(lo, c);
+        hi          = _mm512_mask_add_epi64(hi, _mm512_cmplt_epu64_mask(sum, c), hi, _mm512_set1_epi64(1));
+        lo          = sum;
+    }
+    __m512i xh, xl;
+    MulWide(ShiftRight128(hi, lo, s1), mu, xh, xl);
+    __m512i r = ReduceOnce512(_mm512_sub_epi64(lo, _mm512_mullo_epi64(ShiftRight128(xh, xl, s2), q)), q);
+    return ACC ? ReduceOnce512(r, q) : r;
+}
+
+// a * b (+ c) mod q for a k-bit q below 2^50, with the 52-bit multipliers of IFMA: the quotient of p = a * b + c
+// is estimated by floor(floor(p / 2^(k-1)) * mu / 2^(k+1)) with mu = floor(2^(2k) / q), which fits in 52 bits, and
+// is underestimated by at most 2
+AVX512_TARGET inline __m512i MulModBarrett52(__m512i a, __m512i b, __m512i c, __m512i q, __m512i mu, __m128i kLeft,
+                                             __m128i kRight, __m128i estLeft, __m128i estRight) {
+    const __m512i zero   = _mm512_setzero_si512();
+    const __m512i mask52 = _mm512_set1_epi64((uint64_t(1) << 52) - 1);
+    __m512i lo           = _mm512_madd52lo_epu64(c, a, b);
+    __m512i hi           = _mm512_madd52hi_epu64(zero, a, b);
+    __m512i x            = _mm512_add_epi64(_mm512_sll_epi64(hi, kLeft), _mm512_srl_epi64(lo, kRight));
+    __m512i est          = _mm512_add_epi64(_mm512_sll_epi64(_mm512_madd52hi_epu64(zero, x, mu), estLeft),
+                                            _mm512_srl_epi64(_mm512_madd52lo_epu64(zero, x, mu), estRight));
+    __m512i r = _mm512_and_si512(_mm512_sub_epi64(lo, _mm512_madd52lo_epu64(zero, est, q)), mask52);
+    return ReduceOnce512(ReduceOnce512(r, q), q);
+}
+
+template <bool BROADCAST>
+AVX512_TARGET inline __m512i LoadOperand512(const uint64_t* b, size_t i) {
+    return BROADCAST ? _mm512_set1_epi64(static_cast<int64_t>(b[0])) : _mm512_loadu_si512(b + i);
+}
+
+template <bool BROADCAST>
+AVX512_TARGET void AddAVX512(uint64_t* a, const uint64_t* b, size_t n, uint64_t modulus) {
+    const __m512i q = _mm512_set1_epi64(modulus);
+    for (size_t i = 0; i < n; i += 8) {
+        __m512i r = _mm512_add_epi64(_mm512_loadu_si512(a + i), LoadOperand512<BROADCAST>(b, i));
+        _mm512_storeu_si512(a + i, ReduceOnce512(r, q));
+    }
+}
+
+template <bool BROADCAST>
+AVX512_TARGET void SubAVX512(uint64_t* a, const uint64_t* b, size_t n, uint64_t modulus) {
+    const __m512i q = _mm512_set1_epi64(modulus);
+    for (size_t i = 0; i < n; i += 8) {
+        __m512i x = _mm512_loadu_si512(a + i);
+        __m512i y = LoadOperand512<BROADCAST>(b, i);
+        __m512i r = _mm512_sub_epi64(x, y);
+        _mm512_storeu_si512(a + i, _mm512_mask_add_epi64(r, _mm512_cmplt_epu64_mask(x, y), r, q));
+    }
+}
+
+template <bool ACC>
+AVX512_TARGET void MulAVX512(uint64_t* a, const uint64_t* b, const uint64_t* c, size_t n, uint64_t modulus,
+                             uint64_t mu, uint32_t k) {
+    const __m512i q   = _mm512_set1_epi64(modulus);
+    const __m512i vmu  = _mm512_set1_epi64(mu);
+    const __m512i zero = _mm512_setzero_si512();
+    const Shift128 s1(k - 2);
+    const Shift128 s2(k + 5);
+    for (size_t i = 0; i < n; i += 8) {
+        __m512i r;
+        if constexpr (ACC)
+            r = MulModBarrett512<true>(_mm512_loadu_si512(b + i), _mm512_loadu_si512(c + i), _mm512_loadu_si512(a + i),
+                                       q, vmu, s1, s2);
+        else
+            r = MulModBarrett512<false>(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i), zero, q, vmu, s1, s2);
+        _mm512_storeu_si512(a + i, r);
+    }
+}
+
+template <bool ACC>
+AVX512_TARGET void MulIFMA(uint64_t* a, const uint64_t* b, const uint64_t* c, size_t n, uint64_t modulus, uint32_t k) {
+    const uint64_t mu52    = static_cast<uint64_t>((static_cast<unsigned __int128>(1) << (2 * k)) / modulus);
+    const __m512i q        = _mm512_set1_epi64(modulus);
+    const __m512i mu       = _mm512_set1_epi64(mu52);
+    const __m128i kLeft    = _mm_cvtsi64_si128(53 - k);
+    const __m128i kRight   = _mm_cvtsi64_si128(k - 1);
+    const __m128i estLeft  = _mm_cvtsi64_si128(51 - k);
+    const __m128i estRight = _mm_cvtsi64_si128(k + 1);
+    const __m512i zero     = _mm512_setzero_si512();
+    for (size_t i = 0; i < n; i += 8) {
+        __m512i r;
+        if constexpr (ACC)
+            r = MulModBarrett52(_mm512_loadu_si512(b + i), _mm512_loadu_si512(c + i), _mm512_loadu_si512(a + i), q,
+                                mu, kLeft, kRight, estLeft, estRight);
+        else
+            r = MulModBarrett52(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i), zero, q, mu, kLeft, kRight,
+                                estLeft, estRight);
+        _mm512_storeu_si512(a + i, r);
+    }
+}
+
+template <bool IFMA>
+AVX512_TARGET void MulConstAVX512(uint64_t* a, uint64_t b, uint64_t bPrecon, size_t n, uint64_t modulus) {
+    const __m512i q  = _mm512_set1_epi64(modulus);
+    const __m512i w  = _mm512_set1_epi64(b);
+    const __m512i wp = PreconConst512<IFMA>(bPrecon);
+    for (size_t i = 0; i < n; i += 8)
+        _mm512_storeu_si512(a + i, MulModConst512<IFMA>(_mm512_loadu_si512(a + i), w, wp, q));
+}
+
+// lazy accumulation (hi, lo) += b * c, of the 52-bit halves of the products with IFMA
+template <bool BROADCAST>
+AVX512_TARGET void MulAccumulateIFMA(uint64_t* hi, uint64_t* lo, const uint64_t* b, const uint64_t* c, size_t n) {
+    for (size_t i = 0; i < n; i += 8) {
+        __m512i x = _mm512_loadu_si512(b + i);
+        __m512i y = LoadOperand512<BROADCAST>(c, i);
+        _mm512_storeu_si512(lo + i, _mm512_madd52lo_epu64(_mm512_loadu_si512(lo + i), x, y));
+        _mm512_storeu_si512(hi + i, _mm512_madd52hi_epu64(_mm512_loadu_si512(hi + i), x, y));
+    }
+}
+
+// lazy accumulation (hi, lo) += b * c, of the 64-bit halves of the products
+template <bool BROADCAST>
+AVX512_TARGET void MulAccumulateAVX512(uint64_t* hi, uint64_t* lo, const uint64_t* b, const uint64_t* c, size_t n) {
+    const __m512i one = _mm512_set1_epi64(1);
+    for (size_t i = 0; i < n; i += 8) {
+        __m512i ph, pl;
+        MulWide(_mm512_loadu_si512(b + i), LoadOperand512<BROADCAST>(c, i), ph, pl);
+        __m512i l = _mm512_loadu_si512(lo + i);
+        __m512i s = _mm512_add_epi64(l, pl);
+        __m512i h = _mm512_add_epi64(_mm512_loadu_si512(hi + i), ph);
+        _mm512_storeu_si512(lo + i, s);
+        _mm512_storeu_si512(hi + i, _mm512_mask_add_epi64(h, _mm512_cmplt_epu64_mask(s, l), h, one));
+    }
+}
+
+// level of the element-wise kernels, which process blocks of 8 values
+SIMDLevel ElementwiseSIMDLevel(size_t n, uint64_t modulus) {
+    if (n < MIN_SIMD_LENGTH || (n & 7) != 0 || modulus >= MAX_ELEMENTWISE_MODULUS)
+        return SIMDLevel::SCALAR;
+    return GetSIMDLevel();
+}
+
+uint32_t BitLength(uint64_t x) {
+    return 64 - static_cast<uint32_t>(__builtin_clzll(x));
+}
+
+#endif  // OPENFHE_SIMD_X86
+
+}  // namespace
+
+SIMDLevel GetSupportedSIMDLevel() {
+    static const SIMDLevel supported = DetectSIMDLevel();
+    return supported;
+}
+
+SIMDLevel GetSIMDLevel() {
+    return CurrentSIMDLevel().load(std::memory_order_relaxed);
+}
+
+void SetSIMDLevel(SIMDLevel level) {
+    CurrentSIMDLevel().store(std::min(level, GetSupportedSIMDLevel()), std::memory_order_relaxed);
+}
+
+bool SIMDForwardNTT(uint64_t* element, uint32_t n, uint64_t modulus, const uint64_t* rootOfUnityTable,
+                    const uint64_t* preconRootOfUnityTable) {
+#ifdef OPENFHE_SIMD_X86
+    SIMDLevel level = GetSIMDLevel();
+    if (level == SIMDLevel::SCALAR || n < MIN_SIMD_LENGTH || modulus >= MAX_SIMD_MODULUS)
+        return false;
+    if (level == SIMDLevel::AVX512IFMA) {
+        if (modulus < MAX_IFMA_MODULUS)
+            ForwardAVX512<true>(element, n, modulus, rootOfUnityTable, preconRootOfUnityTable);
+        else
+            ForwardAVX512<false>(element, n, modulus, rootOfUnityTable, preconRootOfUnityTable);
+        ForwardAVX2(element, n, modulus, rootOfUnityTable, preconRootOfUnityTable, 4);
+    }
+    else {
+        ForwardAVX2(element, n, modulus, rootOfUnityTable, preconRootOfUnityTable, n >> 1);
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool SIMDInverseNTT(uint64_t* element, uint32_t n, uint64_t modulus, const uint64_t* rootOfUnityInverseTable,
+                    const uint64_t* preconRootOfUnityInverseTable, uint64_t cycloOrderInv, uint64_t preconCycloOrderInv,
+                    uint64_t omega1Inv, uint64_t preconOmega1Inv) {
+#ifdef OPENFHE_SIMD_X86
+    SIMDLevel level = GetSIMDLevel();
+    if (level == SIMDLevel::SCALAR || n < MIN_SIMD_LENGTH || modulus >= MAX_SIMD_MODULUS)
+        return false;
+    if (level == SIMDLevel::AVX512IFMA) {
+        InverseAVX2(element, n, modulus, rootOfUnityInverseTable, preconRootOfUnityInverseTable, 8);
+        if (modulus < MAX_IFMA_MODULUS)
+            InverseAVX512<true>(element, n, modulus, rootOfUnityInverseTable, preconRootOfUnityInverseTable,
+                                cycloOrderInv, preconCycloOrderInv, omega1Inv, preconOmega1Inv);
+        else
+            InverseAVX512<false>(element, n, modulus, rootOfUnityInverseTable, preconRootOfUnityInverseTable,
+                                 cycloOrderInv, preconCycloOrderInv, omega1Inv, preconOmega1Inv);
+    }
+    else {
+        InverseAVX2(element, n, modulus, rootOfUnityInverseTable, preconRootOfUnityInverseTable, n >> 1);
+        InverseLastAVX2(element, n, modulus, cycloOrderInv, preconCycloOrderInv, omega1Inv, preconOmega1Inv);
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool SIMDModAdd(uint64_t* a, const uint64_t* b, size_t n, uint64_t modulus) {
+#ifdef OPENFHE_SIMD_X86
+    switch (ElementwiseSIMDLevel(n, modulus)) {
+        case SIMDLevel::AVX512IFMA:
+            AddAVX512<false>(a, b, n, modulus);
+            return true;
+        case SIMDLevel::AVX2:
+            AddAVX2<false>(a, b, n, modulus);
+            return true;
+        default:
+            return false;
+    }
+#else
+    return false;
+#endif
+}
+
+bool SIMDModAddConst(uint64_t* a, uint64_t b, size_t n, uint64_t modulus) {
+#ifdef OPENFHE_SIMD_X86
+    switch (ElementwiseSIMDLevel(n, modulus)) {
+        case SIMDLevel::AVX512IFMA:
+            AddAVX512<true>(a, &b, n, modulus);
+            return true;
+        case SIMDLevel::AVX2:
+            AddAVX2<true>(a, &b, n, modulus);
+            return true;
+        default:
+            return false;
+    }
+#else
+    return false;
+#endif
+}
+
+bool SIMDModSub(uint64_t* a, const uint64_t* b, size_t n, uint64_t modulus) {
+#ifdef OPENFHE_SIMD_X86
+    switch (ElementwiseSIMDLevel(n, modulus)) {
+        case SIMDLevel::AVX512IFMA:
+            SubAVX512<false>(a, b, n, modulus);
+            return true;
+        case SIMDLevel::AVX2:
+            SubAVX2<false>(a, b, n, modulus);
+            return true;
+        default:
+            return false;
+    }
+#else
+    return false;
+#endif
+}
+
+bool SIMDModSubConst(uint64_t* a, uint64_t b, size_t n, uint64_t modulus) {
+#ifdef OPENFHE_SIMD_X86
+    switch (ElementwiseSIMDLevel(n, modulus)) {
+        case SIMDLevel::AVX512IFMA:
+            SubAVX512<true>(a, &b, n, modulus);
+            return true;
+        case SIMDLevel::AVX2:
+            SubAVX2<true>(a, &b, n, modulus);
+            return true;
+        default:
+            return false;
+    }
+#else
+    return false;
+#endif
+}
+
+bool SIMDModMul(uint64_t* a, const uint64_t* b, size_t n, uint64_t modulus, uint64_t mu) {
+#ifdef OPENFHE_SIMD_X86
+    if (ElementwiseSIMDLevel(n, modulus) != SIMDLevel::AVX512IFMA)
+        return false;
+    if (modulus < MAX_IFMA_MODULUS)
+        MulIFMA<false>(a, b, nullptr, n, modulus, BitLength(modulus));
+    else
+        MulAVX512<false>(a, b, nullptr, n, modulus, mu, BitLength(modulus));
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool SIMDModMulConst(uint64_t* a, uint64_t b, uint64_t bPrecon, size_t n, uint64_t modulus) {
+#ifdef OPENFHE_SIMD_X86
+    if (ElementwiseSIMDLevel(n, modulus) != SIMDLevel::AVX512IFMA)
+        return false;
+    if (modulus < MAX_IFMA_MODULUS)
+        MulConstAVX512<true>(a, b, bPrecon, n, modulus);
+    else
+        MulConstAVX512<false>(a, b, bPrecon, n, modulus);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool SIMDModMulAdd(uint64_t* a, const uint64_t* b, const uint64_t* c, size_t n, uint64_t modulus, uint64_t mu) {
+#ifdef OPENFHE_SIMD_X86
+    if (ElementwiseSIMDLevel(n, modulus) != SIMDLevel::AVX512IFMA)
+        return false;
+    if (modulus < MAX_IFMA_MODULUS)
+        MulIFMA<true>(a, b, c, n, modulus, BitLength(modulus));
+    else
+        MulAVX512<true>(a, b, c, n, modulus, mu, BitLength(modulus));
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint32_t SIMDAccumulatorShift(uint64_t modulus) {
+#ifdef OPENFHE_SIMD_X86
+    if (GetSIMDLevel() == SIMDLevel::AVX512IFMA && modulus < MAX_IFMA_MODULUS)
+        return 52;
+#endif
+    return 64;
+}
+
+bool SIMDMulAccumulate(uint64_t* hi, uint64_t* lo, const uint64_t* b, const uint64_t* c, size_t n, uint32_t shift) {
+#ifdef OPENFHE_SIMD_X86
+    if (ElementwiseSIMDLevel(n, 0) != SIMDLevel::AVX512IFMA)
+        return false;
+    if (shift == 52)
+        MulAccumulateIFMA<false>(hi, lo, b, c, n);
+    else
+        MulAccumulateAVX512<false>(hi, lo, b, c, n);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool SIMDMulAccumulateConst(uint64_t* hi, uint64_t* lo, const uint64_t* b, uint64_t c, size_t n, uint32_t shift) {
+#ifdef OPENFHE_SIMD_X86
+    if (ElementwiseSIMDLevel(n, 0) != SIMDLevel::AVX512IFMA)
+        return false;
+    if (shift == 52)
+        MulAccumulateIFMA<true>(hi, lo, b, &c, n);
+    else
+        MulAccumulateAVX512<true>(hi, lo, b, &c, n);
+    return true;
+#else
+    return false;
+#endif
+}
+
+}  // namespace intnat
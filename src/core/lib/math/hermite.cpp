@@ -30,6 +30,7 @@
 //==================================================================================
 
 #include "math/hermite.h"
+#include "math/dftransform.h"
 #include "utils/exception.h"
 
 #include <cmath>
@@ -38,6 +39,40 @@
 
 namespace lbcrypto {
 
+namespace {
+
+// Returns Y[k] = sum_l y[l] * exp(-2i*pi*k*l/p) for k in [0, p). All the alpha/beta/delta/theta
+// sums of the Hermite coefficients reduce to Y, since exp(-2i*pi*(p+k)*l/p) = exp(-2i*pi*k*l/p)
+// and exp(-2i*pi*(p-k)*l/p) = conj(exp(-2i*pi*k*l/p)) for integer l.
+std::vector<std::complex<double>> lutSpectrum(const std::vector<double>& y) {
+  size_t p = y.size();
+  std::vector<std::complex<double>> a(y.begin(), y.end());
+
+  if ((p & (p - 1)) == 0) {
+    // the radix-2 FFT keeps its twiddle tables cached across calls
+    return DiscreteFourierTransform::FFTForwardTransform(a);
+  }
+
+  // non power-of-two number of points: direct DFT on a table of the p roots of unity
+  std::vector<std::complex<double>> roots(p);
+  for (size_t j = 0; j < p; ++j) {
+    roots[j] = std::polar(1.0, -2 * M_PI * j / p);
+  }
+  std::vector<std::complex<double>> Y(p, std::complex<double>(0.0, 0.0));
+  for (size_t k = 0; k < p; ++k) {
+    size_t idx = 0;
+    for (size_t l = 0; l < p; ++l) {
+      Y[k] += y[l] * roots[idx];
+      idx += k;
+      if (idx >= p)
+        idx -= p;
+    }
+  }
+  return Y;
+}
+
+}  // namespace
+
 std::vector<std::complex<double>> hermiteInterpOrder1Coeff(std::function<double(double)> f, int p) {
   if (!p) {
     OPENFHE_THROW("The number of points of interest cannot be zero!");
@@ -55,13 +90,9 @@ std::vector<std::complex<double>> hermiteInterpOrder1Coeff(std::function<double(
   }
   alpha[0] = std::complex<double>(1.0 / p * sum_y, 0);
 
+  std::vector<std::complex<double>> Y = lutSpectrum(y);
   for (int k = 1; k < p; ++k) {
-    for (int l = 0; l < p; ++l) {
-      std::complex<double> exp_term = std::exp(std::complex<double>(0, -2 * M_PI * k * l / p));
-      alpha[k] += y[l] * exp_term;
-    }
-
-    alpha[k] *= 2.0 * (p - k) / (p * p);
+    alpha[k] = Y[k] * (2.0 * (p - k) / (p * p));
   }
 
   return alpha;
@@ -79,9 +110,9 @@ std::vector<std::complex<double>> hermiteInterpOrder2Coeff(std::function<double(
   }
 
   std::vector<std::complex<double>> alpha(p, std::complex<double>(0.0, 0.0));
-  std::vector<std::complex<double>> beta(p/2, std::complex<double>(0.0, 0.0));
-  std::vector<std::complex<double>> delta(p/2, std::complex<double>(0.0, 0.0));
-  std::vector<std::complex<double>> theta(p/2, std::complex<double>(0.0, 0.0));
+  std::vector<std::complex<double>> beta(p/2 + 1, std::complex<double>(0.0, 0.0));
+  std::vector<std::complex<double>> delta(p/2 + 1, std::complex<double>(0.0, 0.0));
+  std::vector<std::complex<double>> theta(p/2 + 1, std::complex<double>(0.0, 0.0));
 
   double sum_y = 0;
   for (int i = 0; i < p; ++i) {
@@ -89,30 +120,16 @@ std::vector<std::complex<double>> hermiteInterpOrder2Coeff(std::function<double(
   }
   alpha[0] = std::complex<double>(1.0 / p * sum_y, 0);
 
+  std::vector<std::complex<double>> Y = lutSpectrum(y);
   for (int k = 1; k < p; ++k) {
-    for (int l = 0; l < p; ++l) {
-      std::complex<double> exp_term = std::exp(std::complex<double>(0, -2 * M_PI * k * l / p));
-      alpha[k] += y[l] * exp_term;
-
-      if (k > 0 && k <= p / 2) {
-        beta[k - 1] += y[l] * exp_term;
-
-        exp_term = std::exp(std::complex<double>(0, -2 * M_PI * (p + k) * l / p));
-        delta[k - 1] += y[l] * exp_term;
-
-        exp_term = std::exp(std::complex<double>(0, -2 * M_PI * (p - k) * l / p));
-        theta[k - 1] += y[l] * exp_term;
-      }
-    }
-
-    alpha[k] *= 2. * (p - k) / (p * p);
+    alpha[k] = Y[k] * (2. * (p - k) / (p * p));
 
     if (k > 0 && k <= p / 2) {
       int gamma = (p % 2 == 0 && k == p / 2) ? 1. : 0.;
-      double scale = ((2. - gamma) * k * (p - k)) / (p * p * p);
-      beta[k - 1] *= scale;
-      delta[k - 1] *= scale;
-      theta[k - 1] *= scale;
+      double scale = ((2. - gamma) * k * (p - k)) / std::pow(p, 3);
+      beta[k - 1] = Y[k] * scale;
+      delta[k - 1] = Y[k] * scale;
+      theta[k - 1] = std::conj(Y[k]) * scale;
     }
   }
 
@@ -153,26 +170,14 @@ std::vector<std::complex<double>> hermiteInterpOrder3Coeff(std::function<double(
   }
   alpha[0] = std::complex<double>(1.0 / p * sum_y, 0);
 
+  std::vector<std::complex<double>> Y = lutSpectrum(y);
   for (int k = 1; k < p; ++k) {
-    for (int l = 0; l < p; ++l) {
-      std::complex<double> exp_term = std::exp(std::complex<double>(0, -2 * M_PI * k * l / p));
-      alpha[k] += y[l] * exp_term;
-
-      beta[k] += y[l] * exp_term;
-
-      exp_term = std::exp(std::complex<double>(0, -2 * M_PI * (p + k) * l / p));
-      delta[k] += y[l] * exp_term;
-
-      exp_term = std::exp(std::complex<double>(0, -2 * M_PI * (p - k) * l / p));
-      theta[k] += y[l] * exp_term;
-    }
-
-    alpha[k] *= 2. * (p - k) / (p * p);
+    alpha[k] = Y[k] * (2. * (p - k) / (p * p));
 
     double scale = (2. * k * (p - k) * (2. * p - k)) / (3. * std::pow(p, 4));
-    beta[k] *= scale;
-    delta[k] *= scale;
-    theta[k] *= scale;
+    beta[k] = Y[k] * scale;
+    delta[k] = Y[k] * scale;
+    theta[k] = std::conj(Y[k]) * scale;
   }
 
   std::vector<std::complex<double>> coeffs(2*p, std::complex<double>(0.0, 0.0));
@@ -186,4 +191,17 @@ std::vector<std::complex<double>> hermiteInterpOrder3Coeff(std::function<double(
   return coeffs;
 }
 
+std::vector<std::complex<double>> hermiteInterpCoeff(std::function<double(double)> f, int p, int order) {
+  switch (order) {
+    case 1:
+      return hermiteInterpOrder1Coeff(f, p);
+    case 2:
+      return hermiteInterpOrder2Coeff(f, p);
+    case 3:
+      return hermiteInterpOrder3Coeff(f, p);
+    default:
+      OPENFHE_THROW("Order of Hermite interpolation must be between 1 and 3");
+  }
+}
+
 }
@@ -0,0 +1,166 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2025, CEA-List
+//
+// All rights reserved.
+//
+// Author TPOC: jules.dumezy@cea.fr
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#include "utils/opcounters.h"
+
+#ifdef PARALLEL
+    #include <omp.h>
+#endif
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace lbcrypto {
+
+std::atomic<int32_t> OpCounters::s_enabled{0};
+std::atomic<uint64_t> OpCounters::s_counters[NUM_OP_COUNTERS];
+
+namespace {
+
+// A sink with the OpenMP thread numbers of the thread that attached it at each enclosing nesting level,
+// which the threads of the parallel regions it opens share.
+struct AttachedSink {
+    OpCounterSink* sink;
+    OpCounterSink* previous;  // sink of the thread before the attachment
+    std::vector<int> ancestors;
+};
+
+std::mutex s_attachedMutex;
+std::vector<AttachedSink> s_attached;
+// bumped by every Attach() and Detach(), so that the threads know when to resolve their sink again
+std::atomic<uint64_t> s_generation{1};
+
+thread_local OpCounterSink* t_sink = nullptr;
+
+#ifdef PARALLEL
+// The sink of an OpenMP thread without one of its own, resolved for a generation of the attached sinks. The result
+// only depends on the nesting level and on the ancestor thread numbers up to the deepest attached level, which are
+// checked as a pooled thread can join the teams of other computations without any attachment in between.
+struct ResolvedSink {
+    uint64_t generation = 0;
+    int level           = 0;
+    std::vector<int> ancestors;
+    OpCounterSink* sink = nullptr;
+};
+
+thread_local ResolvedSink t_resolved;
+
+// The sink attached by the closest ancestor of the calling OpenMP thread, null if there is none or if several
+// sinks attached at the same level match (computations started on different threads outside of a parallel region).
+void ResolveAncestorSink(int level) {
+    std::lock_guard<std::mutex> lock(s_attachedMutex);
+    OpCounterSink* sink = nullptr;
+    int sinkLevel       = -1;
+    int maxLevel        = 0;
+    bool ambiguous      = false;
+    for (const auto& attached : s_attached) {
+        int attachedLevel = static_cast<int>(attached.ancestors.size());
+        if (attachedLevel >= level)
+            continue;
+        maxLevel = std::max(maxLevel, attachedLevel);
+        if (attachedLevel < sinkLevel)
+            continue;
+        bool match = true;
+        for (int l = 1; l <= attachedLevel && match; ++l)
+            match = (attached.ancestors[l - 1] == omp_get_ancestor_thread_num(l));
+        if (!match)
+            continue;
+        ambiguous = (attachedLevel == sinkLevel);
+        sink      = attached.sink;
+        sinkLevel = attachedLevel;
+    }
+
+    t_resolved.generation = s_generation.load(std::memory_order_relaxed);
+    t_resolved.level      = level;
+    t_resolved.ancestors.resize(maxLevel);
+    for (int l = 1; l <= maxLevel; ++l)
+        t_resolved.ancestors[l - 1] = omp_get_ancestor_thread_num(l);
+    t_resolved.sink = ambiguous ? nullptr : sink;
+}
+
+OpCounterSink* FindAncestorSink(int level) {
+    bool valid = (t_resolved.generation == s_generation.load(std::memory_order_relaxed)) && (t_resolved.level == level);
+    for (size_t l = 1; l <= t_resolved.ancestors.size() && valid; ++l)
+        valid = (t_resolved.ancestors[l - 1] == omp_get_ancestor_thread_num(static_cast<int>(l)));
+    if (!valid)
+        ResolveAncestorSink(level);
+    return t_resolved.sink;
+}
+#endif
+
+}  // namespace
+
+void OpCounters::AddEnabled(OpCounterType type, uint64_t count) {
+    s_counters[type].fetch_add(count, std::memory_order_relaxed);
+    OpCounterSink* sink = t_sink;
+#ifdef PARALLEL
+    if (sink == nullptr) {
+        int level = omp_get_level();
+        if (level > 0)
+            sink = FindAncestorSink(level);
+    }
+#endif
+    if (sink != nullptr)
+        sink->counters[type].fetch_add(count, std::memory_order_relaxed);
+}
+
+void OpCounters::Attach(OpCounterSink* sink) {
+    AttachedSink attached{sink, t_sink, {}};
+#ifdef PARALLEL
+    for (int l = 1; l <= omp_get_level(); ++l)
+        attached.ancestors.push_back(omp_get_ancestor_thread_num(l));
+#endif
+    {
+        std::lock_guard<std::mutex> lock(s_attachedMutex);
+        s_attached.push_back(std::move(attached));
+        s_generation.fetch_add(1, std::memory_order_relaxed);
+    }
+    t_sink = sink;
+    Enable();
+}
+
+void OpCounters::Detach(OpCounterSink* sink) {
+    {
+        std::lock_guard<std::mutex> lock(s_attachedMutex);
+        for (auto it = s_attached.begin(); it != s_attached.end(); ++it) {
+            if (it->sink == sink) {
+                t_sink = it->previous;
+                s_attached.erase(it);
+                s_generation.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+        }
+    }
+    Disable();
+}
+
+}  // namespace lbcrypto
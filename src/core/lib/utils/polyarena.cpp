@@ -0,0 +1,195 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2025, CEA-List
+//
+// All rights reserved.
+//
+// Author TPOC: jules.dumezy@cea.fr
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#include "utils/polyarena.h"
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+namespace lbcrypto {
+
+namespace {
+
+// prefix of every buffer, recording the arena it goes back to (nullptr for the heap)
+struct BlockHeader {
+    PolyArena::State* state;
+    size_t bytes;
+};
+
+constexpr size_t HEADER_SIZE =
+    (sizeof(BlockHeader) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+BlockHeader* NewBlock(PolyArena::State* state, size_t bytes) {
+    auto* block  = static_cast<BlockHeader*>(::operator new(HEADER_SIZE + bytes));
+    block->state = state;
+    block->bytes = bytes;
+    return block;
+}
+
+}  // namespace
+
+struct PolyArena::State {
+    std::mutex mutex;
+    // cached buffers by size
+    std::unordered_map<size_t, std::vector<BlockHeader*>> blocks;
+    size_t maxCachedBytes;
+    size_t cachedBytes  = 0;
+    size_t outstanding  = 0;
+    size_t numReused    = 0;
+    size_t numAllocated = 0;
+    // false once the arena is destroyed, the state living until its last buffer is released
+    bool alive = true;
+
+    explicit State(size_t maxCached) : maxCachedBytes(maxCached) {}
+
+    void ReleaseCached() {
+        for (auto& [bytes, list] : blocks) {
+            for (auto* block : list)
+                ::operator delete(block);
+        }
+        blocks.clear();
+        cachedBytes = 0;
+    }
+};
+
+// arena active on the calling thread
+static thread_local PolyArena::State* t_arena = nullptr;
+
+PolyArena::PolyArena(size_t maxCachedBytes) : m_state(new State(maxCachedBytes)) {}
+
+PolyArena::~PolyArena() {
+    bool last;
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        m_state->ReleaseCached();
+        m_state->alive = false;
+        last           = (m_state->outstanding == 0);
+    }
+    if (last)
+        delete m_state;
+}
+
+void PolyArena::Release() {
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    m_state->ReleaseCached();
+}
+
+size_t PolyArena::GetCachedBytes() const {
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    return m_state->cachedBytes;
+}
+
+size_t PolyArena::GetNumReused() const {
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    return m_state->numReused;
+}
+
+size_t PolyArena::GetNumAllocated() const {
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    return m_state->numAllocated;
+}
+
+void* PolyArena::Allocate(size_t bytes) {
+    State* state = t_arena;
+    BlockHeader* block;
+    if (state == nullptr) {
+        block = NewBlock(nullptr, bytes);
+    }
+    else {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        auto it = state->blocks.find(bytes);
+        if (it != state->blocks.end() && !it->second.empty()) {
+            block = it->second.back();
+            it->second.pop_back();
+            state->cachedBytes -= bytes;
+            ++state->numReused;
+        }
+        else {
+            block = NewBlock(state, bytes);
+            ++state->numAllocated;
+        }
+        ++state->outstanding;
+    }
+    return reinterpret_cast<char*>(block) + HEADER_SIZE;
+}
+
+void PolyArena::Deallocate(void* ptr) noexcept {
+    if (ptr == nullptr)
+        return;
+    auto* block  = reinterpret_cast<BlockHeader*>(static_cast<char*>(ptr) - HEADER_SIZE);
+    State* state = block->state;
+    if (state == nullptr) {
+        ::operator delete(block);
+        return;
+    }
+
+    bool cached = false;
+    bool last   = false;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        --state->outstanding;
+        if (state->alive &&
+            (state->maxCachedBytes == 0 || state->cachedBytes + block->bytes <= state->maxCachedBytes)) {
+            try {
+                state->blocks[block->bytes].push_back(block);
+                state->cachedBytes += block->bytes;
+                cached = true;
+            }
+            catch (...) {
+            }
+        }
+        last = !state->alive && state->outstanding == 0;
+    }
+    if (!cached)
+        ::operator delete(block);
+    if (last)
+        delete state;
+}
+
+PolyArenaScope::PolyArenaScope() : m_prev(t_arena) {
+    if (t_arena == nullptr) {
+        m_owned = std::make_unique<PolyArena>();
+        t_arena = m_owned->m_state;
+    }
+}
+
+PolyArenaScope::PolyArenaScope(PolyArena& arena) : m_prev(t_arena) {
+    t_arena = arena.m_state;
+}
+
+PolyArenaScope::~PolyArenaScope() {
+    t_arena = m_prev;
+}
+
+}  // namespace lbcrypto
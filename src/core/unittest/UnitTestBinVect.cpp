@@ -38,6 +38,8 @@
 
 #include "lattice/lat-hal.h"
 #include "lattice/ilelement.h"
+#include "math/hal/intnat/simdnat.h"
+#include "math/nbtheory.h"
 #include "testdefs.h"
 #include "utils/debug.h"
 #include "utils/inttypes.h"
@@ -550,3 +552,97 @@ void modmul_vector(const std::string& msg) {
 TEST(UTBinVect, modmul_vector) {
     RUN_BIG_BACKENDS(modmul_vector, "modmul_vector")
 }
+
+// cross-check of the vectorised element-wise kernels of every supported level against the scalar loops
+TEST(UTBinVect, simd_cross_check) {
+    const auto supported = intnat::GetSupportedSIMDLevel();
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    for (usint bits : {30, 49, 55, 60}) {
+        NativeInteger q = LastPrime<NativeInteger>(bits, 2048);
+        for (usint len : {16, 20, 1024}) {
+            NativeVector a = dug.GenerateVector(len, q);
+            NativeVector b = dug.GenerateVector(len, q);
+            NativeVector c = dug.GenerateVector(len, q);
+            NativeInteger k{dug.GenerateVector(1, q)[0]};
+
+            auto run = [&](intnat::SIMDLevel level) {
+                intnat::SetSIMDLevel(level);
+                return std::vector<NativeVector>{NativeVector(a).ModAddEq(b),     NativeVector(a).ModAddEq(k),
+                                                 NativeVector(a).ModSubEq(b),     NativeVector(a).ModSubEq(k),
+                                                 NativeVector(a).ModMulEq(b),     NativeVector(a).ModMulEq(k),
+                                                 NativeVector(a).ModMulAddEq(b, c), a.ModAdd(b),
+                                                 a.ModSub(k),                     a.ModMul(k)};
+            };
+            auto scalar = run(intnat::SIMDLevel::SCALAR);
+            EXPECT_EQ(scalar[6], NativeVector(a).ModAddEq(NativeVector(b).ModMulEq(c)))
+                << "fused multiply-add, " << bits << " bits, length " << len;
+            for (auto level : {intnat::SIMDLevel::AVX2, intnat::SIMDLevel::AVX512IFMA}) {
+                if (level > supported)
+                    break;
+                auto simd = run(level);
+                for (size_t i = 0; i < scalar.size(); ++i)
+                    EXPECT_EQ(scalar[i], simd[i]) << "operation " << i << ", level " << static_cast<int>(level)
+                                                  << ", " << bits << " bits, length " << len;
+            }
+            intnat::SetSIMDLevel(supported);
+        }
+    }
+}
+
+TEST(UTBinVect, lazy_accumulator) {
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    for (auto level : {intnat::SIMDLevel::SCALAR, intnat::GetSupportedSIMDLevel()}) {
+        intnat::SetSIMDLevel(level);
+        for (usint bits : {30, 49, 55, 60}) {
+            NativeInteger q = LastPrime<NativeInteger>(bits, 2048);
+            for (usint len : {16, 20}) {
+                // more products than fit in the double words of a 60-bit modulus, to exercise the folding
+                NativeVectorAccumulator acc(len, q);
+                NativeVector expected(len, q);
+                for (usint j = 0; j < 300; ++j) {
+                    NativeVector b = dug.GenerateVector(len, q);
+                    if (j % 2 == 0) {
+                        NativeVector c = dug.GenerateVector(len, q);
+                        acc.AddProduct(b, c);
+                        expected.ModMulAddEq(b, c);
+                    }
+                    else {
+                        NativeInteger k{dug.GenerateVector(1, q)[0]};
+                        acc.AddProduct(b, k);
+                        expected.ModAddEq(b.ModMul(k));
+                    }
+                }
+                EXPECT_EQ(expected, acc.GetValues())
+                    << "level " << static_cast<int>(level) << ", " << bits << " bits, length " << len;
+            }
+        }
+    }
+
+    // with the 52-bit multipliers of IFMA, more than the 2^12 products folded at once, of the largest values
+    if (intnat::GetSupportedSIMDLevel() >= intnat::SIMDLevel::AVX512IFMA) {
+        intnat::SetSIMDLevel(intnat::SIMDLevel::AVX512IFMA);
+        for (usint bits : {30, 49}) {
+            NativeInteger q = LastPrime<NativeInteger>(bits, 2048);
+            for (usint len : {16, 20}) {
+                NativeVectorAccumulator acc(len, q);
+                NativeVector expected(len, q);
+                NativeVector largest(len, q);
+                for (usint i = 0; i < len; ++i)
+                    largest[i] = q - 1;
+                for (usint j = 0; j < 2 * 4096 + 100; ++j) {
+                    NativeVector b = (j % 3 == 0) ? dug.GenerateVector(len, q) : largest;
+                    if (j % 2 == 0) {
+                        acc.AddProduct(b, largest);
+                        expected.ModMulAddEq(b, largest);
+                    }
+                    else {
+                        acc.AddProduct(b, q - 1);
+                        expected.ModAddEq(b.ModMul(q - 1));
+                    }
+                }
+                EXPECT_EQ(expected, acc.GetValues()) << "IFMA folding, " << bits << " bits, length " << len;
+            }
+        }
+    }
+    intnat::SetSIMDLevel(intnat::GetSupportedSIMDLevel());
+}
@@ -592,6 +592,87 @@ TEST(UTDCRTPoly, DCRT_mod_ops_on_two_elements) {
     RUN_BIG_DCRTPOLYS(DCRT_mod_ops_on_two_elements, "DCRT DCRT_mod_ops_on_two_elements");
 }
 
+template <typename Element>
+void DCRT_fused_basis_switch(const std::string& msg) {
+    using Integer = typename Element::Integer;
+    using Params  = typename Element::Params;
+
+    uint32_t order = 2048;
+    uint32_t sizeQ = 3;
+    uint32_t sizeP = 2;
+
+    std::vector<NativeInteger> moduli(sizeQ + sizeP);
+    std::vector<NativeInteger> roots(sizeQ + sizeP);
+    moduli[0] = LastPrime<NativeInteger>(50, order);
+    roots[0]  = RootOfUnity<NativeInteger>(order, moduli[0]);
+    for (uint32_t i = 1; i < sizeQ + sizeP; ++i) {
+        moduli[i] = PreviousPrime<NativeInteger>(moduli[i - 1], order);
+        roots[i]  = RootOfUnity<NativeInteger>(order, moduli[i]);
+    }
+    auto paramsQ = std::make_shared<Params>(order, std::vector<NativeInteger>(moduli.begin(), moduli.begin() + sizeQ),
+                                            std::vector<NativeInteger>(roots.begin(), roots.begin() + sizeQ));
+    auto paramsP = std::make_shared<Params>(order, std::vector<NativeInteger>(moduli.begin() + sizeQ, moduli.end()),
+                                            std::vector<NativeInteger>(roots.begin() + sizeQ, roots.end()));
+
+    // the constants only need to be the same for both paths, they do not have to be the CRT ones
+    std::vector<NativeInteger> QHatInvModq(sizeQ);
+    std::vector<NativeInteger> QHatInvModqPrecon(sizeQ);
+    std::vector<std::vector<NativeInteger>> QHatModp(sizeQ, std::vector<NativeInteger>(sizeP));
+    for (uint32_t i = 0; i < sizeQ; ++i) {
+        QHatInvModq[i]       = NativeInteger(12345 + i);
+        QHatInvModqPrecon[i] = QHatInvModq[i].PrepModMulConst(moduli[i]);
+        for (uint32_t j = 0; j < sizeP; ++j)
+            QHatModp[i][j] = moduli[i].Mod(moduli[sizeQ + j]) - NativeInteger(j + 1);
+    }
+    const auto barrettBase(Integer(1).LShiftEq(128));
+    std::vector<DoubleNativeInt> modpBarrettMu(sizeP);
+    for (uint32_t j = 0; j < sizeP; ++j)
+        modpBarrettMu[j] = (barrettBase / Integer(moduli[sizeQ + j])).template ConvertToInt<DoubleNativeInt>();
+
+    typename Element::DugType dug;
+    Element x(dug, paramsQ, Format::EVALUATION);
+
+    auto xCoef = x.Clone();
+    xCoef.SetFormat(Format::COEFFICIENT);
+    auto expected = xCoef.ApproxSwitchCRTBasis(paramsQ, paramsP, QHatInvModq, QHatInvModqPrecon, QHatModp,
+                                               modpBarrettMu);
+    expected.SetFormat(Format::EVALUATION);
+
+    EXPECT_EQ(expected, x.ApproxSwitchCRTBasisEval(paramsQ, paramsP, QHatInvModq, QHatInvModqPrecon, QHatModp,
+                                                   modpBarrettMu))
+        << msg << " Failure: ApproxSwitchCRTBasisEval from EVALUATION";
+
+    // the smallest grain size splits the towers over ranges of coefficients when there are more threads than towers
+    auto grain = OpenFHEParallelControls.GetGrainSize(BASIS_SWITCH_OP);
+    OpenFHEParallelControls.SetGrainSize(BASIS_SWITCH_OP, 1);
+    auto split = x.ApproxSwitchCRTBasisEval(paramsQ, paramsP, QHatInvModq, QHatInvModqPrecon, QHatModp, modpBarrettMu);
+    OpenFHEParallelControls.SetGrainSize(BASIS_SWITCH_OP, grain);
+    EXPECT_EQ(expected, split) << msg << " Failure: ApproxSwitchCRTBasisEval split over coefficients";
+    EXPECT_EQ(expected, xCoef.ApproxSwitchCRTBasisEval(paramsQ, paramsP, QHatInvModq, QHatInvModqPrecon, QHatModp,
+                                                       modpBarrettMu))
+        << msg << " Failure: ApproxSwitchCRTBasisEval from COEFFICIENT";
+
+    // the sum is permuted in one pass, with the missing towers of the added element taken as zero
+    uint32_t n = paramsQ->GetRingDimension();
+    std::vector<uint32_t> vec(n);
+    PrecomputeAutoMap(n, 5, &vec);
+    Element y(dug, paramsQ, Format::EVALUATION);
+    EXPECT_EQ((x + y).AutomorphismTransform(5, vec), x.AutomorphismTransformOfSum(y, 5, vec))
+        << msg << " Failure: AutomorphismTransformOfSum";
+
+    Element y0(y);
+    y0.DropLastElements(1);
+    auto partial = x.AutomorphismTransformOfSum(y0, 5, vec);
+    auto sum     = x + y;
+    sum.SetElementAtIndex(sizeQ - 1, x.GetElementAtIndex(sizeQ - 1));
+    EXPECT_EQ(sum.AutomorphismTransform(5, vec), partial)
+        << msg << " Failure: AutomorphismTransformOfSum of fewer towers";
+}
+
+TEST(UTDCRTPoly, DCRT_fused_basis_switch) {
+    RUN_BIG_DCRTPOLYS(DCRT_fused_basis_switch, "DCRT_fused_basis_switch");
+}
+
 // only need to try this with one
 void testDCRTPolyConstructorNegative(std::vector<NativePoly>& towers) {
     DCRTPoly expectException(towers);
@@ -0,0 +1,138 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  This code tests the Hermite interpolation coefficients against their direct computation
+ */
+
+#include "gtest/gtest.h"
+
+#include "math/hermite.h"
+#include "utils/exception.h"
+
+#include <cmath>
+#include <complex>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace lbcrypto;
+
+namespace {
+
+// sum_l f(l) * exp(-2i*pi*k*l/p), computed term by term
+std::complex<double> directSum(const std::function<double(double)>& f, int p, int k) {
+    std::complex<double> sum(0.0, 0.0);
+    for (int l = 0; l < p; ++l)
+        sum += f(l) * std::exp(std::complex<double>(0, -2 * M_PI * k * l / p));
+    return sum;
+}
+
+std::vector<std::complex<double>> directAlpha(const std::function<double(double)>& f, int p) {
+    std::vector<std::complex<double>> alpha(p);
+    alpha[0] = directSum(f, p, 0) / static_cast<double>(p);
+    for (int k = 1; k < p; ++k)
+        alpha[k] = directSum(f, p, k) * (2.0 * (p - k) / (p * p));
+    return alpha;
+}
+
+std::vector<std::complex<double>> directOrder2Coeff(const std::function<double(double)>& f, int p) {
+    std::vector<std::complex<double>> alpha = directAlpha(f, p);
+    std::vector<std::complex<double>> beta(p / 2 + 1), delta(p / 2 + 1), theta(p / 2 + 1);
+    for (int k = 1; k <= p / 2; ++k) {
+        int gamma    = (p % 2 == 0 && k == p / 2) ? 1 : 0;
+        double scale = ((2. - gamma) * k * (p - k)) / (p * p * p);
+        beta[k - 1]  = directSum(f, p, k) * scale;
+        delta[k - 1] = directSum(f, p, p + k) * scale;
+        theta[k - 1] = directSum(f, p, p - k) * scale;
+    }
+
+    std::vector<std::complex<double>> coeffs(3 * p / 2);
+    coeffs[0] = alpha[0];
+    for (int i = 1; i < 3 * p / 2; ++i) {
+        if (i < p / 2)
+            coeffs[i] = alpha[i] + beta[i];
+        else if (i == p / 2)
+            coeffs[i] = alpha[i] + beta[i] - (1 - p % 2) * 0.5 * theta[p - i - (p % 2)];
+        else if (i < p)
+            coeffs[i] = alpha[i] - 0.5 * theta[p - i];
+        else if (i > p)
+            coeffs[i] = -0.5 * delta[i - p];
+    }
+    return coeffs;
+}
+
+std::vector<std::complex<double>> directOrder3Coeff(const std::function<double(double)>& f, int p) {
+    std::vector<std::complex<double>> alpha = directAlpha(f, p);
+    std::vector<std::complex<double>> beta(p), delta(p), theta(p);
+    for (int k = 1; k < p; ++k) {
+        double scale = (2. * k * (p - k) * (2. * p - k)) / (3. * std::pow(p, 4));
+        beta[k]      = directSum(f, p, k) * scale;
+        delta[k]     = directSum(f, p, p + k) * scale;
+        theta[k]     = directSum(f, p, p - k) * scale;
+    }
+
+    std::vector<std::complex<double>> coeffs(2 * p);
+    coeffs[0] = alpha[0];
+    for (int i = 1; i < 2 * p; ++i) {
+        if (i < p)
+            coeffs[i] = alpha[i] + beta[i] - 0.5 * theta[p - i];
+        if (i > p)
+            coeffs[i] = -0.5 * delta[i - p];
+    }
+    return coeffs;
+}
+
+void checkCoeffs(const std::vector<std::complex<double>>& expected, const std::vector<std::complex<double>>& actual,
+                 const std::string& msg) {
+    ASSERT_EQ(expected.size(), actual.size()) << msg;
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_NEAR(expected[i].real(), actual[i].real(), 1e-9) << msg << " coefficient " << i;
+        EXPECT_NEAR(expected[i].imag(), actual[i].imag(), 1e-9) << msg << " coefficient " << i;
+    }
+}
+
+}  // namespace
+
+// the power-of-two numbers of points go through the FFT, the others through the table DFT
+TEST(UTHermite, coefficients_match_direct_formula) {
+    const std::function<double(double)> f = [](double x) {
+        return std::fmod(3 * x * x + 1, 7) - 0.5 * x;
+    };
+    for (int p : {2, 4, 8, 16, 3, 5, 6, 12}) {
+        const std::string msg = "p = " + std::to_string(p);
+        checkCoeffs(directAlpha(f, p), hermiteInterpOrder1Coeff(f, p), msg + " order 1");
+        checkCoeffs(directOrder2Coeff(f, p), hermiteInterpOrder2Coeff(f, p), msg + " order 2");
+        checkCoeffs(directOrder3Coeff(f, p), hermiteInterpOrder3Coeff(f, p), msg + " order 3");
+        checkCoeffs(directOrder3Coeff(f, p), hermiteInterpCoeff(f, p, 3), msg + " order 3 dispatch");
+    }
+    EXPECT_THROW(hermiteInterpOrder1Coeff(f, 0), OpenFHEException);
+}
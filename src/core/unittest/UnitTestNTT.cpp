@@ -42,6 +42,7 @@
 #include "gtest/gtest.h"
 
 #include "lattice/lat-hal.h"
+#include "math/hal/intnat/simdnat.h"
 #include "math/distrgen.h"
 #include "math/nbtheory.h"
 #include "testdefs.h"
@@ -111,3 +112,39 @@ void switch_format_simple_double_crt(const std::string& msg) {
 TEST(UTNTT, switch_format_simple_double_crt) {
     RUN_BIG_DCRTPOLYS(switch_format_simple_double_crt, "switch_format_simple_double_crt")
 }
+
+// the vectorised transforms of every supported level must give the same results as the scalar ones
+TEST(UTNTT, simd_cross_check) {
+    const auto supported = intnat::GetSupportedSIMDLevel();
+    for (usint bits : {30, 49, 55, 60}) {
+        for (usint m : {32, 64, 2048, 16384}) {
+            NativeInteger modulus = LastPrime<NativeInteger>(bits, m);
+            NativeInteger root    = RootOfUnity<NativeInteger>(m, modulus);
+            auto params           = std::make_shared<ILNativeParams>(m, modulus, root);
+
+            NativePoly::DugType dug;
+            NativePoly x(dug, params, Format::COEFFICIENT);
+
+            intnat::SetSIMDLevel(intnat::SIMDLevel::SCALAR);
+            NativePoly xScalar(x);
+            xScalar.SwitchFormat();
+            NativePoly xScalarInv(xScalar);
+            xScalarInv.SwitchFormat();
+
+            for (auto level : {intnat::SIMDLevel::AVX2, intnat::SIMDLevel::AVX512IFMA}) {
+                if (level > supported)
+                    break;
+                intnat::SetSIMDLevel(level);
+                NativePoly xSIMD(x);
+                xSIMD.SwitchFormat();
+                std::string msg = ", level " + std::to_string(static_cast<int>(level)) + ", " + std::to_string(bits) +
+                                  " bits, m = " + std::to_string(m);
+                EXPECT_EQ(xScalar, xSIMD) << "forward" << msg;
+                xSIMD.SwitchFormat();
+                EXPECT_EQ(xScalarInv, xSIMD) << "inverse" << msg;
+                EXPECT_EQ(x, xSIMD) << "round trip" << msg;
+            }
+            intnat::SetSIMDLevel(supported);
+        }
+    }
+}
@@ -0,0 +1,158 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  This file tests the arena recycling the storage of the native vectors
+ */
+
+#include "gtest/gtest.h"
+
+#include "math/math-hal.h"
+#include "utils/polyarena.h"
+
+#include <cstring>
+#include <thread>
+
+using namespace lbcrypto;
+
+TEST(UTPolyArena, reuse_in_scope) {
+    PolyArena arena;
+    {
+        PolyArenaScope scope(arena);
+        void* ptr = PolyArena::Allocate(4096);
+        PolyArena::Deallocate(ptr);
+        EXPECT_EQ(arena.GetCachedBytes(), 4096u);
+
+        // a buffer of the same size is handed out again, one of another size comes from the heap
+        EXPECT_EQ(PolyArena::Allocate(4096), ptr);
+        void* other = PolyArena::Allocate(2048);
+        EXPECT_EQ(arena.GetNumReused(), 1u);
+        EXPECT_EQ(arena.GetNumAllocated(), 2u);
+        EXPECT_EQ(arena.GetCachedBytes(), 0u);
+        PolyArena::Deallocate(ptr);
+        PolyArena::Deallocate(other);
+        EXPECT_EQ(arena.GetCachedBytes(), 6144u);
+
+        // the towers of the temporaries of a loop share the same buffers
+        NativeInteger q("1152921504606844417");
+        size_t allocated = 0;
+        for (uint32_t i = 0; i < 4; ++i) {
+            NativeVector a(1000, q, 3);
+            NativeVector b(a);
+            EXPECT_EQ(a, b);
+            if (i == 0)
+                allocated = arena.GetNumAllocated();
+        }
+        EXPECT_EQ(arena.GetNumAllocated(), allocated);
+    }
+
+    // nested scopes without argument keep the active arena
+    size_t reused = arena.GetNumReused();
+    {
+        PolyArenaScope scope(arena);
+        PolyArenaScope nested;
+        PolyArena::Deallocate(PolyArena::Allocate(4096));
+        EXPECT_EQ(arena.GetNumReused(), reused + 1);
+    }
+
+    // without an active arena the buffers come from the heap
+    PolyArena::Deallocate(PolyArena::Allocate(4096));
+    EXPECT_EQ(arena.GetNumReused(), reused + 1);
+
+    arena.Release();
+    EXPECT_EQ(arena.GetCachedBytes(), 0u);
+}
+
+TEST(UTPolyArena, buffers_outlive_arena) {
+    NativeInteger q("1152921504606844417");
+    NativeVector kept;
+    void* ptr;
+    {
+        PolyArenaScope scope;
+        ptr = PolyArena::Allocate(1024);
+        std::memset(ptr, 0x5a, 1024);
+        NativeVector temp(1024, q, 7);
+        kept = NativeVector(1024, q, 11);
+    }
+    // the arena is gone: its outstanding buffers stay valid and go back to the heap when released
+    EXPECT_EQ(static_cast<unsigned char*>(ptr)[1023], 0x5a);
+    PolyArena::Deallocate(ptr);
+    for (uint32_t i = 0; i < kept.GetLength(); ++i)
+        EXPECT_EQ(kept[i], NativeInteger(11));
+    kept = NativeVector(2, q);
+}
+
+TEST(UTPolyArena, release_from_other_thread) {
+    PolyArena arena;
+    PolyArenaScope scope(arena);
+    void* ptr = PolyArena::Allocate(4096);
+
+    // a buffer released by another thread goes back to the arena it was allocated from
+    std::thread worker([ptr] { PolyArena::Deallocate(ptr); });
+    worker.join();
+    EXPECT_EQ(arena.GetCachedBytes(), 4096u);
+    EXPECT_EQ(PolyArena::Allocate(4096), ptr);
+    EXPECT_EQ(arena.GetNumReused(), 1u);
+
+    // and the allocations of a thread without an active arena do not use it
+    void* heap = nullptr;
+    std::thread other([&heap] { heap = PolyArena::Allocate(4096); });
+    other.join();
+    EXPECT_EQ(arena.GetNumAllocated(), 1u);
+    PolyArena::Deallocate(heap);
+    EXPECT_EQ(arena.GetCachedBytes(), 0u);
+    PolyArena::Deallocate(ptr);
+}
+
+TEST(UTPolyArena, max_cached_bytes) {
+    PolyArena arena(2048);
+    PolyArenaScope scope(arena);
+    void* ptrs[3];
+    for (auto& ptr : ptrs)
+        ptr = PolyArena::Allocate(1024);
+    for (auto& ptr : ptrs)
+        PolyArena::Deallocate(ptr);
+    // the buffer released above the bound is freed
+    EXPECT_EQ(arena.GetCachedBytes(), 2048u);
+
+    for (auto& ptr : ptrs)
+        ptr = PolyArena::Allocate(1024);
+    EXPECT_EQ(arena.GetNumReused(), 2u);
+    EXPECT_EQ(arena.GetNumAllocated(), 4u);
+    // a buffer larger than the bound is never cached
+    void* large = PolyArena::Allocate(4096);
+    PolyArena::Deallocate(large);
+    EXPECT_EQ(arena.GetCachedBytes(), 0u);
+    for (auto& ptr : ptrs)
+        PolyArena::Deallocate(ptr);
+    EXPECT_EQ(arena.GetCachedBytes(), 2048u);
+}
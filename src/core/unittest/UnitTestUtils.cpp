@@ -38,6 +38,7 @@
 #include "include/gtest/gtest.h"
 
 #include "utils/utilities.h"
+#include "utils/parallel.h"
 
 using namespace lbcrypto;
 
@@ -53,3 +54,23 @@ TEST(Utilities, IsPowerOfTwo) {
         EXPECT_FALSE(IsPowerOfTwo(not_power_of_two));
     }
 }
+
+TEST(Utilities, ParallelControlsThreadLimit) {
+    // enough work for every thread at any grain size
+    const uint64_t n    = 1 << 20;
+    const uint64_t cost = 1 << 20;
+
+    OpenFHEParallelControls.Disable();
+    EXPECT_EQ(OpenFHEParallelControls.GetThreadLimit(BASIS_SWITCH_OP, n, cost), 1);
+
+    OpenFHEParallelControls.SetNumThreads(2);
+    EXPECT_LE(OpenFHEParallelControls.GetThreadLimit(BASIS_SWITCH_OP, n, cost), 2);
+
+    OpenFHEParallelControls.Enable();
+#ifdef PARALLEL
+    EXPECT_EQ(OpenFHEParallelControls.GetThreadLimit(BASIS_SWITCH_OP, n, cost),
+              OpenFHEParallelControls.GetMachineThreads());
+#else
+    EXPECT_EQ(OpenFHEParallelControls.GetThreadLimit(BASIS_SWITCH_OP, n, cost), 1);
+#endif
+}
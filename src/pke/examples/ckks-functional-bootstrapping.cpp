@@ -97,14 +97,25 @@ void FuncBootstrapExample(std::function<double(double)> f, int bits, int p) {
     usint ringDim = cc->GetRingDimension();
     std::cout << "CKKS scheme is using ring dimension " << ringDim << std::endl << std::endl;
 
-    // Precomputations for bootstrapping
+    // Selects the fastest encoding/decoding configuration fitting in the levels allocated to them, the
+    // baby-step giant-step dimensions being chosen by the key switching cost model
     int numSlots = ringDim/2;
+    cc->SetBootstrapBSGSCostModel(true);
+    auto configs = cc->TuneBootstrapParameters(numSlots, levelBudget[0] + levelBudget[1]);
+    levelBudget  = configs[0].levelBudget;
+    bsgsDim      = configs[0].dim1;
+    std::cout << "Level budget {" << levelBudget[0] << ", " << levelBudget[1] << "}, dim1 {" << bsgsDim[0] << ", "
+              << bsgsDim[1] << "}: " << configs[0].numRotationKeys << " rotation keys, "
+              << configs[0].keyMemory / (1 << 20) << " MiB" << std::endl << std::endl;
+
+    // Precomputations for bootstrapping
     cc->EvalFuncBootstrapSetup(levelBudget, bsgsDim, numSlots, bits);
 
     // Key Generation
     auto keyPair = cc->KeyGen();
     cc->EvalMultKeyGen(keyPair.secretKey);
-    cc->EvalBootstrapKeyGen(keyPair.secretKey, numSlots);
+    // only the automorphisms used by functional bootstrapping, conjugation included
+    cc->EvalFuncBootstrapKeyGen(keyPair.secretKey, numSlots);
 
     // Input vector [0, 1, ..., p-2, p-1]
     std::vector<std::complex<double>> x;
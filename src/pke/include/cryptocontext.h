@@ -50,6 +50,7 @@
 #include "encoding/plaintextfactory.h"
 
 #include "key/evalkey.h"
+#include "key/evalkeystore.h"
 #include "key/keypair.h"
 
 #include "schemebase/base-pke.h"
@@ -956,6 +957,32 @@ public:
     // TODO (dsuponit): move InsertEvalAutomorphismKey() to the private section of the class
     static void InsertEvalAutomorphismKey(const std::shared_ptr<std::map<usint, EvalKey<Element>>> evalKeyMap,
                                           const std::string& keyTag = "");
+
+    /**
+   * SaveEvalAutomorphismKeyStore - writes the automorphism keys of a key tag to a file indexed by
+   * automorphism index, from which LoadEvalAutomorphismKeyStore loads them one at a time.
+   * Supported for DCRTPoly only.
+   *
+   * @param filename the file to write.
+   * @param keyTag the secret key tag of the keys.
+   */
+    static void SaveEvalAutomorphismKeyStore(const std::string& filename, const std::string& keyTag);
+
+    /**
+   * LoadEvalAutomorphismKeyStore - opens a file written by SaveEvalAutomorphismKeyStore and adds a
+   * stand-in for each of its keys to the automorphism key map, for the indices without a key yet.
+   * The rotations (EvalAtIndex, EvalFastRotation, bootstrapping) then load the keys on first use and
+   * keep the most recently used ones under the memory budget of the returned store, which can be
+   * changed later on. The crypto context must have the same parameters as the one that saved the keys.
+   * Supported for DCRTPoly only.
+   *
+   * @param filename the file to read.
+   * @param memoryBudget maximum memory of the loaded keys in bytes, 0 for no limit.
+   * @param useMmap whether the file is memory-mapped, otherwise the keys are read from it on demand.
+   * @return the store of the keys.
+   */
+    std::shared_ptr<EvalKeyStore> LoadEvalAutomorphismKeyStore(const std::string& filename,
+                                                               uint64_t memoryBudget = 0, bool useMmap = true);
     //------------------------------------------------------------------------------
     // TURN FEATURES ON
     //------------------------------------------------------------------------------
@@ -2806,6 +2833,27 @@ public:
         return GetScheme()->EvalChebyshevSeries(ciphertext, coefficients, a, b);
     }
 
+    /**
+   * Evaluates several Chebyshev series on the same ciphertext. The Chebyshev polynomials of
+   * the (mapped) input are computed once, for the largest degree, and shared by all the series,
+   * so that k outputs cost a single polynomial basis plus the k series-specific products.
+   * The linear method is used if the largest degree is less than 5, Paterson-Stockmeyer otherwise.
+   * Supported only in CKKS.
+   *
+   * @param ciphertext input ciphertext
+   * @param &coefficients the Chebyshev expansions, one per output
+   * @param a - lower bound of argument for which the coefficients were found
+   * @param b - upper bound of argument for which the coefficients were found
+   * @return the results of the evaluations, in the order of the series.
+   */
+    std::vector<Ciphertext<Element>> EvalChebyshevSeriesMulti(ConstCiphertext<Element> ciphertext,
+                                                              const std::vector<std::vector<double>>& coefficients,
+                                                              double a, double b) const {
+        ValidateCiphertext(ciphertext);
+
+        return GetScheme()->EvalChebyshevSeriesMulti(ciphertext, coefficients, a, b);
+    }
+
     /**
    * Naive linear method for evaluating Chebyshev polynomial interpolation;
    * first the range [a,b] is mapped to [-1,1] using linear transformation 1 + 2
@@ -2873,6 +2921,22 @@ public:
     Ciphertext<Element> EvalChebyshevFunction(std::function<std::complex<double>(double)> func, ConstCiphertext<Element> ciphertext,
                                               double a, double b, uint32_t degree) const;
 
+    /**
+   * Evaluates the Chebyshev approximations of several functions over the range [a,b] on the same
+   * ciphertext, sharing the Chebyshev polynomials between them (see EvalChebyshevSeriesMulti).
+   * Supported only in CKKS.
+   *
+   * @param funcs the functions to be approximated
+   * @param ciphertext input ciphertext
+   * @param a - lower bound of argument for which the coefficients were found
+   * @param b - upper bound of argument for which the coefficients were found
+   * @param degree Desired degree of approximation, common to all the functions
+   * @return the results of the evaluations, in the order of the functions.
+   */
+    std::vector<Ciphertext<Element>> EvalChebyshevFunctionMulti(const std::vector<std::function<double(double)>>& funcs,
+                                                                ConstCiphertext<Element> ciphertext, double a, double b,
+                                                                uint32_t degree) const;
+
     /**
    * Evaluate approximate sine function on a ciphertext using the Chebyshev approximation.
    * Supported only in CKKS.
@@ -3545,6 +3609,31 @@ public:
 
         CryptoContextImpl<Element>::InsertEvalAutomorphismKey(evalKeys, privateKey->GetKeyTag());
     }
+    /**
+   * Returns the automorphism indices used by the functional bootstrapping of the given number of slots
+   * (EvalFuncBootstrap, EvalFuncBootstrapBatch, EvalFuncMVBootstrap and the tree variants), conjugation
+   * included. Together with SerializeEvalAutomorphismKey for specific indices, it allows to ship only these
+   * keys. Supported in CKKS only.
+   *
+   * @param slots number of slots set up with EvalFuncBootstrapSetup, 0 for full packing.
+   * @return the sorted automorphism indices.
+   */
+    std::vector<uint32_t> FindFuncBootstrapAutomorphismIndices(uint32_t slots = 0) const {
+        return GetScheme()->FindFuncBootstrapAutomorphismIndices(slots, GetCyclotomicOrder());
+    }
+
+    /**
+   * Generates exactly the automorphism keys used by functional bootstrapping, see
+   * FindFuncBootstrapAutomorphismIndices, in a single parallel batch. Keys already generated for the key tag,
+   * e.g. for another number of slots, are not generated again. Supported in CKKS only.
+   *
+   * @param privateKey private key.
+   * @param slots number of slots set up with EvalFuncBootstrapSetup, 0 for full packing.
+   */
+    void EvalFuncBootstrapKeyGen(const PrivateKey<Element> privateKey, uint32_t slots = 0) {
+        EvalAutomorphismKeyGen(privateKey, FindFuncBootstrapAutomorphismIndices(slots));
+    }
+
     /**
    * Computes the plaintexts for encoding and decoding for both linear and FFT-like methods. Supported in CKKS only.
    *
@@ -3578,16 +3667,173 @@ public:
         return GetScheme()->EvalFuncBootstrap(ciphertext, func, num_poi, order);
     }
 
+    /**
+   * Functional bootstrapping with a precompiled LUT, which avoids recomputing the interpolation
+   * coefficients at each call.
+   *
+   * @param ciphertext the input ciphertext.
+   * @param lut the LUT built once with HermiteLUT(func, num_poi, order).
+   * @return the bootstrapped ciphertext.
+   */
+    Ciphertext<Element> EvalFuncBootstrap(ConstCiphertext<Element> ciphertext, const HermiteLUT& lut) const {
+        return GetScheme()->EvalFuncBootstrap(ciphertext, lut);
+    }
+
+    /**
+   * Functional bootstrapping of several ciphertexts with the same LUT. The setup (precomputations lookup,
+   * polynomial coefficients, conjugation key) is shared, and the ciphertexts are bootstrapped in parallel.
+   * All ciphertexts should have the same number of slots.
+   *
+   * @param ciphertexts the input ciphertexts.
+   * @param func the function to evaluate.
+   * @param num_poi the number of points of interest (size of the LUT domain).
+   * @param order order of the Hermite interpolation.
+   * @return the bootstrapped ciphertexts, in the same order as the inputs.
+   */
+    std::vector<Ciphertext<Element>> EvalFuncBootstrapBatch(const std::vector<ConstCiphertext<Element>>& ciphertexts,
+                                                            std::function<double(double)> func, int num_poi,
+                                                            int order) const {
+        return GetScheme()->EvalFuncBootstrapBatch(ciphertexts, func, num_poi, order);
+    }
+
+    std::vector<Ciphertext<Element>> EvalFuncBootstrapBatch(const std::vector<ConstCiphertext<Element>>& ciphertexts,
+                                                            const HermiteLUT& lut) const {
+        return GetScheme()->EvalFuncBootstrapBatch(ciphertexts, lut);
+    }
+
     std::vector<Ciphertext<Element>> EvalFuncMVBootstrap(ConstCiphertext<Element> ciphertext, std::vector<std::function<double(double)>> func_vec,
                                                          int num_poi, int order) const {
         return GetScheme()->EvalFuncMVBootstrap(ciphertext, func_vec, num_poi, order);
     }
 
+    std::vector<Ciphertext<Element>> EvalFuncMVBootstrap(ConstCiphertext<Element> ciphertext,
+                                                         const std::vector<HermiteLUT>& luts) const {
+        return GetScheme()->EvalFuncMVBootstrap(ciphertext, luts);
+    }
+
+    /**
+   * Evaluates several LUTs on a ciphertext whose slots encode exp(2*pi*i*m/num_poi), i.e. the output of the
+   * exponential stage of the functional bootstrapping, without any bootstrapping. The powers of the input are
+   * computed once, for the largest LUT degree, and shared by all the LUTs. For an input on the roots of unity,
+   * the slots of the i-th output hold luts[i](m) in their real part; unlike the bootstrapping, no conjugate is
+   * added, so the imaginary part holds the approximation noise.
+   *
+   * @param ciphertext the exp-encoded input ciphertext.
+   * @param luts the LUTs to evaluate, all with the same number of points.
+   * @return the evaluated LUTs, in the same order as luts.
+   */
+    std::vector<Ciphertext<Element>> EvalFuncMultiLUT(ConstCiphertext<Element> ciphertext,
+                                                      const std::vector<HermiteLUT>& luts) const {
+        ValidateCiphertext(ciphertext);
+
+        return GetScheme()->EvalFuncMultiLUT(ciphertext, luts);
+    }
+
     Ciphertext<DCRTPoly> EvalFuncSimpleTreeMVB(ConstCiphertext<DCRTPoly> ciphertext, std::function<double(double)> func,
                                                int num_poi, int order) const {
         return GetScheme()->EvalFuncSimpleTreeMVB(ciphertext, func, num_poi, order);
     }
 
+    /**
+   * Tree-based functional bootstrapping of an input split into numDigits digits of digitBits bits each.
+   * The digits are given most significant first, two per ciphertext (real part then imaginary part),
+   * and the digits of func(x) are returned with the same layout.
+   *
+   * @param ciphertexts the ceil(numDigits / 2) ciphertexts holding the input digits.
+   * @param func the function to evaluate on the numDigits * digitBits bits input.
+   * @param digitBits the number of bits per digit, which should match the precision given to EvalFuncBootstrapSetup.
+   * @param numDigits the number of digits (at least 2). A LUT is evaluated for every digit and every value of the
+   * other digits, i.e. numDigits * 2^(digitBits * (numDigits - 1)) LUTs, which should not exceed 1024.
+   * @return the ciphertexts holding the digits of the result.
+   */
+    std::vector<Ciphertext<DCRTPoly>> EvalFuncTreeMVB(const std::vector<ConstCiphertext<DCRTPoly>>& ciphertexts,
+                                                      std::function<double(double)> func, uint32_t digitBits,
+                                                      uint32_t numDigits) const {
+        return GetScheme()->EvalFuncTreeMVB(ciphertexts, func, digitBits, numDigits);
+    }
+
+    /**
+   * Attaches a sink recording the per-stage timings of the subsequent (functional) bootstraps, and for
+   * each bootstrap its wall time, number of key switches, NTTs and rescales and peak tower count.
+   * The sink can be queried or dumped as JSON at any time. Supported in CKKS only.
+   *
+   * @param stats the sink to fill, or nullptr to stop recording.
+   */
+    void SetBootstrapStats(std::shared_ptr<BootstrapStats> stats) {
+        GetScheme()->SetBootstrapStats(stats);
+    }
+
+    /**
+   * Keeps only compact seeds (the slot values) of the CoeffsToSlots/SlotsToCoeffs diagonals computed by the
+   * subsequent EvalBootstrapSetup/EvalFuncBootstrapSetup/EvalBootstrapPrecompute calls, instead of the
+   * plaintexts in the extended basis. Each diagonal is then encoded just before it is used, and the
+   * cacheSize most recently used ones are kept. This cuts the resident memory of the precomputations by
+   * roughly the number of towers of P*Q, at the cost of encoding the cache misses on every bootstrap.
+   * The linear transform bootstrapping (level budget {1, 1}) always precomputes its plaintexts.
+   * Supported in CKKS only.
+   *
+   * @param onTheFly whether to encode the diagonals on the fly.
+   * @param cacheSize the maximum number of encoded diagonals kept between uses, 0 for none.
+   */
+    void SetBootstrapDiagonalsOnTheFly(bool onTheFly, uint32_t cacheSize = 0) {
+        GetScheme()->SetBootstrapDiagonalsOnTheFly(onTheFly, cacheSize);
+    }
+
+    /**
+   * Selects the CoeffsToSlots/SlotsToCoeffs baby-step giant-step dimensions left unset (0 in dim1) of the
+   * subsequent EvalBootstrapSetup/EvalFuncBootstrapSetup/EvalBootstrapPrecompute/TuneBootstrapParameters
+   * calls with a key switching cost model of this crypto context, instead of the default heuristic. The
+   * selected dimensions usually need other rotation keys than the default ones, so the keys have to be
+   * generated after the setup with the same choice. Supported in CKKS only.
+   *
+   * @param useCostModel whether to select the unset dimensions with the cost model.
+   */
+    void SetBootstrapBSGSCostModel(bool useCostModel) {
+        GetScheme()->SetBootstrapBSGSCostModel(useCostModel);
+    }
+
+    /**
+   * Writes the CoeffsToSlots/SlotsToCoeffs plaintexts of all the bootstrapping configurations set up so far
+   * to a binary file, in evaluation representation, so that other processes can load them instead of
+   * recomputing them. Not supported for diagonals kept as seeds (see SetBootstrapDiagonalsOnTheFly).
+   * Supported in CKKS only.
+   *
+   * @param filename the file to write.
+   */
+    void SaveBootstrapPrecomputations(const std::string& filename) const {
+        GetScheme()->SaveBootstrapPrecomputations(filename);
+    }
+
+    /**
+   * Loads the bootstrapping precomputations written by SaveBootstrapPrecomputations, replacing a call to
+   * EvalBootstrapSetup/EvalFuncBootstrapSetup. The file is memory-mapped read-only while it is loaded, and
+   * the towers are copied from it into the plaintexts: this only saves the setup time (the encodings and
+   * NTTs), the loaded plaintexts take as much memory as computed ones and are not shared between processes.
+   * The crypto context must have the same parameters as the one that saved it. Supported in CKKS only.
+   *
+   * @param filename the file to read.
+   */
+    void LoadBootstrapPrecomputations(const std::string& filename) {
+        GetScheme()->LoadBootstrapPrecomputations(*this, filename);
+    }
+
+    /**
+   * Models the latency of CoeffsToSlots and SlotsToCoeffs for the candidate level budgets and
+   * baby-step giant-step dimensions fitting in the given depth, and returns them from the fastest
+   * to the slowest with their number of rotation keys and key memory. The model uses the number of
+   * towers of Q and P, the digit size and the ring dimension of this crypto context, so it should be
+   * created with the target parameters. Supported in CKKS only.
+   *
+   * @param slots number of slots to be bootstrapped, 0 for full packing.
+   * @param depth the number of levels available for the encoding and the decoding together.
+   * @param numThreads the number of threads of the evaluation, 0 for the current OpenMP setting.
+   * @return the candidate configurations, fastest first.
+   */
+    std::vector<BootstrapConfig> TuneBootstrapParameters(uint32_t slots = 0, uint32_t depth = 9,
+                                                         uint32_t numThreads = 0) const {
+        return GetScheme()->TuneBootstrapParameters(*this, slots, depth, numThreads);
+    }
+
     //------------------------------------------------------------------------------
     // Scheme switching Methods
     //------------------------------------------------------------------------------
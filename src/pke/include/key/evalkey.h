@@ -45,6 +45,8 @@
  */
 namespace lbcrypto {
 
+struct EvalKeyPacked;
+
 /**
  * @brief Abstract interface for evaluation/proxy keys
  * @tparam Element a ring element.
@@ -224,6 +226,15 @@ public:
         OPENFHE_THROW("GetAinDCRT operation not supported");
     }
 
+    /**
+   * Getter function to access the layout of the key for the inner products of hybrid key switching.
+   *
+   * @return the packed key, nullptr if the key is not packed.
+   */
+    virtual std::shared_ptr<const EvalKeyPacked> GetPackedKey() const {
+        return nullptr;
+    }
+
     virtual void ClearKeys() {
         OPENFHE_THROW("ClearKeys operation is not supported");
     }
@@ -35,7 +35,9 @@
 #include "key/evalkeyrelin-fwd.h"
 #include "key/evalkey.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <utility>
@@ -49,6 +51,63 @@
  */
 namespace lbcrypto {
 
+// number of 32-bit words of the seed of the "a" polynomials of a seeded evaluation key
+constexpr size_t EVAL_KEY_SEED_SIZE = 8;
+
+/**
+ * Expands the seed of a seeded evaluation key into its "a" polynomials, one per digit, in basis
+ * QP and in evaluation representation. Each tower of each digit is sampled from its own Blake2
+ * stream, so the expansion does not depend on the platform nor on the number of threads.
+ */
+template <class Element>
+std::vector<Element> ExpandEvalKeySeed(const CryptoContext<Element> cc, const std::vector<uint32_t>& seed) {
+    OPENFHE_THROW("Seeded evaluation keys are only supported for DCRTPoly");
+}
+
+template <>
+std::vector<DCRTPoly> ExpandEvalKeySeed(const CryptoContext<DCRTPoly> cc, const std::vector<uint32_t>& seed);
+
+/**
+ * Evaluation key laid out for the inner products of hybrid key switching: each tower of the key basis
+ * holds the "b" and "a" values of all the digits, interleaved coefficient by coefficient, so that the
+ * inner product of a coefficient walks contiguous memory.
+ */
+struct EvalKeyPacked {
+    uint32_t numDigits = 0;
+    uint32_t ringDim   = 0;
+    // basis of the polynomials of the key
+    std::shared_ptr<DCRTPoly::Params> params;
+    // towers[i][2 * (k * numDigits + j)] and towers[i][2 * (k * numDigits + j) + 1] are the k-th
+    // coefficients of the i-th towers of b_j and a_j
+    std::vector<std::vector<NativeInteger::Integer>> towers;
+};
+
+/**
+ * Packs the polynomials of an evaluation key (see EvalKeyPacked).
+ *
+ * @return the packed key, nullptr if the crypto context does not use hybrid key switching.
+ */
+template <class Element>
+std::shared_ptr<const EvalKeyPacked> PackEvalKey(const CryptoContext<Element> cc, const std::vector<Element>& av,
+                                                 const std::vector<Element>& bv) {
+    return nullptr;
+}
+
+template <>
+std::shared_ptr<const EvalKeyPacked> PackEvalKey(const CryptoContext<DCRTPoly> cc, const std::vector<DCRTPoly>& av,
+                                                 const std::vector<DCRTPoly>& bv);
+
+/**
+ * Unpacks the polynomials of an evaluation key packed by PackEvalKey.
+ */
+template <class Element>
+void UnpackEvalKey(const EvalKeyPacked& packed, std::vector<Element>* av, std::vector<Element>* bv) {
+    OPENFHE_THROW("Packed evaluation keys are only supported for DCRTPoly");
+}
+
+template <>
+void UnpackEvalKey(const EvalKeyPacked& packed, std::vector<DCRTPoly>* av, std::vector<DCRTPoly>* bv);
+
 /**
  * @brief Concrete class for Relinearization keys of RLWE scheme
  * @tparam Element a ring element.
@@ -71,7 +130,14 @@ public:
    *@param &rhs key to copy from
    */
     explicit EvalKeyRelinImpl(const EvalKeyRelinImpl<Element>& rhs)
-        : EvalKeyImpl<Element>(rhs.GetCryptoContext()), m_rKey(rhs.m_rKey) {}
+        : EvalKeyImpl<Element>(rhs.GetCryptoContext()),
+          m_rKey(rhs.m_rKey),
+          m_aSeed(rhs.m_aSeed),
+          m_aExpanded(rhs.m_aExpanded.load()),
+          m_packed(rhs.m_packed),
+          m_bUnpacked(rhs.m_bUnpacked.load()),
+          m_packPending(rhs.m_packPending.load()),
+          m_keepPolys(rhs.m_keepPolys.load()) {}
 
     /**
    * Move constructor
@@ -79,7 +145,14 @@ public:
    *@param &rhs key to move from
    */
     explicit EvalKeyRelinImpl(EvalKeyRelinImpl<Element>&& rhs) noexcept
-        : EvalKeyImpl<Element>(rhs.GetCryptoContext()), m_rKey(std::move(rhs.m_rKey)) {}
+        : EvalKeyImpl<Element>(rhs.GetCryptoContext()),
+          m_rKey(std::move(rhs.m_rKey)),
+          m_aSeed(std::move(rhs.m_aSeed)),
+          m_aExpanded(rhs.m_aExpanded.load()),
+          m_packed(std::move(rhs.m_packed)),
+          m_bUnpacked(rhs.m_bUnpacked.load()),
+          m_packPending(rhs.m_packPending.load()),
+          m_keepPolys(rhs.m_keepPolys.load()) {}
 
     operator bool() const {
         return static_cast<bool>(this->context) && m_rKey.size() != 0;
@@ -93,6 +166,12 @@ public:
     EvalKeyRelinImpl<Element>& operator=(const EvalKeyRelinImpl<Element>& rhs) {
         this->context = rhs.context;
         this->m_rKey  = rhs.m_rKey;
+        m_aSeed       = rhs.m_aSeed;
+        m_aExpanded   = rhs.m_aExpanded.load();
+        m_packed      = rhs.m_packed;
+        m_bUnpacked   = rhs.m_bUnpacked.load();
+        m_packPending = rhs.m_packPending.load();
+        m_keepPolys   = rhs.m_keepPolys.load();
         return *this;
     }
 
@@ -105,6 +184,12 @@ public:
         this->context = rhs.context;
         rhs.context   = 0;
         m_rKey        = std::move(rhs.m_rKey);
+        m_aSeed       = std::move(rhs.m_aSeed);
+        m_aExpanded   = rhs.m_aExpanded.load();
+        m_packed      = std::move(rhs.m_packed);
+        m_bUnpacked   = rhs.m_bUnpacked.load();
+        m_packPending = rhs.m_packPending.load();
+        m_keepPolys   = rhs.m_keepPolys.load();
         return *this;
     }
 
@@ -115,7 +200,10 @@ public:
    * @param &a is the Element vector to be copied.
    */
     virtual void SetAVector(const std::vector<Element>& a) {
+        DropPacked();
         m_rKey.insert(m_rKey.begin() + 0, a);
+        m_aSeed.clear();
+        m_aExpanded = true;
     }
 
     /**
@@ -125,16 +213,45 @@ public:
    * @param &&a is the Element vector to be moved.
    */
     virtual void SetAVector(std::vector<Element>&& a) {
+        DropPacked();
         m_rKey.insert(m_rKey.begin() + 0, std::move(a));
+        m_aSeed.clear();
+        m_aExpanded = true;
+    }
+
+    /**
+   * Replaces the stored "a" polynomials by the seed they were expanded from (see ExpandEvalKeySeed).
+   * They are expanded again on first use, and only the seed is serialized. A packed key keeps them
+   * in its packed layout.
+   *
+   * @param &seed is the seed, of EVAL_KEY_SEED_SIZE words.
+   */
+    void SetAVectorSeed(const std::vector<uint32_t>& seed) {
+        m_aSeed = seed;
+        if (m_packed != nullptr)
+            return;
+        m_rKey.at(0).clear();
+        m_aExpanded = false;
+    }
+
+    /**
+   * @return the seed of the "a" polynomials, empty if the key is not seeded.
+   */
+    const std::vector<uint32_t>& GetAVectorSeed() const {
+        return m_aSeed;
     }
 
     /**
    * Getter function to access Relinearization Element Vector A.
    * Overrides base class implementation.
    *
-   * @return Element vector A.
+   * @return Element vector A. On a packed key, the polynomials are unpacked next to the packed layout,
+   * and both stay resident until the key is modified.
    */
     virtual const std::vector<Element>& GetAVector() const {
+        // m_packPending is read first: once it is cleared, the packing has completed
+        if (m_packPending.load(std::memory_order_acquire) || !m_aExpanded.load(std::memory_order_acquire))
+            MaterializeKeys();
         return m_rKey.at(0);
     }
 
@@ -145,6 +262,7 @@ public:
    * @param &b is the Element vector to be copied.
    */
     virtual void SetBVector(const std::vector<Element>& b) {
+        DropPacked();
         m_rKey.insert(m_rKey.begin() + 1, b);
     }
 
@@ -155,6 +273,7 @@ public:
    * @param &&b is the Element vector to be moved.
    */
     virtual void SetBVector(std::vector<Element>&& b) {
+        DropPacked();
         m_rKey.insert(m_rKey.begin() + 1, std::move(b));
     }
 
@@ -162,12 +281,73 @@ public:
    * Getter function to access Relinearization Element Vector B.
    * Overrides base class implementation.
    *
-   * @return Element vector B.
+   * @return Element vector B. On a packed key, the polynomials are unpacked next to the packed layout,
+   * and both stay resident until the key is modified.
    */
     virtual const std::vector<Element>& GetBVector() const {
+        if (m_packPending.load(std::memory_order_acquire) || !m_bUnpacked.load(std::memory_order_acquire))
+            MaterializeKeys();
         return m_rKey.at(1);
     }
 
+    /**
+   * Lays the key out for the inner products of hybrid key switching (see EvalKeyPacked) and releases
+   * its polynomials, which are unpacked again if they are accessed. Keys of a crypto context using
+   * another key switching technique are left as they are. A seeded key whose "a" polynomials are not
+   * expanded is only packed by the first call to GetPackedKey, so that it holds its seed and its "b"
+   * polynomials until it is used; if its polynomials are accessed before, this packing keeps them next
+   * to the packed layout, as references to them may still be held. Not thread safe.
+   */
+    void Pack() {
+        if (m_packed != nullptr || m_rKey.size() < 2)
+            return;
+        if (!m_aExpanded) {
+            m_packPending = true;
+            return;
+        }
+        auto packed = PackEvalKey<Element>(this->GetCryptoContext(), m_rKey.at(0), GetBVector());
+        if (packed == nullptr)
+            return;
+        m_packed    = std::move(packed);
+        m_rKey      = {std::vector<Element>(), std::vector<Element>()};
+        m_aExpanded = false;
+        m_bUnpacked = false;
+    }
+
+    /**
+   * @return the packed layout of the key, nullptr if it is not packed. A key whose packing was deferred
+   * by Pack() is packed first; concurrent calls are safe, but not with concurrent accesses to its polynomials.
+   */
+    std::shared_ptr<const EvalKeyPacked> GetPackedKey() const override {
+        if (m_packPending.load(std::memory_order_acquire))
+            PackPending();
+        return m_packed;
+    }
+
+    /**
+   * @return whether the key is packed, without packing a key whose packing was deferred.
+   */
+    bool IsPacked() const {
+        return !m_packPending.load(std::memory_order_acquire) && m_packed != nullptr;
+    }
+
+    /**
+   * @return the memory of the polynomials held by the key in bytes, packed or not.
+   */
+    uint64_t GetResidentMemory() const {
+        std::lock_guard<std::mutex> lock(m_aMutex);
+        uint64_t memory = 0;
+        if (m_packed != nullptr) {
+            for (const auto& tower : m_packed->towers)
+                memory += tower.size() * sizeof(NativeInteger::Integer);
+        }
+        for (const auto& polys : m_rKey) {
+            for (const auto& poly : polys)
+                memory += poly.GetNumOfElements() * uint64_t(poly.GetRingDimension()) * sizeof(NativeInteger);
+        }
+        return memory;
+    }
+
     /**
    * Setter function to store key switch Element.
    * Throws exception, to be overridden by derived class.
@@ -235,6 +415,12 @@ public:
     virtual void ClearKeys() {
         m_rKey.clear();
         m_dcrtKeys.clear();
+        m_aSeed.clear();
+        m_aExpanded   = true;
+        m_packed      = nullptr;
+        m_bUnpacked   = true;
+        m_packPending = false;
+        m_keepPolys   = false;
     }
 
     bool key_compare(const EvalKeyImpl<Element>& other) const {
@@ -243,6 +429,13 @@ public:
         if (!CryptoObject<Element>::operator==(other))
             return false;
 
+        for (const auto* key : {this, &oth}) {
+            if (key->m_rKey.size() != 0) {
+                key->GetAVector();
+                key->GetBVector();
+            }
+        }
+
         if (this->m_rKey.size() != oth.m_rKey.size())
             return false;
         for (size_t i = 0; i < this->m_rKey.size(); i++) {
@@ -259,7 +452,18 @@ public:
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
         ar(::cereal::base_class<EvalKeyImpl<Element>>(this));
-        ar(::cereal::make_nvp("k", m_rKey));
+        std::vector<std::vector<Element>> unpacked;
+        const auto& rKey = SerializedKeys(&unpacked, version < 2 || m_aSeed.empty());
+        if (version < 2) {
+            ar(::cereal::make_nvp("k", rKey));
+            return;
+        }
+        // seeded keys only store the seed of their "a" polynomials
+        ar(::cereal::make_nvp("s", m_aSeed));
+        if (m_aSeed.empty())
+            ar(::cereal::make_nvp("k", rKey));
+        else
+            ar(::cereal::make_nvp("b", rKey.at(1)));
     }
 
     template <class Archive>
@@ -269,18 +473,114 @@ public:
                           " is from a later version of the library");
         }
         ar(::cereal::base_class<EvalKeyImpl<Element>>(this));
-        ar(::cereal::make_nvp("k", m_rKey));
+        m_aSeed.clear();
+        m_aExpanded = true;
+        m_packed      = nullptr;
+        m_bUnpacked   = true;
+        m_packPending = false;
+        m_keepPolys   = false;
+        if (version < 2) {
+            ar(::cereal::make_nvp("k", m_rKey));
+        }
+        else {
+            ar(::cereal::make_nvp("s", m_aSeed));
+            if (m_aSeed.empty()) {
+                ar(::cereal::make_nvp("k", m_rKey));
+            }
+            else {
+                std::vector<Element> b;
+                ar(::cereal::make_nvp("b", b));
+                m_rKey      = {std::vector<Element>(), std::move(b)};
+                m_aExpanded = false;
+            }
+        }
+        Pack();
     }
     std::string SerializedObjectName() const {
         return "EvalKeyRelin";
     }
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
     }
 
 private:
+    // unpacks a packed key, or expands the "a" polynomials of a seeded key; the polynomials of a key
+    // whose packing is deferred are then kept by PackPending
+    void MaterializeKeys() const {
+        std::lock_guard<std::mutex> lock(m_aMutex);
+        if (m_packPending.load(std::memory_order_relaxed))
+            m_keepPolys.store(true, std::memory_order_relaxed);
+        if (m_packed != nullptr && !m_bUnpacked.load(std::memory_order_relaxed)) {
+            UnpackEvalKey<Element>(*m_packed, &m_rKey.at(0), &m_rKey.at(1));
+            m_aExpanded.store(true, std::memory_order_release);
+            m_bUnpacked.store(true, std::memory_order_release);
+        }
+        if (!m_aExpanded.load(std::memory_order_relaxed)) {
+            m_rKey.at(0) = ExpandEvalKeySeed<Element>(this->GetCryptoContext(), m_aSeed);
+            m_aExpanded.store(true, std::memory_order_release);
+        }
+    }
+
+    // packs a key whose packing was deferred by Pack(), expanding its "a" polynomials; they are only
+    // released if no reference to them was returned, m_rKey is never reassigned otherwise
+    void PackPending() const {
+        std::lock_guard<std::mutex> lock(m_aMutex);
+        if (!m_packPending.load(std::memory_order_relaxed))
+            return;
+        if (!m_aExpanded.load(std::memory_order_relaxed))
+            m_rKey.at(0) = ExpandEvalKeySeed<Element>(this->GetCryptoContext(), m_aSeed);
+        m_packed = PackEvalKey<Element>(this->GetCryptoContext(), m_rKey.at(0), m_rKey.at(1));
+        if (m_packed != nullptr && !m_keepPolys.load(std::memory_order_relaxed)) {
+            m_rKey = {std::vector<Element>(), std::vector<Element>()};
+            m_aExpanded.store(false, std::memory_order_relaxed);
+            m_bUnpacked.store(false, std::memory_order_relaxed);
+        }
+        else {
+            m_aExpanded.store(true, std::memory_order_relaxed);
+        }
+        m_packPending.store(false, std::memory_order_release);
+    }
+
+    // returns to the polynomial form before the key is modified
+    void DropPacked() {
+        m_packPending = false;
+        m_keepPolys   = false;
+        if (m_packed == nullptr)
+            return;
+        MaterializeKeys();
+        m_packed = nullptr;
+    }
+
+    // the polynomials to serialize: the ones of the key, or the ones unpacked in *unpacked for a packed key
+    const std::vector<std::vector<Element>>& SerializedKeys(std::vector<std::vector<Element>>* unpacked,
+                                                            bool withA) const {
+        if (m_packed != nullptr && !m_bUnpacked.load(std::memory_order_acquire)) {
+            unpacked->resize(2);
+            UnpackEvalKey<Element>(*m_packed, &(*unpacked)[0], &(*unpacked)[1]);
+            return *unpacked;
+        }
+        if (withA && m_rKey.size() != 0)
+            GetAVector();
+        return m_rKey;
+    }
+
     // private member to store vector of vector of Element.
-    std::vector<std::vector<Element>> m_rKey;
+    // the "a" vector of a seeded key is expanded on first use and a packed key is unpacked on first
+    // access, hence mutable
+    mutable std::vector<std::vector<Element>> m_rKey;
+
+    // seed of the "a" polynomials, empty if the key is not seeded
+    std::vector<uint32_t> m_aSeed;
+    mutable std::atomic<bool> m_aExpanded{true};
+    mutable std::mutex m_aMutex;
+
+    // layout for hybrid key switching, m_rKey is only filled again on access
+    mutable std::shared_ptr<const EvalKeyPacked> m_packed;
+    mutable std::atomic<bool> m_bUnpacked{true};
+    // packing deferred by Pack() until the "a" polynomials of a seeded key are used
+    mutable std::atomic<bool> m_packPending{false};
+    // set when the polynomials of a key whose packing is deferred are accessed, so that PackPending keeps them
+    mutable std::atomic<bool> m_keepPolys{false};
 
     // Used for hybrid key switching
     std::vector<DCRTPoly> m_dcrtKeys;
@@ -0,0 +1,246 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2025, CEA-List
+//
+// All rights reserved.
+//
+// Author TPOC: jules.dumezy@cea.fr
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Automorphism keys stored in an indexed file and loaded on demand under a memory budget
+ */
+
+#ifndef LBCRYPTO_CRYPTO_KEY_EVALKEYSTORE_H
+#define LBCRYPTO_CRYPTO_KEY_EVALKEYSTORE_H
+
+#include "key/evalkeyrelin.h"
+#include "utils/mappedfile.h"
+
+#include <cstdint>
+#include <fstream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lbcrypto {
+
+/**
+ * @brief Automorphism keys of one key tag, stored in a binary file indexed by automorphism index.
+ *
+ * The keys are loaded one at a time on first use, from a memory mapping of the file or by reading
+ * it, and the loaded keys are kept under a memory budget, the least recently used ones being
+ * released first. A key that is still used by a computation stays alive until the computation
+ * releases it, so the budget can be exceeded by the keys in flight. The memory of the loaded keys is
+ * measured on the keys themselves, as a seeded key only holds its seed and its "b" polynomials until
+ * it is used in a key switching.
+ */
+class EvalKeyStore {
+public:
+    /**
+   * Opens a file written by Save.
+   *
+   * @param cc the crypto context of the keys, with the same parameters as the one that saved them.
+   * @param filename the file to read.
+   * @param memoryBudget the maximum memory of the loaded keys in bytes, 0 for no limit.
+   * @param useMmap whether the file is memory-mapped, otherwise the keys are read from it on demand.
+   */
+    EvalKeyStore(const CryptoContext<DCRTPoly> cc, const std::string& filename, uint64_t memoryBudget = 0,
+                 bool useMmap = true);
+
+    EvalKeyStore(const EvalKeyStore&)            = delete;
+    EvalKeyStore& operator=(const EvalKeyStore&) = delete;
+
+    /**
+   * Writes automorphism keys to an indexed file, in evaluation representation. Seeded keys only
+   * store their seed and their "b" polynomials.
+   *
+   * @param filename the file to write.
+   * @param keyMap the keys by automorphism index.
+   * @param keyTag the tag of the keys.
+   */
+    static void Save(const std::string& filename, const std::map<uint32_t, EvalKey<DCRTPoly>>& keyMap,
+                     const std::string& keyTag);
+
+    const std::string& GetKeyTag() const {
+        return m_keyTag;
+    }
+
+    /**
+   * @return the automorphism indices of the stored keys, in increasing order.
+   */
+    std::vector<uint32_t> GetIndices() const;
+
+    /**
+   * Returns the key of an automorphism index, loading it if it is not in memory. Thread safe.
+   *
+   * @param index the automorphism index.
+   * @return the key.
+   */
+    EvalKey<DCRTPoly> GetKey(uint32_t index);
+
+    /**
+   * Sets the memory budget of the loaded keys, releasing the least recently used ones above it.
+   *
+   * @param memoryBudget the budget in bytes, 0 for no limit.
+   */
+    void SetMemoryBudget(uint64_t memoryBudget);
+
+    uint64_t GetMemoryBudget() const;
+
+    /**
+   * @return the memory of the polynomials of the keys currently held by the store, in bytes.
+   */
+    uint64_t GetResidentMemory() const;
+
+    /**
+   * @return the number of keys loaded from the file so far.
+   */
+    uint64_t GetNumLoads() const;
+
+    /**
+   * Releases all the keys held by the store.
+   */
+    void Release();
+
+private:
+    struct Entry {
+        uint64_t offset = 0;
+        uint64_t size   = 0;
+        EvalKey<DCRTPoly> key;
+        std::list<uint32_t>::iterator lru;
+    };
+
+    // reads a key from the file, without holding the lock of the cache
+    EvalKey<DCRTPoly> Load(const Entry& entry);
+
+    // parameters of a polynomial with the given moduli, shared by the keys
+    std::shared_ptr<DCRTPoly::Params> GetParams(const std::vector<NativeInteger::Integer>& moduli);
+
+    static uint64_t KeyMemory(const EvalKey<DCRTPoly>& key);
+
+    // memory of the keys held by the store, measured on the keys as they expand once used
+    uint64_t ResidentMemory() const;
+
+    // releases the least recently used keys above the budget, the most recent one excepted
+    void Evict();
+
+    CryptoContext<DCRTPoly> m_cc;
+    std::string m_filename;
+    std::string m_keyTag;
+    std::unique_ptr<MappedFile> m_mappedFile;
+    std::ifstream m_in;
+    std::mutex m_inMutex;
+    // parameters of the towers of Q and P by modulus
+    std::map<NativeInteger::Integer, std::shared_ptr<ILNativeParams>> m_towerParams;
+    std::map<std::vector<NativeInteger::Integer>, std::shared_ptr<DCRTPoly::Params>> m_params;
+    std::mutex m_paramsMutex;
+
+    mutable std::mutex m_mutex;
+    std::map<uint32_t, Entry> m_entries;
+    // most recently used first
+    std::list<uint32_t> m_lru;
+    uint64_t m_memoryBudget = 0;
+    uint64_t m_numLoads     = 0;
+};
+
+/**
+ * @brief Stand-in for a key of an EvalKeyStore in the automorphism key map of a crypto context.
+ *
+ * The rotations fetch the actual key through ResolveEvalKey for the duration of the key switching.
+ * Code that reads the polynomials of the stand-in directly gets the ones of a key pinned by the
+ * calling thread, which stays valid until the next key switching of that thread with a stored key,
+ * the pinned keys being dropped then.
+ */
+class EvalKeyStoredImpl : public EvalKeyRelinImpl<DCRTPoly> {
+public:
+    EvalKeyStoredImpl(const CryptoContext<DCRTPoly> cc, std::shared_ptr<EvalKeyStore> store, uint32_t index)
+        : EvalKeyRelinImpl<DCRTPoly>(cc), m_store(std::move(store)), m_index(index) {
+        this->SetKeyTag(m_store->GetKeyTag());
+    }
+
+    EvalKey<DCRTPoly> Load() const {
+        return m_store->GetKey(m_index);
+    }
+
+    const std::vector<DCRTPoly>& GetAVector() const override {
+        return Pin()->GetAVector();
+    }
+
+    const std::vector<DCRTPoly>& GetBVector() const override {
+        return Pin()->GetBVector();
+    }
+
+    // the packed key is shared with the caller, so the key is not pinned
+    std::shared_ptr<const EvalKeyPacked> GetPackedKey() const override {
+        return Load()->GetPackedKey();
+    }
+
+    std::shared_ptr<EvalKeyStore> GetStore() const {
+        return m_store;
+    }
+
+    uint32_t GetIndex() const {
+        return m_index;
+    }
+
+    /**
+   * Drops the keys pinned by the calling thread.
+   */
+    static void DropPinned();
+
+private:
+    // loads the key and keeps it alive for the calling thread until DropPinned
+    const EvalKey<DCRTPoly>& Pin() const;
+
+    std::shared_ptr<EvalKeyStore> m_store;
+    uint32_t m_index;
+};
+
+/**
+ * Returns the key to use for a key switching: the key itself, or the key loaded by its store if it
+ * stands for a stored key.
+ */
+template <typename Element>
+EvalKey<Element> ResolveEvalKey(const EvalKey<Element>& evalKey) {
+    return evalKey;
+}
+
+template <>
+inline EvalKey<DCRTPoly> ResolveEvalKey(const EvalKey<DCRTPoly>& evalKey) {
+    const auto stored = std::dynamic_pointer_cast<EvalKeyStoredImpl>(evalKey);
+    if (stored == nullptr)
+        return evalKey;
+    EvalKeyStoredImpl::DropPinned();
+    return stored->Load();
+}
+
+}  // namespace lbcrypto
+
+#endif
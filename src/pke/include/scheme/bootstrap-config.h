@@ -0,0 +1,56 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2025, CEA-List
+//
+// All rights reserved.
+//
+// Author TPOC: jules.dumezy@cea.fr
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#ifndef LBCRYPTO_INC_SCHEME_BOOTSTRAP_CONFIG_H
+#define LBCRYPTO_INC_SCHEME_BOOTSTRAP_CONFIG_H
+
+#include <cstdint>
+#include <vector>
+
+namespace lbcrypto {
+
+/**
+ * A candidate configuration of the homomorphic encoding and decoding of bootstrapping, as returned
+ * by TuneBootstrapParameters. levelBudget and dim1 are meant to be passed as is to
+ * EvalBootstrapSetup/EvalFuncBootstrapSetup.
+ */
+struct BootstrapConfig {
+    std::vector<uint32_t> levelBudget;  // {encoding, decoding}
+    std::vector<uint32_t> dim1;         // {encoding, decoding}, 0 for the default choice of the setup
+
+    uint32_t numRotationKeys = 0;  // including the conjugation key
+    uint64_t keyMemory       = 0;  // in bytes, for the rotation and conjugation keys
+    double cost              = 0;  // modeled latency of CoeffsToSlots and SlotsToCoeffs, in single tower products
+};
+
+}  // namespace lbcrypto
+
+#endif
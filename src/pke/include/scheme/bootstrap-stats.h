@@ -0,0 +1,216 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2025, CEA-List
+//
+// All rights reserved.
+//
+// Author TPOC: jules.dumezy@cea.fr
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#ifndef LBCRYPTO_INC_SCHEME_BOOTSTRAP_STATS_H
+#define LBCRYPTO_INC_SCHEME_BOOTSTRAP_STATS_H
+
+#include "utils/opcounters.h"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#ifdef BOOTSTRAPTIMING
+    #include <iostream>
+#endif
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lbcrypto {
+
+/**
+ * Accumulated wall time and number of runs of a bootstrapping stage.
+ */
+struct BootstrapStageStats {
+    double time    = 0;  // in milliseconds
+    uint64_t calls = 0;
+};
+
+/**
+ * Statistics of a single bootstrap (EvalBootstrap, EvalFuncBootstrap, EvalFuncMVBootstrap, ...).
+ */
+struct BootstrapRunStats {
+    std::string method;
+    double time          = 0;  // in milliseconds
+    uint64_t keySwitches = 0;
+    uint64_t ntts        = 0;  // single tower NTTs and inverse NTTs
+    uint64_t rescales    = 0;  // dropped levels
+    uint32_t peakTowers  = 0;  // largest number of towers of a ciphertext
+    std::map<std::string, BootstrapStageStats> stages;
+};
+
+/**
+ * Runtime sink for the statistics of (functional) bootstrapping. A sink is attached to a crypto
+ * context with SetBootstrapStats and is filled by every subsequent bootstrap until it is detached.
+ * Stages run in parallel sections (e.g. real and imaginary parts) are accumulated per thread, so the
+ * sum of the stage times can exceed the wall time of the bootstrap.
+ * Runs are keyed by the thread that opened them, so that the ciphertexts of a batch bootstrapped in
+ * parallel are recorded as separate runs. A stage timed on a thread without a run of its own (a worker
+ * of a parallel section) is attributed to the open run if there is a single one.
+ * The operations of a run are counted by an OpCounterSink attached to the thread that opened it, which
+ * also receives the operations of the OpenMP threads of its parallel sections.
+ */
+class BootstrapStats {
+public:
+    void AddStage(const std::string& stage, double time);
+
+    /**
+     * Opens a run for the calling thread, nested runs (e.g. EvalBootstrap iterations) are merged into the
+     * outermost one.
+     */
+    void BeginRun(const std::string& method);
+
+    void EndRun();
+
+    /**
+     * Records the number of towers of a ciphertext of the run of the calling thread.
+     */
+    void UpdatePeakTowers(uint32_t towers);
+
+    std::map<std::string, BootstrapStageStats> GetStages() const;
+
+    /**
+     * Returns the most recent runs, oldest first.
+     */
+    std::vector<BootstrapRunStats> GetRuns() const;
+
+    /**
+     * Sets the number of runs kept, older runs are dropped (the stage totals are kept).
+     */
+    void SetMaxRuns(size_t maxRuns);
+
+    /**
+     * Dumps the stage totals and the runs as a JSON object.
+     */
+    std::string ToJSON() const;
+
+    void Reset();
+
+private:
+    mutable std::mutex m_mutex;
+    std::map<std::string, BootstrapStageStats> m_stages;
+    std::deque<BootstrapRunStats> m_runs;
+    size_t m_maxRuns = 1024;
+
+    struct ActiveRun {
+        uint32_t depth = 0;
+        BootstrapRunStats stats;
+        std::chrono::steady_clock::time_point start;
+        OpCounterSink counters;
+    };
+
+    // the run of the calling thread, or the single open run for a thread without one; null if none applies
+    ActiveRun* FindRun();
+
+    // open runs, by the thread that opened them
+    std::map<std::thread::id, ActiveRun> m_active;
+};
+
+/**
+ * Records the wall time between its construction and its destruction (or Stop()) as a stage of the
+ * sink, if any. Builds with BOOTSTRAPTIMING also print the time of every stage to std::cerr.
+ */
+class BootstrapStageTimer {
+public:
+    BootstrapStageTimer(const std::shared_ptr<BootstrapStats>& stats, const char* stage)
+        : m_stats(stats.get()), m_stage(stage) {
+#ifdef BOOTSTRAPTIMING
+        m_running = true;
+#else
+        m_running = (m_stats != nullptr);
+#endif
+        if (m_running)
+            m_start = std::chrono::steady_clock::now();
+    }
+
+    ~BootstrapStageTimer() {
+        Stop();
+    }
+
+    void Stop() {
+        if (!m_running)
+            return;
+        double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+        if (m_stats)
+            m_stats->AddStage(m_stage, time);
+#ifdef BOOTSTRAPTIMING
+        std::cerr << m_stage << " time: " << time / 1000.0 << " s" << std::endl;
+#endif
+        m_running = false;
+    }
+
+    BootstrapStageTimer(const BootstrapStageTimer&)            = delete;
+    BootstrapStageTimer& operator=(const BootstrapStageTimer&) = delete;
+
+private:
+    BootstrapStats* m_stats;
+    const char* m_stage;
+    bool m_running;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+/**
+ * Records a bootstrap as a run of the sink, if any, for the lifetime of the object.
+ */
+class BootstrapRunRecorder {
+public:
+    BootstrapRunRecorder(const std::shared_ptr<BootstrapStats>& stats, const char* method) : m_stats(stats) {
+        if (m_stats)
+            m_stats->BeginRun(method);
+    }
+
+    ~BootstrapRunRecorder() {
+        if (m_stats)
+            m_stats->EndRun();
+    }
+
+    BootstrapRunRecorder(const BootstrapRunRecorder&)            = delete;
+    BootstrapRunRecorder& operator=(const BootstrapRunRecorder&) = delete;
+
+private:
+    std::shared_ptr<BootstrapStats> m_stats;
+};
+
+/**
+ * Runs func as a stage of the sink, if any, and returns its result.
+ */
+template <typename Func>
+auto TimeBootstrapStage(const std::shared_ptr<BootstrapStats>& stats, const char* stage, Func&& func) -> decltype(func()) {
+    BootstrapStageTimer timer(stats, stage);
+    return func();
+}
+
+}  // namespace lbcrypto
+
+#endif
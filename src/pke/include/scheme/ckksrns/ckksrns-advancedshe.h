@@ -120,10 +120,20 @@ public:
                                              const std::vector<std::complex<double>>& coefficients, double a,
                                              double b) const override;
 
+    std::vector<Ciphertext<DCRTPoly>> EvalChebyshevSeriesMulti(ConstCiphertext<DCRTPoly> ciphertext,
+                                                               const std::vector<std::vector<double>>& coefficients,
+                                                               double a, double b) const override;
+
     Ciphertext<DCRTPoly> EvalChebyshevSeriesLinear(ConstCiphertext<DCRTPoly> ciphertext,
                                                    const std::vector<double>& coefficients, double a,
                                                    double b) const override;
 
+    std::vector<Ciphertext<DCRTPoly>> ComputeChebyshevPolynomialsLinear(ConstCiphertext<DCRTPoly> x, uint32_t k,
+                                                                        double a, double b) const;
+
+    Ciphertext<DCRTPoly> EvalChebyshevSeriesLinear(std::vector<Ciphertext<DCRTPoly>> T,
+                                                   const std::vector<double>& coefficients) const;
+
     Ciphertext<DCRTPoly> EvalChebyshevSeriesLinear(ConstCiphertext<DCRTPoly> ciphertext,
                                                    const std::vector<std::complex<double>>& coefficients, double a,
                                                    double b) const override;
@@ -140,6 +150,14 @@ public:
                                                const std::vector<double>& coefficients, double a,
                                                double b) const override;
 
+    std::vector<std::vector<Ciphertext<DCRTPoly>>> ComputeChebyshevPolynomialsPS(ConstCiphertext<DCRTPoly> x,
+                                                                                 uint32_t n, double a,
+                                                                                 double b) const;
+
+    Ciphertext<DCRTPoly> EvalChebyshevSeriesPS(std::vector<Ciphertext<DCRTPoly>> T,
+                                               std::vector<Ciphertext<DCRTPoly>> T2, Ciphertext<DCRTPoly> T2km1,
+                                               const std::vector<double>& coefficients) const;
+
     Ciphertext<DCRTPoly> EvalChebyshevSeriesPS(ConstCiphertext<DCRTPoly> ciphertext,
                                                const std::vector<std::complex<double>>& coefficients, double a,
                                                double b) const override;
@@ -0,0 +1,109 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2025, CEA-List
+//
+// All rights reserved.
+//
+// Author TPOC: jules.dumezy@cea.fr
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#ifndef LBCRYPTO_CRYPTO_CKKSRNS_DIAGONAL_CACHE_H
+#define LBCRYPTO_CRYPTO_CKKSRNS_DIAGONAL_CACHE_H
+
+#include "encoding/plaintext-fwd.h"
+#include "lattice/lat-hal.h"
+
+#include <complex>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace lbcrypto {
+
+/**
+ * Slot values of a CoeffsToSlots/SlotsToCoeffs diagonal (already rotated and scaled), with the extended
+ * basis and level to encode it with. Kept instead of the encoded plaintext when the diagonals are
+ * generated on the fly: a seed holds slots complex values, the plaintext N * (#towers of P*Q) words.
+ */
+struct CKKSDiagonalSeed {
+    CKKSDiagonalSeed() = default;
+
+    CKKSDiagonalSeed(std::vector<std::complex<double>>&& values, std::shared_ptr<DCRTPoly::Params> params,
+                     uint32_t level);
+
+    std::vector<std::complex<double>> values;
+    std::shared_ptr<DCRTPoly::Params> params;
+    uint32_t level = 0;
+    uint64_t id    = 0;  // unique key of the diagonal in the cache, 0 for an empty seed
+};
+
+/**
+ * Bounded least-recently-used cache of the diagonals encoded from their seeds, shared by all the slot
+ * configurations of a context. It is safe to use from several threads; encodings run outside the lock.
+ */
+class CKKSDiagonalCache {
+public:
+    explicit CKKSDiagonalCache(size_t capacity) : m_capacity(capacity) {}
+
+    /**
+     * Returns the plaintext of the seed, calling encode (and caching its result) on a miss.
+     */
+    ConstPlaintext Get(const CKKSDiagonalSeed& seed, const std::function<ConstPlaintext()>& encode);
+
+    /**
+     * Sets the maximum number of plaintexts kept, the least recently used ones are dropped.
+     */
+    void SetCapacity(size_t capacity);
+
+    size_t GetCapacity() const;
+
+    size_t Size() const;
+
+    uint64_t GetHits() const;
+
+    uint64_t GetMisses() const;
+
+    void Clear();
+
+private:
+    void EvictInternal();
+
+    mutable std::mutex m_mutex;
+    size_t m_capacity;
+    uint64_t m_hits   = 0;
+    uint64_t m_misses = 0;
+    // most recently used first
+    std::list<std::pair<uint64_t, ConstPlaintext>> m_entries;
+    std::unordered_map<uint64_t, std::list<std::pair<uint64_t, ConstPlaintext>>::iterator> m_index;
+};
+
+}  // namespace lbcrypto
+
+#endif
@@ -43,6 +43,7 @@
 #include "encoding/plaintext-fwd.h"
 #include "schemerns/rns-fhe.h"
 #include "scheme/ckksrns/ckksrns-utils.h"
+#include "scheme/ckksrns/ckksrns-diagonal-cache.h"
 #include "utils/caller_info.h"
 #include "math/hal/basicint.h"
 
@@ -72,6 +73,8 @@ public:
         m_U0hatTPre    = rhs.m_U0hatTPre;
         m_U0PreFFT     = rhs.m_U0PreFFT;
         m_U0hatTPreFFT = rhs.m_U0hatTPreFFT;
+        m_U0Seeds      = rhs.m_U0Seeds;
+        m_U0hatTSeeds  = rhs.m_U0hatTSeeds;
     }
 
     CKKSBootstrapPrecom(CKKSBootstrapPrecom&& rhs) {
@@ -83,6 +86,8 @@ public:
         m_U0hatTPre    = std::move(rhs.m_U0hatTPre);
         m_U0PreFFT     = std::move(rhs.m_U0PreFFT);
         m_U0hatTPreFFT = std::move(rhs.m_U0hatTPreFFT);
+        m_U0Seeds      = std::move(rhs.m_U0Seeds);
+        m_U0hatTSeeds  = std::move(rhs.m_U0hatTSeeds);
     }
 
     virtual ~CKKSBootstrapPrecom() {}
@@ -120,6 +125,11 @@ public:
     // coefficients corresponding to conj(U0^T); used in encoding
     std::vector<std::vector<ConstPlaintext>> m_U0hatTPreFFT;
 
+    // seeds of the coefficients corresponding to U0 and conj(U0^T) when they are encoded on the fly;
+    // m_U0PreFFT and m_U0hatTPreFFT then only hold empty levels
+    std::vector<std::vector<CKKSDiagonalSeed>> m_U0Seeds;
+    std::vector<std::vector<CKKSDiagonalSeed>> m_U0hatTSeeds;
+
     template <class Archive>
     void save(Archive& ar) const {
         ar(cereal::make_nvp("dim1_Enc", m_dim1));
@@ -169,12 +179,48 @@ public:
     Ciphertext<DCRTPoly> EvalFuncBootstrap(ConstCiphertext<DCRTPoly> ciphertext, std::function<double(double)> func,
                                            int num_poi, int order) const override;
 
+    Ciphertext<DCRTPoly> EvalFuncBootstrap(ConstCiphertext<DCRTPoly> ciphertext, const HermiteLUT& lut) const override;
+
+    std::vector<Ciphertext<DCRTPoly>> EvalFuncBootstrapBatch(const std::vector<ConstCiphertext<DCRTPoly>>& ciphertexts,
+                                                             std::function<double(double)> func, int num_poi,
+                                                             int order) const override;
+
+    std::vector<Ciphertext<DCRTPoly>> EvalFuncBootstrapBatch(const std::vector<ConstCiphertext<DCRTPoly>>& ciphertexts,
+                                                             const HermiteLUT& lut) const override;
+
     std::vector<Ciphertext<DCRTPoly>> EvalFuncMVBootstrap(ConstCiphertext<DCRTPoly> ciphertext, std::vector<std::function<double(double)>> func_vec,
                                                           int num_poi, int order) const override;
 
+    std::vector<Ciphertext<DCRTPoly>> EvalFuncMVBootstrap(ConstCiphertext<DCRTPoly> ciphertext,
+                                                          const std::vector<HermiteLUT>& luts) const override;
+
+    std::vector<Ciphertext<DCRTPoly>> EvalFuncMultiLUT(ConstCiphertext<DCRTPoly> ciphertext,
+                                                       const std::vector<HermiteLUT>& luts) const override;
+
     Ciphertext<DCRTPoly> EvalFuncSimpleTreeMVB(ConstCiphertext<DCRTPoly> ciphertext, std::function<double(double)> func,
                                                int num_poi, int order) const override;
 
+    std::vector<Ciphertext<DCRTPoly>> EvalFuncTreeMVB(const std::vector<ConstCiphertext<DCRTPoly>>& ciphertexts,
+                                                      std::function<double(double)> func, uint32_t digitBits,
+                                                      uint32_t numDigits) const override;
+
+    void SetBootstrapStats(std::shared_ptr<BootstrapStats> stats) override {
+        m_bootStats = stats;
+    }
+
+    void SetBootstrapDiagonalsOnTheFly(bool onTheFly, uint32_t cacheSize) override;
+
+    void SetBootstrapBSGSCostModel(bool useCostModel) override {
+        m_bsgsCostModel = useCostModel;
+    }
+
+    void SaveBootstrapPrecomputations(const std::string& filename) const override;
+
+    void LoadBootstrapPrecomputations(const CryptoContextImpl<DCRTPoly>& cc, const std::string& filename) override;
+
+    std::vector<BootstrapConfig> TuneBootstrapParameters(const CryptoContextImpl<DCRTPoly>& cc, uint32_t slots,
+                                                         uint32_t depth, uint32_t numThreads) const override;
+
     //------------------------------------------------------------------------------
     // Find Rotation Indices
     //------------------------------------------------------------------------------
@@ -183,6 +229,8 @@ public:
 
     std::vector<int32_t> FindLinearTransformRotationIndices(uint32_t slots, uint32_t M);
 
+    std::vector<uint32_t> FindFuncBootstrapAutomorphismIndices(uint32_t slots, uint32_t M) const override;
+
     std::vector<int32_t> FindCoeffsToSlotsRotationIndices(uint32_t slots, uint32_t M);
 
     std::vector<int32_t> FindSlotsToCoeffsRotationIndices(uint32_t slots, uint32_t M);
@@ -205,13 +253,15 @@ public:
                                                                          const std::vector<std::complex<double>>& A,
                                                                          const std::vector<uint32_t>& rotGroup,
                                                                          bool flag_i, double scale = 1,
-                                                                         uint32_t L = 0) const;
+                                                                         uint32_t L = 0,
+                                                                         std::vector<std::vector<CKKSDiagonalSeed>>* seeds = nullptr) const;
 
     std::vector<std::vector<ConstPlaintext>> EvalSlotsToCoeffsPrecompute(const CryptoContextImpl<DCRTPoly>& cc,
                                                                          const std::vector<std::complex<double>>& A,
                                                                          const std::vector<uint32_t>& rotGroup,
                                                                          bool flag_i, double scale = 1,
-                                                                         uint32_t L = 0) const;
+                                                                         uint32_t L = 0, bool stcFirst = false,
+                                                                         std::vector<std::vector<CKKSDiagonalSeed>>* seeds = nullptr) const;
 
     //------------------------------------------------------------------------------
     // EVALUATION: CoeffsToSlots and SlotsToCoeffs
@@ -257,6 +307,14 @@ private:
     //------------------------------------------------------------------------------
     // Auxiliary Bootstrap Functions
     //------------------------------------------------------------------------------
+    static std::vector<int32_t> FindLinearTransformRotationIndices(uint32_t dim1, uint32_t slots, uint32_t M);
+
+    static std::vector<int32_t> FindCoeffsToSlotsRotationIndices(const std::vector<int32_t>& paramsEnc, uint32_t slots,
+                                                                 uint32_t M);
+
+    static std::vector<int32_t> FindSlotsToCoeffsRotationIndices(const std::vector<int32_t>& paramsDec, uint32_t slots,
+                                                                 uint32_t M);
+
     uint32_t GetBootstrapDepthInternal(uint32_t approxModDepth, const std::vector<uint32_t>& levelBudget,
                                        const CryptoContextImpl<DCRTPoly>& cc);
     static uint32_t GetModDepthInternal(SecretKeyDist secretKeyDist);
@@ -265,16 +323,94 @@ private:
 
     void ApplyDoubleAngleIterations(Ciphertext<DCRTPoly>& ciphertext, uint32_t numIt) const;
 
+    Ciphertext<DCRTPoly> EvalFuncBootstrapInternal(ConstCiphertext<DCRTPoly> ciphertext,
+                                                   const std::shared_ptr<CKKSBootstrapPrecom> precom,
+                                                   const std::vector<std::complex<double>>& coeffExp,
+                                                   const std::vector<std::complex<double>>& coeffLUT, bool isPS,
+                                                   const std::map<usint, EvalKey<DCRTPoly>>& evalKeyMap,
+                                                   double pre) const;
+
+    /**
+   * Evaluates several LUT polynomials on the powers of the same exp-encoded ciphertext, computed once
+   * for the highest degree of the polynomials. If realPart is set, P + conj(P) is returned for each
+   * polynomial P; the shared powers are then conjugated instead of the outputs when it needs fewer key
+   * switches.
+   */
+    std::vector<Ciphertext<DCRTPoly>> EvalFuncLUTs(ConstCiphertext<DCRTPoly> ctxtExp,
+                                                   const std::vector<std::vector<std::complex<double>>>& coeffs,
+                                                   bool realPart) const;
+
+    Ciphertext<DCRTPoly> EvalFuncModRaise(Ciphertext<DCRTPoly> ciphertext, double pre) const;
+
+    Ciphertext<DCRTPoly> EvalFuncSparseCoeffsToSlots(ConstCiphertext<DCRTPoly> ciphertext, double pre) const;
+
+    Ciphertext<DCRTPoly> EvalFuncSparseMerge(ConstCiphertext<DCRTPoly> ciphertext, std::complex<double> factor) const;
+
+    std::vector<Ciphertext<DCRTPoly>> EvalFuncDigitsToSlots(ConstCiphertext<DCRTPoly> ciphertext,
+                                                            const std::shared_ptr<CKKSBootstrapPrecom> precom,
+                                                            double pre) const;
+
     Plaintext MakeAuxPlaintext(const CryptoContextImpl<DCRTPoly>& cc, const std::shared_ptr<ParmType> params,
                                const std::vector<std::complex<double>>& value, size_t noiseScaleDeg, uint32_t level,
                                usint slots) const;
 
+    /**
+   * One level of CoeffsToSlots/SlotsToCoeffs with double hoisting: g baby steps sharing one digit
+   * decomposition of ctxt, and b giant steps accumulated in the extended basis with a single ModDown.
+   *
+   * @param As the diagonals of the level, As[g * i + j] for giant step i and baby step j.
+   * @param rotIn the baby-step rotation indices.
+   * @param rotOut the giant-step rotation indices.
+   * @param numRotations the index of the diagonal skipped in the baby steps.
+   */
+    Ciphertext<DCRTPoly> EvalBSGSLevelExt(ConstCiphertext<DCRTPoly> ctxt, const std::vector<ConstPlaintext>& As,
+                                          const std::vector<int32_t>& rotIn, const std::vector<int32_t>& rotOut,
+                                          int32_t g, int32_t b, int32_t numRotations) const;
+
+    /**
+   * Returns the diagonals of level s of CoeffsToSlots/SlotsToCoeffs: A[s] when they were precomputed,
+   * otherwise buffer, filled from the seeds through the diagonal cache.
+   */
+    const std::vector<ConstPlaintext>& GetTransformDiagonals(const CryptoContextImpl<DCRTPoly>& cc,
+                                                             const std::vector<std::vector<ConstPlaintext>>& A,
+                                                             const std::vector<std::vector<CKKSDiagonalSeed>>& seeds,
+                                                             uint32_t s, std::vector<ConstPlaintext>& buffer) const;
+
+    /**
+   * Estimates the cost of an outer rotation of CoeffsToSlots/SlotsToCoeffs relative to an inner (hoisted)
+   * one, used to select the baby-step giant-step dimensions that are not set.
+   */
+    double GetBSGSOuterCost(const CryptoContextImpl<DCRTPoly>& cc) const;
+
+    // GetBSGSOuterCost under SetBootstrapBSGSCostModel, 0 for the default heuristic otherwise
+    double GetSetupOuterCost(const CryptoContextImpl<DCRTPoly>& cc) const {
+        return m_bsgsCostModel ? GetBSGSOuterCost(cc) : 0;
+    }
+
     Ciphertext<DCRTPoly> EvalMultExt(ConstCiphertext<DCRTPoly> ciphertext, ConstPlaintext plaintext) const;
 
     void EvalAddExtInPlace(Ciphertext<DCRTPoly>& ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2) const;
 
+    /**
+   * Sum of the products of ciphertexts in the extended basis by plaintexts, e.g., the baby steps of
+   * CoeffsToSlots/SlotsToCoeffs, accumulated with lazy reduction.
+   */
+    Ciphertext<DCRTPoly> EvalMultSumExt(const std::vector<ConstCiphertext<DCRTPoly>>& ciphertexts,
+                                        const std::vector<ConstPlaintext>& plaintexts) const;
+
     Ciphertext<DCRTPoly> EvalAddExt(ConstCiphertext<DCRTPoly> ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2) const;
 
+    /**
+   * Rotates a ciphertext of the extended basis P*Q and keeps the result in P*Q (double hoisting): only the
+   * second element is brought down to Q for its digit decomposition, the first one is permuted in P*Q.
+   *
+   * @param ciphertext the ciphertext in the extended basis.
+   * @param index the rotation index.
+   * @param paramsQl the parameters of Q at the level of the ciphertext.
+   */
+    Ciphertext<DCRTPoly> EvalRotateExt(ConstCiphertext<DCRTPoly> ciphertext, int32_t index,
+                                       const std::shared_ptr<ParmType>& paramsQl) const;
+
     EvalKey<DCRTPoly> ConjugateKeyGen(const PrivateKey<DCRTPoly> privateKey) const;
 
     Ciphertext<DCRTPoly> Conjugate(ConstCiphertext<DCRTPoly> ciphertext,
@@ -311,11 +447,24 @@ private:
         3;  // number of double-angle iterations in CKKS bootstrapping. Must be static because it is used in a static function.
     static const uint32_t R_FUNC = 
         4; // number of double-angle iterations in CKKS functional bootstrapping
+    static const uint32_t MAX_TREE_LUTS = 1024;  // upper bound for the number of digit LUTs of a tree evaluation
     uint32_t m_correctionFactor = 0;  // correction factor, which we scale the message by to improve precision
 
     // key tuple is dim1, levelBudgetEnc, levelBudgetDec
     std::map<uint32_t, std::shared_ptr<CKKSBootstrapPrecom>> m_bootPrecomMap;
 
+    // per-stage timings of the bootstraps, not recorded if null
+    std::shared_ptr<BootstrapStats> m_bootStats;
+
+    // whether the CoeffsToSlots/SlotsToCoeffs diagonals of the next precomputations are kept as seeds
+    bool m_diagOnTheFly = false;
+
+    // whether the unset baby-step giant-step dimensions of the next setups are selected by the cost model
+    bool m_bsgsCostModel = false;
+
+    // diagonals encoded from their seeds, kept between bootstraps
+    std::shared_ptr<CKKSDiagonalCache> m_diagCache;
+
     // Chebyshev series coefficients for the SPARSE case
     static const inline std::vector<double> g_coefficientsSparse{
         -0.18646470117093214,   0.036680543700430925,    -0.20323558926782626,     0.029327390306199311,
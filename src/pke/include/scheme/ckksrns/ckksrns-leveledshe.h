@@ -119,6 +119,9 @@ public:
     void EvalMultInPlace(Ciphertext<DCRTPoly>& ciphertext, double operand) const override;
     void EvalMultInPlace(Ciphertext<DCRTPoly>& ciphertext, std::complex<double> operand) const override;
 
+    Ciphertext<DCRTPoly> EvalLinearWSumCore(const std::vector<Ciphertext<DCRTPoly>>& ciphertexts,
+                                            const std::vector<double>& constants) const override;
+
     Ciphertext<DCRTPoly> MultByInteger(ConstCiphertext<DCRTPoly> ciphertext, uint64_t integer) const override;
 
     void MultByIntegerInPlace(Ciphertext<DCRTPoly>& ciphertext, uint64_t integer) const override;
@@ -118,6 +118,7 @@ std::vector<uint32_t> ComputeDegreesPS(const uint32_t n);
  * @return multiplicative depth
  */
 uint32_t GetMultiplicativeDepthByCoeffVector(const std::vector<double>& vec, bool isNormalized = false);
+uint32_t GetMultiplicativeDepthByCoeffVector(const std::vector<std::complex<double>>& vec, bool isNormalized = false);
 
 /**
  * Extracts shifted diagonal of matrix A.
@@ -227,9 +228,25 @@ std::vector<uint32_t> SelectLayers(uint32_t logSlots, uint32_t budget = 4);
  * @param slots number of slots
  * @param levelBudget the allocated level budget for the computation.
  * @param dim1 the value for the inner dimension in the baby-step giant-step strategy
+ * @param outerCost cost of an outer rotation relative to an inner one, see SelectBSGSDim. When
+ * positive, it selects the inner dimensions left unset instead of the fixed heuristic.
  * @return vector with parameters for the homomorphic encoding and decoding in bootstrapping
  */
-std::vector<int32_t> GetCollapsedFFTParams(uint32_t slots, uint32_t levelBudget = 4, uint32_t dim1 = 0);
+std::vector<int32_t> GetCollapsedFFTParams(uint32_t slots, uint32_t levelBudget = 4, uint32_t dim1 = 0,
+                                           double outerCost = 0);
+
+/**
+ * Selects the inner dimension g of the baby-step giant-step strategy of one collapsed level of the
+ * homomorphic encoding/decoding. With double hoisting, the g - 1 inner rotations share one digit
+ * decomposition and only cost a key switching inner product, while each of the (numRotations + 1) / g - 1
+ * outer rotations also needs a ModDown and a digit decomposition. The numRotations plaintext
+ * multiplications do not depend on g.
+ *
+ * @param numRotations number of rotations of the collapsed level.
+ * @param outerCost cost of an outer rotation relative to an inner one.
+ * @return the power of two g minimizing the cost of the rotations.
+ */
+uint32_t SelectBSGSDim(uint32_t numRotations, double outerCost);
 
 /**
  *  Gets inner loop dimension for baby step giant step algorithm for linear transform,
@@ -0,0 +1,142 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2025, CEA-List
+//
+// All rights reserved.
+//
+// Author TPOC: jules.dumezy@cea.fr
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#ifndef LBCRYPTO_INC_SCHEME_HERMITE_LUT_H
+#define LBCRYPTO_INC_SCHEME_HERMITE_LUT_H
+
+#include "utils/exception.h"
+#include "utils/serial.h"
+
+#include "cereal/types/complex.hpp"
+
+#include <complex>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace lbcrypto {
+
+/**
+ * Precompiled LUT for functional bootstrapping: the Hermite interpolation coefficients of a function
+ * together with the way they are evaluated. It only depends on the function, the number of points
+ * of interest and the interpolation order, so it can be built once, serialized and reused with any
+ * crypto context.
+ */
+class HermiteLUT {
+public:
+    HermiteLUT() = default;
+
+    /**
+   * Computes the Hermite interpolation coefficients of func on the points 0, ..., numPoints - 1.
+   *
+   * @param func the function to interpolate
+   * @param numPoints the number of points of interest (size of the LUT domain)
+   * @param order order of the Hermite interpolation, between 1 and 3
+   */
+    HermiteLUT(std::function<double(double)> func, uint32_t numPoints, uint32_t order = 1);
+
+    const std::vector<std::complex<double>>& GetCoefficients() const {
+        return m_coefficients;
+    }
+
+    uint32_t GetNumPoints() const {
+        return m_numPoints;
+    }
+
+    uint32_t GetOrder() const {
+        return m_order;
+    }
+
+    uint32_t GetDegree() const {
+        return m_degree;
+    }
+
+    /**
+   * @return true if the polynomial is evaluated with Paterson-Stockmeyer, false for the linear method
+   */
+    bool IsPS() const {
+        return m_isPS;
+    }
+
+    /**
+   * @return the multiplicative depth of the polynomial evaluation
+   */
+    uint32_t GetDepth() const {
+        return m_depth;
+    }
+
+    template <class Archive>
+    void save(Archive& ar, std::uint32_t const version) const {
+        ar(cereal::make_nvp("c", m_coefficients));
+        ar(cereal::make_nvp("p", m_numPoints));
+        ar(cereal::make_nvp("o", m_order));
+        ar(cereal::make_nvp("d", m_degree));
+        ar(cereal::make_nvp("ps", m_isPS));
+        ar(cereal::make_nvp("dp", m_depth));
+    }
+
+    template <class Archive>
+    void load(Archive& ar, std::uint32_t const version) {
+        if (version > SerializedVersion()) {
+            OPENFHE_THROW("serialized object version " + std::to_string(version) +
+                          " is from a later version of the library");
+        }
+        ar(cereal::make_nvp("c", m_coefficients));
+        ar(cereal::make_nvp("p", m_numPoints));
+        ar(cereal::make_nvp("o", m_order));
+        ar(cereal::make_nvp("d", m_degree));
+        ar(cereal::make_nvp("ps", m_isPS));
+        ar(cereal::make_nvp("dp", m_depth));
+    }
+
+    std::string SerializedObjectName() const {
+        return "HermiteLUT";
+    }
+
+    static uint32_t SerializedVersion() {
+        return 1;
+    }
+
+private:
+    std::vector<std::complex<double>> m_coefficients;
+    uint32_t m_numPoints = 0;
+    uint32_t m_order     = 0;
+    uint32_t m_degree    = 0;
+    bool m_isPS          = false;
+    uint32_t m_depth     = 0;
+};
+
+}  // namespace lbcrypto
+
+CEREAL_CLASS_VERSION(lbcrypto::HermiteLUT, lbcrypto::HermiteLUT::SerializedVersion());
+
+#endif
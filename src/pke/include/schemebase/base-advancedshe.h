@@ -243,6 +243,23 @@ public:
         OPENFHE_THROW("EvalChebyshevSeries is not supported for the scheme.");
     }
 
+    /**
+   * Evaluates several Chebyshev series on the same input; the Chebyshev polynomials
+   * T_i(y), with y = -1 + 2 (x-a)/(b-a), are computed once for the largest degree and
+   * shared by all the series.
+   *
+   * @param &cipherText input ciphertext
+   * @param &coefficients vector of Chebyshev expansions, one per output
+   * @param a - lower bound of argument for which the coefficients were found
+   * @param b - upper bound of argument for which the coefficients were found
+   * @return the results of the evaluations, in the order of the series.
+   */
+    virtual std::vector<Ciphertext<Element>> EvalChebyshevSeriesMulti(ConstCiphertext<Element> ciphertext,
+                                                                      const std::vector<std::vector<double>>& coefficients,
+                                                                      double a, double b) const {
+        OPENFHE_THROW("EvalChebyshevSeriesMulti is not supported for the scheme.");
+    }
+
     virtual Ciphertext<Element> EvalChebyshevSeriesLinear(ConstCiphertext<Element> ciphertext,
                                                           const std::vector<double>& coefficients, double a,
                                                           double b) const {
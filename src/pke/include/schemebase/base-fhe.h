@@ -48,6 +48,9 @@
 #include "binfhecontext.h"
 #include "key/keypair.h"
 #include "scheme/scheme-swch-params.h"
+#include "scheme/hermite-lut.h"
+#include "scheme/bootstrap-stats.h"
+#include "scheme/bootstrap-config.h"
 
 #include <memory>
 #include <vector>
@@ -151,16 +154,76 @@ public:
         OPENFHE_THROW("EvalFuncBootstrap is not implemented for this scheme");
     }
 
+    virtual Ciphertext<Element> EvalFuncBootstrap(ConstCiphertext<Element> ciphertext, const HermiteLUT& lut) const {
+        OPENFHE_THROW("EvalFuncBootstrap is not implemented for this scheme");
+    }
+
+    virtual std::vector<Ciphertext<Element>> EvalFuncBootstrapBatch(const std::vector<ConstCiphertext<Element>>& ciphertexts,
+                                                                    std::function<double(double)> func, int num_poi,
+                                                                    int order) const {
+        OPENFHE_THROW("EvalFuncBootstrapBatch is not implemented for this scheme");
+    }
+
+    virtual std::vector<Ciphertext<Element>> EvalFuncBootstrapBatch(const std::vector<ConstCiphertext<Element>>& ciphertexts,
+                                                                    const HermiteLUT& lut) const {
+        OPENFHE_THROW("EvalFuncBootstrapBatch is not implemented for this scheme");
+    }
+
     virtual std::vector<Ciphertext<Element>> EvalFuncMVBootstrap(ConstCiphertext<Element> ciphertext, std::vector<std::function<double(double)>> func_vec,
                                                                  int num_poi, int order) const {
         OPENFHE_THROW("EvalFuncMVBootstrap is not implemented for this scheme");
     }
 
+    virtual std::vector<Ciphertext<Element>> EvalFuncMVBootstrap(ConstCiphertext<Element> ciphertext,
+                                                                 const std::vector<HermiteLUT>& luts) const {
+        OPENFHE_THROW("EvalFuncMVBootstrap is not implemented for this scheme");
+    }
+
+    virtual std::vector<Ciphertext<Element>> EvalFuncMultiLUT(ConstCiphertext<Element> ciphertext,
+                                                              const std::vector<HermiteLUT>& luts) const {
+        OPENFHE_THROW("EvalFuncMultiLUT is not implemented for this scheme");
+    }
+
     virtual Ciphertext<DCRTPoly> EvalFuncSimpleTreeMVB(ConstCiphertext<DCRTPoly> ciphertext, std::function<double(double)> func,
                                                        int num_poi, int order) const {
         OPENFHE_THROW("EvalFuncSimpleTreeMVB is not implemented for this scheme");
     }
 
+    virtual std::vector<Ciphertext<DCRTPoly>> EvalFuncTreeMVB(const std::vector<ConstCiphertext<DCRTPoly>>& ciphertexts,
+                                                              std::function<double(double)> func, uint32_t digitBits,
+                                                              uint32_t numDigits) const {
+        OPENFHE_THROW("EvalFuncTreeMVB is not implemented for this scheme");
+    }
+
+    virtual void SetBootstrapStats(std::shared_ptr<BootstrapStats> stats) {
+        OPENFHE_THROW("SetBootstrapStats is not implemented for this scheme");
+    }
+
+    virtual void SetBootstrapDiagonalsOnTheFly(bool onTheFly, uint32_t cacheSize) {
+        OPENFHE_THROW("SetBootstrapDiagonalsOnTheFly is not implemented for this scheme");
+    }
+
+    virtual void SetBootstrapBSGSCostModel(bool useCostModel) {
+        OPENFHE_THROW("SetBootstrapBSGSCostModel is not implemented for this scheme");
+    }
+
+    virtual void SaveBootstrapPrecomputations(const std::string& filename) const {
+        OPENFHE_THROW("SaveBootstrapPrecomputations is not implemented for this scheme");
+    }
+
+    virtual void LoadBootstrapPrecomputations(const CryptoContextImpl<Element>& cc, const std::string& filename) {
+        OPENFHE_THROW("LoadBootstrapPrecomputations is not implemented for this scheme");
+    }
+
+    virtual std::vector<uint32_t> FindFuncBootstrapAutomorphismIndices(uint32_t slots, uint32_t M) const {
+        OPENFHE_THROW("FindFuncBootstrapAutomorphismIndices is not implemented for this scheme");
+    }
+
+    virtual std::vector<BootstrapConfig> TuneBootstrapParameters(const CryptoContextImpl<Element>& cc, uint32_t slots,
+                                                                 uint32_t depth, uint32_t numThreads) const {
+        OPENFHE_THROW("TuneBootstrapParameters is not implemented for this scheme");
+    }
+
     /**
    * Sets all parameters for switching from CKKS to FHEW
    *
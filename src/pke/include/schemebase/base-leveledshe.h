@@ -466,6 +466,19 @@ public:
         OPENFHE_THROW("double scalar multiplication is not implemented for this scheme");
     }
 
+    /**
+   * Virtual function for the weighted sum of ciphertexts with the same level, depth and number of elements, without
+   * rescaling. The products by the weights are accumulated before they are reduced.
+   *
+   * @param ciphertexts the input ciphertexts.
+   * @param constants the weights.
+   * @return the weighted sum, with the depth of the products.
+   */
+    virtual Ciphertext<Element> EvalLinearWSumCore(const std::vector<Ciphertext<Element>>& ciphertexts,
+                                                   const std::vector<double>& constants) const {
+        OPENFHE_THROW("EvalLinearWSumCore is not implemented for this scheme");
+    }
+
     virtual Ciphertext<DCRTPoly> MultByInteger(ConstCiphertext<DCRTPoly> ciphertext, uint64_t integer) const {
         OPENFHE_THROW("MultByInteger is not implemented for this scheme");
     }
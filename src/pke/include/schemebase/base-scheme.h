@@ -911,6 +911,12 @@ public:
         return;
     }
 
+    virtual Ciphertext<Element> EvalLinearWSumCore(const std::vector<Ciphertext<Element>>& ciphertexts,
+                                                   const std::vector<double>& constants) const {
+        VerifyLeveledSHEEnabled(__func__);
+        return m_LeveledSHE->EvalLinearWSumCore(ciphertexts, constants);
+    }
+
     virtual Ciphertext<DCRTPoly> MultByInteger(ConstCiphertext<DCRTPoly> ciphertext, uint64_t integer) const {
         VerifyLeveledSHEEnabled(__func__);
         if (!ciphertext)
@@ -1343,6 +1349,15 @@ public:
         return m_AdvancedSHE->EvalChebyshevSeries(ciphertext, coefficients, a, b);
     }
 
+    std::vector<Ciphertext<Element>> EvalChebyshevSeriesMulti(ConstCiphertext<Element> ciphertext,
+                                                              const std::vector<std::vector<double>>& coefficients,
+                                                              double a, double b) const {
+        VerifyAdvancedSHEEnabled(__func__);
+        if (!ciphertext)
+            OPENFHE_THROW("Input ciphertext is nullptr");
+        return m_AdvancedSHE->EvalChebyshevSeriesMulti(ciphertext, coefficients, a, b);
+    }
+
     Ciphertext<Element> EvalChebyshevSeriesLinear(ConstCiphertext<Element> ciphertext,
                                                   const std::vector<double>& coefficients, double a, double b) const {
         VerifyAdvancedSHEEnabled(__func__);
@@ -1621,18 +1636,93 @@ public:
         return m_FHE->EvalFuncBootstrap(ciphertext, func, num_poi, order);
     }
 
+    Ciphertext<Element> EvalFuncBootstrap(ConstCiphertext<Element> ciphertext, const HermiteLUT& lut) const {
+        VerifyFHEEnabled(__func__);
+        return m_FHE->EvalFuncBootstrap(ciphertext, lut);
+    }
+
+    std::vector<Ciphertext<Element>> EvalFuncBootstrapBatch(const std::vector<ConstCiphertext<Element>>& ciphertexts,
+                                                            std::function<double(double)> func, int num_poi,
+                                                            int order) const {
+        VerifyFHEEnabled(__func__);
+        return m_FHE->EvalFuncBootstrapBatch(ciphertexts, func, num_poi, order);
+    }
+
+    std::vector<Ciphertext<Element>> EvalFuncBootstrapBatch(const std::vector<ConstCiphertext<Element>>& ciphertexts,
+                                                            const HermiteLUT& lut) const {
+        VerifyFHEEnabled(__func__);
+        return m_FHE->EvalFuncBootstrapBatch(ciphertexts, lut);
+    }
+
     std::vector<Ciphertext<Element>> EvalFuncMVBootstrap(ConstCiphertext<Element> ciphertext, std::vector<std::function<double(double)>> func_vec,
                                                          int num_poi, int order) const {
         VerifyFHEEnabled(__func__);
         return m_FHE->EvalFuncMVBootstrap(ciphertext, func_vec, num_poi, order);
     }
 
+    std::vector<Ciphertext<Element>> EvalFuncMVBootstrap(ConstCiphertext<Element> ciphertext,
+                                                         const std::vector<HermiteLUT>& luts) const {
+        VerifyFHEEnabled(__func__);
+        return m_FHE->EvalFuncMVBootstrap(ciphertext, luts);
+    }
+
+    std::vector<Ciphertext<Element>> EvalFuncMultiLUT(ConstCiphertext<Element> ciphertext,
+                                                      const std::vector<HermiteLUT>& luts) const {
+        VerifyFHEEnabled(__func__);
+        if (!ciphertext)
+            OPENFHE_THROW("Input ciphertext is nullptr");
+        return m_FHE->EvalFuncMultiLUT(ciphertext, luts);
+    }
+
     Ciphertext<DCRTPoly> EvalFuncSimpleTreeMVB(ConstCiphertext<DCRTPoly> ciphertext, std::function<double(double)> func,
                                                int num_poi, int order) const {
         VerifyFHEEnabled(__func__);
         return m_FHE->EvalFuncSimpleTreeMVB(ciphertext, func, num_poi, order);
     }
 
+    std::vector<Ciphertext<DCRTPoly>> EvalFuncTreeMVB(const std::vector<ConstCiphertext<DCRTPoly>>& ciphertexts,
+                                                      std::function<double(double)> func, uint32_t digitBits,
+                                                      uint32_t numDigits) const {
+        VerifyFHEEnabled(__func__);
+        return m_FHE->EvalFuncTreeMVB(ciphertexts, func, digitBits, numDigits);
+    }
+
+    void SetBootstrapStats(std::shared_ptr<BootstrapStats> stats) {
+        VerifyFHEEnabled(__func__);
+        m_FHE->SetBootstrapStats(stats);
+    }
+
+    void SetBootstrapDiagonalsOnTheFly(bool onTheFly, uint32_t cacheSize) {
+        VerifyFHEEnabled(__func__);
+        m_FHE->SetBootstrapDiagonalsOnTheFly(onTheFly, cacheSize);
+    }
+
+    void SetBootstrapBSGSCostModel(bool useCostModel) {
+        VerifyFHEEnabled(__func__);
+        m_FHE->SetBootstrapBSGSCostModel(useCostModel);
+    }
+
+    void SaveBootstrapPrecomputations(const std::string& filename) const {
+        VerifyFHEEnabled(__func__);
+        m_FHE->SaveBootstrapPrecomputations(filename);
+    }
+
+    void LoadBootstrapPrecomputations(const CryptoContextImpl<Element>& cc, const std::string& filename) {
+        VerifyFHEEnabled(__func__);
+        m_FHE->LoadBootstrapPrecomputations(cc, filename);
+    }
+
+    std::vector<uint32_t> FindFuncBootstrapAutomorphismIndices(uint32_t slots, uint32_t M) const {
+        VerifyFHEEnabled(__func__);
+        return m_FHE->FindFuncBootstrapAutomorphismIndices(slots, M);
+    }
+
+    std::vector<BootstrapConfig> TuneBootstrapParameters(const CryptoContextImpl<Element>& cc, uint32_t slots,
+                                                         uint32_t depth, uint32_t numThreads) const {
+        VerifyFHEEnabled(__func__);
+        return m_FHE->TuneBootstrapParameters(cc, slots, depth, numThreads);
+    }
+
     // SCHEMESWITCHING methods
 
     LWEPrivateKey EvalCKKStoFHEWSetup(const SchSwchParams& params) {
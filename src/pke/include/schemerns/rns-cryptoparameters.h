@@ -558,6 +558,16 @@ public:
         return m_modqBarrettMu;
     }
 
+    /**
+   * Gets the Barrett modulo reduction precomputation for the towers of QP, used by the lazy
+   * inner products of HYBRID key switching
+   *
+   * @return the precomputed table
+   */
+    const std::vector<DoubleNativeInt>& GetModQPBarrettMu() const {
+        return m_modQPBarrettMu;
+    }
+
     /**
    * Method that returns the precomputed values for [t^(-1)]_{q_i}
    * Used in ModulusSwitching.
@@ -1460,6 +1470,9 @@ protected:
     // Stores the BarrettUint128ModUint64 precomputations for q_j
     std::vector<DoubleNativeInt> m_modqBarrettMu;
 
+    // Stores the BarrettUint128ModUint64 precomputations for the towers of QP
+    std::vector<DoubleNativeInt> m_modQPBarrettMu;
+
     // Stores [t^{-1}]_{p_j}
     std::vector<NativeInteger> m_tInvModp;
 
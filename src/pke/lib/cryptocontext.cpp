@@ -42,6 +42,7 @@
 
 #include "cryptocontext.h"
 
+#include "key/evalkeystore.h"
 #include "key/privatekey.h"
 #include "key/publickey.h"
 #include "math/chebyshev.h"
@@ -534,6 +535,16 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalChebyshevFunction(std::funct
     return EvalChebyshevSeries(ciphertext, coefficients, a, b);
 }
 
+template <typename Element>
+std::vector<Ciphertext<Element>> CryptoContextImpl<Element>::EvalChebyshevFunctionMulti(
+    const std::vector<std::function<double(double)>>& funcs, ConstCiphertext<Element> ciphertext, double a, double b,
+    uint32_t degree) const {
+    std::vector<std::vector<double>> coefficients(funcs.size());
+    for (size_t i = 0; i < funcs.size(); i++)
+        coefficients[i] = EvalChebyshevCoefficients(funcs[i], a, b, degree);
+    return EvalChebyshevSeriesMulti(ciphertext, coefficients, a, b);
+}
+
 template <typename Element>
 Ciphertext<Element> CryptoContextImpl<Element>::EvalSin(ConstCiphertext<Element> ciphertext, double a, double b,
                                                         uint32_t degree) const {
@@ -570,22 +581,7 @@ template <typename Element>
 Ciphertext<Element> CryptoContextImpl<Element>::EvalHermiteFunction(std::function<double(double)> func,
                                                                     ConstCiphertext<Element> ciphertext,
                                                                     int p, int order) const {
-  std::vector<std::complex<double>> coefficients;
-
-  switch (order) {
-    case 1:
-      coefficients = hermiteInterpOrder1Coeff(func, p);
-      break;
-    case 2:
-      coefficients = hermiteInterpOrder2Coeff(func, p);
-      break;
-    case 3:
-      coefficients = hermiteInterpOrder3Coeff(func, p);
-      break;
-    default:
-      OPENFHE_THROW("Order of Hermite interpolation must be between 1 and 3");
-      break;
-  }
+  auto coefficients = hermiteInterpCoeff(func, p, order);
 
   return EvalPoly(ciphertext, coefficients);
 }
@@ -944,6 +940,27 @@ void CryptoContextImpl<DCRTPoly>::RecoverSharedKey(PrivateKey<DCRTPoly>& sk,
     }
 }
 
+template <>
+void CryptoContextImpl<DCRTPoly>::SaveEvalAutomorphismKeyStore(const std::string& filename,
+                                                               const std::string& keyTag) {
+    EvalKeyStore::Save(filename, CryptoContextImpl<DCRTPoly>::GetEvalAutomorphismKeyMap(keyTag), keyTag);
+}
+
+template <>
+std::shared_ptr<EvalKeyStore> CryptoContextImpl<DCRTPoly>::LoadEvalAutomorphismKeyStore(const std::string& filename,
+                                                                                         uint64_t memoryBudget,
+                                                                                         bool useMmap) {
+    const auto cc = GetContextForPointer(this);
+    auto store    = std::make_shared<EvalKeyStore>(cc, filename, memoryBudget, useMmap);
+
+    auto keyMap = std::make_shared<std::map<usint, EvalKey<DCRTPoly>>>();
+    for (uint32_t index : store->GetIndices())
+        (*keyMap)[index] = std::make_shared<EvalKeyStoredImpl>(cc, store, index);
+    CryptoContextImpl<DCRTPoly>::InsertEvalAutomorphismKey(keyMap, store->GetKeyTag());
+
+    return store;
+}
+
 template class CryptoContextImpl<DCRTPoly>;
 
 }  // namespace lbcrypto
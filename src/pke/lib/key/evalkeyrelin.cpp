@@ -30,8 +30,136 @@
 //==================================================================================
 #include "cryptocontext.h"
 #include "key/evalkeyrelin.h"
+#include "schemerns/rns-cryptoparameters.h"
+#include "utils/prng/blake2engine.h"
+
+#include <algorithm>
 
 // the code below is from evalkeyrelin-impl.cpp
 namespace lbcrypto {
 template class EvalKeyRelinImpl<DCRTPoly>;
+
+template <>
+std::vector<DCRTPoly> ExpandEvalKeySeed(const CryptoContext<DCRTPoly> cc, const std::vector<uint32_t>& seed) {
+    if (seed.size() != EVAL_KEY_SEED_SIZE)
+        OPENFHE_THROW("The seed of an evaluation key should have " + std::to_string(EVAL_KEY_SEED_SIZE) + " words");
+
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(cc->GetCryptoParameters());
+    const auto paramsQP     = cryptoParams->GetParamsQP();
+
+    uint32_t numPartQ = cryptoParams->GetNumPartQ();
+    uint32_t sizeQP   = paramsQP->GetParams().size();
+    uint32_t N        = paramsQP->GetRingDimension();
+
+    using IntType = NativeInteger::Integer;
+    constexpr uint32_t intBits = sizeof(IntType) * 8;
+
+    std::vector<DCRTPoly> av(numPartQ, DCRTPoly(paramsQP, Format::EVALUATION, true));
+
+#pragma omp parallel for collapse(2)
+    for (uint32_t part = 0; part < numPartQ; ++part) {
+        for (uint32_t i = 0; i < sizeQP; ++i) {
+            // the stream of a tower is keyed by the seed, the digit and the tower index
+            default_prng::Blake2Engine::blake2_seed_array_t key{};
+            std::copy(seed.begin(), seed.end(), key.begin());
+            key[EVAL_KEY_SEED_SIZE]     = part;
+            key[EVAL_KEY_SEED_SIZE + 1] = i;
+            default_prng::Blake2Engine gen(key, 0);
+
+            const auto& params   = paramsQP->GetParams()[i];
+            const IntType q      = params->GetModulus().ConvertToInt<IntType>();
+            const uint32_t qBits = params->GetModulus().GetMSB();
+            const IntType mask   = (qBits >= intBits) ? ~IntType(0) : ((IntType(1) << qBits) - 1);
+
+            // rejection sampling of values below q
+            NativeVector values(N, params->GetModulus());
+            for (uint32_t k = 0; k < N; ++k) {
+                IntType x;
+                do {
+                    x = 0;
+                    for (uint32_t w = 0; w < qBits; w += 32)
+                        x = (x << 32) | gen();
+                    x &= mask;
+                } while (x >= q);
+                values[k] = x;
+            }
+
+            NativePoly tower(params, Format::EVALUATION, true);
+            tower.SetValues(std::move(values), Format::EVALUATION);
+            av[part].SetElementAtIndex(i, std::move(tower));
+        }
+    }
+
+    return av;
+}
+
+template <>
+std::shared_ptr<const EvalKeyPacked> PackEvalKey(const CryptoContext<DCRTPoly> cc, const std::vector<DCRTPoly>& av,
+                                                 const std::vector<DCRTPoly>& bv) {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(cc->GetCryptoParameters());
+    if (cryptoParams == nullptr || cryptoParams->GetKeySwitchTechnique() != HYBRID || bv.empty() ||
+        av.size() != bv.size())
+        return nullptr;
+    for (const auto* polys : {&av, &bv}) {
+        for (const auto& poly : *polys) {
+            if (poly.GetFormat() != Format::EVALUATION || poly.GetNumOfElements() != bv[0].GetNumOfElements())
+                return nullptr;
+        }
+    }
+
+    auto packed       = std::make_shared<EvalKeyPacked>();
+    packed->numDigits = bv.size();
+    packed->ringDim   = bv[0].GetRingDimension();
+    packed->params    = bv[0].GetParams();
+
+    uint32_t numDigits = packed->numDigits;
+    uint32_t ringDim   = packed->ringDim;
+    uint32_t numTowers = bv[0].GetNumOfElements();
+    packed->towers.resize(numTowers);
+
+#pragma omp parallel for
+    for (uint32_t i = 0; i < numTowers; ++i) {
+        auto& tower = packed->towers[i];
+        tower.resize(2 * size_t(numDigits) * ringDim);
+        for (uint32_t j = 0; j < numDigits; ++j) {
+            const NativeVector& b = bv[j].GetElementAtIndex(i).GetValues();
+            const NativeVector& a = av[j].GetElementAtIndex(i).GetValues();
+            for (uint32_t k = 0; k < ringDim; ++k) {
+                tower[2 * (size_t(k) * numDigits + j)]     = b[k].ConvertToInt<NativeInteger::Integer>();
+                tower[2 * (size_t(k) * numDigits + j) + 1] = a[k].ConvertToInt<NativeInteger::Integer>();
+            }
+        }
+    }
+
+    return packed;
+}
+
+template <>
+void UnpackEvalKey(const EvalKeyPacked& packed, std::vector<DCRTPoly>* av, std::vector<DCRTPoly>* bv) {
+    uint32_t numDigits = packed.numDigits;
+    uint32_t ringDim   = packed.ringDim;
+    const auto& towers = packed.params->GetParams();
+
+    av->assign(numDigits, DCRTPoly(packed.params, Format::EVALUATION, false));
+    bv->assign(numDigits, DCRTPoly(packed.params, Format::EVALUATION, false));
+
+#pragma omp parallel for
+    for (uint32_t i = 0; i < towers.size(); ++i) {
+        const auto& tower = packed.towers[i];
+        for (uint32_t j = 0; j < numDigits; ++j) {
+            NativeVector b(ringDim, towers[i]->GetModulus());
+            NativeVector a(ringDim, towers[i]->GetModulus());
+            for (uint32_t k = 0; k < ringDim; ++k) {
+                b[k] = NativeInteger(tower[2 * (size_t(k) * numDigits + j)]);
+                a[k] = NativeInteger(tower[2 * (size_t(k) * numDigits + j) + 1]);
+            }
+            NativePoly bj(towers[i], Format::EVALUATION);
+            bj.SetValues(std::move(b), Format::EVALUATION);
+            (*bv)[j].SetElementAtIndex(i, std::move(bj));
+            NativePoly aj(towers[i], Format::EVALUATION);
+            aj.SetValues(std::move(a), Format::EVALUATION);
+            (*av)[j].SetElementAtIndex(i, std::move(aj));
+        }
+    }
+}
 }  // namespace lbcrypto
@@ -0,0 +1,456 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2025, CEA-List
+//
+// All rights reserved.
+//
+// Author TPOC: jules.dumezy@cea.fr
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#include "key/evalkeystore.h"
+#include "cryptocontext.h"
+#include "schemerns/rns-cryptoparameters.h"
+#include "utils/exception.h"
+
+#include <cstring>
+
+namespace lbcrypto {
+
+namespace {
+
+// All the fields are written in the native byte order. The header holds the magic, the version, the
+// size of a tower word, the ring dimension, the size of the header, the key tag and the table of the
+// keys: automorphism index, offset and size. Each key holds its number of digits, a seed flag and the
+// seed if set, then its "a" polynomials (unless seeded) and its "b" polynomials. Each polynomial holds
+// its number of towers, their moduli and their values in EVALUATION format.
+constexpr char KEYSTORE_MAGIC[8]    = {'O', 'F', 'H', 'E', 'E', 'V', 'K', 'S'};
+constexpr uint32_t KEYSTORE_VERSION = 1;
+// magic, version, word size, ring dimension and header size
+constexpr size_t KEYSTORE_PREFIX_SIZE = sizeof(KEYSTORE_MAGIC) + 3 * sizeof(uint32_t) + sizeof(uint64_t);
+
+using KeyWord = NativeInteger::Integer;
+
+class KeyReader {
+public:
+    KeyReader(const char* data, size_t size, const std::string& filename)
+        : m_data(data), m_size(size), m_filename(filename) {}
+
+    template <typename T>
+    T Read() {
+        T value;
+        std::memcpy(&value, Skip(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    // returns the current position and moves past the next numBytes bytes
+    const char* Skip(size_t numBytes) {
+        if (numBytes > m_size - m_pos)
+            OPENFHE_THROW("Error deserializing from " + m_filename + ": unexpected end of file");
+        const char* ptr = m_data + m_pos;
+        m_pos += numBytes;
+        return ptr;
+    }
+
+private:
+    const char* m_data;
+    size_t m_size;
+    size_t m_pos = 0;
+    std::string m_filename;
+};
+
+template <typename T>
+void WriteValue(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void WritePolys(std::ofstream& out, const std::vector<DCRTPoly>& polys) {
+    std::vector<KeyWord> buffer;
+    for (const auto& poly : polys) {
+        if (poly.GetFormat() != Format::EVALUATION)
+            OPENFHE_THROW("Evaluation keys are expected in EVALUATION format");
+        uint32_t numTowers = poly.GetNumOfElements();
+        WriteValue(out, numTowers);
+        for (uint32_t i = 0; i < numTowers; i++)
+            WriteValue(out, poly.GetElementAtIndex(i).GetModulus().ConvertToInt<KeyWord>());
+        for (uint32_t i = 0; i < numTowers; i++) {
+            const NativeVector& values = poly.GetElementAtIndex(i).GetValues();
+            buffer.resize(values.GetLength());
+            for (size_t j = 0; j < buffer.size(); j++)
+                buffer[j] = values[j].ConvertToInt<KeyWord>();
+            out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(KeyWord));
+        }
+    }
+}
+
+// tower of a loaded key whose values are copied in a second, parallel pass
+struct KeyTowerJob {
+    DCRTPoly* poly;
+    uint32_t tower;
+    const char* values;
+};
+
+}  // namespace
+
+void EvalKeyStore::Save(const std::string& filename, const std::map<uint32_t, EvalKey<DCRTPoly>>& keyMap,
+                        const std::string& keyTag) {
+    if (keyMap.empty())
+        OPENFHE_THROW("There are no automorphism keys to save for ID [" + keyTag + "].");
+
+    std::ofstream out(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+        OPENFHE_THROW("Can not open " + filename);
+
+    uint32_t ringDim    = keyMap.begin()->second->GetCryptoContext()->GetRingDimension();
+    uint64_t headerSize = KEYSTORE_PREFIX_SIZE + sizeof(uint32_t) + keyTag.size() + sizeof(uint32_t) +
+                          keyMap.size() * (sizeof(uint32_t) + 2 * sizeof(uint64_t));
+
+    out.write(KEYSTORE_MAGIC, sizeof(KEYSTORE_MAGIC));
+    WriteValue(out, KEYSTORE_VERSION);
+    WriteValue(out, static_cast<uint32_t>(sizeof(KeyWord)));
+    WriteValue(out, ringDim);
+    WriteValue(out, headerSize);
+    WriteValue(out, static_cast<uint32_t>(keyTag.size()));
+    out.write(keyTag.data(), keyTag.size());
+    WriteValue(out, static_cast<uint32_t>(keyMap.size()));
+    // the table is written once the offsets of the keys are known
+    auto tablePos = out.tellp();
+    out.seekp(headerSize);
+
+    std::vector<std::pair<uint64_t, uint64_t>> table;
+    uint64_t offset = headerSize;
+    for (const auto& [index, evalKey] : keyMap) {
+        auto key = std::dynamic_pointer_cast<EvalKeyRelinImpl<DCRTPoly>>(ResolveEvalKey(evalKey));
+        if (key == nullptr)
+            OPENFHE_THROW("Only relinearization keys can be saved to a key store");
+
+        // a packed key is unpacked in temporaries rather than in place, and a key not packed yet is left as it is
+        std::vector<DCRTPoly> unpackedA;
+        std::vector<DCRTPoly> unpackedB;
+        const auto packed = key->IsPacked() ? key->GetPackedKey() : nullptr;
+        if (packed != nullptr)
+            UnpackEvalKey(*packed, &unpackedA, &unpackedB);
+        const auto& seed = key->GetAVectorSeed();
+        const auto& bv   = (packed != nullptr) ? unpackedB : key->GetBVector();
+
+        WriteValue(out, static_cast<uint32_t>(bv.size()));
+        WriteValue(out, static_cast<uint8_t>(!seed.empty()));
+        if (!seed.empty())
+            out.write(reinterpret_cast<const char*>(seed.data()), seed.size() * sizeof(uint32_t));
+        else
+            WritePolys(out, (packed != nullptr) ? unpackedA : key->GetAVector());
+        WritePolys(out, bv);
+
+        uint64_t end = static_cast<uint64_t>(out.tellp());
+        table.emplace_back(offset, end - offset);
+        offset = end;
+    }
+
+    out.seekp(tablePos);
+    auto entry = table.begin();
+    for (const auto& [index, evalKey] : keyMap) {
+        WriteValue(out, index);
+        WriteValue(out, entry->first);
+        WriteValue(out, entry->second);
+        ++entry;
+    }
+
+    out.close();
+    if (!out)
+        OPENFHE_THROW("Error serializing to " + filename);
+}
+
+EvalKeyStore::EvalKeyStore(const CryptoContext<DCRTPoly> cc, const std::string& filename, uint64_t memoryBudget,
+                           bool useMmap)
+    : m_cc(cc), m_filename(filename), m_memoryBudget(memoryBudget) {
+    // the header is read in memory in both modes
+    std::vector<char> header;
+    const char* headerData;
+    if (useMmap) {
+        m_mappedFile = std::make_unique<MappedFile>(filename);
+        headerData   = m_mappedFile->Data();
+        if (m_mappedFile->Size() < KEYSTORE_PREFIX_SIZE)
+            OPENFHE_THROW(filename + " does not hold evaluation keys");
+    }
+    else {
+        m_in.open(filename, std::ios::in | std::ios::binary);
+        if (!m_in.is_open())
+            OPENFHE_THROW("Can not open " + filename);
+        header.resize(KEYSTORE_PREFIX_SIZE);
+        m_in.read(header.data(), header.size());
+        if (!m_in)
+            OPENFHE_THROW(filename + " does not hold evaluation keys");
+        headerData = header.data();
+    }
+
+    KeyReader prefix(headerData, KEYSTORE_PREFIX_SIZE, filename);
+    if (std::memcmp(prefix.Skip(sizeof(KEYSTORE_MAGIC)), KEYSTORE_MAGIC, sizeof(KEYSTORE_MAGIC)) != 0)
+        OPENFHE_THROW(filename + " does not hold evaluation keys");
+    if (prefix.Read<uint32_t>() != KEYSTORE_VERSION)
+        OPENFHE_THROW("Unsupported version of the evaluation keys in " + filename);
+    if (prefix.Read<uint32_t>() != sizeof(KeyWord))
+        OPENFHE_THROW(filename + " was written with a different native integer size");
+    uint32_t ringDim = prefix.Read<uint32_t>();
+    if (ringDim != cc->GetRingDimension())
+        OPENFHE_THROW(filename + " was written for ring dimension " + std::to_string(ringDim) + " instead of " +
+                      std::to_string(cc->GetRingDimension()));
+    uint64_t headerSize = prefix.Read<uint64_t>();
+
+    if (useMmap) {
+        if (headerSize > m_mappedFile->Size())
+            OPENFHE_THROW("Error deserializing from " + filename + ": unexpected end of file");
+    }
+    else {
+        header.resize(headerSize);
+        m_in.read(header.data() + KEYSTORE_PREFIX_SIZE, headerSize - KEYSTORE_PREFIX_SIZE);
+        if (!m_in)
+            OPENFHE_THROW("Error deserializing from " + filename + ": unexpected end of file");
+        headerData = header.data();
+    }
+
+    KeyReader reader(headerData, headerSize, filename);
+    reader.Skip(KEYSTORE_PREFIX_SIZE);
+    uint32_t tagSize = reader.Read<uint32_t>();
+    m_keyTag.assign(reader.Skip(tagSize), tagSize);
+    uint32_t numKeys = reader.Read<uint32_t>();
+    for (uint32_t k = 0; k < numKeys; k++) {
+        uint32_t index = reader.Read<uint32_t>();
+        Entry& entry   = m_entries[index];
+        entry.offset   = reader.Read<uint64_t>();
+        entry.size     = reader.Read<uint64_t>();
+        if (useMmap && (entry.offset > m_mappedFile->Size() || entry.size > m_mappedFile->Size() - entry.offset))
+            OPENFHE_THROW("Error deserializing from " + filename + ": unexpected end of file");
+    }
+
+    // the towers of the keys are among the ones of Q and P
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(cc->GetCryptoParameters());
+    for (const auto& params : cryptoParams->GetElementParams()->GetParams())
+        m_towerParams[params->GetModulus().ConvertToInt<KeyWord>()] = params;
+    if (cryptoParams->GetParamsP() != nullptr) {
+        for (const auto& params : cryptoParams->GetParamsP()->GetParams())
+            m_towerParams[params->GetModulus().ConvertToInt<KeyWord>()] = params;
+    }
+    // keys in basis QP or Q share the parameters of the crypto context
+    for (const auto& params : {cryptoParams->GetParamsQP(), cryptoParams->GetElementParams()}) {
+        if (params == nullptr)
+            continue;
+        std::vector<KeyWord> moduli;
+        for (const auto& tower : params->GetParams())
+            moduli.push_back(tower->GetModulus().ConvertToInt<KeyWord>());
+        m_params[moduli] = params;
+    }
+}
+
+std::vector<uint32_t> EvalKeyStore::GetIndices() const {
+    std::vector<uint32_t> indices;
+    indices.reserve(m_entries.size());
+    for (const auto& entry : m_entries)
+        indices.push_back(entry.first);
+    return indices;
+}
+
+EvalKey<DCRTPoly> EvalKeyStore::GetKey(uint32_t index) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(index);
+    if (it == m_entries.end())
+        OPENFHE_THROW("EvalKey for index [" + std::to_string(index) + "] is not in " + m_filename);
+    Entry& entry = it->second;
+    if (entry.key != nullptr) {
+        m_lru.splice(m_lru.begin(), m_lru, entry.lru);
+        return entry.key;
+    }
+
+    // other threads can use the store while the key is read
+    lock.unlock();
+    auto key = Load(entry);
+    lock.lock();
+
+    m_numLoads++;
+    if (entry.key != nullptr) {
+        // loaded meanwhile by another thread
+        m_lru.splice(m_lru.begin(), m_lru, entry.lru);
+        return entry.key;
+    }
+    entry.key = key;
+    m_lru.push_front(index);
+    entry.lru = m_lru.begin();
+    Evict();
+    return key;
+}
+
+void EvalKeyStore::SetMemoryBudget(uint64_t memoryBudget) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_memoryBudget = memoryBudget;
+    Evict();
+}
+
+uint64_t EvalKeyStore::GetMemoryBudget() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_memoryBudget;
+}
+
+uint64_t EvalKeyStore::GetResidentMemory() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return ResidentMemory();
+}
+
+uint64_t EvalKeyStore::GetNumLoads() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numLoads;
+}
+
+void EvalKeyStore::Release() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (uint32_t index : m_lru)
+        m_entries[index].key = nullptr;
+    m_lru.clear();
+}
+
+uint64_t EvalKeyStore::KeyMemory(const EvalKey<DCRTPoly>& key) {
+    return std::static_pointer_cast<EvalKeyRelinImpl<DCRTPoly>>(key)->GetResidentMemory();
+}
+
+uint64_t EvalKeyStore::ResidentMemory() const {
+    uint64_t memory = 0;
+    for (uint32_t index : m_lru)
+        memory += KeyMemory(m_entries.at(index).key);
+    return memory;
+}
+
+void EvalKeyStore::Evict() {
+    if (m_memoryBudget == 0)
+        return;
+    uint64_t memory = ResidentMemory();
+    while (memory > m_memoryBudget && m_lru.size() > 1) {
+        Entry& entry = m_entries[m_lru.back()];
+        memory -= KeyMemory(entry.key);
+        entry.key = nullptr;
+        m_lru.pop_back();
+    }
+}
+
+std::shared_ptr<DCRTPoly::Params> EvalKeyStore::GetParams(const std::vector<KeyWord>& moduli) {
+    std::lock_guard<std::mutex> lock(m_paramsMutex);
+    auto& params = m_params[moduli];
+    if (params == nullptr) {
+        std::vector<std::shared_ptr<ILNativeParams>> towers;
+        for (const auto& modulus : moduli) {
+            auto it = m_towerParams.find(modulus);
+            if (it == m_towerParams.end())
+                OPENFHE_THROW(m_filename + " was not written for the parameters of this crypto context");
+            towers.push_back(it->second);
+        }
+        params = std::make_shared<DCRTPoly::Params>(m_cc->GetCyclotomicOrder(), towers);
+    }
+    return params;
+}
+
+EvalKey<DCRTPoly> EvalKeyStore::Load(const Entry& entry) {
+    std::vector<char> buffer;
+    const char* data;
+    if (m_mappedFile != nullptr) {
+        data = m_mappedFile->Data() + entry.offset;
+    }
+    else {
+        buffer.resize(entry.size);
+        std::lock_guard<std::mutex> lock(m_inMutex);
+        m_in.seekg(entry.offset);
+        m_in.read(buffer.data(), entry.size);
+        if (!m_in)
+            OPENFHE_THROW("Error deserializing from " + m_filename + ": unexpected end of file");
+        data = buffer.data();
+    }
+
+    KeyReader reader(data, entry.size, m_filename);
+    uint32_t numParts = reader.Read<uint32_t>();
+    bool seeded       = reader.Read<uint8_t>() != 0;
+    std::vector<uint32_t> seed;
+    if (seeded) {
+        seed.resize(EVAL_KEY_SEED_SIZE);
+        std::memcpy(seed.data(), reader.Skip(seed.size() * sizeof(uint32_t)), seed.size() * sizeof(uint32_t));
+    }
+
+    uint32_t ringDim = m_cc->GetRingDimension();
+    std::vector<DCRTPoly> av(seeded ? 0 : numParts);
+    std::vector<DCRTPoly> bv(numParts);
+    std::vector<KeyTowerJob> jobs;
+    auto readPolys = [&](std::vector<DCRTPoly>& polys) {
+        for (auto& poly : polys) {
+            std::vector<KeyWord> moduli(reader.Read<uint32_t>());
+            for (auto& modulus : moduli)
+                modulus = reader.Read<KeyWord>();
+            poly               = DCRTPoly(GetParams(moduli), Format::EVALUATION, false);
+            const char* values = reader.Skip(moduli.size() * ringDim * sizeof(KeyWord));
+            for (uint32_t i = 0; i < moduli.size(); i++)
+                jobs.push_back({&poly, i, values + i * ringDim * sizeof(KeyWord)});
+        }
+    };
+    readPolys(av);
+    readPolys(bv);
+
+#pragma omp parallel for
+    for (size_t k = 0; k < jobs.size(); k++) {
+        const auto& job    = jobs[k];
+        const auto& params = job.poly->GetParams()->GetParams()[job.tower];
+        const char* values = job.values;
+        NativeVector vec(ringDim, params->GetModulus());
+        for (uint32_t j = 0; j < ringDim; j++, values += sizeof(KeyWord)) {
+            KeyWord word;
+            std::memcpy(&word, values, sizeof(KeyWord));
+            vec[j] = NativeInteger(word);
+        }
+        NativePoly tower(params, Format::EVALUATION);
+        tower.SetValues(std::move(vec), Format::EVALUATION);
+        job.poly->SetElementAtIndex(job.tower, std::move(tower));
+    }
+
+    auto key = std::make_shared<EvalKeyRelinImpl<DCRTPoly>>(m_cc);
+    key->SetAVector(std::move(av));
+    key->SetBVector(std::move(bv));
+    if (seeded)
+        key->SetAVectorSeed(seed);
+    key->SetKeyTag(m_keyTag);
+    // a seeded key is only packed, and its "a" polynomials expanded, by its first key switching
+    key->Pack();
+    return key;
+}
+
+// keys read directly through the stand-ins by each thread
+static thread_local std::vector<EvalKey<DCRTPoly>> t_pinned;
+
+const EvalKey<DCRTPoly>& EvalKeyStoredImpl::Pin() const {
+    auto key = Load();
+    for (const auto& pinned : t_pinned) {
+        if (pinned == key)
+            return pinned;
+    }
+    t_pinned.push_back(std::move(key));
+    return t_pinned.back();
+}
+
+void EvalKeyStoredImpl::DropPinned() {
+    t_pinned.clear();
+}
+
+}  // namespace lbcrypto
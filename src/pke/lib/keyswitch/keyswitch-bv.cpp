@@ -45,6 +45,7 @@
 #include "key/evalkeyrelin.h"
 #include "schemerns/rns-cryptoparameters.h"
 #include "cryptocontext.h"
+#include "utils/opcounters.h"
 
 namespace lbcrypto {
 
@@ -313,6 +314,8 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchBV::EvalKeySwitchPrecomputeCore(
 std::shared_ptr<std::vector<DCRTPoly>> KeySwitchBV::EvalFastKeySwitchCore(
     const std::shared_ptr<std::vector<DCRTPoly>> digits, const EvalKey<DCRTPoly> evalKey,
     const std::shared_ptr<ParmType> paramsQl) const {
+    OpCounters::Add(KEYSWITCH_COUNTER);
+
     std::vector<DCRTPoly> bv(evalKey->GetBVector());
     std::vector<DCRTPoly> av(evalKey->GetAVector());
 
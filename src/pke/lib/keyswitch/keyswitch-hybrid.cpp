@@ -42,6 +42,10 @@
 #include "key/evalkeyrelin.h"
 #include "scheme/ckksrns/ckksrns-cryptoparameters.h"
 #include "ciphertext.h"
+#include "math/distributiongenerator.h"
+#include "utils/opcounters.h"
+#include "utils/parallel.h"
+#include "utils/utilities-int.h"
 
 namespace lbcrypto {
 
@@ -89,19 +93,30 @@ EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGenInternal(const PrivateKey<DCRTPol
 
     const auto ns      = cryptoParams->GetNoiseScale();
     const DggType& dgg = cryptoParams->GetDiscreteGaussianGenerator();
-    DugType dug;
 
     size_t numPartQ = cryptoParams->GetNumPartQ();
 
-    std::vector<DCRTPoly> av(numPartQ);
+    // single-key HE: the uniform "a" polynomials are expanded from a seed, which is all the key keeps of them;
+    // threshold HE: they are the ones of the previous key
+    std::vector<uint32_t> seed;
+    std::vector<DCRTPoly> av;
+    if (ekPrev == nullptr) {
+        seed.resize(EVAL_KEY_SEED_SIZE);
+        auto& prng = PseudoRandomNumberGenerator::GetPRNG();
+        for (auto& word : seed)
+            word = prng();
+        av = ExpandEvalKeySeed(newKey->GetCryptoContext(), seed);
+    }
+    else {
+        av = ekPrev->GetAVector();
+    }
     std::vector<DCRTPoly> bv(numPartQ);
 
     std::vector<NativeInteger> PModq = cryptoParams->GetPModq();
     size_t numPerPartQ               = cryptoParams->GetNumPerPartQ();
 
     for (size_t part = 0; part < numPartQ; ++part) {
-        DCRTPoly a = (ekPrev == nullptr) ? DCRTPoly(dug, paramsQP, Format::EVALUATION) :  // single-key HE
-                                           ekPrev->GetAVector()[part];                                      // threshold HE
+        const DCRTPoly& a = av[part];
         DCRTPoly e(dgg, paramsQP, Format::EVALUATION);
         DCRTPoly b(paramsQP, Format::EVALUATION, true);
 
@@ -124,13 +139,16 @@ EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGenInternal(const PrivateKey<DCRTPol
             }
         }
 
-        av[part] = a;
         bv[part] = b;
     }
 
+    // the key is packed from the "a" polynomials at hand, the seed is only kept for serialization
     ek->SetAVector(std::move(av));
     ek->SetBVector(std::move(bv));
     ek->SetKeyTag(newKey->GetKeyTag());
+    ek->Pack();
+    if (!seed.empty())
+        ek->SetAVectorSeed(seed);
     return ek;
 }
 
@@ -205,6 +223,7 @@ EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGenInternal(const PrivateKey<DCRTPol
     ek->SetAVector(std::move(av));
     ek->SetBVector(std::move(bv));
     ek->SetKeyTag(newKey->GetKeyTag());
+    ek->Pack();
 
     return ek;
 }
@@ -377,35 +396,34 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalKeySwitchPrecomputeC
         }
     }
 
-    std::vector<DCRTPoly> partsCtCompl(numPartQl);
     std::vector<DCRTPoly> partsCtExt(numPartQl);
 
     for (uint32_t part = 0; part < numPartQl; part++) {
-        auto partCtClone = partsCt[part].Clone();
-        partCtClone.SetFormat(Format::COEFFICIENT);
-
+        // the basis extension takes the digit in EVALUATION format and returns the complement towers in
+        // EVALUATION format, with the NTTs done in the same pass over each tower
         uint32_t sizePartQl = partsCt[part].GetNumOfElements();
-        partsCtCompl[part]  = partCtClone.ApproxSwitchCRTBasis(
-             cryptoParams->GetParamsPartQ(part), cryptoParams->GetParamsComplPartQ(sizeQl - 1, part),
-             cryptoParams->GetPartQlHatInvModq(part, sizePartQl - 1),
-             cryptoParams->GetPartQlHatInvModqPrecon(part, sizePartQl - 1),
-             cryptoParams->GetPartQlHatModp(sizeQl - 1, part),
-             cryptoParams->GetmodComplPartqBarrettMu(sizeQl - 1, part));
-
-        partsCtCompl[part].SetFormat(Format::EVALUATION);
-
-        partsCtExt[part] = DCRTPoly(paramsQlP, Format::EVALUATION, true);
-
+        auto partCtCompl    = partsCt[part].ApproxSwitchCRTBasisEval(
+            cryptoParams->GetParamsPartQ(part), cryptoParams->GetParamsComplPartQ(sizeQl - 1, part),
+            cryptoParams->GetPartQlHatInvModq(part, sizePartQl - 1),
+            cryptoParams->GetPartQlHatInvModqPrecon(part, sizePartQl - 1),
+            cryptoParams->GetPartQlHatModp(sizeQl - 1, part),
+            cryptoParams->GetmodComplPartqBarrettMu(sizeQl - 1, part));
+
+        // the towers are moved into place rather than copied
+        partsCtExt[part] = DCRTPoly(paramsQlP, Format::EVALUATION, false);
+
+        auto& complTowers  = partCtCompl.GetAllElements();
+        auto& digitTowers  = partsCt[part].GetAllElements();
         usint startPartIdx = alpha * part;
         usint endPartIdx   = startPartIdx + sizePartQl;
         for (usint i = 0; i < startPartIdx; i++) {
-            partsCtExt[part].SetElementAtIndex(i, partsCtCompl[part].GetElementAtIndex(i));
+            partsCtExt[part].SetElementAtIndex(i, std::move(complTowers[i]));
         }
         for (usint i = startPartIdx, idx = 0; i < endPartIdx; i++, idx++) {
-            partsCtExt[part].SetElementAtIndex(i, partsCt[part].GetElementAtIndex(idx));
+            partsCtExt[part].SetElementAtIndex(i, std::move(digitTowers[idx]));
         }
         for (usint i = endPartIdx; i < sizeQlP; ++i) {
-            partsCtExt[part].SetElementAtIndex(i, partsCtCompl[part].GetElementAtIndex(i - sizePartQl));
+            partsCtExt[part].SetElementAtIndex(i, std::move(complTowers[i - sizePartQl]));
         }
     }
 
@@ -439,9 +457,9 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCore(
 std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCoreExt(
     const std::shared_ptr<std::vector<DCRTPoly>> digits, const EvalKey<DCRTPoly> evalKey,
     const std::shared_ptr<ParmType> paramsQl) const {
-    const auto cryptoParams         = std::dynamic_pointer_cast<CryptoParametersRNS>(evalKey->GetCryptoParameters());
-    const std::vector<DCRTPoly>& bv = evalKey->GetBVector();
-    const std::vector<DCRTPoly>& av = evalKey->GetAVector();
+    OpCounters::Add(KEYSWITCH_COUNTER);
+
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(evalKey->GetCryptoParameters());
 
     const std::shared_ptr<ParmType> paramsP   = cryptoParams->GetParamsP();
     const std::shared_ptr<ParmType> paramsQlP = (*digits)[0].GetParams();
@@ -450,6 +468,79 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCoreExt
     size_t sizeQlP = paramsQlP->GetParams().size();
     size_t sizeQ   = cryptoParams->GetElementParams()->GetParams().size();
 
+#if defined(HAVE_INT128) && NATIVEINT == 64
+    // The inner products over the digits are accumulated in 128 bits and reduced once per coefficient,
+    // from the packed layout of the key if available
+    const auto packed               = evalKey->GetPackedKey();
+    const auto& modQPBarrettMu      = cryptoParams->GetModQPBarrettMu();
+    const std::vector<DCRTPoly>* bv = (packed == nullptr) ? &evalKey->GetBVector() : nullptr;
+    const std::vector<DCRTPoly>* av = (packed == nullptr) ? &evalKey->GetAVector() : nullptr;
+
+    uint32_t numDigits = digits->size();
+    uint32_t ringDim   = paramsQlP->GetRingDimension();
+
+    DCRTPoly cTilda0(paramsQlP, Format::EVALUATION, false);
+    DCRTPoly cTilda1(paramsQlP, Format::EVALUATION, false);
+
+    #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQlP))
+    for (usint i = 0; i < sizeQlP; i++) {
+        // the towers of P follow the ones of Q in the key
+        usint idx                 = (i < sizeQl) ? i : i - sizeQl + sizeQ;
+        const auto& params        = paramsQlP->GetParams()[i];
+        const uint64_t q          = params->GetModulus().ConvertToInt<uint64_t>();
+        const DoubleNativeInt& mu = modQPBarrettMu[idx];
+
+        std::vector<const NativeVector*> cj(numDigits);
+        for (uint32_t j = 0; j < numDigits; j++)
+            cj[j] = &(*digits)[j].GetElementAtIndex(i).GetValues();
+
+        NativeVector sum0(ringDim, params->GetModulus());
+        NativeVector sum1(ringDim, params->GetModulus());
+        if (packed != nullptr) {
+            const auto* key = packed->towers[idx].data();
+            for (uint32_t k = 0; k < ringDim; k++, key += 2 * packed->numDigits) {
+                DoubleNativeInt acc0 = 0;
+                DoubleNativeInt acc1 = 0;
+                for (uint32_t j = 0; j < numDigits; j++) {
+                    uint64_t cjk = (*cj[j])[k].ConvertToInt<uint64_t>();
+                    acc0 += Mul128(cjk, key[2 * j]);
+                    acc1 += Mul128(cjk, key[2 * j + 1]);
+                }
+                sum0[k] = NativeInteger(BarrettUint128ModUint64(acc0, q, mu));
+                sum1[k] = NativeInteger(BarrettUint128ModUint64(acc1, q, mu));
+            }
+        }
+        else {
+            std::vector<const NativeVector*> bj(numDigits);
+            std::vector<const NativeVector*> aj(numDigits);
+            for (uint32_t j = 0; j < numDigits; j++) {
+                bj[j] = &(*bv)[j].GetElementAtIndex(idx).GetValues();
+                aj[j] = &(*av)[j].GetElementAtIndex(idx).GetValues();
+            }
+            for (uint32_t k = 0; k < ringDim; k++) {
+                DoubleNativeInt acc0 = 0;
+                DoubleNativeInt acc1 = 0;
+                for (uint32_t j = 0; j < numDigits; j++) {
+                    uint64_t cjk = (*cj[j])[k].ConvertToInt<uint64_t>();
+                    acc0 += Mul128(cjk, (*bj[j])[k].ConvertToInt<uint64_t>());
+                    acc1 += Mul128(cjk, (*aj[j])[k].ConvertToInt<uint64_t>());
+                }
+                sum0[k] = NativeInteger(BarrettUint128ModUint64(acc0, q, mu));
+                sum1[k] = NativeInteger(BarrettUint128ModUint64(acc1, q, mu));
+            }
+        }
+
+        NativePoly cTilda0i(params, Format::EVALUATION);
+        cTilda0i.SetValues(std::move(sum0), Format::EVALUATION);
+        cTilda0.SetElementAtIndex(i, std::move(cTilda0i));
+        NativePoly cTilda1i(params, Format::EVALUATION);
+        cTilda1i.SetValues(std::move(sum1), Format::EVALUATION);
+        cTilda1.SetElementAtIndex(i, std::move(cTilda1i));
+    }
+#else
+    const std::vector<DCRTPoly>& bv = evalKey->GetBVector();
+    const std::vector<DCRTPoly>& av = evalKey->GetAVector();
+
     DCRTPoly cTilda0(paramsQlP, Format::EVALUATION, true);
     DCRTPoly cTilda1(paramsQlP, Format::EVALUATION, true);
 
@@ -475,6 +566,7 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCoreExt
             cTilda1.SetElementAtIndex(i, cTilda1.GetElementAtIndex(i) + cji * aji);
         }
     }
+#endif
 
     return std::make_shared<std::vector<DCRTPoly>>(
         std::initializer_list<DCRTPoly>{std::move(cTilda0), std::move(cTilda1)});
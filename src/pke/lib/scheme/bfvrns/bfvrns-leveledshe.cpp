@@ -41,6 +41,7 @@ BFV implementation. See https://eprint.iacr.org/2021/204 for details.
 #include "schemebase/base-scheme.h"
 #include "cryptocontext.h"
 #include "ciphertext.h"
+#include "key/evalkeystore.h"
 
 namespace lbcrypto {
 
@@ -762,7 +763,7 @@ Ciphertext<DCRTPoly> LeveledSHEBFVRNS::EvalAutomorphism(ConstCiphertext<DCRTPoly
     PrecomputeAutoMap(N, i, &vec);
 
     auto result = ciphertext->Clone();
-    RelinearizeCore(result, evalKeyMap.at(i));
+    RelinearizeCore(result, ResolveEvalKey(evalKeyMap.at(i)));
 
     auto& rcv = result->GetElements();
     rcv[0]    = rcv[0].AutomorphismTransform(i, vec);
@@ -821,7 +822,7 @@ Ciphertext<DCRTPoly> LeveledSHEBFVRNS::EvalFastRotation(ConstCiphertext<DCRTPoly
     if (evalKeyIterator == evalKeyMap.end()) {
         OPENFHE_THROW("EvalKey for index [" + std::to_string(autoIndex) + "] is not found.");
     }
-    auto evalKey = evalKeyIterator->second;
+    auto evalKey = ResolveEvalKey(evalKeyIterator->second);
 
     auto algo                       = cc->GetScheme();
     const std::vector<DCRTPoly>& cv = ciphertext->GetElements();
@@ -863,9 +864,8 @@ Ciphertext<DCRTPoly> LeveledSHEBFVRNS::EvalFastRotation(ConstCiphertext<DCRTPoly
     std::vector<uint32_t> vec(N);
     PrecomputeAutoMap(N, autoIndex, &vec);
 
-    (*ba)[0] += cv[0];
-
-    (*ba)[0] = (*ba)[0].AutomorphismTransform(autoIndex, vec);
+    // the addition of c0 is done in the same pass as the permutation
+    (*ba)[0] = (*ba)[0].AutomorphismTransformOfSum(cv[0], autoIndex, vec);
     (*ba)[1] = (*ba)[1].AutomorphismTransform(autoIndex, vec);
 
     Ciphertext<DCRTPoly> result = ciphertext->Clone();
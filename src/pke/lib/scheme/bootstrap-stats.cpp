@@ -0,0 +1,153 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2025, CEA-List
+//
+// All rights reserved.
+//
+// Author TPOC: jules.dumezy@cea.fr
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#include "scheme/bootstrap-stats.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace lbcrypto {
+
+namespace {
+
+void StagesToJSON(std::ostream& os, const std::map<std::string, BootstrapStageStats>& stages) {
+    os << "{";
+    bool first = true;
+    for (const auto& stage : stages) {
+        if (!first)
+            os << ",";
+        first = false;
+        os << "\"" << stage.first << "\":{\"time_ms\":" << stage.second.time << ",\"calls\":" << stage.second.calls
+           << "}";
+    }
+    os << "}";
+}
+
+}  // namespace
+
+BootstrapStats::ActiveRun* BootstrapStats::FindRun() {
+    auto it = m_active.find(std::this_thread::get_id());
+    if (it != m_active.end())
+        return &it->second;
+    return (m_active.size() == 1) ? &m_active.begin()->second : nullptr;
+}
+
+void BootstrapStats::AddStage(const std::string& stage, double time) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& stats = m_stages[stage];
+    stats.time += time;
+    stats.calls++;
+    if (auto run = FindRun()) {
+        auto& runStats = run->stats.stages[stage];
+        runStats.time += time;
+        runStats.calls++;
+    }
+}
+
+void BootstrapStats::BeginRun(const std::string& method) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& run = m_active[std::this_thread::get_id()];
+    if (run.depth++ > 0)
+        return;
+    run.stats.method = method;
+    OpCounters::Attach(&run.counters);
+    run.start = std::chrono::steady_clock::now();
+}
+
+void BootstrapStats::EndRun() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_active.find(std::this_thread::get_id());
+    if (it == m_active.end() || --it->second.depth > 0)
+        return;
+    auto& run             = it->second;
+    auto elapsed          = std::chrono::steady_clock::now() - run.start;
+    run.stats.time        = std::chrono::duration<double, std::milli>(elapsed).count();
+    OpCounters::Detach(&run.counters);
+    run.stats.ntts        = run.counters.Get(NTT_COUNTER);
+    run.stats.keySwitches = run.counters.Get(KEYSWITCH_COUNTER);
+    run.stats.rescales    = run.counters.Get(RESCALE_COUNTER);
+
+    m_runs.push_back(std::move(run.stats));
+    m_active.erase(it);
+    while (m_runs.size() > m_maxRuns)
+        m_runs.pop_front();
+}
+
+void BootstrapStats::UpdatePeakTowers(uint32_t towers) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (auto run = FindRun())
+        run->stats.peakTowers = std::max(run->stats.peakTowers, towers);
+}
+
+std::map<std::string, BootstrapStageStats> BootstrapStats::GetStages() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stages;
+}
+
+std::vector<BootstrapRunStats> BootstrapStats::GetRuns() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::vector<BootstrapRunStats>(m_runs.begin(), m_runs.end());
+}
+
+void BootstrapStats::SetMaxRuns(size_t maxRuns) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxRuns = maxRuns;
+    while (m_runs.size() > m_maxRuns)
+        m_runs.pop_front();
+}
+
+std::string BootstrapStats::ToJSON() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::ostringstream os;
+    os << "{\"stages\":";
+    StagesToJSON(os, m_stages);
+    os << ",\"runs\":[";
+    for (size_t i = 0; i < m_runs.size(); ++i) {
+        const auto& run = m_runs[i];
+        if (i > 0)
+            os << ",";
+        os << "{\"method\":\"" << run.method << "\",\"time_ms\":" << run.time << ",\"key_switches\":" << run.keySwitches
+           << ",\"ntts\":" << run.ntts << ",\"rescales\":" << run.rescales << ",\"peak_towers\":" << run.peakTowers
+           << ",\"stages\":";
+        StagesToJSON(os, run.stages);
+        os << "}";
+    }
+    os << "]}";
+    return os.str();
+}
+
+void BootstrapStats::Reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stages.clear();
+    m_runs.clear();
+}
+
+}  // namespace lbcrypto
@@ -43,6 +43,7 @@ CKKS implementation. See https://eprint.iacr.org/2020/1118 for details.
 #include "ciphertext-fwd.h"
 #include "lattice/hal/lat-backend.h"
 #include "utils/exception.h"
+#include "utils/polyarena.h"
 #define PROFILE
 
 #include "cryptocontext.h"
@@ -52,6 +53,7 @@ CKKS implementation. See https://eprint.iacr.org/2020/1118 for details.
 
 #include "schemebase/base-scheme.h"
 
+#include <algorithm>
 #include <complex>
 
 namespace lbcrypto {
@@ -121,12 +123,30 @@ Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalLinearWSumMutable(std::vector<Ciphe
         }
     }
 
-    Ciphertext<DCRTPoly> weightedSum = cc->EvalMult(ciphertexts[0], constants[0]);
+    // the products are accumulated before they are reduced when the ciphertexts line up, which is always the case
+    // after the adjustment above; FIXEDMANUAL leaves them as they are
+    const auto& c0 = ciphertexts[0];
+    bool aligned   = (cryptoParams->GetScalingTechnique() == FIXEDMANUAL) || (c0->GetNoiseScaleDeg() == 1);
+    for (uint32_t i = 1; i < ciphertexts.size() && aligned; i++) {
+        const auto& ci = ciphertexts[i];
+        if (ci->GetLevel() != c0->GetLevel() || ci->GetNoiseScaleDeg() != c0->GetNoiseScaleDeg() ||
+            ci->NumberCiphertextElements() != c0->NumberCiphertextElements() ||
+            ci->GetElements()[0].GetNumOfElements() != c0->GetElements()[0].GetNumOfElements())
+            aligned = false;
+    }
 
-    Ciphertext<DCRTPoly> tmp;
-    for (uint32_t i = 1; i < ciphertexts.size(); i++) {
-        tmp = cc->EvalMult(ciphertexts[i], constants[i]);
-        cc->EvalAddInPlace(weightedSum, tmp);
+    Ciphertext<DCRTPoly> weightedSum;
+    if (aligned) {
+        weightedSum = algo->EvalLinearWSumCore(ciphertexts, constants);
+    }
+    else {
+        weightedSum = cc->EvalMult(ciphertexts[0], constants[0]);
+
+        Ciphertext<DCRTPoly> tmp;
+        for (uint32_t i = 1; i < ciphertexts.size(); i++) {
+            tmp = cc->EvalMult(ciphertexts[i], constants[i]);
+            cc->EvalAddInPlace(weightedSum, tmp);
+        }
     }
 
     cc->ModReduceInPlace(weightedSum);
@@ -1317,10 +1337,10 @@ Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalPolyPS(std::vector<Ciphertext<DCRTP
     if (coefficients[coefficients.size() - 1] == std::complex<double>(0.0, 0.0))
         f2.resize(n + 1);
 
-    std::vector<uint32_t> degs = ComputeDegreesPS(n);
-    /* Compute positive integers k,m such that n < k(2^m-1), k is close to sqrt(n/2)	and the depth = ceil(log2(k))+m is minimized */
-    uint32_t k                 = degs[0];
-    uint32_t m                 = degs[1];
+    /* k and m are set by the precomputed powers, which may have been computed for a degree higher than n
+       (e.g. several LUTs sharing the same powers, or a LUT with vanishing high-order coefficients) */
+    uint32_t k = powers.size();
+    uint32_t m = powers2.size();
 
     // needed x^k
     std::vector<int32_t> indices(k, 0);
@@ -1486,6 +1506,8 @@ Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalPolyPS(std::vector<Ciphertext<DCRTP
 Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalChebyshevSeries(ConstCiphertext<DCRTPoly> x,
                                                              const std::vector<double>& coefficients, double a,
                                                              double b) const {
+    // the temporaries of the evaluation recycle their storage, see PolyArena
+    PolyArenaScope arena;
     uint32_t n = Degree(coefficients);
 
     if (n < 5) {
@@ -1500,6 +1522,7 @@ Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalChebyshevSeries(ConstCiphertext<DCR
 Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalChebyshevSeries(ConstCiphertext<DCRTPoly> x,
                                                              const std::vector<std::complex<double>>& coefficients, double a,
                                                              double b) const {
+    PolyArenaScope arena;
     uint32_t n = Degree(coefficients);
 
     if (4 < n  && n < 17) {
@@ -1511,11 +1534,68 @@ Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalChebyshevSeries(ConstCiphertext<DCR
 
 
 
+std::vector<Ciphertext<DCRTPoly>> AdvancedSHECKKSRNS::EvalChebyshevSeriesMulti(
+    ConstCiphertext<DCRTPoly> x, const std::vector<std::vector<double>>& coefficients, double a, double b) const {
+    PolyArenaScope arena;
+    if (coefficients.empty())
+        OPENFHE_THROW("The vector of series can not be empty");
+
+    // each series is trimmed to its actual degree, the Chebyshev polynomials are computed once for the largest one
+    std::vector<std::vector<double>> series(coefficients.size());
+    uint32_t n = 1;
+    for (size_t i = 0; i < coefficients.size(); i++) {
+        if (coefficients[i].empty())
+            OPENFHE_THROW("The coefficients vector can not be empty");
+        uint32_t degree = std::max<uint32_t>(Degree(coefficients[i]), 1);
+        series[i]       = coefficients[i];
+        series[i].resize(degree + 1, 0.0);
+        n = std::max(n, degree);
+    }
+
+    // the evaluation of a series modifies some of the Chebyshev polynomials in place,
+    // so every series but the last one works on copies
+    auto clone = [](const std::vector<Ciphertext<DCRTPoly>>& cts) {
+        std::vector<Ciphertext<DCRTPoly>> copies(cts.size());
+        for (size_t i = 0; i < cts.size(); i++)
+            copies[i] = cts[i]->Clone();
+        return copies;
+    };
+
+    std::vector<Ciphertext<DCRTPoly>> results(series.size());
+    if (n < 5) {
+        auto T = ComputeChebyshevPolynomialsLinear(x, n, a, b);
+        for (size_t i = 0; i < series.size(); i++) {
+            results[i] = EvalChebyshevSeriesLinear((i + 1 < series.size()) ? clone(T) : T, series[i]);
+        }
+    }
+    else {
+        auto chebPolys = ComputeChebyshevPolynomialsPS(x, n, a, b);
+        for (size_t i = 0; i < series.size(); i++) {
+            if (i + 1 < series.size())
+                results[i] = EvalChebyshevSeriesPS(clone(chebPolys[0]), clone(chebPolys[1]),
+                                                   chebPolys[2][0]->Clone(), series[i]);
+            else
+                results[i] = EvalChebyshevSeriesPS(chebPolys[0], chebPolys[1], chebPolys[2][0], series[i]);
+        }
+    }
+
+    return results;
+}
+
+
+
 Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalChebyshevSeriesLinear(ConstCiphertext<DCRTPoly> x,
                                                                    const std::vector<double>& coefficients, double a,
                                                                    double b) const {
-    usint k = coefficients.size() - 1;
+    auto T = ComputeChebyshevPolynomialsLinear(x, coefficients.size() - 1, a, b);
+    return EvalChebyshevSeriesLinear(T, coefficients);
+}
+
 
+
+std::vector<Ciphertext<DCRTPoly>> AdvancedSHECKKSRNS::ComputeChebyshevPolynomialsLinear(ConstCiphertext<DCRTPoly> x,
+                                                                                       uint32_t k, double a,
+                                                                                       double b) const {
     // computes linear transformation y = -1 + 2 (x-a)/(b-a)
     // consumes one level when a <> -1 && b <> 1
     auto cc = x->GetCryptoContext();
@@ -1585,6 +1665,19 @@ Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalChebyshevSeriesLinear(ConstCipherte
         cc->LevelReduceInPlace(T[i - 1], nullptr, levelDiff);
     }
 
+    return T;
+}
+
+
+
+Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalChebyshevSeriesLinear(std::vector<Ciphertext<DCRTPoly>> T,
+                                                                   const std::vector<double>& coefficients) const {
+    usint k = coefficients.size() - 1;
+    if (k == 0 || k > T.size())
+        OPENFHE_THROW("The degree of the series does not match the precomputed Chebyshev polynomials");
+
+    auto cc = T.front()->GetCryptoContext();
+
     // perform scalar multiplication for the highest-order term
     auto result = cc->EvalMult(T[k - 1], coefficients[k]);
 
@@ -2014,14 +2107,14 @@ Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::InnerEvalChebyshevPS(ConstCiphertext<DC
 Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalChebyshevSeriesPS(ConstCiphertext<DCRTPoly> x,
                                                                const std::vector<double>& coefficients, double a,
                                                                double b) const {
-    uint32_t n = Degree(coefficients);
+    auto chebPolys = ComputeChebyshevPolynomialsPS(x, Degree(coefficients), a, b);
+    return EvalChebyshevSeriesPS(chebPolys[0], chebPolys[1], chebPolys[2][0], coefficients);
+}
 
-    std::vector<double> f2 = coefficients;
 
-    // Make sure the coefficients do not have the zero dominant terms
-    if (coefficients[coefficients.size() - 1] == 0)
-        f2.resize(n + 1);
 
+std::vector<std::vector<Ciphertext<DCRTPoly>>> AdvancedSHECKKSRNS::ComputeChebyshevPolynomialsPS(
+    ConstCiphertext<DCRTPoly> x, uint32_t n, double a, double b) const {
     std::vector<uint32_t> degs = ComputeDegreesPS(n);
     uint32_t k                 = degs[0];
     uint32_t m                 = degs[1];
@@ -2119,6 +2212,32 @@ Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalChebyshevSeriesPS(ConstCiphertext<D
         cc->EvalSubInPlace(T2km1, T2.front());
     }
 
+    return {T, T2, {T2km1}};
+}
+
+
+
+Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalChebyshevSeriesPS(std::vector<Ciphertext<DCRTPoly>> T,
+                                                               std::vector<Ciphertext<DCRTPoly>> T2,
+                                                               Ciphertext<DCRTPoly> T2km1,
+                                                               const std::vector<double>& coefficients) const {
+    uint32_t n = Degree(coefficients);
+
+    std::vector<double> f2 = coefficients;
+
+    // Make sure the coefficients do not have the zero dominant terms
+    if (coefficients[coefficients.size() - 1] == 0)
+        f2.resize(n + 1);
+
+    /* k and m are set by the precomputed Chebyshev polynomials, which may have been computed for a degree
+       higher than n (e.g. several series sharing the same polynomials) */
+    uint32_t k = T.size();
+    uint32_t m = T2.size();
+    if (n >= k * ((1 << m) - 1))
+        OPENFHE_THROW("The degree of the series is too large for the precomputed Chebyshev polynomials");
+
+    auto cc = T.front()->GetCryptoContext();
+
     // We also need to reduce the number of levels of T[k-1] and of T2[0] by another level.
     //  cc->LevelReduceInPlace(T[k-1], nullptr);
     //  cc->LevelReduceInPlace(T2.front(), nullptr);
@@ -2194,7 +2313,7 @@ Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalChebyshevSeriesPS(ConstCiphertext<D
     Ciphertext<DCRTPoly> qu;
 
     if (Degree(divqr->q) > k) {
-        qu = InnerEvalChebyshevPS(x, divqr->q, k, m - 1, T, T2);
+        qu = InnerEvalChebyshevPS(T.front(), divqr->q, k, m - 1, T, T2);
     }
     else {
         // dq = k from construction
@@ -2232,7 +2351,7 @@ Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalChebyshevSeriesPS(ConstCiphertext<D
     Ciphertext<DCRTPoly> su;
 
     if (Degree(s2) > k) {
-        su = InnerEvalChebyshevPS(x, s2, k, m - 1, T, T2);
+        su = InnerEvalChebyshevPS(T.front(), s2, k, m - 1, T, T2);
     }
     else {
         // ds = k from construction
@@ -2253,7 +2372,7 @@ Ciphertext<DCRTPoly> AdvancedSHECKKSRNS::EvalChebyshevSeriesPS(ConstCiphertext<D
             cc->EvalAddInPlace(su, T[k - 1]);
         }
         else {
-            su = T[k - 1];
+            su = T[k - 1]->Clone();
         }
 
         // adds the free term (at x^0)
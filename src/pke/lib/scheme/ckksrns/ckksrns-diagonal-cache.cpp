@@ -0,0 +1,112 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2025, CEA-List
+//
+// All rights reserved.
+//
+// Author TPOC: jules.dumezy@cea.fr
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#include "scheme/ckksrns/ckksrns-diagonal-cache.h"
+
+#include "encoding/plaintext.h"
+
+#include <atomic>
+
+namespace lbcrypto {
+
+CKKSDiagonalSeed::CKKSDiagonalSeed(std::vector<std::complex<double>>&& values,
+                                   std::shared_ptr<DCRTPoly::Params> params, uint32_t level)
+    : values(std::move(values)), params(std::move(params)), level(level) {
+    static std::atomic<uint64_t> nextId{1};
+    id = nextId++;
+}
+
+ConstPlaintext CKKSDiagonalCache::Get(const CKKSDiagonalSeed& seed, const std::function<ConstPlaintext()>& encode) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_index.find(seed.id);
+        if (it != m_index.end()) {
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            m_hits++;
+            return it->second->second;
+        }
+        m_misses++;
+    }
+
+    ConstPlaintext plaintext = encode();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // another thread may have encoded the same diagonal meanwhile
+    if (m_capacity > 0 && m_index.find(seed.id) == m_index.end()) {
+        m_entries.emplace_front(seed.id, plaintext);
+        m_index[seed.id] = m_entries.begin();
+        EvictInternal();
+    }
+    return plaintext;
+}
+
+void CKKSDiagonalCache::SetCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capacity = capacity;
+    EvictInternal();
+}
+
+size_t CKKSDiagonalCache::GetCapacity() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_capacity;
+}
+
+size_t CKKSDiagonalCache::Size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+uint64_t CKKSDiagonalCache::GetHits() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hits;
+}
+
+uint64_t CKKSDiagonalCache::GetMisses() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_misses;
+}
+
+void CKKSDiagonalCache::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_index.clear();
+    m_hits   = 0;
+    m_misses = 0;
+}
+
+void CKKSDiagonalCache::EvictInternal() {
+    while (m_entries.size() > m_capacity) {
+        m_index.erase(m_entries.back().first);
+        m_entries.pop_back();
+    }
+}
+
+}  // namespace lbcrypto
@@ -0,0 +1,359 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2025, CEA-List
+//
+// All rights reserved.
+//
+// Author TPOC: jules.dumezy@cea.fr
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+Binary file format of the bootstrapping precomputations, mapped read-only when loaded
+ */
+
+#include "scheme/ckksrns/ckksrns-fhe.h"
+#include "scheme/ckksrns/ckksrns-cryptoparameters.h"
+#include "cryptocontext.h"
+#include "encoding/ckkspackedencoding.h"
+#include "utils/exception.h"
+#include "utils/mappedfile.h"
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace lbcrypto {
+
+namespace {
+
+// All the fields are written in the native byte order. The file starts with the magic, the
+// version, the size of a tower word, the ring dimension, the correction factor and the number of
+// configurations. Each configuration holds its slots, dim1, encoding/decoding parameters and the
+// m_U0hatTPre, m_U0Pre, m_U0hatTPreFFT and m_U0PreFFT tables. Each plaintext holds a presence flag,
+// its noise scale degree, level, scaling factor, slots and moduli, then its towers in EVALUATION format.
+constexpr char PRECOM_MAGIC[8]    = {'O', 'F', 'H', 'E', 'B', 'T', 'P', 'C'};
+constexpr uint32_t PRECOM_VERSION = 1;
+
+using PrecomWord = NativeInteger::Integer;
+
+class PrecomWriter {
+public:
+    explicit PrecomWriter(const std::string& filename)
+        : m_filename(filename), m_out(filename, std::ios::out | std::ios::binary | std::ios::trunc) {
+        if (!m_out.is_open())
+            OPENFHE_THROW("Can not open " + filename);
+    }
+
+    template <typename T>
+    void Write(const T& value) {
+        WriteArray(&value, 1);
+    }
+
+    template <typename T>
+    void WriteArray(const T* data, size_t count) {
+        m_out.write(reinterpret_cast<const char*>(data), count * sizeof(T));
+        if (!m_out)
+            OPENFHE_THROW("Error serializing to " + m_filename);
+    }
+
+    void WriteParams(const std::vector<int32_t>& params) {
+        Write(static_cast<uint32_t>(params.size()));
+        WriteArray(params.data(), params.size());
+    }
+
+    void WritePlaintext(const ConstPlaintext& pt) {
+        Write(static_cast<uint8_t>(pt != nullptr));
+        if (pt == nullptr)
+            return;
+
+        const DCRTPoly& element = pt->GetElement<DCRTPoly>();
+        if (element.GetFormat() != Format::EVALUATION)
+            OPENFHE_THROW("Bootstrapping plaintexts are expected in EVALUATION format");
+
+        uint32_t numTowers = element.GetNumOfElements();
+        Write(static_cast<uint32_t>(pt->GetNoiseScaleDeg()));
+        Write(static_cast<uint32_t>(pt->GetLevel()));
+        Write(pt->GetScalingFactor());
+        Write(static_cast<uint32_t>(pt->GetSlots()));
+        Write(numTowers);
+        for (uint32_t i = 0; i < numTowers; i++)
+            Write(element.GetElementAtIndex(i).GetModulus().ConvertToInt<PrecomWord>());
+
+        std::vector<PrecomWord> buffer;
+        for (uint32_t i = 0; i < numTowers; i++) {
+            const NativeVector& values = element.GetElementAtIndex(i).GetValues();
+            buffer.resize(values.GetLength());
+            for (size_t j = 0; j < buffer.size(); j++)
+                buffer[j] = values[j].ConvertToInt<PrecomWord>();
+            WriteArray(buffer.data(), buffer.size());
+        }
+    }
+
+    void WriteLevel(const std::vector<ConstPlaintext>& level) {
+        Write(static_cast<uint32_t>(level.size()));
+        for (const auto& pt : level)
+            WritePlaintext(pt);
+    }
+
+    void WriteTable(const std::vector<std::vector<ConstPlaintext>>& table) {
+        Write(static_cast<uint32_t>(table.size()));
+        for (const auto& level : table)
+            WriteLevel(level);
+    }
+
+    void Close() {
+        m_out.close();
+        if (!m_out)
+            OPENFHE_THROW("Error serializing to " + m_filename);
+    }
+
+private:
+    std::string m_filename;
+    std::ofstream m_out;
+};
+
+class PrecomReader {
+public:
+    PrecomReader(const MappedFile& file, const std::string& filename)
+        : m_data(file.Data()), m_size(file.Size()), m_filename(filename) {}
+
+    template <typename T>
+    T Read() {
+        T value;
+        std::memcpy(&value, Skip(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    // returns the current position and moves past the next numBytes bytes
+    const char* Skip(size_t numBytes) {
+        if (numBytes > m_size - m_pos)
+            OPENFHE_THROW("Error deserializing from " + m_filename + ": unexpected end of file");
+        const char* ptr = m_data + m_pos;
+        m_pos += numBytes;
+        return ptr;
+    }
+
+    std::vector<int32_t> ReadParams() {
+        std::vector<int32_t> params(Read<uint32_t>());
+        if (!params.empty())
+            std::memcpy(params.data(), Skip(params.size() * sizeof(int32_t)), params.size() * sizeof(int32_t));
+        return params;
+    }
+
+private:
+    const char* m_data;
+    size_t m_size;
+    size_t m_pos = 0;
+    std::string m_filename;
+};
+
+// plaintext whose header has been read, its towers are copied in a second, parallel pass
+struct PrecomPlaintextJob {
+    ConstPlaintext* dst;
+    std::shared_ptr<DCRTPoly::Params> params;
+    uint32_t noiseScaleDeg;
+    uint32_t level;
+    double scalingFactor;
+    uint32_t slots;
+    const char* values;
+};
+
+}  // namespace
+
+void FHECKKSRNS::SaveBootstrapPrecomputations(const std::string& filename) const {
+    if (m_bootPrecomMap.empty())
+        OPENFHE_THROW("There are no bootstrapping precomputations to save. Call EvalBootstrapSetup first.");
+
+    uint32_t ringDim = 0;
+    for (const auto& entry : m_bootPrecomMap) {
+        const auto& precom = entry.second;
+        if (!precom->m_U0Seeds.empty() || !precom->m_U0hatTSeeds.empty())
+            OPENFHE_THROW("Bootstrapping diagonals encoded on the fly can not be saved.");
+        for (const auto* table : {&precom->m_U0hatTPreFFT, &precom->m_U0PreFFT}) {
+            for (const auto& level : *table) {
+                for (const auto& pt : level) {
+                    if (pt != nullptr && ringDim == 0)
+                        ringDim = pt->GetElementRingDimension();
+                }
+            }
+        }
+        for (const auto* level : {&precom->m_U0hatTPre, &precom->m_U0Pre}) {
+            for (const auto& pt : *level) {
+                if (pt != nullptr && ringDim == 0)
+                    ringDim = pt->GetElementRingDimension();
+            }
+        }
+    }
+    if (ringDim == 0)
+        OPENFHE_THROW("The bootstrapping setup was run without precomputing the plaintexts.");
+
+    PrecomWriter writer(filename);
+    writer.WriteArray(PRECOM_MAGIC, sizeof(PRECOM_MAGIC));
+    writer.Write(PRECOM_VERSION);
+    writer.Write(static_cast<uint32_t>(sizeof(PrecomWord)));
+    writer.Write(ringDim);
+    writer.Write(m_correctionFactor);
+    writer.Write(static_cast<uint32_t>(m_bootPrecomMap.size()));
+
+    for (const auto& entry : m_bootPrecomMap) {
+        const auto& precom = entry.second;
+        writer.Write(precom->m_slots);
+        writer.Write(precom->m_dim1);
+        writer.WriteParams(precom->m_paramsEnc);
+        writer.WriteParams(precom->m_paramsDec);
+        writer.WriteLevel(precom->m_U0hatTPre);
+        writer.WriteLevel(precom->m_U0Pre);
+        writer.WriteTable(precom->m_U0hatTPreFFT);
+        writer.WriteTable(precom->m_U0PreFFT);
+    }
+
+    writer.Close();
+}
+
+void FHECKKSRNS::LoadBootstrapPrecomputations(const CryptoContextImpl<DCRTPoly>& cc, const std::string& filename) {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(cc.GetCryptoParameters());
+
+    MappedFile file(filename);
+    PrecomReader reader(file, filename);
+
+    if (std::memcmp(reader.Skip(sizeof(PRECOM_MAGIC)), PRECOM_MAGIC, sizeof(PRECOM_MAGIC)) != 0)
+        OPENFHE_THROW(filename + " does not hold bootstrapping precomputations");
+    if (reader.Read<uint32_t>() != PRECOM_VERSION)
+        OPENFHE_THROW("Unsupported version of the bootstrapping precomputations in " + filename);
+    if (reader.Read<uint32_t>() != sizeof(PrecomWord))
+        OPENFHE_THROW(filename + " was written with a different native integer size");
+
+    uint32_t ringDim = reader.Read<uint32_t>();
+    if (ringDim != cc.GetRingDimension())
+        OPENFHE_THROW(filename + " was written for ring dimension " + std::to_string(ringDim) +
+                      " instead of " + std::to_string(cc.GetRingDimension()));
+    uint32_t correctionFactor = reader.Read<uint32_t>();
+    uint32_t numConfigs       = reader.Read<uint32_t>();
+
+    // the towers of the plaintexts are among the ones of Q and P
+    std::map<PrecomWord, std::shared_ptr<ILNativeParams>> towerParams;
+    for (const auto& params : cryptoParams->GetElementParams()->GetParams())
+        towerParams[params->GetModulus().ConvertToInt<PrecomWord>()] = params;
+    if (cryptoParams->GetParamsP() != nullptr) {
+        for (const auto& params : cryptoParams->GetParamsP()->GetParams())
+            towerParams[params->GetModulus().ConvertToInt<PrecomWord>()] = params;
+    }
+    // plaintexts at the same level share their parameters
+    std::map<std::vector<PrecomWord>, std::shared_ptr<DCRTPoly::Params>> sharedParams;
+    uint32_t M = cc.GetCyclotomicOrder();
+
+    std::vector<PrecomPlaintextJob> jobs;
+    auto readLevel = [&](std::vector<ConstPlaintext>& level) {
+        level.resize(reader.Read<uint32_t>());
+        for (auto& pt : level) {
+            if (!reader.Read<uint8_t>())
+                continue;
+            PrecomPlaintextJob job;
+            job.dst           = &pt;
+            job.noiseScaleDeg = reader.Read<uint32_t>();
+            job.level         = reader.Read<uint32_t>();
+            job.scalingFactor = reader.Read<double>();
+            job.slots         = reader.Read<uint32_t>();
+
+            std::vector<PrecomWord> moduli(reader.Read<uint32_t>());
+            for (auto& modulus : moduli)
+                modulus = reader.Read<PrecomWord>();
+            auto& params = sharedParams[moduli];
+            if (params == nullptr) {
+                std::vector<std::shared_ptr<ILNativeParams>> towers;
+                for (const auto& modulus : moduli) {
+                    auto it = towerParams.find(modulus);
+                    if (it == towerParams.end())
+                        OPENFHE_THROW(filename + " was not written for the parameters of this crypto context");
+                    towers.push_back(it->second);
+                }
+                params = std::make_shared<DCRTPoly::Params>(M, towers);
+            }
+            job.params = params;
+            job.values = reader.Skip(moduli.size() * ringDim * sizeof(PrecomWord));
+            jobs.push_back(std::move(job));
+        }
+    };
+    auto readTable = [&](std::vector<std::vector<ConstPlaintext>>& table) {
+        table.resize(reader.Read<uint32_t>());
+        for (auto& level : table)
+            readLevel(level);
+    };
+
+    std::map<uint32_t, std::shared_ptr<CKKSBootstrapPrecom>> precomMap;
+    for (uint32_t c = 0; c < numConfigs; c++) {
+        auto precom         = std::make_shared<CKKSBootstrapPrecom>();
+        precom->m_slots     = reader.Read<uint32_t>();
+        precom->m_dim1      = reader.Read<uint32_t>();
+        precom->m_paramsEnc = reader.ReadParams();
+        precom->m_paramsDec = reader.ReadParams();
+        readLevel(precom->m_U0hatTPre);
+        readLevel(precom->m_U0Pre);
+        readTable(precom->m_U0hatTPreFFT);
+        readTable(precom->m_U0PreFFT);
+        precomMap[precom->m_slots] = precom;
+    }
+
+    // set by the jobs finding a word that is not reduced modulo its tower, as they can not throw
+    std::atomic<bool> outOfRange(false);
+#pragma omp parallel for
+    for (size_t k = 0; k < jobs.size(); k++) {
+        const auto& job = jobs[k];
+        auto pt = std::make_shared<CKKSPackedEncoding>(job.params, cc.GetEncodingParams(),
+                                                       std::vector<std::complex<double>>(), job.noiseScaleDeg,
+                                                       job.level, job.scalingFactor, job.slots);
+        DCRTPoly& element  = pt->GetElement<DCRTPoly>();
+        const auto& towers = job.params->GetParams();
+        const char* values = job.values;
+        for (size_t i = 0; i < towers.size(); i++) {
+            const PrecomWord modulus = towers[i]->GetModulus().ConvertToInt<PrecomWord>();
+            NativeVector vec(ringDim, towers[i]->GetModulus());
+            for (uint32_t j = 0; j < ringDim; j++, values += sizeof(PrecomWord)) {
+                PrecomWord word;
+                std::memcpy(&word, values, sizeof(PrecomWord));
+                if (word >= modulus)
+                    outOfRange = true;
+                vec[j] = NativeInteger(word);
+            }
+            NativePoly tower(towers[i], Format::EVALUATION);
+            tower.SetValues(std::move(vec), Format::EVALUATION);
+            element.SetElementAtIndex(i, std::move(tower));
+        }
+        element.OverrideFormat(Format::EVALUATION);
+        *job.dst = pt;
+    }
+    if (outOfRange)
+        OPENFHE_THROW(filename + " holds tower values that are not reduced modulo their tower");
+
+    m_correctionFactor = correctionFactor;
+    for (auto& entry : precomMap)
+        m_bootPrecomMap[entry.first] = entry.second;
+}
+
+}  // namespace lbcrypto
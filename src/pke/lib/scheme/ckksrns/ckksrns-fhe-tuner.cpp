@@ -0,0 +1,235 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2025, CEA-List
+//
+// All rights reserved.
+//
+// Author TPOC: jules.dumezy@cea.fr
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+Cost model of CoeffsToSlots/SlotsToCoeffs used to select the level budgets and baby-step giant-step dimensions
+ */
+
+#include "scheme/ckksrns/ckksrns-fhe.h"
+#include "scheme/ckksrns/ckksrns-cryptoparameters.h"
+#include "cryptocontext.h"
+#include "utils/exception.h"
+#include "utils/parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <vector>
+
+namespace lbcrypto {
+
+namespace {
+
+// Costs are counted in products of one tower, with an NTT of one tower worth log2(N) / 2 of them,
+// for a ciphertext with l towers of Q (see FHECKKSRNS::GetBSGSOuterCost).
+class LinearTransformCostModel {
+public:
+    LinearTransformCostModel(double k, double alpha, double ntt, double numThreads)
+        : m_k(k), m_alpha(alpha), m_ntt(ntt), m_numThreads(numThreads) {}
+
+    // collapsed level of CoeffsToSlots/SlotsToCoeffs, with double hoisting
+    double CollapsedLevel(double l, double numRotations, double g, double b) const {
+        return ModUp(l) + std::ceil((g - 1) / m_numThreads) * InnerProduct(l) + numRotations * PlainMult(l) +
+               (b - 1) * (ModDown(l) + ModUp(l) + InnerProduct(l)) + 2 * ModDown(l) + Rescale(l);
+    }
+
+    // linear transform bootstrapping, with single hoisting
+    double LinearTransform(double l, double slots, double bStep, double gStep) const {
+        return ModUp(l) + std::ceil((bStep - 1) / m_numThreads) * InnerProduct(l) + slots * PlainMult(l) +
+               (gStep - 1) * (2 * ModDown(l) + ModUp(l) + InnerProduct(l)) + 2 * ModDown(l) + Rescale(l);
+    }
+
+private:
+    double Digits(double l) const {
+        return std::ceil(l / m_alpha);
+    }
+
+    double ModUp(double l) const {
+        double beta = Digits(l);
+        return (l + beta * (l + m_k - m_alpha)) * m_ntt + beta * m_alpha * (l + m_k - m_alpha);
+    }
+
+    double ModDown(double l) const {
+        return (m_k + l) * m_ntt + m_k * l;
+    }
+
+    double InnerProduct(double l) const {
+        return 2 * Digits(l) * (l + m_k);
+    }
+
+    double PlainMult(double l) const {
+        return 2 * (l + m_k);
+    }
+
+    double Rescale(double l) const {
+        return 2 * l * (m_ntt + 1);
+    }
+
+    double m_k;
+    double m_alpha;
+    double m_ntt;
+    double m_numThreads;
+};
+
+// Modeled cost of the collapsed FFT described by params, starting at l towers and dropping one tower per level.
+double CollapsedFFTCost(const LinearTransformCostModel& model, const std::vector<int32_t>& params, int32_t l) {
+    int32_t levelBudget = params[CKKS_BOOT_PARAMS::LEVEL_BUDGET];
+    int32_t flagRem     = (params[CKKS_BOOT_PARAMS::LAYERS_REM] == 0) ? 0 : 1;
+
+    double cost = 0;
+    for (int32_t s = 0; s < levelBudget - flagRem; s++) {
+        cost += model.CollapsedLevel(std::max(l - s, 1), params[CKKS_BOOT_PARAMS::NUM_ROTATIONS],
+                                     params[CKKS_BOOT_PARAMS::GIANT_STEP], params[CKKS_BOOT_PARAMS::BABY_STEP]);
+    }
+    if (flagRem) {
+        cost += model.CollapsedLevel(std::max(l - levelBudget + 1, 1), params[CKKS_BOOT_PARAMS::NUM_ROTATIONS_REM],
+                                     params[CKKS_BOOT_PARAMS::GIANT_STEP_REM], params[CKKS_BOOT_PARAMS::BABY_STEP_REM]);
+    }
+    return cost;
+}
+
+// The inner dimensions worth trying for a collapsed FFT: the cost model choice (0) and every power of two
+// dividing the number of rotations plus one.
+std::vector<uint32_t> CandidateDims(uint32_t slots, uint32_t levelBudget) {
+    std::vector<uint32_t> dims{0};
+    uint32_t numRotations = GetCollapsedFFTParams(slots, levelBudget)[CKKS_BOOT_PARAMS::NUM_ROTATIONS];
+    for (uint32_t g = 2; g <= numRotations + 1; g <<= 1) {
+        dims.push_back(g);
+    }
+    return dims;
+}
+
+}  // namespace
+
+std::vector<BootstrapConfig> FHECKKSRNS::TuneBootstrapParameters(const CryptoContextImpl<DCRTPoly>& cc,
+                                                                 uint32_t slots, uint32_t depth,
+                                                                 uint32_t numThreads) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(cc.GetCryptoParameters());
+
+    if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
+        OPENFHE_THROW("CKKS Bootstrapping is only supported for the Hybrid key switching method.");
+    if (depth < 2)
+        OPENFHE_THROW("The encoding and the decoding need at least one level each");
+
+    uint32_t M = cc.GetCyclotomicOrder();
+    uint32_t N = cc.GetRingDimension();
+    if (slots == 0)
+        slots = M / 4;
+
+    uint32_t logSlots = std::log2(slots);
+    // even for the case of a single slot we need one level for rescaling
+    if (logSlots == 0) {
+        logSlots = 1;
+    }
+
+    if (numThreads == 0)
+        numThreads = OpenFHEParallelControls.GetNumThreads();
+
+    int32_t sizeQ  = cryptoParams->GetElementParams()->GetParams().size();
+    uint32_t sizeP = cryptoParams->GetParamsP()->GetParams().size();
+    LinearTransformCostModel model(sizeP, cryptoParams->GetNumPerPartQ(), std::log2(N) / 2, numThreads);
+
+    // CoeffsToSlots runs right after ModRaise, SlotsToCoeffs after the approximate modular reduction
+    int32_t modDepth = GetModDepthInternal(cryptoParams->GetSecretKeyDist());
+
+    // a rotation key holds two polynomials of P*Q per digit
+    uint64_t keySize = 2 * static_cast<uint64_t>(cryptoParams->GetNumPartQ()) * (sizeQ + sizeP) * N *
+                       sizeof(NativeInteger::Integer);
+
+    // the unset dimensions are selected as the setup will
+    double outerCost = GetSetupOuterCost(cc);
+
+    std::vector<BootstrapConfig> configs;
+    std::set<std::vector<int32_t>> visited;
+
+    for (uint32_t lEnc = 1; lEnc <= std::min(logSlots, depth - 1); lEnc++) {
+        for (uint32_t lDec = 1; lDec <= std::min(logSlots, depth - lEnc); lDec++) {
+            int32_t towersDec = std::max(sizeQ - int32_t(lEnc) - modDepth, int32_t(lDec) + 1);
+
+            if (lEnc == 1 && lDec == 1) {
+                // linear transform bootstrapping, a single inner dimension for both transforms
+                for (uint32_t dim1 : CandidateDims(slots, 1)) {
+                    uint32_t bStep = (dim1 == 0) ? std::ceil(std::sqrt(slots)) : dim1;
+                    uint32_t gStep = std::ceil(static_cast<double>(slots) / bStep);
+                    if (bStep > slots || !visited.insert(std::vector<int32_t>{1, 1, int32_t(bStep)}).second)
+                        continue;
+
+                    BootstrapConfig config;
+                    config.levelBudget     = std::vector<uint32_t>{1, 1};
+                    config.dim1            = std::vector<uint32_t>{dim1, dim1};
+                    config.numRotationKeys = FindLinearTransformRotationIndices(dim1, slots, M).size() + 1;
+                    config.keyMemory       = config.numRotationKeys * keySize;
+                    config.cost            = model.LinearTransform(sizeQ, slots, bStep, gStep) +
+                                             model.LinearTransform(towersDec, slots, bStep, gStep);
+                    configs.push_back(config);
+                }
+                continue;
+            }
+
+            for (uint32_t dimEnc : CandidateDims(slots, lEnc)) {
+                auto paramsEnc = GetCollapsedFFTParams(slots, lEnc, dimEnc, outerCost);
+                auto indexEnc  = FindCoeffsToSlotsRotationIndices(paramsEnc, slots, M);
+
+                for (uint32_t dimDec : CandidateDims(slots, lDec)) {
+                    auto paramsDec = GetCollapsedFFTParams(slots, lDec, dimDec, outerCost);
+
+                    // dimensions matching the cost model choice give the same configuration
+                    std::vector<int32_t> key(paramsEnc);
+                    key.insert(key.end(), paramsDec.begin(), paramsDec.end());
+                    if (!visited.insert(key).second)
+                        continue;
+
+                    std::vector<int32_t> indexList = FindSlotsToCoeffsRotationIndices(paramsDec, slots, M);
+                    indexList.insert(indexList.end(), indexEnc.begin(), indexEnc.end());
+                    std::sort(indexList.begin(), indexList.end());
+                    indexList.erase(std::unique(indexList.begin(), indexList.end()), indexList.end());
+
+                    BootstrapConfig config;
+                    config.levelBudget     = std::vector<uint32_t>{lEnc, lDec};
+                    config.dim1            = std::vector<uint32_t>{dimEnc, dimDec};
+                    config.numRotationKeys = indexList.size() + 1;
+                    config.keyMemory       = config.numRotationKeys * keySize;
+                    config.cost =
+                        CollapsedFFTCost(model, paramsEnc, sizeQ) + CollapsedFFTCost(model, paramsDec, towersDec);
+                    configs.push_back(config);
+                }
+            }
+        }
+    }
+
+    std::stable_sort(configs.begin(), configs.end(), [](const BootstrapConfig& a, const BootstrapConfig& b) {
+        return (a.cost < b.cost) || (a.cost == b.cost && a.numRotationKeys < b.numRotationKeys);
+    });
+
+    return configs;
+}
+
+}  // namespace lbcrypto
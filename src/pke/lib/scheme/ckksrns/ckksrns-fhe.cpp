@@ -43,6 +43,7 @@
 
 #include "scheme/ckksrns/ckksrns-fhe.h"
 
+#include "key/evalkeystore.h"
 #include "key/privatekey.h"
 #include "scheme/ckksrns/ckksrns-cryptoparameters.h"
 #include "schemebase/base-scheme.h"
@@ -52,14 +53,18 @@
 #include "lattice/lat-hal.h"
 
 #include "math/hal/basicint.h"
+#include "math/chebyshev.h"
 #include "math/dftransform.h"
+#include "math/hermite.h"
 
 #include "utils/exception.h"
 #include "utils/parallel.h"
+#include "utils/polyarena.h"
 #include "utils/utilities.h"
 #include "scheme/ckksrns/ckksrns-utils.h"
 
 #include <cmath>
+#include <exception>
 #include <memory>
 #include <vector>
 
@@ -145,8 +150,9 @@ void FHECKKSRNS::EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::
         newBudget[1] = 1;
     }
 
-    precom->m_paramsEnc = GetCollapsedFFTParams(slots, newBudget[0], dim1[0]);
-    precom->m_paramsDec = GetCollapsedFFTParams(slots, newBudget[1], dim1[1]);
+    double outerCost    = GetSetupOuterCost(cc);
+    precom->m_paramsEnc = GetCollapsedFFTParams(slots, newBudget[0], dim1[0], outerCost);
+    precom->m_paramsDec = GetCollapsedFFTParams(slots, newBudget[1], dim1[1], outerCost);
 
     if (precompute) {
         uint32_t m    = 4 * slots;
@@ -183,6 +189,15 @@ void FHECKKSRNS::EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::
             if (!bits)
                 OPENFHE_THROW("For functional bootstrapping, bits should be set to at least 1.");
             scaleDec = 2. / (pre * pow(2, bits));
+            // With FLEXIBLEAUTO*, SlotsToCoeffs ends at the scaling factor of the last level instead of 2^p,
+            // the ratio is folded in so that the message is raised with scale 2^p as in FIXEDMANUAL
+            // (with FLEXIBLEAUTOEXT, the input still has the extra modulus and SlotsToCoeffs ends with two towers)
+            if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL) {
+                uint32_t lastLevel = cryptoParams->GetElementParams()->GetParams().size() - 1;
+                if (cryptoParams->GetScalingTechnique() == FLEXIBLEAUTOEXT)
+                    lastLevel -= 1;
+                scaleDec *= pow(2, cryptoParams->GetPlaintextModulus()) / cryptoParams->GetScalingFactorReal(lastLevel);
+            }
         }
         else {
             double k  = (cryptoParams->GetSecretKeyDist() == SPARSE_TERNARY) ? K_SPARSE : 1.0;
@@ -200,8 +215,13 @@ void FHECKKSRNS::EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::
 
         if (stcFirst || functional) {
             lEnc = L0 - precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET]; // CtS
+            // FLEXIBLEAUTO* rescales the raised ciphertext before CoeffsToSlots
+            if (functional && cryptoParams->GetScalingTechnique() != FIXEDMANUAL)
+                lEnc -= 1;
             if (!functional)
                 lDec = precom->m_paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET] + 1; // StC
+            else if (cryptoParams->GetScalingTechnique() == FLEXIBLEAUTOEXT)
+                lDec = 2; // StC, on an input that still has the extra modulus
             else
                 lDec = 1; // StC
         }
@@ -245,8 +265,13 @@ void FHECKKSRNS::EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::
             }
         }
         else {
-            precom->m_U0hatTPreFFT = EvalCoeffsToSlotsPrecompute(cc, ksiPows, rotGroup, false, scaleEnc, lEnc);
-            precom->m_U0PreFFT     = EvalSlotsToCoeffsPrecompute(cc, ksiPows, rotGroup, false, scaleDec, lDec);
+            precom->m_U0hatTSeeds.clear();
+            precom->m_U0Seeds.clear();
+            precom->m_U0hatTPreFFT = EvalCoeffsToSlotsPrecompute(cc, ksiPows, rotGroup, false, scaleEnc, lEnc,
+                                                                 m_diagOnTheFly ? &precom->m_U0hatTSeeds : nullptr);
+            precom->m_U0PreFFT =
+                EvalSlotsToCoeffsPrecompute(cc, ksiPows, rotGroup, false, scaleDec, lDec, stcFirst || functional,
+                                            m_diagOnTheFly ? &precom->m_U0Seeds : nullptr);
         }
     }
 }
@@ -256,6 +281,35 @@ void FHECKKSRNS::EvalFuncBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, s
   EvalBootstrapSetup(cc, levelBudget, dim1, numSlots, 0, true, true, true, bits);
 }
 
+double FHECKKSRNS::GetBSGSOuterCost(const CryptoContextImpl<DCRTPoly>& cc) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(cc.GetCryptoParameters());
+
+    // costs counted in products of one tower, with an NTT of one tower worth log2(N) / 2 of them
+    double l     = cryptoParams->GetElementParams()->GetParams().size();
+    double k     = cryptoParams->GetParamsP()->GetParams().size();
+    double alpha = cryptoParams->GetNumPerPartQ();
+    double beta  = std::ceil(l / alpha);
+    double ntt   = std::log2(cc.GetRingDimension()) / 2;
+
+    // key switching inner product of a hoisted rotation
+    double inner = 2 * beta * (l + k);
+    // ModDown of the second element and digit decomposition (ModUp) of an outer rotation
+    double modDown = (k + l) * ntt + k * l;
+    double modUp   = (l + beta * (l + k - alpha)) * ntt + beta * alpha * (l + k - alpha);
+
+    return (inner + modDown + modUp) / inner;
+}
+
+void FHECKKSRNS::SetBootstrapDiagonalsOnTheFly(bool onTheFly, uint32_t cacheSize) {
+    m_diagOnTheFly = onTheFly;
+    if (!onTheFly)
+        m_diagCache = nullptr;
+    else if (m_diagCache)
+        m_diagCache->SetCapacity(cacheSize);
+    else
+        m_diagCache = std::make_shared<CKKSDiagonalCache>(cacheSize);
+}
+
 std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> FHECKKSRNS::EvalBootstrapKeyGen(
     const PrivateKey<DCRTPoly> privateKey, uint32_t slots) {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(privateKey->GetCryptoParameters());
@@ -271,14 +325,16 @@ std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> FHECKKSRNS::EvalBootstrapKey
 
     if (slots == 0)
         slots = M / 4;
-    // computing all indices for baby-step giant-step procedure
-    auto algo     = cc->GetScheme();
-    auto evalKeys = algo->EvalAtIndexKeyGen(nullptr, privateKey, FindBootstrapRotationIndices(slots, M));
-
-    auto conjKey       = ConjugateKeyGen(privateKey);
-    (*evalKeys)[M - 1] = conjKey;
-
-    return evalKeys;
+    // computing all indices for baby-step giant-step procedure, the rotation and conjugation keys being generated
+    // in a single parallel batch
+    auto rotIndices = FindBootstrapRotationIndices(slots, M);
+    std::vector<uint32_t> autoIndices;
+    autoIndices.reserve(rotIndices.size() + 1);
+    for (auto index : rotIndices)
+        autoIndices.push_back(FindAutomorphismIndex2nComplex(index, M));
+    autoIndices.push_back(M - 1);
+
+    return cc->GetScheme()->EvalAutomorphismKeyGen(privateKey, autoIndices);
 }
 
 void FHECKKSRNS::EvalBootstrapPrecompute(const CryptoContextImpl<DCRTPoly>& cc, uint32_t numSlots) {
@@ -301,8 +357,9 @@ void FHECKKSRNS::EvalBootstrapPrecompute(const CryptoContextImpl<DCRTPoly>& cc,
     std::vector<uint32_t> newBudget({static_cast<uint32_t>(precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET]),
                                      static_cast<uint32_t>(precom->m_paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET])});
 
-    precom->m_paramsEnc = GetCollapsedFFTParams(slots, newBudget[0], dim1[0]);
-    precom->m_paramsDec = GetCollapsedFFTParams(slots, newBudget[1], dim1[1]);
+    double outerCost    = GetSetupOuterCost(cc);
+    precom->m_paramsEnc = GetCollapsedFFTParams(slots, newBudget[0], dim1[0], outerCost);
+    precom->m_paramsDec = GetCollapsedFFTParams(slots, newBudget[1], dim1[1], outerCost);
 
     uint32_t m    = 4 * slots;
     bool isSparse = (M != m) ? true : false;
@@ -376,13 +433,19 @@ void FHECKKSRNS::EvalBootstrapPrecompute(const CryptoContextImpl<DCRTPoly>& cc,
         }
     }
     else {
-        precom->m_U0hatTPreFFT = EvalCoeffsToSlotsPrecompute(cc, ksiPows, rotGroup, false, scaleEnc, lEnc);
-        precom->m_U0PreFFT     = EvalSlotsToCoeffsPrecompute(cc, ksiPows, rotGroup, false, scaleDec, lDec);
+        precom->m_U0hatTSeeds.clear();
+        precom->m_U0Seeds.clear();
+        precom->m_U0hatTPreFFT = EvalCoeffsToSlotsPrecompute(cc, ksiPows, rotGroup, false, scaleEnc, lEnc,
+                                                             m_diagOnTheFly ? &precom->m_U0hatTSeeds : nullptr);
+        precom->m_U0PreFFT     = EvalSlotsToCoeffsPrecompute(cc, ksiPows, rotGroup, false, scaleDec, lDec, false,
+                                                             m_diagOnTheFly ? &precom->m_U0Seeds : nullptr);
     }
 }
 
 Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphertext, uint32_t numIterations,
                                                uint32_t precision) const {
+    // the storage of the temporaries is recycled from stage to stage, see PolyArena
+    PolyArenaScope arena;
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
 
     if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
@@ -395,12 +458,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         OPENFHE_THROW("CKKS Iterative Bootstrapping is only supported for 1 or 2 iterations.");
     }
 
-#ifdef BOOTSTRAPTIMING
-    TimeVar t;
-    double timeEncode(0.0);
-    double timeModReduce(0.0);
-    double timeDecode(0.0);
-#endif
+    BootstrapRunRecorder run(m_bootStats, "EvalBootstrap");
 
     auto cc        = ciphertext->GetCryptoContext();
     uint32_t M     = cc->GetCyclotomicOrder();
@@ -514,6 +572,8 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
     // it's being raised to.
     // Increasing the modulus
 
+    BootstrapStageTimer modRaiseTimer(m_bootStats, "ModRaise");
+
     Ciphertext<DCRTPoly> raised = ciphertext->Clone();
     auto algo                   = cc->GetScheme();
     algo->ModReduceInternalInPlace(raised, raised->GetNoiseScaleDeg() - 1);
@@ -534,6 +594,10 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
     raised->SetLevel(L0 - ctxtDCRT[0].GetNumOfElements());
     raised->SetElements(std::move(ctxtDCRT));
 
+    modRaiseTimer.Stop();
+    if (m_bootStats)
+        m_bootStats->UpdatePeakTowers(raised->GetElements()[0].GetNumOfElements());
+
 #ifdef BOOTSTRAPTIMING
     std::cerr << "\nNumber of levels at the beginning of bootstrapping: "
               << raised->GetElements()[0].GetNumOfElements() - 1 << std::endl;
@@ -574,14 +638,12 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         // FULLY PACKED CASE
         //------------------------------------------------------------------------------
 
-#ifdef BOOTSTRAPTIMING
-        TIC(t);
-#endif
-
         //------------------------------------------------------------------------------
         // Running CoeffToSlot
         //------------------------------------------------------------------------------
 
+        BootstrapStageTimer ctsTimer(m_bootStats, "CoeffsToSlots");
+
         // need to call internal modular reduction so it also works for FLEXIBLEAUTO
         algo->ModReduceInternalInPlace(raised, BASE_NUM_LEVELS_TO_DROP);
 
@@ -589,6 +651,8 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         auto ctxtEnc = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0hatTPre, raised) :
                                          EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised);
 
+        ctsTimer.Stop();
+
         auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ctxtEnc->GetKeyTag());
         auto conj       = Conjugate(ctxtEnc, evalKeyMap);
         auto ctxtEncI   = cc->EvalSub(ctxtEnc, conj);
@@ -612,6 +676,8 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         // Running Approximate Mod Reduction
         //------------------------------------------------------------------------------
 
+        BootstrapStageTimer modReduceTimer(m_bootStats, "ApproxModReduction");
+
         // Evaluate Chebyshev series for the sine wave
         ctxtEnc  = cc->EvalChebyshevSeries(ctxtEnc, coefficients, coeffLowerBound, coeffUpperBound);
         ctxtEncI = cc->EvalChebyshevSeries(ctxtEncI, coefficients, coeffLowerBound, coeffUpperBound);
@@ -638,15 +704,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         // scale the message back up after Chebyshev interpolation
         algo->MultByIntegerInPlace(ctxtEnc, scalar);
 
-#ifdef BOOTSTRAPTIMING
-        timeModReduce = TOC(t);
-
-        std::cerr << "Approximate modular reduction time: " << timeModReduce / 1000.0 << " s" << std::endl;
-
-        // Running SlotToCoeff
-
-        TIC(t);
-#endif
+        modReduceTimer.Stop();
 
         //------------------------------------------------------------------------------
         // Running SlotToCoeff
@@ -659,8 +717,10 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         }
 
         // Only one linear transform is needed
-        ctxtDec = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0Pre, ctxtEnc) :
-                                    EvalSlotsToCoeffs(precom->m_U0PreFFT, ctxtEnc);
+        ctxtDec = TimeBootstrapStage(m_bootStats, "SlotsToCoeffs", [&] {
+            return (isLTBootstrap) ? EvalLinearTransform(precom->m_U0Pre, ctxtEnc) :
+                                     EvalSlotsToCoeffs(precom->m_U0PreFFT, ctxtEnc);
+        });
     }
     else {
         //------------------------------------------------------------------------------
@@ -671,24 +731,26 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         // Running PartialSum
         //------------------------------------------------------------------------------
 
+        BootstrapStageTimer partialSumTimer(m_bootStats, "PartialSum");
         for (uint32_t j = 1; j < N / (2 * slots); j <<= 1) {
             auto temp = cc->EvalRotate(raised, j * slots);
             cc->EvalAddInPlace(raised, temp);
         }
-
-#ifdef BOOTSTRAPTIMING
-        TIC(t);
-#endif
+        partialSumTimer.Stop();
 
         //------------------------------------------------------------------------------
         // Running CoeffsToSlots
         //------------------------------------------------------------------------------
 
+        BootstrapStageTimer ctsTimer(m_bootStats, "CoeffsToSlots");
+
         algo->ModReduceInternalInPlace(raised, BASE_NUM_LEVELS_TO_DROP);
 
         auto ctxtEnc = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0hatTPre, raised) :
                                          EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised);
 
+        ctsTimer.Stop();
+
         auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ctxtEnc->GetKeyTag());
         auto conj       = Conjugate(ctxtEnc, evalKeyMap);
         cc->EvalAddInPlace(ctxtEnc, conj);
@@ -704,20 +766,12 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
             }
         }
 
-#ifdef BOOTSTRAPTIMING
-        timeEncode = TOC(t);
-
-        std::cerr << "\nEncoding time: " << timeEncode / 1000.0 << " s" << std::endl;
-
-        // Running Approximate Mod Reduction
-
-        TIC(t);
-#endif
-
         //------------------------------------------------------------------------------
         // Running Approximate Mod Reduction
         //------------------------------------------------------------------------------
 
+        BootstrapStageTimer modReduceTimer(m_bootStats, "ApproxModReduction");
+
         // Evaluate Chebyshev series for the sine wave
         ctxtEnc = cc->EvalChebyshevSeries(ctxtEnc, coefficients, coeffLowerBound, coeffUpperBound);
 
@@ -738,15 +792,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         // scale the message back up after Chebyshev interpolation
         algo->MultByIntegerInPlace(ctxtEnc, scalar);
 
-#ifdef BOOTSTRAPTIMING
-        timeModReduce = TOC(t);
-
-        std::cerr << "Approximate modular reduction time: " << timeModReduce / 1000.0 << " s" << std::endl;
-
-        // Running SlotToCoeff
-
-        TIC(t);
-#endif
+        modReduceTimer.Stop();
 
         //------------------------------------------------------------------------------
         // Running SlotsToCoeffs
@@ -759,8 +805,10 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         }
 
         // linear transform for decoding
-        ctxtDec = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0Pre, ctxtEnc) :
-                                    EvalSlotsToCoeffs(precom->m_U0PreFFT, ctxtEnc);
+        ctxtDec = TimeBootstrapStage(m_bootStats, "SlotsToCoeffs", [&] {
+            return (isLTBootstrap) ? EvalLinearTransform(precom->m_U0Pre, ctxtEnc) :
+                                     EvalSlotsToCoeffs(precom->m_U0PreFFT, ctxtEnc);
+        });
 
         cc->EvalAddInPlace(ctxtDec, cc->EvalRotate(ctxtDec, slots));
     }
@@ -771,12 +819,6 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
     algo->MultByIntegerInPlace(ctxtDec, corFactor);
 #endif
 
-#ifdef BOOTSTRAPTIMING
-    timeDecode = TOC(t);
-
-    std::cout << "Decoding time: " << timeDecode / 1000.0 << " s" << std::endl;
-#endif
-
     auto bootstrappingNumTowers = ctxtDec->GetElements()[0].GetNumOfElements();
 
     // If we start with more towers, than we obtain from bootstrapping, return the original ciphertext.
@@ -788,6 +830,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
 }
 
 Ciphertext<DCRTPoly> FHECKKSRNS::EvalStCFirstBootstrap(ConstCiphertext<DCRTPoly> ciphertext) const {
+    PolyArenaScope arena;
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
 
     if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
@@ -800,12 +843,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalStCFirstBootstrap(ConstCiphertext<DCRTPoly>
     OPENFHE_THROW("128-bit CKKS StC First Bootstrapping is not supported for 128 NATIVEINT.");
 #endif
 
-#ifdef BOOTSTRAPTIMING
-    TimeVar t;
-    double timeStC(0.0);
-    double timeCtS(0.0);
-    double timeEvalMod(0.0);
-#endif
+    BootstrapRunRecorder run(m_bootStats, "EvalStCFirstBootstrap");
 
     auto cc        = ciphertext->GetCryptoContext();
     uint32_t M     = cc->GetCyclotomicOrder();
@@ -862,24 +900,16 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalStCFirstBootstrap(ConstCiphertext<DCRTPoly>
         // FULLY PACKED CASE
         //------------------------------------------------------------------------------
 
-#ifdef BOOTSTRAPTIMING
-    TIC(t);
-#endif
-
         //------------------------------------------------------------------------------
         // Running SlotToCoeff
         //------------------------------------------------------------------------------
-        auto ctxtStC = EvalSlotsToCoeffs(precom->m_U0PreFFT, ciphertext);
-
-#ifdef BOOTSTRAPTIMING
-    timeStC = TOC(t);
-    std::cerr << "\nSlotsToCoeffs time: " << timeStC / 1000.0 << " s" << std::endl;
-    TIC(t);
-#endif
+        auto ctxtStC = TimeBootstrapStage(m_bootStats, "SlotsToCoeffs", [&] { return EvalSlotsToCoeffs(precom->m_U0PreFFT, ciphertext); });
 
         //------------------------------------------------------------------------------
         // RAISING THE MODULUS
         //------------------------------------------------------------------------------
+        BootstrapStageTimer modRaiseTimer(m_bootStats, "ModRaise");
+
         Ciphertext<DCRTPoly> raised = ctxtStC;
         auto algo                   = cc->GetScheme();
         algo->ModReduceInternalInPlace(raised, raised->GetNoiseScaleDeg() - 1);
@@ -898,13 +928,17 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalStCFirstBootstrap(ConstCiphertext<DCRTPoly>
         raised->SetLevel(L0 - ctxtDCRT[0].GetNumOfElements());
         raised->SetElements(std::move(ctxtDCRT));
 
+        modRaiseTimer.Stop();
+        if (m_bootStats)
+            m_bootStats->UpdatePeakTowers(raised->GetElements()[0].GetNumOfElements());
+
         double constantEvalMult = pre / N;
         cc->EvalMultInPlace(raised, constantEvalMult);
 
         //------------------------------------------------------------------------------
         // Running CoeffToSlot
         //------------------------------------------------------------------------------
-        auto ctxtCtS = EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised);
+        auto ctxtCtS = TimeBootstrapStage(m_bootStats, "CoeffsToSlots", [&] { return EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised); });
 
         auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ctxtCtS->GetKeyTag());
         auto conj       = Conjugate(ctxtCtS, evalKeyMap);
@@ -921,12 +955,6 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalStCFirstBootstrap(ConstCiphertext<DCRTPoly>
             }
         }
 
-#ifdef BOOTSTRAPTIMING
-    timeCtS = TOC(t);
-    std::cerr << "CoeffsToSlots time: " << timeCtS / 1000.0 << " s" << std::endl;
-    TIC(t);
-#endif
-
         //------------------------------------------------------------------------------
         // Running EvalMod
         //------------------------------------------------------------------------------
@@ -937,18 +965,14 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalStCFirstBootstrap(ConstCiphertext<DCRTPoly>
 
         // See https://eprint.iacr.org/2022/024 for additional details
         auto f = [powR, K](double x) -> double { return 1/pow((2 * M_PI), 1./powR) * std::cos(2 * M_PI / powR * (K * x - 0.25)); };
+        BootstrapStageTimer modReduceTimer(m_bootStats, "ApproxModReduction");
         auto ctxtEM = cc->EvalChebyshevFunction(std::function<double(double)>(f), ctxtCtS, -1, 1, 44);
         ApplyDoubleAngleIterations(ctxtEM, r);
+        modReduceTimer.Stop();
 
         algo->MultByIntegerInPlace(ctxtEM, scalar);
         result = ctxtEM;
 
-#ifdef BOOTSTRAPTIMING
-        timeEvalMod = TOC(t);
-        std::cerr << "EvalMod time: " << timeEvalMod / 1000.0 << " s" << std::endl;
-        TIC(t);
-#endif
-
 #if NATIVEINT != 128
     uint64_t corFactor = (uint64_t)1 << std::llround(correction);
     algo->MultByIntegerInPlace(result, corFactor);
@@ -965,31 +989,48 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalStCFirstBootstrap(ConstCiphertext<DCRTPoly>
 
 Ciphertext<DCRTPoly> FHECKKSRNS::EvalFuncBootstrap(ConstCiphertext<DCRTPoly> ciphertext, std::function<double(double)> func,
                                                    int num_poi, int order) const {
-    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
+    return EvalFuncBootstrapBatch({ciphertext}, HermiteLUT(func, num_poi, order))[0];
+}
+
+Ciphertext<DCRTPoly> FHECKKSRNS::EvalFuncBootstrap(ConstCiphertext<DCRTPoly> ciphertext, const HermiteLUT& lut) const {
+    return EvalFuncBootstrapBatch({ciphertext}, lut)[0];
+}
+
+std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalFuncBootstrapBatch(const std::vector<ConstCiphertext<DCRTPoly>>& ciphertexts,
+                                                                     std::function<double(double)> func, int num_poi,
+                                                                     int order) const {
+    return EvalFuncBootstrapBatch(ciphertexts, HermiteLUT(func, num_poi, order));
+}
+
+std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalFuncBootstrapBatch(const std::vector<ConstCiphertext<DCRTPoly>>& ciphertexts,
+                                                                     const HermiteLUT& lut) const {
+    if (ciphertexts.empty())
+        OPENFHE_THROW("No ciphertext to bootstrap.");
+
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertexts[0]->GetCryptoParameters());
 
     if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
         OPENFHE_THROW("CKKS Functional Bootstrapping is only supported for the Hybrid key switching method.");
-    if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL)
-        OPENFHE_THROW("CKKS Functional Bootstrapping is only supported for FIXEDMANUAL scaling.");
+    if (cryptoParams->GetScalingTechnique() == FIXEDAUTO)
+        OPENFHE_THROW("CKKS Functional Bootstrapping is only supported for FIXEDMANUAL and FLEXIBLEAUTO* scaling.");
     if(cryptoParams->GetSecretKeyDist() != SPARSE_TERNARY)
         OPENFHE_THROW("CKKS Functional Bootstrapping is only supported for SPARSE_TERNARY key.");
 #if NATIVEINT == 128 && !defined(__EMSCRIPTEN__)
     OPENFHE_THROW("128-bit CKKS Functional Bootstrapping is not supported for 128 NATIVEINT.");
 #endif
 
-#ifdef BOOTSTRAPTIMING
-    TimeVar t;
-    double timeStC(0.0);
-    double timeMR(0.0);
-    double timeCtS(0.0);
-    double timeLUT(0.0);
-#endif
-
-    auto cc     = ciphertext->GetCryptoContext();
-    uint32_t M  = cc->GetCyclotomicOrder();
-    uint32_t L0 = cryptoParams->GetElementParams()->GetParams().size();
+    auto cc = ciphertexts[0]->GetCryptoContext();
 
-    uint32_t slots = ciphertext->GetSlots();
+    // the precomputations and the conjugation key are looked up once, for the first ciphertext
+    uint32_t slots = ciphertexts[0]->GetSlots();
+    for (const auto& ciphertext : ciphertexts) {
+        if (ciphertext->GetCryptoContext() != cc)
+            OPENFHE_THROW("All ciphertexts of a batch should be created in the same CryptoContext.");
+        if (ciphertext->GetKeyTag() != ciphertexts[0]->GetKeyTag())
+            OPENFHE_THROW("All ciphertexts of a batch should be encrypted with the same keys.");
+        if (ciphertext->GetSlots() != slots)
+            OPENFHE_THROW("All ciphertexts of a batch should have the same number of slots.");
+    }
 
     auto pair = m_bootPrecomMap.find(slots);
     if (pair == m_bootPrecomMap.end()) {
@@ -999,22 +1040,8 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalFuncBootstrap(ConstCiphertext<DCRTPoly> cip
         OPENFHE_THROW(errorMsg);
     }
     const std::shared_ptr<CKKSBootstrapPrecom> precom = pair->second;
-    size_t N                                          = cc->GetRingDimension();
-
-    auto elementParamsRaised = *(cryptoParams->GetElementParams());
-
-    auto paramsQ = elementParamsRaised.GetParams();
-    usint sizeQ  = paramsQ.size();
-
-    std::vector<NativeInteger> moduli(sizeQ);
-    std::vector<NativeInteger> roots(sizeQ);
-    for (size_t i = 0; i < sizeQ; i++) {
-        moduli[i] = paramsQ[i]->GetModulus();
-        roots[i]  = paramsQ[i]->GetRootOfUnity();
-    }
-    auto elementParamsRaisedPtr = std::make_shared<ILDCRTParams<DCRTPoly::Integer>>(M, moduli, roots);
 
-    NativeInteger q = elementParamsRaisedPtr->GetParams()[0]->GetModulus().ConvertToInt();
+    NativeInteger q = cryptoParams->GetElementParams()->GetParams()[0]->GetModulus().ConvertToInt();
     double qDouble  = q.ConvertToDouble();
 
     const auto p = cryptoParams->GetPlaintextModulus();
@@ -1031,8 +1058,100 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalFuncBootstrap(ConstCiphertext<DCRTPoly> cip
 
     double pre      = 1. / post;
 
+    // The polynomial coefficients and the conjugation key are shared by the whole batch
+    int K = K_FUNC;
+    int powR = pow(2, R_FUNC);
+    auto f = [K, powR](double x) -> std::complex<double> { return std::exp(std::complex<double>(0, 2 * M_PI * K * x / powR)); };
+
+    auto coeffExp = EvalChebyshevCoefficients(f, -1, 1, 16);
+    // the LUT is interpolated at half scale as the conjugate is added back after the evaluation
+    std::vector<std::complex<double>> coeffLUT(lut.GetCoefficients());
+    for (auto& c : coeffLUT)
+        c *= 0.5;
+
+    const auto& evalKeyMap = cc->GetEvalAutomorphismKeyMap(ciphertexts[0]->GetKeyTag());
+    // a missing key is reported here, as the bootstrap itself may run in a parallel section
+    for (uint32_t index : FindFuncBootstrapAutomorphismIndices(slots, cc->GetCyclotomicOrder())) {
+        if (evalKeyMap.find(index) == evalKeyMap.end())
+            OPENFHE_THROW("EvalKey for index [" + std::to_string(index) + "] is not found." +
+                          " Need to call EvalBootstrapKeyGen or EvalFuncBootstrapKeyGen to proceed");
+    }
+
+    std::vector<Ciphertext<DCRTPoly>> result(ciphertexts.size());
+
+    if (ciphertexts.size() == 1) {
+        BootstrapRunRecorder run(m_bootStats, "EvalFuncBootstrap");
+        result[0] = EvalFuncBootstrapInternal(ciphertexts[0], precom, coeffExp, coeffLUT, lut.IsPS(), evalKeyMap, pre);
+        return result;
+    }
+
+    // One ciphertext per thread, so that the stages of different ciphertexts overlap. The sections inside
+    // EvalFuncBootstrapInternal then only get threads of their own with nested parallelism. An exception can not
+    // leave the parallel section: the first one is rethrown after it.
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 1)
+    for (size_t i = 0; i < ciphertexts.size(); i++) {
+        try {
+            // every ciphertext is a run of its own, on the thread that bootstraps it
+            BootstrapRunRecorder run(m_bootStats, "EvalFuncBootstrap");
+            result[i] =
+                EvalFuncBootstrapInternal(ciphertexts[i], precom, coeffExp, coeffLUT, lut.IsPS(), evalKeyMap, pre);
+        }
+        catch (...) {
+#pragma omp critical
+            {
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+    }
+    if (error)
+        std::rethrow_exception(error);
+
+    return result;
+}
+
+namespace {
+
+// A constant LUT has no power to evaluate, and EvalPolyLinear/EvalPolyPS need a nonzero leading coefficient: its
+// value is added to an encryption of zero at the level of the exp-encoded ciphertext instead.
+Ciphertext<DCRTPoly> EvalConstantLUT(ConstCiphertext<DCRTPoly> ctxtExp, std::complex<double> constant) {
+    auto cc     = ctxtExp->GetCryptoContext();
+    auto result = cc->EvalSub(ctxtExp, ctxtExp);
+    cc->EvalAddInPlace(result, constant);
+    return result;
+}
+
+}  // namespace
+
+// Functional bootstrapping of a single ciphertext once the setup of EvalFuncBootstrapBatch is done.
+Ciphertext<DCRTPoly> FHECKKSRNS::EvalFuncBootstrapInternal(ConstCiphertext<DCRTPoly> ciphertext,
+                                                           const std::shared_ptr<CKKSBootstrapPrecom> precom,
+                                                           const std::vector<std::complex<double>>& coeffExp,
+                                                           const std::vector<std::complex<double>>& coeffLUT, bool isPS,
+                                                           const std::map<usint, EvalKey<DCRTPoly>>& evalKeyMap,
+                                                           double pre) const {
+    // the storage of the temporaries is recycled from stage to stage, one arena per thread of a batch
+    PolyArenaScope arena;
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
+
+    auto cc        = ciphertext->GetCryptoContext();
+    uint32_t M     = cc->GetCyclotomicOrder();
+    uint32_t slots = ciphertext->GetSlots();
+
     Ciphertext<DCRTPoly> result;
 
+    auto evalLUT = [&](ConstCiphertext<DCRTPoly> ctxt) {
+        if (coeffLUT.size() == 1)
+            return EvalConstantLUT(ctxt, coeffLUT[0]);
+        return (isPS) ? cc->EvalPolyPS(ctxt, coeffLUT) : cc->EvalPolyLinear(ctxt, coeffLUT);
+    };
+
+    // The SlotsToCoeffs plaintexts are precomputed for a rescaled input
+    ConstCiphertext<DCRTPoly> ctxtIn = ciphertext;
+    if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL && ciphertext->GetNoiseScaleDeg() == 2)
+        ctxtIn = cc->GetScheme()->ModReduceInternal(ciphertext, BASE_NUM_LEVELS_TO_DROP);
+
     bool isLTBootstrap = (precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1) &&
                          (precom->m_paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1);
 
@@ -1041,62 +1160,32 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalFuncBootstrap(ConstCiphertext<DCRTPoly> cip
         // FULLY PACKED CASE
         //------------------------------------------------------------------------------
 
-#ifdef BOOTSTRAPTIMING
-    TIC(t);
-#endif
-
         //------------------------------------------------------------------------------
         // Running SlotToCoeff
         //------------------------------------------------------------------------------
 
-        auto ctxtStC = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0Pre, ciphertext):
-                                         EvalSlotsToCoeffs(precom->m_U0PreFFT, ciphertext);
-
-#ifdef BOOTSTRAPTIMING
-    timeStC = TOC(t);
-    std::cerr << "\nSlotsToCoeffs time: " << timeStC / 1000.0 << " s" << std::endl;
-    TIC(t);
-#endif
+        auto ctxtStC = TimeBootstrapStage(m_bootStats, "SlotsToCoeffs", [&] {
+            return (isLTBootstrap) ? EvalLinearTransform(precom->m_U0Pre, ctxtIn) :
+                                     EvalSlotsToCoeffs(precom->m_U0PreFFT, ctxtIn);
+        });
 
         //------------------------------------------------------------------------------
         // RAISING THE MODULUS
         //------------------------------------------------------------------------------
 
-        Ciphertext<DCRTPoly> raised = ctxtStC;
-        auto algo                   = cc->GetScheme();
-        algo->ModReduceInternalInPlace(raised, raised->GetNoiseScaleDeg() - 1);
-
-        auto ctxtDCRT = raised->GetElements();
-
-        for (size_t i = 0; i < ctxtDCRT.size(); i++) {
-            DCRTPoly temp(elementParamsRaisedPtr, COEFFICIENT);
-            ctxtDCRT[i].SetFormat(COEFFICIENT);
-            temp = ctxtDCRT[i].GetElementAtIndex(0);
-            temp.SetFormat(EVALUATION);
-            ctxtDCRT[i] = temp;
-        }
-
-        raised->SetLevel(L0 - ctxtDCRT[0].GetNumOfElements());
-        raised->SetElements(std::move(ctxtDCRT));
-
-        double constantEvalMult = pre / N;
-        cc->EvalMultInPlace(raised, constantEvalMult);
-
-#ifdef BOOTSTRAPTIMING
-    timeMR = TOC(t);
-    std::cerr << "\nModRaise time: " << timeMR / 1000.0 << " s" << std::endl;
-    TIC(t);
-#endif
+        auto algo   = cc->GetScheme();
+        auto raised = EvalFuncModRaise(ctxtStC, pre);
 
         //------------------------------------------------------------------------------
         // Running CoeffToSlot
         //------------------------------------------------------------------------------
 
-        auto ctxtCtS = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0hatTPre, raised):
-                                         EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised);
+        auto ctxtCtS = TimeBootstrapStage(m_bootStats, "CoeffsToSlots", [&] {
+            return (isLTBootstrap) ? EvalLinearTransform(precom->m_U0hatTPre, raised) :
+                                     EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised);
+        });
 
-        auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ctxtCtS->GetKeyTag());
-        auto conj       = Conjugate(ctxtCtS, evalKeyMap);
+        auto conj = Conjugate(ctxtCtS, evalKeyMap);
         Ciphertext<DCRTPoly> ctxtCtSI;
         
         bool use_imslots = true;
@@ -1157,20 +1246,10 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalFuncBootstrap(ConstCiphertext<DCRTPoly> cip
             }
         }
 
-#ifdef BOOTSTRAPTIMING
-    timeCtS = TOC(t);
-    std::cerr << "CoeffsToSlots time: " << timeCtS / 1000.0 << " s" << std::endl;
-    TIC(t);
-#endif
-
         //------------------------------------------------------------------------------
         // Running EvalLUT
         //------------------------------------------------------------------------------
 
-        int K = K_FUNC;
-        int powR = pow(2, R_FUNC);
-        auto f = [K, powR](double x) -> std::complex<double> { return std::exp(std::complex<double>(0, 2 * M_PI * K * x / powR)); };
-
         if (use_imslots) {
             Ciphertext<DCRTPoly> ctxtInterp, ctxtInterpI;
 
@@ -1178,95 +1257,180 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalFuncBootstrap(ConstCiphertext<DCRTPoly> cip
             {
                 #pragma omp section
                 {
-                    auto ctxtExp = cc->EvalChebyshevFunction(f, ctxtCtS, -1, 1, 16); // 14 low
-                    for (uint32_t i = 0; i < R_FUNC; ++i) {
-                        cc->EvalSquareInPlace(ctxtExp);
-                        cc->ModReduceInPlace(ctxtExp);
-                    }
-
-                    ctxtInterp = cc->EvalHermiteFunction([func](double x) -> double { return 0.5 * func(x); }, ctxtExp, num_poi, order);
+                    auto ctxtExp = TimeBootstrapStage(m_bootStats, "ExpChebyshev", [&] { return cc->EvalChebyshevSeries(ctxtCtS, coeffExp, -1, 1); }); // 14 low
+                    TimeBootstrapStage(m_bootStats, "Squarings", [&] {
+                        for (uint32_t i = 0; i < R_FUNC; ++i) {
+                            cc->EvalSquareInPlace(ctxtExp);
+                            cc->ModReduceInPlace(ctxtExp);
+                        }
+                    });
 
-                    conj = Conjugate(ctxtInterp, evalKeyMap);
-                    cc->EvalAddInPlace(ctxtInterp, conj);
+                    ctxtInterp = TimeBootstrapStage(m_bootStats, "Hermite", [&] { return evalLUT(ctxtExp); });
                 }
 
                 #pragma omp section
                 {
-                    auto ctxtExpI = cc->EvalChebyshevFunction(f, ctxtCtSI, -1, 1, 16);
-                    for (uint32_t i = 0; i < R_FUNC; ++i) {
-                        cc->EvalSquareInPlace(ctxtExpI);
-                        cc->ModReduceInPlace(ctxtExpI);
-                    }
-
-                    ctxtInterpI = cc->EvalHermiteFunction([func](double x) -> double { return 0.5 * func(x); }, ctxtExpI, num_poi, order);
+                    auto ctxtExpI = TimeBootstrapStage(m_bootStats, "ExpChebyshev", [&] { return cc->EvalChebyshevSeries(ctxtCtSI, coeffExp, -1, 1); });
+                    TimeBootstrapStage(m_bootStats, "Squarings", [&] {
+                        for (uint32_t i = 0; i < R_FUNC; ++i) {
+                            cc->EvalSquareInPlace(ctxtExpI);
+                            cc->ModReduceInPlace(ctxtExpI);
+                        }
+                    });
 
-                    conj = Conjugate(ctxtInterpI, evalKeyMap);
-                    cc->EvalAddInPlace(ctxtInterpI, conj);
+                    ctxtInterpI = TimeBootstrapStage(m_bootStats, "Hermite", [&] { return evalLUT(ctxtExpI); });
 
                     algo->MultByMonomialInPlace(ctxtInterpI, M / 4);
                 }
             }
 
-            result = cc->EvalAdd(ctxtInterp, ctxtInterpI);
+            // both real parts are extracted with a single conjugation: for the evaluations A and B (at half scale),
+            // (A + conj(A)) + i (B + conj(B)) = (A + iB) + conj(A - iB)
+            auto ctxtDiff = cc->EvalSub(ctxtInterp, ctxtInterpI);
+            result        = cc->EvalAdd(ctxtInterp, ctxtInterpI);
+            cc->EvalAddInPlace(result, Conjugate(ctxtDiff, evalKeyMap));
         }
         else {
-            auto ctxtExp = cc->EvalChebyshevFunction(f, ctxtCtS, -1, 1, 16); // 14 low
+            auto ctxtExp = TimeBootstrapStage(m_bootStats, "ExpChebyshev", [&] { return cc->EvalChebyshevSeries(ctxtCtS, coeffExp, -1, 1); }); // 14 low
+            TimeBootstrapStage(m_bootStats, "Squarings", [&] {
+                for (uint32_t i = 0; i < R_FUNC; ++i) {
+                    cc->EvalSquareInPlace(ctxtExp);
+                    cc->ModReduceInPlace(ctxtExp);
+                }
+            });
+
+            auto ctxtInterp = TimeBootstrapStage(m_bootStats, "Hermite", [&] { return evalLUT(ctxtExp); });
+
+            cc->EvalAddInPlace(ctxtInterp, Conjugate(ctxtInterp, evalKeyMap));
+
+            result = ctxtInterp;
+        }
+
+    }
+    else {
+        //------------------------------------------------------------------------------
+        // SPARSELY PACKED CASE
+        //------------------------------------------------------------------------------
+
+        auto ctxtCtS = EvalFuncSparseCoeffsToSlots(ctxtIn, pre);
+
+        //------------------------------------------------------------------------------
+        // Running EvalLUT
+        //------------------------------------------------------------------------------
+
+        // real and imaginary parts share a single LUT evaluation over 2 * slots slots
+        auto ctxtExp = TimeBootstrapStage(m_bootStats, "ExpChebyshev", [&] { return cc->EvalChebyshevSeries(ctxtCtS, coeffExp, -1, 1); });
+        TimeBootstrapStage(m_bootStats, "Squarings", [&] {
             for (uint32_t i = 0; i < R_FUNC; ++i) {
                 cc->EvalSquareInPlace(ctxtExp);
                 cc->ModReduceInPlace(ctxtExp);
             }
+        });
 
-            auto ctxtInterp = cc->EvalHermiteFunction([func](double x) -> double { return 0.5 * func(x); }, ctxtExp, num_poi, order);
+        auto ctxtInterp = TimeBootstrapStage(m_bootStats, "Hermite", [&] { return evalLUT(ctxtExp); });
 
-            conj = Conjugate(ctxtInterp, evalKeyMap);
-            cc->EvalAddInPlace(ctxtInterp, conj);
+        cc->EvalAddInPlace(ctxtInterp, Conjugate(ctxtInterp, evalKeyMap));
 
-            result = ctxtInterp;
-        }
+        result = EvalFuncSparseMerge(ctxtInterp, std::complex<double>(0, 1));
 
-#ifdef BOOTSTRAPTIMING
-    timeLUT = TOC(t);
-    std::cerr << "EvalLUT time: " << (timeLUT) / 1000.0 << " s" << std::endl;
-#endif
+    }
+
+    return result;
+}
+
+
+
+namespace {
 
+// Highest degree among the LUT polynomials evaluated on the same powers; Hermite LUTs of order 2 and 3 have a
+// degree above the number of points.
+uint32_t MaxDegree(const std::vector<std::vector<std::complex<double>>>& coeffs) {
+    uint32_t degree = 0;
+    for (const auto& coeff : coeffs)
+        degree = std::max(degree, Degree(coeff));
+    return degree;
+}
+
+// Same choice as EvalPoly and HermiteLUT::IsPS for complex coefficients
+bool UsePSForDegree(uint32_t degree) {
+    return 4 < degree && degree < 17;
+}
+
+// Key switches saved by conjugating the shared powers of an exp-encoded ciphertext once, instead of conjugating
+// nbConj outputs among the nbOut LUTs of the given degree evaluated on it: the conjugated powers need the linear
+// evaluation, whose outputs are then plain weighted sums, while Paterson-Stockmeyer needs non-scalar products for
+// each output.
+bool ConjugatePowersIsCheaper(uint32_t degree, size_t nbOut, size_t nbConj) {
+    if (degree == 0)
+        return false;
+    bool use_ps = UsePSForDegree(degree);
+
+    // the linear evaluation is one level deeper than Paterson-Stockmeyer for some degrees, but never for 2^b points
+    if (use_ps && ((degree + 1) & degree))
+        return false;
+
+    size_t costConjPowers = (degree - 1) + degree;
+    size_t costConjOutputs;
+    if (use_ps) {
+        std::vector<uint32_t> degs = ComputeDegreesPS(degree);
+        uint32_t k = degs[0];
+        uint32_t m = degs[1];
+        costConjOutputs = (k + 2 * m - 3) + nbOut * ((1 << (m - 1)) - 1) + nbConj;
     }
     else {
-        OPENFHE_THROW("Sparse packing Functional Bootstrapping not yet implemented.");
+        costConjOutputs = (degree - 1) + nbConj;
     }
 
-    return result;
+    return costConjPowers < costConjOutputs;
 }
 
+}  // namespace
+
 
 
 std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalFuncMVBootstrap(ConstCiphertext<DCRTPoly> ciphertext, std::vector<std::function<double(double)>> func_vec,
                                                                   int num_poi, int order) const {
+    if (order != 1) {
+        std::cout << "Setting order back to one as only order 1 currently supported.";
+        order = 1;
+    }
+
+    std::vector<HermiteLUT> luts;
+    luts.reserve(func_vec.size());
+    for (const auto& func : func_vec)
+        luts.emplace_back(func, num_poi, order);
+
+    return EvalFuncMVBootstrap(ciphertext, luts);
+}
+
+std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalFuncMVBootstrap(ConstCiphertext<DCRTPoly> ciphertext,
+                                                                  const std::vector<HermiteLUT>& luts) const {
+    PolyArenaScope arena;
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
 
     if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
         OPENFHE_THROW("CKKS Functional Bootstrapping is only supported for the Hybrid key switching method.");
-    if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL)
-        OPENFHE_THROW("CKKS Functional Bootstrapping is only supported for FIXEDMANUAL scaling.");
+    if (cryptoParams->GetScalingTechnique() == FIXEDAUTO)
+        OPENFHE_THROW("CKKS Functional Bootstrapping is only supported for FIXEDMANUAL and FLEXIBLEAUTO* scaling.");
     if(cryptoParams->GetSecretKeyDist() != SPARSE_TERNARY)
         OPENFHE_THROW("CKKS Functional Bootstrapping is only supported for SPARSE_TERNARY key.");
 #if NATIVEINT == 128 && !defined(__EMSCRIPTEN__)
     OPENFHE_THROW("128-bit CKKS Functional Bootstrapping is not supported for 128 NATIVEINT.");
 #endif
-    if (order != 1) {
-        std::cout << "Setting order back to one as only order 1 currently supported.";
-        order = 1;
+    if (luts.empty())
+        OPENFHE_THROW("No LUT to evaluate.");
+    int num_poi = luts[0].GetNumPoints();
+    for (const auto& lut : luts) {
+        if (lut.GetOrder() != 1)
+            OPENFHE_THROW("Only order 1 Hermite interpolation is supported for Multi-Value Functional Bootstrapping.");
+        if (static_cast<int>(lut.GetNumPoints()) != num_poi)
+            OPENFHE_THROW("All LUTs of a Multi-Value Functional Bootstrapping should have the same number of points.");
     }
 
-#ifdef BOOTSTRAPTIMING
-    TimeVar t;
-    double timeStC(0.0);
-    double timeCtS(0.0);
-    double timeLUT(0.0);
-#endif
+    BootstrapRunRecorder run(m_bootStats, "EvalFuncMVBootstrap");
 
-    auto cc     = ciphertext->GetCryptoContext();
-    uint32_t M  = cc->GetCyclotomicOrder();
-    uint32_t L0 = cryptoParams->GetElementParams()->GetParams().size();
+    auto cc    = ciphertext->GetCryptoContext();
+    uint32_t M = cc->GetCyclotomicOrder();
 
     uint32_t slots = ciphertext->GetSlots();
 
@@ -1278,22 +1442,8 @@ std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalFuncMVBootstrap(ConstCiphertex
         OPENFHE_THROW(errorMsg);
     }
     const std::shared_ptr<CKKSBootstrapPrecom> precom = pair->second;
-    size_t N                                          = cc->GetRingDimension();
-
-    auto elementParamsRaised = *(cryptoParams->GetElementParams());
-
-    auto paramsQ = elementParamsRaised.GetParams();
-    usint sizeQ  = paramsQ.size();
-
-    std::vector<NativeInteger> moduli(sizeQ);
-    std::vector<NativeInteger> roots(sizeQ);
-    for (size_t i = 0; i < sizeQ; i++) {
-        moduli[i] = paramsQ[i]->GetModulus();
-        roots[i]  = paramsQ[i]->GetRootOfUnity();
-    }
-    auto elementParamsRaisedPtr = std::make_shared<ILDCRTParams<DCRTPoly::Integer>>(M, moduli, roots);
 
-    NativeInteger q = elementParamsRaisedPtr->GetParams()[0]->GetModulus().ConvertToInt();
+    NativeInteger q = cryptoParams->GetElementParams()->GetParams()[0]->GetModulus().ConvertToInt();
     double qDouble  = q.ConvertToDouble();
 
     const auto p = cryptoParams->GetPlaintextModulus();
@@ -1310,9 +1460,22 @@ std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalFuncMVBootstrap(ConstCiphertex
 
     double pre      = 1. / post;
 
-    size_t nb_func = func_vec.size();
+    size_t nb_func = luts.size();
     std::vector<Ciphertext<DCRTPoly>> result(nb_func);
 
+    // the LUTs are interpolated at half scale as the conjugates are added back after the evaluation
+    std::vector<std::vector<std::complex<double>>> coeffLUT(nb_func);
+    for (size_t i = 0; i < nb_func; ++i) {
+        coeffLUT[i] = luts[i].GetCoefficients();
+        for (auto& c : coeffLUT[i])
+            c *= 0.5;
+    }
+
+    // The SlotsToCoeffs plaintexts are precomputed for a rescaled input
+    ConstCiphertext<DCRTPoly> ctxtIn = ciphertext;
+    if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL && ciphertext->GetNoiseScaleDeg() == 2)
+        ctxtIn = cc->GetScheme()->ModReduceInternal(ciphertext, BASE_NUM_LEVELS_TO_DROP);
+
     bool isLTBootstrap = (precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1) &&
                          (precom->m_paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1);
 
@@ -1321,52 +1484,29 @@ std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalFuncMVBootstrap(ConstCiphertex
         // FULLY PACKED CASE
         //------------------------------------------------------------------------------
 
-#ifdef BOOTSTRAPTIMING
-    TIC(t);
-#endif
-
         //------------------------------------------------------------------------------
         // Running SlotToCoeff
         //------------------------------------------------------------------------------
 
-        auto ctxtStC = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0Pre, ciphertext):
-                                         EvalSlotsToCoeffs(precom->m_U0PreFFT, ciphertext);
-
-#ifdef BOOTSTRAPTIMING
-    timeStC = TOC(t);
-    std::cerr << "\nSlotsToCoeffs time: " << timeStC / 1000.0 << " s" << std::endl;
-    TIC(t);
-#endif
+        auto ctxtStC = TimeBootstrapStage(m_bootStats, "SlotsToCoeffs", [&] {
+            return (isLTBootstrap) ? EvalLinearTransform(precom->m_U0Pre, ctxtIn) :
+                                     EvalSlotsToCoeffs(precom->m_U0PreFFT, ctxtIn);
+        });
 
         //------------------------------------------------------------------------------
         // RAISING THE MODULUS
         //------------------------------------------------------------------------------
-        Ciphertext<DCRTPoly> raised = ctxtStC;
-        auto algo                   = cc->GetScheme();
-        algo->ModReduceInternalInPlace(raised, raised->GetNoiseScaleDeg() - 1);
+        auto algo   = cc->GetScheme();
+        auto raised = EvalFuncModRaise(ctxtStC, pre);
 
-        auto ctxtDCRT = raised->GetElements();
+        //------------------------------------------------------------------------------
+        // Running CoeffToSlot
+        //------------------------------------------------------------------------------
 
-        for (size_t i = 0; i < ctxtDCRT.size(); i++) {
-            DCRTPoly temp(elementParamsRaisedPtr, COEFFICIENT);
-            ctxtDCRT[i].SetFormat(COEFFICIENT);
-            temp = ctxtDCRT[i].GetElementAtIndex(0);
-            temp.SetFormat(EVALUATION);
-            ctxtDCRT[i] = temp;
-        }
-
-        raised->SetLevel(L0 - ctxtDCRT[0].GetNumOfElements());
-        raised->SetElements(std::move(ctxtDCRT));
-
-        double constantEvalMult = pre / N;
-        cc->EvalMultInPlace(raised, constantEvalMult);
-
-        //------------------------------------------------------------------------------
-        // Running CoeffToSlot
-        //------------------------------------------------------------------------------
-
-        auto ctxtCtS = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0hatTPre, raised):
-                                         EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised);
+        auto ctxtCtS = TimeBootstrapStage(m_bootStats, "CoeffsToSlots", [&] {
+            return (isLTBootstrap) ? EvalLinearTransform(precom->m_U0hatTPre, raised) :
+                                     EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised);
+        });
 
         auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ctxtCtS->GetKeyTag());
         auto conj       = Conjugate(ctxtCtS, evalKeyMap);
@@ -1430,12 +1570,6 @@ std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalFuncMVBootstrap(ConstCiphertex
             }
         }
 
-#ifdef BOOTSTRAPTIMING
-    timeCtS = TOC(t);
-    std::cerr << "ModRaise + CoeffsToSlots time: " << timeCtS / 1000.0 << " s" << std::endl;
-    TIC(t);
-#endif
-
         //------------------------------------------------------------------------------
         // Running EvalLUT
         //------------------------------------------------------------------------------
@@ -1444,530 +1578,321 @@ std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalFuncMVBootstrap(ConstCiphertex
         int powR = pow(2, R_FUNC);
         auto f = [K, powR](double x) -> std::complex<double> { return std::exp(std::complex<double>(0, 2 * M_PI * K * x / powR)); };
 
-        bool use_ps = num_poi > 3 && num_poi < 17;
-
         if (use_imslots) {
-            std::vector<Ciphertext<DCRTPoly>> ctxtInterp(nb_func), ctxtInterpI(nb_func);
+            std::vector<Ciphertext<DCRTPoly>> ctxtInterp, ctxtInterpI;
+
+            // the real parts of the evaluations A and B (at half scale) on the real and imaginary inputs are either
+            // extracted through conjugated powers, or together with a single conjugation per output:
+            // (A + conj(A)) + i (B + conj(B)) = (A + iB) + conj(A - iB)
+            bool realParts = ConjugatePowersIsCheaper(MaxDegree(coeffLUT), nb_func, (nb_func + 1) / 2);
 
             #pragma omp parallel sections
             {
                 #pragma omp section
                 {
-                    auto ctxtExp = cc->EvalChebyshevFunction(f, ctxtCtS, -1, 1, 16); // 14 low
-                    for (uint32_t i = 0; i < R_FUNC; ++i) {
-                        cc->EvalSquareInPlace(ctxtExp);
-                        cc->ModReduceInPlace(ctxtExp);
-                    }
-
-                    if (use_ps) {
-                        auto ctxtVecPowersExp = cc->ComputePowersPS(ctxtExp, num_poi - 1);
-                        auto ctxtPowersExp = ctxtVecPowersExp[0];
-                        auto ctxtPowers2Exp = ctxtVecPowersExp[1];
-                        auto ctxtPower2km1Exp = ctxtVecPowersExp[2][0];
-
-                        #pragma omp parallel for
-                        for (size_t i = 0; i < nb_func; ++i) {
-                            auto& func = func_vec[i];
-                            ctxtInterp[i] = cc->EvalHermitePrecomPSFunction([func](double x) -> double { return 0.5 * func(x); }, ctxtPowersExp, ctxtPowers2Exp, ctxtPower2km1Exp, num_poi);
-                            conj = Conjugate(ctxtInterp[i], evalKeyMap);
-                            cc->EvalAddInPlace(ctxtInterp[i], conj);
+                    auto ctxtExp = TimeBootstrapStage(m_bootStats, "ExpChebyshev", [&] { return cc->EvalChebyshevFunction(f, ctxtCtS, -1, 1, 16); }); // 14 low
+                    TimeBootstrapStage(m_bootStats, "Squarings", [&] {
+                        for (uint32_t i = 0; i < R_FUNC; ++i) {
+                            cc->EvalSquareInPlace(ctxtExp);
+                            cc->ModReduceInPlace(ctxtExp);
                         }
-                    }
-                    else {
-                        auto ctxtPowersExp = cc->ComputePowersLinear(ctxtExp, num_poi - 1);
-
-                        #pragma omp parallel for
-                        for (size_t i = 0; i < nb_func; ++i) {
-                            auto& func = func_vec[i];
-                            ctxtInterp[i] = cc->EvalHermitePrecomLinearFunction([func](double x) -> double { return 0.5 * func(x); }, ctxtPowersExp, num_poi);
-                            conj = Conjugate(ctxtInterp[i], evalKeyMap);
-                            cc->EvalAddInPlace(ctxtInterp[i], conj);
-                        }
-                    }
+                    });
+
+                    ctxtInterp = EvalFuncLUTs(ctxtExp, coeffLUT, realParts);
                 }
 
                 #pragma omp section
                 {
-                    auto ctxtExpI = cc->EvalChebyshevFunction(f, ctxtCtSI, -1, 1, 16);
-                    for (uint32_t i = 0; i < R_FUNC; ++i) {
-                        cc->EvalSquareInPlace(ctxtExpI);
-                        cc->ModReduceInPlace(ctxtExpI);
-                    }
-
-                    if (use_ps) {
-                        auto ctxtVecPowersExpI = cc->ComputePowersPS(ctxtExpI, num_poi - 1);
-                        auto ctxtPowersExpI = ctxtVecPowersExpI[0];
-                        auto ctxtPowers2ExpI = ctxtVecPowersExpI[1];
-                        auto ctxtPower2km1ExpI = ctxtVecPowersExpI[2][0];
-
-                        #pragma omp parallel for
-                        for (size_t i = 0; i < nb_func; ++i) {
-                            auto& func = func_vec[i];
-                            ctxtInterpI[i] = cc->EvalHermitePrecomPSFunction([func](double x) -> double { return 0.5 * func(x); }, ctxtPowersExpI, ctxtPowers2ExpI, ctxtPower2km1ExpI, num_poi);
-                            conj = Conjugate(ctxtInterpI[i], evalKeyMap);
-                            cc->EvalAddInPlace(ctxtInterpI[i], conj);
-
-                            algo->MultByMonomialInPlace(ctxtInterpI[i], M / 4);
+                    auto ctxtExpI = TimeBootstrapStage(m_bootStats, "ExpChebyshev", [&] { return cc->EvalChebyshevFunction(f, ctxtCtSI, -1, 1, 16); });
+                    TimeBootstrapStage(m_bootStats, "Squarings", [&] {
+                        for (uint32_t i = 0; i < R_FUNC; ++i) {
+                            cc->EvalSquareInPlace(ctxtExpI);
+                            cc->ModReduceInPlace(ctxtExpI);
                         }
-                    }
-                    else {
-                        auto ctxtPowersExpI = cc->ComputePowersLinear(ctxtExpI, num_poi - 1);
+                    });
 
-                        #pragma omp parallel for
-                        for (size_t i = 0; i < nb_func; ++i) {
-                            auto& func = func_vec[i];
-                            ctxtInterpI[i] = cc->EvalHermitePrecomLinearFunction([func](double x) -> double { return 0.5 * func(x); }, ctxtPowersExpI, num_poi);
-                            conj = Conjugate(ctxtInterpI[i], evalKeyMap);
-                            cc->EvalAddInPlace(ctxtInterpI[i], conj);
-
-                            algo->MultByMonomialInPlace(ctxtInterpI[i], M / 4);
-                        }
-                    }
+                    ctxtInterpI = EvalFuncLUTs(ctxtExpI, coeffLUT, realParts);
                 }
             }
 
             #pragma omp parallel for
             for (size_t i = 0; i < nb_func; ++i) {
+                algo->MultByMonomialInPlace(ctxtInterpI[i], M / 4);
                 result[i] = cc->EvalAdd(ctxtInterp[i], ctxtInterpI[i]);
+                if (!realParts) {
+                    auto ctxtDiff = cc->EvalSub(ctxtInterp[i], ctxtInterpI[i]);
+                    cc->EvalAddInPlace(result[i], Conjugate(ctxtDiff, evalKeyMap));
+                }
             }
         }
         else {
-            std::vector<Ciphertext<DCRTPoly>> ctxtInterp(nb_func);
+            auto ctxtExp = TimeBootstrapStage(m_bootStats, "ExpChebyshev", [&] { return cc->EvalChebyshevFunction(f, ctxtCtS, -1, 1, 16); }); // 14 low
+            TimeBootstrapStage(m_bootStats, "Squarings", [&] {
+                for (uint32_t i = 0; i < R_FUNC; ++i) {
+                    cc->EvalSquareInPlace(ctxtExp);
+                    cc->ModReduceInPlace(ctxtExp);
+                }
+            });
+
+            result = EvalFuncLUTs(ctxtExp, coeffLUT, true);
+        }
+
+    }
+    else {
+        //------------------------------------------------------------------------------
+        // SPARSELY PACKED CASE
+        //------------------------------------------------------------------------------
+
+        auto ctxtCtS = EvalFuncSparseCoeffsToSlots(ctxtIn, pre);
 
-            auto ctxtExp = cc->EvalChebyshevFunction(f, ctxtCtS, -1, 1, 16); // 14 low
+        //------------------------------------------------------------------------------
+        // Running EvalLUT
+        //------------------------------------------------------------------------------
+
+        int K = K_FUNC;
+        int powR = pow(2, R_FUNC);
+        auto f = [K, powR](double x) -> std::complex<double> { return std::exp(std::complex<double>(0, 2 * M_PI * K * x / powR)); };
+
+        // real and imaginary parts share a single set of powers over 2 * slots slots
+        auto ctxtExp = TimeBootstrapStage(m_bootStats, "ExpChebyshev", [&] { return cc->EvalChebyshevFunction(f, ctxtCtS, -1, 1, 16); });
+        TimeBootstrapStage(m_bootStats, "Squarings", [&] {
             for (uint32_t i = 0; i < R_FUNC; ++i) {
                 cc->EvalSquareInPlace(ctxtExp);
                 cc->ModReduceInPlace(ctxtExp);
             }
+        });
 
-            auto ctxtVecPowersExp = cc->ComputePowersPS(ctxtExp, num_poi - 1);
-            auto ctxtPowersExp = ctxtVecPowersExp[0];
-            auto ctxtPowers2Exp = ctxtVecPowersExp[1];
-            auto ctxtPower2km1Exp = ctxtVecPowersExp[2][0];
+        auto ctxtInterp = EvalFuncLUTs(ctxtExp, coeffLUT, true);
 
-            #pragma omp parallel for
-            for (size_t i = 0; i < nb_func; ++i) {
-                auto& func = func_vec[i];
-                ctxtInterp[i] = cc->EvalHermitePrecomPSFunction([func](double x) -> double { return 0.5 * func(x); }, ctxtPowersExp, ctxtPowers2Exp, ctxtPower2km1Exp, num_poi);
-                conj = Conjugate(ctxtInterp[i], evalKeyMap);
-                cc->EvalAddInPlace(ctxtInterp[i], conj);
+        #pragma omp parallel for
+        for (size_t i = 0; i < nb_func; ++i) {
+            result[i] = EvalFuncSparseMerge(ctxtInterp[i], std::complex<double>(0, 1));
+        }
+
+    }
+
+    return result;
+}
+
+std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalFuncMultiLUT(ConstCiphertext<DCRTPoly> ciphertext,
+                                                               const std::vector<HermiteLUT>& luts) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
+
+    if (cryptoParams->GetScalingTechnique() == FIXEDAUTO)
+        OPENFHE_THROW("Multi-LUT evaluation is only supported for FIXEDMANUAL and FLEXIBLEAUTO* scaling.");
+    if (luts.empty())
+        OPENFHE_THROW("No LUT to evaluate.");
+    uint32_t num_poi = luts[0].GetNumPoints();
+    std::vector<std::vector<std::complex<double>>> coeffLUT(luts.size());
+    for (size_t i = 0; i < luts.size(); ++i) {
+        if (luts[i].GetNumPoints() != num_poi)
+            OPENFHE_THROW("All LUTs of a multi-LUT evaluation should have the same number of points.");
+        coeffLUT[i] = luts[i].GetCoefficients();
+    }
+
+    return EvalFuncLUTs(ciphertext, coeffLUT, false);
+}
+
+
+
+std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalFuncLUTs(ConstCiphertext<DCRTPoly> ctxtExp,
+                                                           const std::vector<std::vector<std::complex<double>>>& coeffs,
+                                                           bool realPart) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ctxtExp->GetCryptoParameters());
+
+    auto cc      = ctxtExp->GetCryptoContext();
+    size_t nbOut = coeffs.size();
+
+    std::vector<Ciphertext<DCRTPoly>> result(nbOut);
+
+    // the polynomial evaluations need a nonzero leading coefficient; constant LUTs are evaluated by EvalConstantLUT
+    std::vector<std::vector<std::complex<double>>> coeffLUT(coeffs);
+    for (auto& coeff : coeffLUT)
+        coeff.resize(Degree(coeff) + 1);
+
+    // the powers are computed once for the highest degree, which is above the number of points for Hermite
+    // interpolations of order 2 and 3
+    uint32_t degree = MaxDegree(coeffLUT);
+
+    if (realPart && ConjugatePowersIsCheaper(degree, nbOut, nbOut)) {
+        // P + conj(P) = sum_j Re(c_j) (z^j + conj(z^j)) + Im(c_j) i (z^j - conj(z^j)): once the powers are
+        // conjugated, every output is a real weighted sum of these shared combinations
+        auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ctxtExp->GetKeyTag());
+        auto algo       = cc->GetScheme();
+        uint32_t M      = cc->GetCyclotomicOrder();
+        auto ctxtPowers = TimeBootstrapStage(m_bootStats, "Hermite", [&] { return cc->ComputePowersLinear(ctxtExp, degree); });
+
+        std::vector<Ciphertext<DCRTPoly>> ctxtParts(2 * degree);
+        #pragma omp parallel for
+        for (uint32_t j = 0; j < degree; ++j) {
+            auto conj = Conjugate(ctxtPowers[j], evalKeyMap);
+            auto diff = cc->EvalSub(ctxtPowers[j], conj);
+            algo->MultByMonomialInPlace(diff, M / 4);
+            ctxtParts[j]          = cc->EvalAdd(ctxtPowers[j], conj);
+            ctxtParts[degree + j] = diff;
+        }
+
+        // the combinations are brought to a common level once, rather than in every weighted sum
+        if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL) {
+            uint32_t maxIdx = 0;
+            for (uint32_t j = 1; j < 2 * degree; ++j) {
+                if ((ctxtParts[j]->GetLevel() > ctxtParts[maxIdx]->GetLevel()) ||
+                    ((ctxtParts[j]->GetLevel() == ctxtParts[maxIdx]->GetLevel()) && (ctxtParts[j]->GetNoiseScaleDeg() == 2)))
+                    maxIdx = j;
             }
 
             #pragma omp parallel for
-            for (size_t i = 0; i < nb_func; ++i) {
-                result[i] = ctxtInterp[i];
+            for (uint32_t j = 0; j < 2 * degree; ++j) {
+                if (j != maxIdx)
+                    algo->AdjustLevelsAndDepthInPlace(ctxtParts[j], ctxtParts[maxIdx]);
+            }
+
+            if (ctxtParts[maxIdx]->GetNoiseScaleDeg() == 2) {
+                #pragma omp parallel for
+                for (uint32_t j = 0; j < 2 * degree; ++j)
+                    algo->ModReduceInternalInPlace(ctxtParts[j], BASE_NUM_LEVELS_TO_DROP);
             }
         }
 
-#ifdef BOOTSTRAPTIMING
-    timeLUT = TOC(t);
-    std::cerr << "EvalLUT time: " << (timeLUT) / 1000.0 << " s" << std::endl;
-#endif
+        std::vector<ConstCiphertext<DCRTPoly>> ctxtSums(ctxtParts.begin(), ctxtParts.end());
+
+        #pragma omp parallel for
+        for (size_t i = 0; i < nbOut; ++i) {
+            const auto& coeff = coeffLUT[i];
+
+            std::vector<double> weights(2 * degree, 0.0);
+            for (uint32_t j = 1; j < coeff.size() && j <= degree; ++j) {
+                weights[j - 1]          = coeff[j].real();
+                weights[degree + j - 1] = coeff[j].imag();
+            }
+
+            result[i] = TimeBootstrapStage(m_bootStats, "Hermite", [&] {
+                auto sum = cc->EvalLinearWSum(ctxtSums, weights);
+                cc->EvalAddInPlace(sum, 2 * coeff[0].real());
+                return sum;
+            });
+        }
+
+        return result;
+    }
 
+    if (degree == 0) {
+        #pragma omp parallel for
+        for (size_t i = 0; i < nbOut; ++i)
+            result[i] = EvalConstantLUT(ctxtExp, coeffLUT[i][0]);
+    }
+    else if (UsePSForDegree(degree)) {
+        auto ctxtVecPowers = TimeBootstrapStage(m_bootStats, "Hermite", [&] { return cc->ComputePowersPS(ctxtExp, degree); });
+
+        #pragma omp parallel for
+        for (size_t i = 0; i < nbOut; ++i) {
+            // with the FLEXIBLEAUTO* techniques, the evaluation adjusts the levels of the powers in place
+            std::vector<Ciphertext<DCRTPoly>> ctxtPowers(ctxtVecPowers[0]);
+            if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL) {
+                for (auto& power : ctxtPowers)
+                    power = power->Clone();
+            }
+            if (coeffLUT[i].size() == 1)
+                result[i] = EvalConstantLUT(ctxtExp, coeffLUT[i][0]);
+            else
+                result[i] = TimeBootstrapStage(m_bootStats, "Hermite", [&] { return cc->EvalPolyPS(ctxtPowers, ctxtVecPowers[1], ctxtVecPowers[2][0], coeffLUT[i]); });
+        }
     }
     else {
-        OPENFHE_THROW("Sparse packing Functional Bootstrapping not yet implemented.");
+        auto ctxtPowers = TimeBootstrapStage(m_bootStats, "Hermite", [&] { return cc->ComputePowersLinear(ctxtExp, degree); });
+
+        #pragma omp parallel for
+        for (size_t i = 0; i < nbOut; ++i) {
+            if (coeffLUT[i].size() == 1)
+                result[i] = EvalConstantLUT(ctxtExp, coeffLUT[i][0]);
+            else
+                result[i] = TimeBootstrapStage(m_bootStats, "Hermite", [&] { return cc->EvalPolyLinear(ctxtPowers, coeffLUT[i]); });
+        }
+    }
+
+    if (realPart) {
+        auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ctxtExp->GetKeyTag());
+
+        #pragma omp parallel for
+        for (size_t i = 0; i < nbOut; ++i) {
+            cc->EvalAddInPlace(result[i], Conjugate(result[i], evalKeyMap));
+        }
     }
 
     return result;
 }
 
-// WIP: @jdumezy
-/*std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalFuncTreeMVB(std::vector<ConstCiphertext<DCRTPoly>> ciphertextVec, std::function<double(double)> func_vec,*/
-/*                                                              int num_poi, int order) const {*/
-/*    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertextVec[0]->GetCryptoParameters());*/
-/**/
-/*    if (cryptoParams->GetKeySwitchTechnique() != HYBRID)*/
-/*        OPENFHE_THROW("CKKS Functional Bootstrapping is only supported for the Hybrid key switching method.");*/
-/*    if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL)*/
-/*        OPENFHE_THROW("CKKS Functional Bootstrapping is only supported for FIXEDMANUAL scaling.");*/
-/*    if(cryptoParams->GetSecretKeyDist() != SPARSE_TERNARY)*/
-/*        OPENFHE_THROW("CKKS Functional Bootstrapping is only supported for SPARSE_TERNARY key.");*/
-/*#if NATIVEINT == 128 && !defined(__EMSCRIPTEN__)*/
-/*    OPENFHE_THROW("128-bit CKKS Functional Bootstrapping is not supported for 128 NATIVEINT.");*/
-/*#endif*/
-/**/
-/*#ifdef BOOTSTRAPTIMING*/
-/*    TimeVar t;*/
-/*    double timeStC(0.0);*/
-/*    double timeCtS(0.0);*/
-/*    double timeLUT(0.0);*/
-/*#endif*/
-/**/
-/*    auto cc     = ciphertextVec[0]->GetCryptoContext();*/
-/*    uint32_t M  = cc->GetCyclotomicOrder();*/
-/*    uint32_t L0 = cryptoParams->GetElementParams()->GetParams().size();*/
-/**/
-/*    uint32_t slots = ciphertextVec[0]->GetSlots();*/
-/**/
-/*    auto pair = m_bootPrecomMap.find(slots);*/
-/*    if (pair == m_bootPrecomMap.end()) {*/
-/*        std::string errorMsg(std::string("Precomputations for ") + std::to_string(slots) +*/
-/*                             std::string(" slots were not generated") +*/
-/*                             std::string(" Need to call EvalBootstrapSetup and then EvalBootstrapKeyGen to proceed"));*/
-/*        OPENFHE_THROW(errorMsg);*/
-/*    }*/
-/*    const std::shared_ptr<CKKSBootstrapPrecom> precom = pair->second;*/
-/*    size_t N                                          = cc->GetRingDimension();*/
-/**/
-/*    auto elementParamsRaised = *(cryptoParams->GetElementParams());*/
-/**/
-/*    auto paramsQ = elementParamsRaised.GetParams();*/
-/*    usint sizeQ  = paramsQ.size();*/
-/**/
-/*    std::vector<NativeInteger> moduli(sizeQ);*/
-/*    std::vector<NativeInteger> roots(sizeQ);*/
-/*    for (size_t i = 0; i < sizeQ; i++) {*/
-/*        moduli[i] = paramsQ[i]->GetModulus();*/
-/*        roots[i]  = paramsQ[i]->GetRootOfUnity();*/
-/*    }*/
-/*    auto elementParamsRaisedPtr = std::make_shared<ILDCRTParams<DCRTPoly::Integer>>(M, moduli, roots);*/
-/**/
-/*    NativeInteger q = elementParamsRaisedPtr->GetParams()[0]->GetModulus().ConvertToInt();*/
-/*    double qDouble  = q.ConvertToDouble();*/
-/**/
-/*    const auto p = cryptoParams->GetPlaintextModulus();*/
-/*    double powP  = pow(2, p);*/
-/**/
-/*    int32_t deg = std::round(std::log2(qDouble / powP));*/
-/*#if NATIVEINT != 128*/
-/*    if (deg > static_cast<int32_t>(m_correctionFactor)) {*/
-/*        OPENFHE_THROW("Degree [" + std::to_string(deg) + "] must be less than or equal to the correction factor [" +*/
-/*                      std::to_string(m_correctionFactor) + "].");*/
-/*    }*/
-/*#endif*/
-/*    double post         = std::pow(2, static_cast<double>(deg));*/
-/**/
-/*    double pre      = 1. / post;*/
-/**/
-/*    size_t nb_ctx = ciphertextVec.size();*/
-/*    std::vector<Ciphertext<DCRTPoly>> result(nb_ctx);*/
-/**/
-/*    bool isLTBootstrap = (precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1) &&*/
-/*                         (precom->m_paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1);*/
-/**/
-/*    if (slots == M / 4) {*/
-/*        bool use_imslots = true;*/
-/*        std::vector<Ciphertext<DCRTPoly>> ctxtCtS(nb_ctx), ctxtCtSI(nb_ctx);*/
-/*        auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ctxtCtS[0]->GetKeyTag());*/
-/*        Ciphertext<DCRTPoly> conj;*/
-/**/
-/*        //------------------------------------------------------------------------------*/
-/*        // FULLY PACKED CASE*/
-/*        //------------------------------------------------------------------------------*/
-/**/
-/*#ifdef BOOTSTRAPTIMING*/
-/*    TIC(t);*/
-/*#endif*/
-/**/
-/*        //------------------------------------------------------------------------------*/
-/*        // Running SlotToCoeff*/
-/*        //------------------------------------------------------------------------------*/
-/**/
-/*        #pragma omp parallel for*/
-/*        for (size_t c = 0; c < nb_ctx; ++c) {*/
-/*            auto ctxtStC = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0Pre, ciphertextVec[c]):*/
-/*                                             EvalSlotsToCoeffs(precom->m_U0PreFFT, ciphertextVec[c]);*/
-/**/
-/*            //------------------------------------------------------------------------------*/
-/*            // RAISING THE MODULUS*/
-/*            //------------------------------------------------------------------------------*/
-/*            Ciphertext<DCRTPoly> raised = ctxtStC;*/
-/*            auto algo                   = cc->GetScheme();*/
-/*            algo->ModReduceInternalInPlace(raised, raised->GetNoiseScaleDeg() - 1);*/
-/**/
-/*            auto ctxtDCRT = raised->GetElements();*/
-/**/
-/*            for (size_t i = 0; i < ctxtDCRT.size(); i++) {*/
-/*                DCRTPoly temp(elementParamsRaisedPtr, COEFFICIENT);*/
-/*                ctxtDCRT[i].SetFormat(COEFFICIENT);*/
-/*                temp = ctxtDCRT[i].GetElementAtIndex(0);*/
-/*                temp.SetFormat(EVALUATION);*/
-/*                ctxtDCRT[i] = temp;*/
-/*            }*/
-/**/
-/*            raised->SetLevel(L0 - ctxtDCRT[0].GetNumOfElements());*/
-/*            raised->SetElements(std::move(ctxtDCRT));*/
-/**/
-/*            double constantEvalMult = pre / N;*/
-/*            cc->EvalMultInPlace(raised, constantEvalMult);*/
-/**/
-/*            //------------------------------------------------------------------------------*/
-/*            // Running CoeffToSlot*/
-/*            //------------------------------------------------------------------------------*/
-/**/
-/*            ctxtCtS[c] = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0hatTPre, raised):*/
-/*                                             EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised);*/
-/**/
-/*            conj = Conjugate(ctxtCtS[c], evalKeyMap);*/
-/**/
-/*            if (use_imslots) {*/
-/*                ctxtCtSI[c] = cc->EvalSub(ctxtCtS[c], conj);*/
-/*                algo->MultByMonomialInPlace(ctxtCtSI[c], 3 * M / 4);*/
-/**/
-/*                cc->EvalAddInPlace(ctxtCtS[c], conj);*/
-/**/
-/*                if (cryptoParams->GetScalingTechnique() == FIXEDMANUAL) {*/
-/*                    #pragma omp parallel sections*/
-/*                    {*/
-/*                        #pragma omp section*/
-/*                        {*/
-/*                            while (ctxtCtS[c]->GetNoiseScaleDeg() > 1) {*/
-/*                                cc->ModReduceInPlace(ctxtCtS[c]);*/
-/*                            }*/
-/*                        }*/
-/*                        #pragma omp section*/
-/*                        {*/
-/*                            while (ctxtCtSI[c]->GetNoiseScaleDeg() > 1) {*/
-/*                                cc->ModReduceInPlace(ctxtCtSI[c]);*/
-/*                            }*/
-/*                        }*/
-/*                    }*/
-/*                }*/
-/*                else {*/
-/*                    #pragma omp parallel sections*/
-/*                    {*/
-/*                        #pragma omp section*/
-/*                        {*/
-/*                            if (ctxtCtS[c]->GetNoiseScaleDeg() == 2) {*/
-/*                                algo->ModReduceInternalInPlace(ctxtCtS[c], BASE_NUM_LEVELS_TO_DROP);*/
-/*                            }*/
-/*                        }*/
-/*                        #pragma omp section*/
-/*                        {*/
-/*                            if (ctxtCtSI[c]->GetNoiseScaleDeg() == 2) {*/
-/*                                algo->ModReduceInternalInPlace(ctxtCtSI[c], BASE_NUM_LEVELS_TO_DROP);*/
-/*                            }*/
-/*                        }*/
-/**/
-/*                    }*/
-/*                }*/
-/*            }*/
-/*            else {*/
-/*                cc->EvalAddInPlace(ctxtCtS[c], conj);*/
-/**/
-/*                if (cryptoParams->GetScalingTechnique() == FIXEDMANUAL) {*/
-/*                    while (ctxtCtS[c]->GetNoiseScaleDeg() > 1) {*/
-/*                        cc->ModReduceInPlace(ctxtCtS[c]);*/
-/*                    }*/
-/*                }*/
-/*                else {*/
-/*                    if (ctxtCtS[c]->GetNoiseScaleDeg() == 2) {*/
-/*                        algo->ModReduceInternalInPlace(ctxtCtS[c], BASE_NUM_LEVELS_TO_DROP);*/
-/*                    }*/
-/*                }*/
-/*            }*/
-/*        }*/
-/**/
-/*        //------------------------------------------------------------------------------*/
-/*        // Running EvalLUT*/
-/*        //------------------------------------------------------------------------------*/
-/**/
-/*        int K = K_FUNC;*/
-/*        int powR = pow(2, R_FUNC);*/
-/*        auto f = [K, powR](double x) -> std::complex<double> { return std::exp(std::complex<double>(0, 2 * M_PI * K * x / powR)); };*/
-/**/
-/*        bool use_ps = num_poi > 3 && num_poi < 17;*/
-/**/
-/*        if (use_imslots) {*/
-/*            std::vector<Ciphertext<DCRTPoly>> ctxtExp(nb_ctx), ctxtExpI(nb_ctx), ctxtInterp(nb_ctx), ctxtInterpI(nb_ctx);*/
-/**/
-/*            #pragma omp parallel sections*/
-/*            {*/
-/*                #pragma omp section*/
-/*                {*/
-/*                    #pragma omp parallel for*/
-/*                    for (size_t i = 0; i < nb_ctx; ++i) {*/
-/*                        ctxtExp[i] = cc->EvalChebyshevFunction(f, ctxtCtS[i], -1, 1, 16); // 14 low*/
-/*                        for (uint32_t i = 0; i < R_FUNC; ++i) {*/
-/*                            cc->EvalSquareInPlace(ctxtExp[i]);*/
-/*                            cc->ModReduceInPlace(ctxtExp[i]);*/
-/*                        }*/
-/**/
-/*                        if (use_ps) {*/
-/*                            auto ctxtVecPowersExp = cc->ComputePowersPS(ctxtExp[i], num_poi - 1);*/
-/*                            auto ctxtPowersExp = ctxtVecPowersExp[0];*/
-/*                            auto ctxtPowers2Exp = ctxtVecPowersExp[1];*/
-/*                            auto ctxtPower2km1Exp = ctxtVecPowersExp[2][0];*/
-/**/
-/*                            #pragma omp parallel for*/
-/*                            for (size_t i = 0; i < nb_func; ++i) {*/
-/*                                auto& func = func_vec[i];*/
-/*                                ctxtInterp[i] = cc->EvalHermitePrecomPSFunction([func](double x) -> double { return 0.5 * func(x); }, ctxtPowersExp, ctxtPowers2Exp, ctxtPower2km1Exp, num_poi);*/
-/*                                conj = Conjugate(ctxtInterp[i], evalKeyMap);*/
-/*                                cc->EvalAddInPlace(ctxtInterp[i], conj);*/
-/*                            }*/
-/*                        }*/
-/*                        else {*/
-/*                            auto ctxtPowersExp = cc->ComputePowersLinear(ctxtExp[i], num_poi - 1);*/
-/**/
-/*                            #pragma omp parallel for*/
-/*                            for (size_t i = 0; i < nb_func; ++i) {*/
-/*                                auto& func = func_vec[i];*/
-/*                                ctxtInterp[i] = cc->EvalHermitePrecomLinearFunction([func](double x) -> double { return 0.5 * func(x); }, ctxtPowersExp, num_poi);*/
-/*                                conj = Conjugate(ctxtInterp[i], evalKeyMap);*/
-/*                                cc->EvalAddInPlace(ctxtInterp[i], conj);*/
-/*                            }*/
-/*                        }*/
-/*                    }*/
-/*                }*/
-/**/
-/*                #pragma omp section*/
-/*                {*/
-/*                    #pragma omp parallel for*/
-/*                    for (size_t i = 0; i < nb_ctx; ++i) {*/
-/*                        ctxtExpI[i] = cc->EvalChebyshevFunction(f, ctxtCtSI[i], -1, 1, 16);*/
-/*                        for (uint32_t i = 0; i < R_FUNC; ++i) {*/
-/*                            cc->EvalSquareInPlace(ctxtExpI[i]);*/
-/*                            cc->ModReduceInPlace(ctxtExpI[i]);*/
-/*                        }*/
-/*                    }*/
-/**/
-/*                    if (use_ps) {*/
-/*                        auto ctxtVecPowersExpI = cc->ComputePowersPS(ctxtExpI, num_poi - 1);*/
-/*                        auto ctxtPowersExpI = ctxtVecPowersExpI[0];*/
-/*                        auto ctxtPowers2ExpI = ctxtVecPowersExpI[1];*/
-/*                        auto ctxtPower2km1ExpI = ctxtVecPowersExpI[2][0];*/
-/**/
-/*                        #pragma omp parallel for*/
-/*                        for (size_t i = 0; i < nb_func; ++i) {*/
-/*                            auto& func = func_vec[i];*/
-/*                            ctxtInterpI[i] = cc->EvalHermitePrecomPSFunction([func](double x) -> double { return 0.5 * func(x); }, ctxtPowersExpI, ctxtPowers2ExpI, ctxtPower2km1ExpI, num_poi);*/
-/*                            conj = Conjugate(ctxtInterpI[i], evalKeyMap);*/
-/*                            cc->EvalAddInPlace(ctxtInterpI[i], conj);*/
-/*                        }*/
-/*                    }*/
-/*                    else {*/
-/*                        auto ctxtPowersExpI = cc->ComputePowersLinear(ctxtExpI, num_poi - 1);*/
-/**/
-/*                        #pragma omp parallel for*/
-/*                        for (size_t i = 0; i < nb_func; ++i) {*/
-/*                            auto& func = func_vec[i];*/
-/*                            ctxtInterpI[i] = cc->EvalHermitePrecomLinearFunction([func](double x) -> double { return 0.5 * func(x); }, ctxtPowersExpI, num_poi);*/
-/*                            conj = Conjugate(ctxtInterpI[i], evalKeyMap);*/
-/*                            cc->EvalAddInPlace(ctxtInterpI[i], conj);*/
-/*                        }*/
-/*                    }*/
-/*                }*/
-/*            }*/
-/**/
-/*            #pragma omp parallel for*/
-/*            for (size_t i = 0; i < nb_func; ++i) {*/
-/*                result[i] = cc->EvalAdd(ctxtInterp[i], ctxtInterpI[i]);*/
-/*            }*/
-/*        }*/
-/*        else {*/
-/*            std::vector<Ciphertext<DCRTPoly>> ctxtExp(nb_ctx), ctxtInterp(nb_func);*/
-/**/
-/*            #pragma omp parallel for*/
-/*            for (size_t i = 0; i < nb_ctx; ++i) {*/
-/*                ctxtExp[i] = cc->EvalChebyshevFunction(f, ctxtCtS[i], -1, 1, 16); // 14 low*/
-/*                for (uint32_t i = 0; i < R_FUNC; ++i) {*/
-/*                    cc->EvalSquareInPlace(ctxtExp[i]);*/
-/*                    cc->ModReduceInPlace(ctxtExp[i]);*/
-/*                }*/
-/*            }*/
-/**/
-/*            auto ctxtVecPowersExp = cc->ComputePowersPS(ctxtExp, num_poi - 1);*/
-/*            auto ctxtPowersExp = ctxtVecPowersExp[0];*/
-/*            auto ctxtPowers2Exp = ctxtVecPowersExp[1];*/
-/*            auto ctxtPower2km1Exp = ctxtVecPowersExp[2][0];*/
-/**/
-/*            #pragma omp parallel for*/
-/*            for (size_t i = 0; i < nb_func; ++i) {*/
-/*                auto& func = func_vec[i];*/
-/*                ctxtInterp[i] = cc->EvalHermitePrecomPSFunction([func](double x) -> double { return 0.5 * func(x); }, ctxtPowersExp, ctxtPowers2Exp, ctxtPower2km1Exp, num_poi);*/
-/*                conj = Conjugate(ctxtInterp[i], evalKeyMap);*/
-/*                cc->EvalAddInPlace(ctxtInterp[i], conj);*/
-/*            }*/
-/**/
-/*            #pragma omp parallel for*/
-/*            for (size_t i = 0; i < nb_func; ++i) {*/
-/*                result[i] = ctxtInterp[i];*/
-/*            }*/
-/*        }*/
-/**/
-/*#ifdef BOOTSTRAPTIMING*/
-/*    timeLUT = TOC(t);*/
-/*    std::cerr << "EvalLUT time: " << (timeLUT) / 1000.0 << " s" << std::endl;*/
-/*#endif*/
-/**/
-/*    }*/
-/*    else {*/
-/*        OPENFHE_THROW("Sparse packing Functional Bootstrapping not yet implemented.");*/
-/*    }*/
-/**/
-/*    return result;*/
-/*}*/
-
-
-// WIP: @jdumezy
-std::vector<std::function<double(double)>> decomposeBasisFunction(std::function<double(double)> f, int num_poi) {
-    int n = pow(2, std::log2(num_poi)/2);
-    
-    std::vector<std::function<double(double)>> msbFunctions(n);
-    std::vector<std::function<double(double)>> lsbFunctions(n);
-    
-    for (int msb = 0; msb < n; ++msb) {
-        msbFunctions[msb] = [f, msb](double x) -> double {
-            unsigned int result = (unsigned int)f(16 * x + msb);
-            return (double)(result >> 4);
-        };
+namespace {
+
+// Digit values of the inputs of a numDigits digits LUT once digit t is removed: r enumerates the other digits,
+// most significant first, and the entry t of the returned vector is left to zero
+std::vector<uint32_t> decomposeRestDigits(uint64_t r, uint32_t t, uint32_t digitBits, uint32_t numDigits) {
+    uint64_t mask = (uint64_t(1) << digitBits) - 1;
+    std::vector<uint32_t> digits(numDigits, 0);
+    for (uint32_t i = numDigits; i-- > 0;) {
+        if (i == t)
+            continue;
+        digits[i] = r & mask;
+        r >>= digitBits;
     }
-    
-    for (int lsb = 0; lsb < 16; ++lsb) {
-        lsbFunctions[lsb] = [f, lsb](double x) -> double {
-            unsigned int result = (unsigned int)f(16 * lsb + x);
-            return (double)(result & 0xF);
-        };
+    return digits;
+}
+
+
+
+// Digit t of f as a function of the input digit t, for each value r of the other digits (index t * base^(numDigits - 1) + r)
+std::vector<std::function<double(double)>> decomposeBasisFunction(std::function<double(double)> f, uint32_t digitBits,
+                                                                   uint32_t numDigits) {
+    uint64_t nbRest = uint64_t(1) << (digitBits * (numDigits - 1));
+    int64_t mask    = (int64_t(1) << digitBits) - 1;
+
+    std::vector<std::function<double(double)>> functions(numDigits * nbRest);
+
+    for (uint32_t t = 0; t < numDigits; ++t) {
+        uint32_t shift = digitBits * (numDigits - 1 - t);
+        for (uint64_t r = 0; r < nbRest; ++r) {
+            auto digits  = decomposeRestDigits(r, t, digitBits, numDigits);
+            int64_t rest = 0;
+            for (uint32_t i = 0; i < numDigits; ++i)
+                rest = (rest << digitBits) + digits[i];
+
+            functions[t * nbRest + r] = [f, rest, shift, mask](double x) -> double {
+                int64_t result = static_cast<int64_t>(f(rest + (static_cast<int64_t>(x) << shift)));
+                return (double)((result >> shift) & mask);
+            };
+        }
     }
 
-    std::vector<std::function<double(double)>> allFunctions;
-    allFunctions.insert(allFunctions.end(), msbFunctions.begin(), msbFunctions.end());
-    allFunctions.insert(allFunctions.end(), lsbFunctions.begin(), lsbFunctions.end());
-    
-    return allFunctions;
+    return functions;
 }
 
 
 
-std::vector<std::function<double(double)>> createEqualFunction(int num_poi) {
-    int n = pow(2, std::log2(num_poi)/2);
+std::vector<std::function<double(double)>> createEqualFunction(uint32_t digitBits) {
+    uint32_t n = 1 << digitBits;
     std::vector<std::function<double(double)>> functions(n);
-    for (int i = 0; i < n; ++i) {
-        functions[i] = [i, n](double x) -> double { return x == i ? n : 0; };
+    for (uint32_t i = 0; i < n; ++i) {
+        functions[i] = [i](double x) -> double { return x == i ? 1 : 0; };
     }
     return functions;
 }
 
 
 
-std::vector<Ciphertext<DCRTPoly>> multCiphertextVec(std::vector<Ciphertext<DCRTPoly>> c0,
-                                                    std::vector<Ciphertext<DCRTPoly>> c1,
-                                                    CryptoContext<DCRTPoly> cc) {
-    size_t n = c0.size();
-    size_t k = n / 2;
-    std::vector<Ciphertext<DCRTPoly>> result(n);
-
-    #pragma omp parallel for
-    for (size_t i = 0; i < n; ++i) {
-        Ciphertext<DCRTPoly> a, b;
-        if (i < k) {
-            a = c0[i];
-            b = cc->EvalMult(c1[i], 1. / k);
-            cc->ModReduceInPlace(b);
+// Product of the ciphertexts, computed as a binary tree to consume ceil(log2(size)) levels
+Ciphertext<DCRTPoly> multCiphertextVec(std::vector<Ciphertext<DCRTPoly>> factors, CryptoContext<DCRTPoly> cc) {
+    while (factors.size() > 1) {
+        std::vector<Ciphertext<DCRTPoly>> next((factors.size() + 1) / 2);
+        for (size_t i = 0; i < factors.size() / 2; ++i) {
+            next[i] = cc->EvalMult(factors[2 * i], factors[2 * i + 1]);
+            cc->ModReduceInPlace(next[i]);
         }
-        else {
-            a = cc->EvalMult(c0[i], 1. / k);
-            b = c1[i];
-            cc->ModReduceInPlace(a);
-        }
-
-        result[i] = cc->EvalMult(a, b);
-        cc->ModReduceInPlace(result[i]);
+        if (factors.size() % 2)
+            next.back() = factors.back();
+        factors = std::move(next);
     }
 
-    return result;
+    return factors[0];
 }
 
 
@@ -1980,72 +1905,30 @@ bool isNotZeroFunction(std::function<double(double)> f, size_t n) {
     return r;
 }
 
+}  // namespace
 
-Ciphertext<DCRTPoly> FHECKKSRNS::EvalFuncSimpleTreeMVB(ConstCiphertext<DCRTPoly> ciphertext, std::function<double(double)> func,
-                                                       int num_poi, int order) const {
-    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
 
-    if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
-        OPENFHE_THROW("CKKS Functional Bootstrapping is only supported for the Hybrid key switching method.");
-    if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL)
-        OPENFHE_THROW("CKKS Functional Bootstrapping is only supported for FIXEDMANUAL scaling.");
-    if(cryptoParams->GetSecretKeyDist() != SPARSE_TERNARY)
-        OPENFHE_THROW("CKKS Functional Bootstrapping is only supported for SPARSE_TERNARY key.");
-#if NATIVEINT == 128 && !defined(__EMSCRIPTEN__)
-    OPENFHE_THROW("128-bit CKKS Functional Bootstrapping is not supported for 128 NATIVEINT.");
-#endif
+std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalFuncDigitsToSlots(ConstCiphertext<DCRTPoly> ciphertext,
+                                                                    const std::shared_ptr<CKKSBootstrapPrecom> precom,
+                                                                    double pre) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
 
-    auto cc     = ciphertext->GetCryptoContext();
-    uint32_t M  = cc->GetCyclotomicOrder();
-    uint32_t L0 = cryptoParams->GetElementParams()->GetParams().size();
+    auto cc    = ciphertext->GetCryptoContext();
+    auto algo  = cc->GetScheme();
+    uint32_t M = cc->GetCyclotomicOrder();
 
     uint32_t slots = ciphertext->GetSlots();
 
-    auto pair = m_bootPrecomMap.find(slots);
-    if (pair == m_bootPrecomMap.end()) {
-        std::string errorMsg(std::string("Precomputations for ") + std::to_string(slots) +
-                             std::string(" slots were not generated") +
-                             std::string(" Need to call EvalBootstrapSetup and then EvalBootstrapKeyGen to proceed"));
-        OPENFHE_THROW(errorMsg);
-    }
-    const std::shared_ptr<CKKSBootstrapPrecom> precom = pair->second;
-    size_t N                                          = cc->GetRingDimension();
-
-    auto elementParamsRaised = *(cryptoParams->GetElementParams());
-
-    auto paramsQ = elementParamsRaised.GetParams();
-    usint sizeQ  = paramsQ.size();
-
-    std::vector<NativeInteger> moduli(sizeQ);
-    std::vector<NativeInteger> roots(sizeQ);
-    for (size_t i = 0; i < sizeQ; i++) {
-        moduli[i] = paramsQ[i]->GetModulus();
-        roots[i]  = paramsQ[i]->GetRootOfUnity();
-    }
-    auto elementParamsRaisedPtr = std::make_shared<ILDCRTParams<DCRTPoly::Integer>>(M, moduli, roots);
-
-    NativeInteger q = elementParamsRaisedPtr->GetParams()[0]->GetModulus().ConvertToInt();
-    double qDouble  = q.ConvertToDouble();
-
-    const auto p = cryptoParams->GetPlaintextModulus();
-    double powP  = pow(2, p);
-
-    int32_t deg = std::round(std::log2(qDouble / powP));
-#if NATIVEINT != 128
-    if (deg > static_cast<int32_t>(m_correctionFactor)) {
-        OPENFHE_THROW("Degree [" + std::to_string(deg) + "] must be less than or equal to the correction factor [" +
-                      std::to_string(m_correctionFactor) + "].");
-    }
-#endif
-    double post         = std::pow(2, static_cast<double>(deg));
-
-    double pre      = 1. / post;
-
-    Ciphertext<DCRTPoly> result;
+    // The SlotsToCoeffs plaintexts are precomputed for a rescaled input
+    ConstCiphertext<DCRTPoly> ctxtIn = ciphertext;
+    if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL && ciphertext->GetNoiseScaleDeg() == 2)
+        ctxtIn = algo->ModReduceInternal(ciphertext, BASE_NUM_LEVELS_TO_DROP);
 
     bool isLTBootstrap = (precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1) &&
                          (precom->m_paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1);
 
+    Ciphertext<DCRTPoly> ctxtCtS, ctxtCtSI;
+
     if (slots == M / 4) {
 
         //------------------------------------------------------------------------------
@@ -2056,44 +1939,29 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalFuncSimpleTreeMVB(ConstCiphertext<DCRTPoly>
         // Running SlotToCoeff
         //------------------------------------------------------------------------------
 
-        auto ctxtStC = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0Pre, ciphertext):
-                                         EvalSlotsToCoeffs(precom->m_U0PreFFT, ciphertext);
+        auto ctxtStC = TimeBootstrapStage(m_bootStats, "SlotsToCoeffs", [&] {
+            return (isLTBootstrap) ? EvalLinearTransform(precom->m_U0Pre, ctxtIn) :
+                                     EvalSlotsToCoeffs(precom->m_U0PreFFT, ctxtIn);
+        });
 
         //------------------------------------------------------------------------------
         // RAISING THE MODULUS
         //------------------------------------------------------------------------------
-        Ciphertext<DCRTPoly> raised = ctxtStC;
-        auto algo                   = cc->GetScheme();
-        algo->ModReduceInternalInPlace(raised, raised->GetNoiseScaleDeg() - 1);
-
-        auto ctxtDCRT = raised->GetElements();
-
-        for (size_t i = 0; i < ctxtDCRT.size(); i++) {
-            DCRTPoly temp(elementParamsRaisedPtr, COEFFICIENT);
-            ctxtDCRT[i].SetFormat(COEFFICIENT);
-            temp = ctxtDCRT[i].GetElementAtIndex(0);
-            temp.SetFormat(EVALUATION);
-            ctxtDCRT[i] = temp;
-        }
-
-        raised->SetLevel(L0 - ctxtDCRT[0].GetNumOfElements());
-        raised->SetElements(std::move(ctxtDCRT));
-
-        double constantEvalMult = pre / N;
-        cc->EvalMultInPlace(raised, constantEvalMult);
+        auto raised = EvalFuncModRaise(ctxtStC, pre);
 
         //------------------------------------------------------------------------------
         // Running CoeffToSlot
         //------------------------------------------------------------------------------
 
-        auto ctxtCtS = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0hatTPre, raised):
-                                         EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised);
+        ctxtCtS = TimeBootstrapStage(m_bootStats, "CoeffsToSlots", [&] {
+            return (isLTBootstrap) ? EvalLinearTransform(precom->m_U0hatTPre, raised) :
+                                     EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised);
+        });
 
 
         auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ctxtCtS->GetKeyTag());
         auto conj = Conjugate(ctxtCtS, evalKeyMap);
-        Ciphertext<DCRTPoly> ctxtCtSI;
-        
+
         ctxtCtSI = cc->EvalSub(ctxtCtS, conj);
         algo->MultByMonomialInPlace(ctxtCtSI, 3 * M / 4);
 
@@ -2134,140 +2002,204 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalFuncSimpleTreeMVB(ConstCiphertext<DCRTPoly>
 
             }
         }
-
+    }
+    else {
         //------------------------------------------------------------------------------
-        // Running EvalLUT
+        // SPARSELY PACKED CASE
         //------------------------------------------------------------------------------
 
-        int K = K_FUNC;
-        int powR = pow(2, R_FUNC);
-        auto f = [K, powR](double x) -> std::complex<double> { return std::exp(std::complex<double>(0, 2 * M_PI * K * x / powR)); };
+        // the real parts sit in the first slots values and the imaginary parts in the next slots values;
+        // rotate the latter down so that both digits of an input are aligned in the same slot
+        ctxtCtS  = EvalFuncSparseCoeffsToSlots(ctxtIn, pre);
+        ctxtCtSI = cc->EvalRotate(ctxtCtS, slots);
+    }
 
-        auto functions = decomposeBasisFunction(func, num_poi);
-        auto functions_eq = createEqualFunction(num_poi);
-        size_t nb_func = functions.size();
-        size_t basis = nb_func / 2;
+    return {ctxtCtS, ctxtCtSI};
+}
 
 
-        bool use_ps = basis > 3 && basis < 17;
+Ciphertext<DCRTPoly> FHECKKSRNS::EvalFuncSimpleTreeMVB(ConstCiphertext<DCRTPoly> ciphertext, std::function<double(double)> func,
+                                                       int num_poi, int order) const {
+    // num_poi points split into two digits of equal size
+    uint32_t digitBits = std::log2(num_poi) / 2;
 
-        std::vector<std::function<double(double)>> combined1(nb_func);
-        std::vector<std::function<double(double)>> combined2(nb_func);
+    return EvalFuncTreeMVB({ciphertext}, func, digitBits, 2)[0];
+}
 
-        for (size_t i = 0; i < basis; ++i) {
-            combined1[i] = functions[i];
-            combined2[i] = functions_eq[i];
-        }
 
-        for (size_t i = basis; i < nb_func; ++i) {
-            combined1[i] = functions_eq[i - basis];
-            combined2[i] = functions[i];
-        }
+std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalFuncTreeMVB(const std::vector<ConstCiphertext<DCRTPoly>>& ciphertexts,
+                                                              std::function<double(double)> func, uint32_t digitBits,
+                                                              uint32_t numDigits) const {
+    PolyArenaScope arena;
+    if (ciphertexts.empty())
+        OPENFHE_THROW("No ciphertext to bootstrap.");
 
-        std::vector<Ciphertext<DCRTPoly>> ctxtInterp(nb_func), ctxtInterpI(nb_func);
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertexts[0]->GetCryptoParameters());
 
-        #pragma omp parallel sections
-        {
-            #pragma omp section
-            {
-                auto ctxtExp = cc->EvalChebyshevFunction(f, ctxtCtS, -1, 1, 16); // 14 low
-                for (uint32_t i = 0; i < R_FUNC; ++i) {
-                    cc->EvalSquareInPlace(ctxtExp);
-                    cc->ModReduceInPlace(ctxtExp);
-                }
+    if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
+        OPENFHE_THROW("CKKS Functional Bootstrapping is only supported for the Hybrid key switching method.");
+    if (cryptoParams->GetScalingTechnique() == FIXEDAUTO)
+        OPENFHE_THROW("CKKS Functional Bootstrapping is only supported for FIXEDMANUAL and FLEXIBLEAUTO* scaling.");
+    if(cryptoParams->GetSecretKeyDist() != SPARSE_TERNARY)
+        OPENFHE_THROW("CKKS Functional Bootstrapping is only supported for SPARSE_TERNARY key.");
+#if NATIVEINT == 128 && !defined(__EMSCRIPTEN__)
+    OPENFHE_THROW("128-bit CKKS Functional Bootstrapping is not supported for 128 NATIVEINT.");
+#endif
+    if (digitBits == 0 || numDigits < 2)
+        OPENFHE_THROW("The tree evaluation needs at least two digits of at least one bit.");
+    if (uint64_t(digitBits) * numDigits > 32)
+        OPENFHE_THROW("The tree evaluation supports inputs of at most 32 bits.");
+    // one LUT per digit and per value of the other digits, each with its own ciphertext
+    uint64_t numLUTs = numDigits * (uint64_t(1) << (digitBits * (numDigits - 1)));
+    if (numLUTs > MAX_TREE_LUTS)
+        OPENFHE_THROW("The tree evaluation of " + std::to_string(numDigits) + " digits of " + std::to_string(digitBits) +
+                      " bits needs " + std::to_string(numLUTs) + " LUTs, more than the " +
+                      std::to_string(MAX_TREE_LUTS) + " supported.");
+    if (ciphertexts.size() != (numDigits + 1) / 2)
+        OPENFHE_THROW("The " + std::to_string(numDigits) + " digits should be packed in " +
+                      std::to_string((numDigits + 1) / 2) + " ciphertexts (two digits per ciphertext).");
+
+    BootstrapRunRecorder run(m_bootStats, "EvalFuncTreeMVB");
+
+    auto cc    = ciphertexts[0]->GetCryptoContext();
+    auto algo  = cc->GetScheme();
+    uint32_t M = cc->GetCyclotomicOrder();
 
-                if (use_ps) {
-                    auto ctxtVecPowersExp = cc->ComputePowersPS(ctxtExp, basis - 1);
-                    auto ctxtPowersExp = ctxtVecPowersExp[0];
-                    auto ctxtPowers2Exp = ctxtVecPowersExp[1];
-                    auto ctxtPower2km1Exp = ctxtVecPowersExp[2][0];
-
-                    #pragma omp parallel for
-                    for (size_t i = 0; i < nb_func; ++i) {
-                        auto& func = combined1[i];
-                        ctxtInterp[i] = cc->EvalHermitePrecomPSFunction([func](double x) -> double { return 0.5 * func(x); }, ctxtPowersExp, ctxtPowers2Exp, ctxtPower2km1Exp, basis);
-                        conj = Conjugate(ctxtInterp[i], evalKeyMap);
-                        cc->EvalAddInPlace(ctxtInterp[i], conj);
-                    }
-                }
-                else {
-                    auto ctxtPowersExp = cc->ComputePowersLinear(ctxtExp, basis - 1);
-
-                    #pragma omp parallel for
-                    for (size_t i = 0; i < nb_func; ++i) {
-                        auto& func = combined1[i];
-                        ctxtInterp[i] = cc->EvalHermitePrecomLinearFunction([func](double x) -> double { return 0.5 * func(x); }, ctxtPowersExp, basis);
-                        conj = Conjugate(ctxtInterp[i], evalKeyMap);
-                        cc->EvalAddInPlace(ctxtInterp[i], conj);
-                    }
-                }
-            }
+    uint32_t slots = ciphertexts[0]->GetSlots();
+    for (const auto& ciphertext : ciphertexts) {
+        if (ciphertext->GetSlots() != slots)
+            OPENFHE_THROW("All the ciphertexts of a tree evaluation should have the same number of slots.");
+    }
 
-            #pragma omp section
-            {
-                auto ctxtExpI = cc->EvalChebyshevFunction(f, ctxtCtSI, -1, 1, 16);
-                for (uint32_t i = 0; i < R_FUNC; ++i) {
-                    cc->EvalSquareInPlace(ctxtExpI);
-                    cc->ModReduceInPlace(ctxtExpI);
-                }
+    auto pair = m_bootPrecomMap.find(slots);
+    if (pair == m_bootPrecomMap.end()) {
+        std::string errorMsg(std::string("Precomputations for ") + std::to_string(slots) +
+                             std::string(" slots were not generated") +
+                             std::string(" Need to call EvalBootstrapSetup and then EvalBootstrapKeyGen to proceed"));
+        OPENFHE_THROW(errorMsg);
+    }
+    const std::shared_ptr<CKKSBootstrapPrecom> precom = pair->second;
 
-                if (use_ps) {
-                    auto ctxtVecPowersExpI = cc->ComputePowersPS(ctxtExpI, basis - 1);
-                    auto ctxtPowersExpI = ctxtVecPowersExpI[0];
-                    auto ctxtPowers2ExpI = ctxtVecPowersExpI[1];
-                    auto ctxtPower2km1ExpI = ctxtVecPowersExpI[2][0];
-
-                    #pragma omp parallel for
-                    for (size_t i = 0; i < nb_func; ++i) {
-                        auto& func = combined2[i];
-                        ctxtInterpI[i] = cc->EvalHermitePrecomPSFunction([func](double x) -> double { return 0.5 * func(x); }, ctxtPowersExpI, ctxtPowers2ExpI, ctxtPower2km1ExpI, basis);
-                        conj = Conjugate(ctxtInterpI[i], evalKeyMap);
-                        cc->EvalAddInPlace(ctxtInterpI[i], conj);
-                    }
-                }
-                else {
-                    auto ctxtPowersExpI = cc->ComputePowersLinear(ctxtExpI, basis - 1);
-
-                    #pragma omp parallel for
-                    for (size_t i = 0; i < nb_func; ++i) {
-                        auto& func = combined2[i];
-                        ctxtInterpI[i] = cc->EvalHermitePrecomLinearFunction([func](double x) -> double { return 0.5 * func(x); }, ctxtPowersExpI, basis);
-                        conj = Conjugate(ctxtInterpI[i], evalKeyMap);
-                        cc->EvalAddInPlace(ctxtInterpI[i], conj);
-                    }
-                }
-            }
-        }
+    NativeInteger q = cryptoParams->GetElementParams()->GetParams()[0]->GetModulus().ConvertToInt();
+    double qDouble  = q.ConvertToDouble();
+
+    const auto p = cryptoParams->GetPlaintextModulus();
+    double powP  = pow(2, p);
 
-        auto ctxt_mult = multCiphertextVec(ctxtInterp, ctxtInterpI, cc);
+    int32_t deg = std::round(std::log2(qDouble / powP));
+#if NATIVEINT != 128
+    if (deg > static_cast<int32_t>(m_correctionFactor)) {
+        OPENFHE_THROW("Degree [" + std::to_string(deg) + "] must be less than or equal to the correction factor [" +
+                      std::to_string(m_correctionFactor) + "].");
+    }
+#endif
+    double post         = std::pow(2, static_cast<double>(deg));
 
-        std::vector<Ciphertext<DCRTPoly>> msb_ctx_vec(basis), lsb_ctx_vec(basis);
+    double pre      = 1. / post;
 
-        #pragma omp parallel for
-        for (size_t i = 0; i < basis; ++i) {
-            msb_ctx_vec[i] = ctxt_mult[i];
-            lsb_ctx_vec[i] = ctxt_mult[i + basis];
-        }
+    //------------------------------------------------------------------------------
+    // Extracting the digits
+    //------------------------------------------------------------------------------
 
-        Ciphertext<DCRTPoly> msb_ctx, lsb_ctx;
+    std::vector<Ciphertext<DCRTPoly>> digits(numDigits);
 
-        #pragma omp parallel sections
-        {
-            #pragma omp section
-            {
-                msb_ctx = cc->EvalAddMany(msb_ctx_vec);
-            }
-            #pragma omp section
-            {
-                lsb_ctx = cc->EvalAddMany(lsb_ctx_vec);
-                algo->MultByMonomialInPlace(lsb_ctx, M / 4);
+    #pragma omp parallel for
+    for (size_t c = 0; c < ciphertexts.size(); ++c) {
+        auto ctxtDigits = EvalFuncDigitsToSlots(ciphertexts[c], precom, pre);
+        digits[2 * c]   = ctxtDigits[0];
+        if (2 * c + 1 < numDigits)
+            digits[2 * c + 1] = ctxtDigits[1];
+    }
+
+    //------------------------------------------------------------------------------
+    // Running EvalLUT
+    //------------------------------------------------------------------------------
+
+    int K = K_FUNC;
+    int powR = pow(2, R_FUNC);
+    auto f = [K, powR](double x) -> std::complex<double> { return std::exp(std::complex<double>(0, 2 * M_PI * K * x / powR)); };
+
+    uint32_t basis  = 1 << digitBits;
+    uint32_t nbRest = numLUTs / numDigits;
+
+    auto functions    = decomposeBasisFunction(func, digitBits, numDigits);
+    auto functions_eq = createEqualFunction(digitBits);
+
+    // each digit goes through the basis equality indicators and the nbRest LUTs of its own output digit;
+    // the LUTs are interpolated at half scale as the conjugates are added back after the evaluation
+    std::vector<std::vector<std::complex<double>>> coeffEq(basis), coeffFunc(numDigits * nbRest);
+
+    #pragma omp parallel for
+    for (size_t i = 0; i < basis + numDigits * nbRest; ++i) {
+        auto& coeff = (i < basis) ? coeffEq[i] : coeffFunc[i - basis];
+        coeff = hermiteInterpOrder1Coeff((i < basis) ? functions_eq[i] : functions[i - basis], basis);
+        for (auto& c : coeff)
+            c *= 0.5;
+    }
+
+    std::vector<std::vector<Ciphertext<DCRTPoly>>> ctxtEq(numDigits);
+    std::vector<Ciphertext<DCRTPoly>> ctxtFunc(numDigits * nbRest);
+
+    #pragma omp parallel for
+    for (uint32_t d = 0; d < numDigits; ++d) {
+        auto ctxtExp = TimeBootstrapStage(m_bootStats, "ExpChebyshev", [&] { return cc->EvalChebyshevFunction(f, digits[d], -1, 1, 16); }); // 14 low
+        TimeBootstrapStage(m_bootStats, "Squarings", [&] {
+            for (uint32_t i = 0; i < R_FUNC; ++i) {
+                cc->EvalSquareInPlace(ctxtExp);
+                cc->ModReduceInPlace(ctxtExp);
             }
+        });
+
+        std::vector<std::vector<std::complex<double>>> coeffDigit(coeffEq);
+        coeffDigit.insert(coeffDigit.end(), coeffFunc.begin() + d * nbRest, coeffFunc.begin() + (d + 1) * nbRest);
+
+        auto ctxtInterp = EvalFuncLUTs(ctxtExp, coeffDigit, true);
+
+        ctxtEq[d].assign(ctxtInterp.begin(), ctxtInterp.begin() + basis);
+        std::copy(ctxtInterp.begin() + basis, ctxtInterp.end(), ctxtFunc.begin() + d * nbRest);
+    }
+
+    //------------------------------------------------------------------------------
+    // Combining the LUTs
+    //------------------------------------------------------------------------------
+
+    // digit t of the result is the sum over the values r of the other digits of LUT_{t,r}(x_t) * prod_{i != t} [x_i == r_i]
+    std::vector<Ciphertext<DCRTPoly>> ctxt_mult(numDigits * nbRest);
+
+    #pragma omp parallel for
+    for (size_t j = 0; j < numDigits * nbRest; ++j) {
+        uint32_t t  = j / nbRest;
+        auto values = decomposeRestDigits(j % nbRest, t, digitBits, numDigits);
+
+        std::vector<Ciphertext<DCRTPoly>> factors = {ctxtFunc[j]};
+        for (uint32_t i = 0; i < numDigits; ++i) {
+            if (i != t)
+                factors.push_back(ctxtEq[i][values[i]]);
         }
+        ctxt_mult[j] = TimeBootstrapStage(m_bootStats, "TreeProducts", [&] { return multCiphertextVec(factors, cc); });
+    }
+
+    std::vector<Ciphertext<DCRTPoly>> ctxtDigits(numDigits);
 
-        result = cc->EvalAdd(msb_ctx, lsb_ctx);
+    #pragma omp parallel for
+    for (uint32_t t = 0; t < numDigits; ++t) {
+        std::vector<Ciphertext<DCRTPoly>> digit_ctx_vec(ctxt_mult.begin() + t * nbRest, ctxt_mult.begin() + (t + 1) * nbRest);
+        ctxtDigits[t] = cc->EvalAddMany(digit_ctx_vec);
     }
-    else {
-        OPENFHE_THROW("Sparse packing Functional Bootstrapping not yet implemented.");
+
+    std::vector<Ciphertext<DCRTPoly>> result(ciphertexts.size());
+
+    #pragma omp parallel for
+    for (size_t c = 0; c < ciphertexts.size(); ++c) {
+        result[c] = ctxtDigits[2 * c];
+        if (2 * c + 1 < numDigits) {
+            algo->MultByMonomialInPlace(ctxtDigits[2 * c + 1], M / 4);
+            result[c] = cc->EvalAdd(result[c], ctxtDigits[2 * c + 1]);
+        }
+
+        // only the first slots values of the sparse layout hold aligned digits
+        if (slots != M / 4)
+            result[c] = EvalFuncSparseMerge(result[c], std::complex<double>(0, 0));
     }
 
     return result;
@@ -2314,6 +2246,50 @@ std::vector<int32_t> FHECKKSRNS::FindBootstrapRotationIndices(uint32_t slots, ui
     return fullIndexList;
 }
 
+std::vector<uint32_t> FHECKKSRNS::FindFuncBootstrapAutomorphismIndices(uint32_t slots, uint32_t M) const {
+    if (slots == 0)
+        slots = M / 4;
+
+    auto pair = m_bootPrecomMap.find(slots);
+    if (pair == m_bootPrecomMap.end()) {
+        std::string errorMsg(std::string("Precomputations for ") + std::to_string(slots) +
+                             std::string(" slots were not generated") +
+                             std::string(" Need to call EvalFuncBootstrapSetup to proceed"));
+        OPENFHE_THROW(errorMsg);
+    }
+    const std::shared_ptr<CKKSBootstrapPrecom> precom = pair->second;
+
+    // the sparsely packed paths always run the collapsed FFTs; their partial sums and merges rotate by
+    // multiples of slots, which are part of the FFT index lists
+    bool isLTBootstrap = (precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1) &&
+                         (precom->m_paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1) && (slots == M / 4);
+
+    std::vector<int32_t> rotIndices;
+    if (isLTBootstrap) {
+        rotIndices = FindLinearTransformRotationIndices(precom->m_dim1, slots, M);
+    }
+    else {
+        rotIndices = FindCoeffsToSlotsRotationIndices(precom->m_paramsEnc, slots, M);
+
+        std::vector<int32_t> indexListStC = FindSlotsToCoeffsRotationIndices(precom->m_paramsDec, slots, M);
+        rotIndices.insert(rotIndices.end(), indexListStC.begin(), indexListStC.end());
+    }
+
+    // distinct rotation indices can share an automorphism; the conjugation is the automorphism M - 1
+    std::vector<uint32_t> autoIndices{M - 1};
+    autoIndices.reserve(rotIndices.size() + 1);
+    for (int32_t index : rotIndices) {
+        autoIndices.push_back(FindAutomorphismIndex2nComplex(index, M));
+    }
+
+    std::sort(autoIndices.begin(), autoIndices.end());
+    autoIndices.erase(std::unique(autoIndices.begin(), autoIndices.end()), autoIndices.end());
+    // the identity does not need a key
+    autoIndices.erase(std::remove(autoIndices.begin(), autoIndices.end(), 1), autoIndices.end());
+
+    return autoIndices;
+}
+
 std::vector<int32_t> FHECKKSRNS::FindLinearTransformRotationIndices(uint32_t slots, uint32_t M) {
     auto pair = m_bootPrecomMap.find(slots);
     if (pair == m_bootPrecomMap.end()) {
@@ -2324,10 +2300,14 @@ std::vector<int32_t> FHECKKSRNS::FindLinearTransformRotationIndices(uint32_t slo
     }
     const std::shared_ptr<CKKSBootstrapPrecom> precom = pair->second;
 
+    return FindLinearTransformRotationIndices(precom->m_dim1, slots, M);
+}
+
+std::vector<int32_t> FHECKKSRNS::FindLinearTransformRotationIndices(uint32_t dim1, uint32_t slots, uint32_t M) {
     std::vector<int32_t> indexList;
 
     // Computing the baby-step g and the giant-step h.
-    int g = (precom->m_dim1 == 0) ? ceil(sqrt(slots)) : precom->m_dim1;
+    int g = (dim1 == 0) ? ceil(sqrt(slots)) : dim1;
     int h = ceil(static_cast<double>(slots) / g);
 
     // computing all indices for baby-step giant-step procedure
@@ -2368,18 +2348,23 @@ std::vector<int32_t> FHECKKSRNS::FindCoeffsToSlotsRotationIndices(uint32_t slots
     }
     const std::shared_ptr<CKKSBootstrapPrecom> precom = pair->second;
 
-    std::vector<int32_t> indexList;
-
-    int32_t levelBudget     = precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET];
-    int32_t layersCollapse  = precom->m_paramsEnc[CKKS_BOOT_PARAMS::LAYERS_COLL];
-    int32_t remCollapse     = precom->m_paramsEnc[CKKS_BOOT_PARAMS::LAYERS_REM];
-    int32_t numRotations    = precom->m_paramsEnc[CKKS_BOOT_PARAMS::NUM_ROTATIONS];
-    int32_t b               = precom->m_paramsEnc[CKKS_BOOT_PARAMS::BABY_STEP];
-    int32_t g               = precom->m_paramsEnc[CKKS_BOOT_PARAMS::GIANT_STEP];
-    int32_t numRotationsRem = precom->m_paramsEnc[CKKS_BOOT_PARAMS::NUM_ROTATIONS_REM];
-    int32_t bRem            = precom->m_paramsEnc[CKKS_BOOT_PARAMS::BABY_STEP_REM];
-    int32_t gRem            = precom->m_paramsEnc[CKKS_BOOT_PARAMS::GIANT_STEP_REM];
-
+    return FindCoeffsToSlotsRotationIndices(precom->m_paramsEnc, slots, M);
+}
+
+std::vector<int32_t> FHECKKSRNS::FindCoeffsToSlotsRotationIndices(const std::vector<int32_t>& paramsEnc,
+                                                                   uint32_t slots, uint32_t M) {
+    std::vector<int32_t> indexList;
+
+    int32_t levelBudget     = paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET];
+    int32_t layersCollapse  = paramsEnc[CKKS_BOOT_PARAMS::LAYERS_COLL];
+    int32_t remCollapse     = paramsEnc[CKKS_BOOT_PARAMS::LAYERS_REM];
+    int32_t numRotations    = paramsEnc[CKKS_BOOT_PARAMS::NUM_ROTATIONS];
+    int32_t b               = paramsEnc[CKKS_BOOT_PARAMS::BABY_STEP];
+    int32_t g               = paramsEnc[CKKS_BOOT_PARAMS::GIANT_STEP];
+    int32_t numRotationsRem = paramsEnc[CKKS_BOOT_PARAMS::NUM_ROTATIONS_REM];
+    int32_t bRem            = paramsEnc[CKKS_BOOT_PARAMS::BABY_STEP_REM];
+    int32_t gRem            = paramsEnc[CKKS_BOOT_PARAMS::GIANT_STEP_REM];
+
     int32_t stop;
     int32_t flagRem;
     if (remCollapse == 0) {
@@ -2445,17 +2430,22 @@ std::vector<int32_t> FHECKKSRNS::FindSlotsToCoeffsRotationIndices(uint32_t slots
     }
     const std::shared_ptr<CKKSBootstrapPrecom> precom = pair->second;
 
+    return FindSlotsToCoeffsRotationIndices(precom->m_paramsDec, slots, M);
+}
+
+std::vector<int32_t> FHECKKSRNS::FindSlotsToCoeffsRotationIndices(const std::vector<int32_t>& paramsDec,
+                                                                   uint32_t slots, uint32_t M) {
     std::vector<int32_t> indexList;
 
-    int32_t levelBudget     = precom->m_paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET];
-    int32_t layersCollapse  = precom->m_paramsDec[CKKS_BOOT_PARAMS::LAYERS_COLL];
-    int32_t remCollapse     = precom->m_paramsDec[CKKS_BOOT_PARAMS::LAYERS_REM];
-    int32_t numRotations    = precom->m_paramsDec[CKKS_BOOT_PARAMS::NUM_ROTATIONS];
-    int32_t b               = precom->m_paramsDec[CKKS_BOOT_PARAMS::BABY_STEP];
-    int32_t g               = precom->m_paramsDec[CKKS_BOOT_PARAMS::GIANT_STEP];
-    int32_t numRotationsRem = precom->m_paramsDec[CKKS_BOOT_PARAMS::NUM_ROTATIONS_REM];
-    int32_t bRem            = precom->m_paramsDec[CKKS_BOOT_PARAMS::BABY_STEP_REM];
-    int32_t gRem            = precom->m_paramsDec[CKKS_BOOT_PARAMS::GIANT_STEP_REM];
+    int32_t levelBudget     = paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET];
+    int32_t layersCollapse  = paramsDec[CKKS_BOOT_PARAMS::LAYERS_COLL];
+    int32_t remCollapse     = paramsDec[CKKS_BOOT_PARAMS::LAYERS_REM];
+    int32_t numRotations    = paramsDec[CKKS_BOOT_PARAMS::NUM_ROTATIONS];
+    int32_t b               = paramsDec[CKKS_BOOT_PARAMS::BABY_STEP];
+    int32_t g               = paramsDec[CKKS_BOOT_PARAMS::GIANT_STEP];
+    int32_t numRotationsRem = paramsDec[CKKS_BOOT_PARAMS::NUM_ROTATIONS_REM];
+    int32_t bRem            = paramsDec[CKKS_BOOT_PARAMS::BABY_STEP_REM];
+    int32_t gRem            = paramsDec[CKKS_BOOT_PARAMS::GIANT_STEP_REM];
 
     int32_t flagRem;
     if (remCollapse == 0) {
@@ -2705,7 +2695,8 @@ std::vector<ConstPlaintext> FHECKKSRNS::EvalLinearTransformPrecompute(
 
 std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute(
     const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::complex<double>>& A,
-    const std::vector<uint32_t>& rotGroup, bool flag_i, double scale, uint32_t L) const {
+    const std::vector<uint32_t>& rotGroup, bool flag_i, double scale, uint32_t L,
+    std::vector<std::vector<CKKSDiagonalSeed>>* seeds) const {
     uint32_t slots = rotGroup.size();
 
     auto pair = m_bootPrecomMap.find(slots);
@@ -2737,16 +2728,17 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
         flagRem = 1;
     }
 
-    // result is the rotated plaintext version of the coefficients
+    // result is the rotated plaintext version of the coefficients, or only their seeds are kept
     std::vector<std::vector<ConstPlaintext>> result(levelBudget);
+    if (seeds)
+        seeds->assign(levelBudget, {});
     for (uint32_t i = 0; i < uint32_t(levelBudget); i++) {
-        if (flagRem == 1 && i == 0) {
-            // remainder corresponds to index 0 in encoding and to last index in decoding
-            result[i] = std::vector<ConstPlaintext>(numRotationsRem);
-        }
-        else {
-            result[i] = std::vector<ConstPlaintext>(numRotations);
-        }
+        // remainder corresponds to index 0 in encoding and to last index in decoding
+        uint32_t numDiagonals = (flagRem == 1 && i == 0) ? numRotationsRem : numRotations;
+        if (seeds)
+            (*seeds)[i].resize(numDiagonals);
+        else
+            result[i].resize(numDiagonals);
     }
 
     // make sure the plaintext is created only with the necessary amount of moduli
@@ -2793,6 +2785,15 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
         sizeQ--;
     }
 
+    // encodes a diagonal, or keeps its values as a seed to be encoded on the fly
+    auto setDiagonal = [&](int32_t s, int32_t k, const std::shared_ptr<ILDCRTParams<BigInteger>>& params,
+                           std::vector<std::complex<double>>& values, uint32_t level) {
+        if (seeds)
+            (*seeds)[s][k] = CKKSDiagonalSeed(std::move(values), params, level);
+        else
+            result[s][k] = MakeAuxPlaintext(cc, params, values, 1, level, values.size());
+    };
+
     if (slots == M / 4) {
         //------------------------------------------------------------------------------
         // fully-packed mode
@@ -2818,8 +2819,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
 
                         auto rotateTemp = Rotate(coeff[s][g * i + j], rot);
 
-                        result[s][g * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s - stop], rotateTemp, 1, level0 - s, rotateTemp.size());
+                        setDiagonal(s, g * i + j, paramsVector[s - stop], rotateTemp, level0 - s);
                     }
                 }
             }
@@ -2836,8 +2836,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
                         }
 
                         auto rotateTemp = Rotate(coeff[stop][gRem * i + j], rot);
-                        result[stop][gRem * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[0], rotateTemp, 1, level0, rotateTemp.size());
+                        setDiagonal(stop, gRem * i + j, paramsVector[0], rotateTemp, level0);
                     }
                 }
             }
@@ -2872,8 +2871,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
                         }
 
                         auto rotateTemp = Rotate(clearTemp, rot);
-                        result[s][g * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s - stop], rotateTemp, 1, level0 - s, rotateTemp.size());
+                        setDiagonal(s, g * i + j, paramsVector[s - stop], rotateTemp, level0 - s);
                     }
                 }
             }
@@ -2894,8 +2892,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
                         }
 
                         auto rotateTemp = Rotate(clearTemp, rot);
-                        result[stop][gRem * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[0], rotateTemp, 1, level0, rotateTemp.size());
+                        setDiagonal(stop, gRem * i + j, paramsVector[0], rotateTemp, level0);
                     }
                 }
             }
@@ -2906,7 +2903,8 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
 
 std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute(
     const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::complex<double>>& A,
-    const std::vector<uint32_t>& rotGroup, bool flag_i, double scale, uint32_t L) const {
+    const std::vector<uint32_t>& rotGroup, bool flag_i, double scale, uint32_t L, bool stcFirst,
+    std::vector<std::vector<CKKSDiagonalSeed>>* seeds) const {
     uint32_t slots = rotGroup.size();
     /*L -= 1;*/
 
@@ -2937,16 +2935,17 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
         flagRem = 1;
     }
 
-    // result is the rotated plaintext version of coeff
+    // result is the rotated plaintext version of coeff, or only their seeds are kept
     std::vector<std::vector<ConstPlaintext>> result(levelBudget);
+    if (seeds)
+        seeds->assign(levelBudget, {});
     for (uint32_t i = 0; i < uint32_t(levelBudget); i++) {
-        if (flagRem == 1 && i == uint32_t(levelBudget - 1)) {
-            // remainder corresponds to index 0 in encoding and to last index in decoding
-            result[i] = std::vector<ConstPlaintext>(numRotationsRem);
-        }
-        else {
-            result[i] = std::vector<ConstPlaintext>(numRotations);
-        }
+        // remainder corresponds to index 0 in encoding and to last index in decoding
+        uint32_t numDiagonals = (flagRem == 1 && i == uint32_t(levelBudget - 1)) ? numRotationsRem : numRotations;
+        if (seeds)
+            (*seeds)[i].resize(numDiagonals);
+        else
+            result[i].resize(numDiagonals);
     }
 
     // make sure the plaintext is created only with the necessary amount of moduli
@@ -2993,7 +2992,18 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
         sizeQ--;
     }
 
-    if (slots == M / 4) {
+    // encodes a diagonal, or keeps its values as a seed to be encoded on the fly
+    auto setDiagonal = [&](int32_t s, int32_t k, const std::shared_ptr<ILDCRTParams<BigInteger>>& params,
+                           std::vector<std::complex<double>>& values, uint32_t level) {
+        if (seeds)
+            (*seeds)[s][k] = CKKSDiagonalSeed(std::move(values), params, level);
+        else
+            result[s][k] = MakeAuxPlaintext(cc, params, values, 1, level, values.size());
+    };
+
+    // When SlotsToCoeffs runs first, a sparsely packed input holds its slots replicated with period slots
+    // instead of the 2*slots real values produced by EvalMod, so U0 alone maps it to the sparse coefficients.
+    if (slots == M / 4 || stcFirst) {
         // fully-packed
         auto coeff = CoeffDecodingCollapse(A, rotGroup, levelBudget, flag_i);
 
@@ -3011,8 +3021,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
                         }
 
                         auto rotateTemp = Rotate(coeff[s][g * i + j], rot);
-                        result[s][g * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1, level0 + s, rotateTemp.size());
+                        setDiagonal(s, g * i + j, paramsVector[s], rotateTemp, level0 + s);
                     }
                 }
             }
@@ -3030,8 +3039,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
                         }
 
                         auto rotateTemp = Rotate(coeff[s][gRem * i + j], rot);
-                        result[s][gRem * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1, level0 + s, rotateTemp.size());
+                        setDiagonal(s, gRem * i + j, paramsVector[s], rotateTemp, level0 + s);
                     }
                 }
             }
@@ -3063,8 +3071,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
                         }
 
                         auto rotateTemp = Rotate(clearTemp, rot);
-                        result[s][g * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1, level0 + s, rotateTemp.size());
+                        setDiagonal(s, g * i + j, paramsVector[s], rotateTemp, level0 + s);
                     }
                 }
             }
@@ -3086,8 +3093,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
                         }
 
                         auto rotateTemp = Rotate(clearTemp, rot);
-                        result[s][gRem * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1, level0 + s, rotateTemp.size());
+                        setDiagonal(s, gRem * i + j, paramsVector[s], rotateTemp, level0 + s);
                     }
                 }
             }
@@ -3138,12 +3144,15 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalLinearTransform(const std::vector<ConstPlai
     DCRTPoly first;
 
     for (uint32_t j = 0; j < gStep; j++) {
-        Ciphertext<DCRTPoly> inner = EvalMultExt(cc->KeySwitchExt(ct, true), A[bStep * j]);
+        std::vector<ConstCiphertext<DCRTPoly>> babySteps{cc->KeySwitchExt(ct, true)};
+        std::vector<ConstPlaintext> babyDiagonals{A[bStep * j]};
         for (uint32_t i = 1; i < bStep; i++) {
             if (bStep * j + i < slots) {
-                EvalAddExtInPlace(inner, EvalMultExt(fastRotation[i - 1], A[bStep * j + i]));
+                babySteps.push_back(fastRotation[i - 1]);
+                babyDiagonals.push_back(A[bStep * j + i]);
             }
         }
+        Ciphertext<DCRTPoly> inner = EvalMultSumExt(babySteps, babyDiagonals);
 
         if (j == 0) {
             first         = cc->KeySwitchDownFirstElement(inner);
@@ -3189,7 +3198,6 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
 
     auto cc    = ctxt->GetCryptoContext();
     uint32_t M = cc->GetCyclotomicOrder();
-    uint32_t N = cc->GetRingDimension();
 
     int32_t levelBudget     = precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET];
     int32_t layersCollapse  = precom->m_paramsEnc[CKKS_BOOT_PARAMS::LAYERS_COLL];
@@ -3257,127 +3265,17 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
             algo->ModReduceInternalInPlace(result, BASE_NUM_LEVELS_TO_DROP);
         }
 
-        // computes the NTTs for each CRT limb (for the hoisted automorphisms used later on)
-        auto digits = cc->EvalFastRotationPrecompute(result);
-
-        std::vector<Ciphertext<DCRTPoly>> fastRotation(g);
-#pragma omp parallel for
-        for (int32_t j = 0; j < g; j++) {
-            if (rot_in[s][j] != 0) {
-                fastRotation[j] = cc->EvalFastRotationExt(result, rot_in[s][j], digits, true);
-            }
-            else {
-                fastRotation[j] = cc->KeySwitchExt(result, true);
-            }
-        }
-
-        Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
-        for (int32_t i = 0; i < b; i++) {
-            // for the first iteration with j=0:
-            int32_t G                  = g * i;
-            Ciphertext<DCRTPoly> inner = EvalMultExt(fastRotation[0], A[s][G]);
-            // continue the loop
-            for (int32_t j = 1; j < g; j++) {
-                if ((G + j) != int32_t(numRotations)) {
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[s][G + j]));
-                }
-            }
-
-            if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(std::move(elements));
-                outer = inner;
-            }
-            else {
-                if (rot_out[s][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[s][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[s][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(std::move(elements));
-                    EvalAddExtInPlace(outer, inner);
-                }
-            }
-        }
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        std::vector<ConstPlaintext> diagonals;
+        const auto& As = GetTransformDiagonals(*cc, A, precom->m_U0hatTSeeds, s, diagonals);
+        result = EvalBSGSLevelExt(result, As, rot_in[s], rot_out[s], g, b, numRotations);
     }
 
     if (flagRem) {
         algo->ModReduceInternalInPlace(result, BASE_NUM_LEVELS_TO_DROP);
 
-        // computes the NTTs for each CRT limb (for the hoisted automorphisms used later on)
-        auto digits = cc->EvalFastRotationPrecompute(result);
-        std::vector<Ciphertext<DCRTPoly>> fastRotation(gRem);
-
-#pragma omp parallel for
-        for (int32_t j = 0; j < gRem; j++) {
-            if (rot_in[stop][j] != 0) {
-                fastRotation[j] = cc->EvalFastRotationExt(result, rot_in[stop][j], digits, true);
-            }
-            else {
-                fastRotation[j] = cc->KeySwitchExt(result, true);
-            }
-        }
-
-        Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
-        for (int32_t i = 0; i < bRem; i++) {
-            Ciphertext<DCRTPoly> inner;
-            // for the first iteration with j=0:
-            int32_t GRem = gRem * i;
-            inner        = EvalMultExt(fastRotation[0], A[stop][GRem]);
-            // continue the loop
-            for (int32_t j = 1; j < gRem; j++) {
-                if ((GRem + j) != int32_t(numRotationsRem)) {
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[stop][GRem + j]));
-                }
-            }
-
-            if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(std::move(elements));
-                outer = inner;
-            }
-            else {
-                if (rot_out[stop][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[stop][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[stop][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(std::move(elements));
-                    EvalAddExtInPlace(outer, inner);
-                }
-            }
-        }
-
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        std::vector<ConstPlaintext> diagonals;
+        const auto& As = GetTransformDiagonals(*cc, A, precom->m_U0hatTSeeds, stop, diagonals);
+        result = EvalBSGSLevelExt(result, As, rot_in[stop], rot_out[stop], gRem, bRem, numRotationsRem);
     }
 
     return result;
@@ -3399,7 +3297,6 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
     auto cc = ctxt->GetCryptoContext();
 
     uint32_t M = cc->GetCyclotomicOrder();
-    uint32_t N = cc->GetRingDimension();
 
     int32_t levelBudget     = precom->m_paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET];
     int32_t layersCollapse  = precom->m_paramsDec[CKKS_BOOT_PARAMS::LAYERS_COLL];
@@ -3468,128 +3365,19 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
         if (s != 0) {
             algo->ModReduceInternalInPlace(result, BASE_NUM_LEVELS_TO_DROP);
         }
-        // computes the NTTs for each CRT limb (for the hoisted automorphisms used later on)
-        auto digits = cc->EvalFastRotationPrecompute(result);
-
-        std::vector<Ciphertext<DCRTPoly>> fastRotation(g);
-#pragma omp parallel for
-        for (int32_t j = 0; j < g; j++) {
-            if (rot_in[s][j] != 0) {
-                fastRotation[j] = cc->EvalFastRotationExt(result, rot_in[s][j], digits, true);
-            }
-            else {
-                fastRotation[j] = cc->KeySwitchExt(result, true);
-            }
-        }
-
-        Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
-        for (int32_t i = 0; i < b; i++) {
-            Ciphertext<DCRTPoly> inner;
-            // for the first iteration with j=0:
-            int32_t G = g * i;
-            inner     = EvalMultExt(fastRotation[0], A[s][G]);
-            // continue the loop
-            for (int32_t j = 1; j < g; j++) {
-                if ((G + j) != int32_t(numRotations)) {
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[s][G + j]));
-                }
-            }
-
-            if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(std::move(elements));
-                outer = inner;
-            }
-            else {
-                if (rot_out[s][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[s][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[s][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(std::move(elements));
-                    EvalAddExtInPlace(outer, inner);
-                }
-            }
-        }
-
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        std::vector<ConstPlaintext> diagonals;
+        const auto& As = GetTransformDiagonals(*cc, A, precom->m_U0Seeds, s, diagonals);
+        result = EvalBSGSLevelExt(result, As, rot_in[s], rot_out[s], g, b, numRotations);
     }
 
     if (flagRem) {
         algo->ModReduceInternalInPlace(result, BASE_NUM_LEVELS_TO_DROP);
-        // computes the NTTs for each CRT limb (for the hoisted automorphisms used later on)
-        auto digits = cc->EvalFastRotationPrecompute(result);
-        std::vector<Ciphertext<DCRTPoly>> fastRotation(gRem);
 
         int32_t s = levelBudget - flagRem;
-#pragma omp parallel for
-        for (int32_t j = 0; j < gRem; j++) {
-            if (rot_in[s][j] != 0) {
-                fastRotation[j] = cc->EvalFastRotationExt(result, rot_in[s][j], digits, true);
-            }
-            else {
-                fastRotation[j] = cc->KeySwitchExt(result, true);
-            }
-        }
-
-        Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
-        for (int32_t i = 0; i < bRem; i++) {
-            Ciphertext<DCRTPoly> inner;
-            // for the first iteration with j=0:
-            int32_t GRem = gRem * i;
-            inner        = EvalMultExt(fastRotation[0], A[s][GRem]);
-            // continue the loop
-            for (int32_t j = 1; j < gRem; j++) {
-                if ((GRem + j) != int32_t(numRotationsRem))
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[s][GRem + j]));
-            }
 
-            if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(std::move(elements));
-                outer = inner;
-            }
-            else {
-                if (rot_out[s][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[s][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[s][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(std::move(elements));
-                    EvalAddExtInPlace(outer, inner);
-                }
-            }
-        }
-
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        std::vector<ConstPlaintext> diagonals;
+        const auto& As = GetTransformDiagonals(*cc, A, precom->m_U0Seeds, s, diagonals);
+        result = EvalBSGSLevelExt(result, As, rot_in[s], rot_out[s], gRem, bRem, numRotationsRem);
     }
 
     return result;
@@ -3682,6 +3470,251 @@ void FHECKKSRNS::ApplyDoubleAngleIterations(Ciphertext<DCRTPoly>& ciphertext, ui
     }
 }
 
+// Raises the modulus of the SlotsToCoeffs output of functional bootstrapping and multiplies it by pre / N.
+// With the FLEXIBLEAUTO* techniques, the SlotsToCoeffs scale was set up so that the raised message has scale 2^p as in
+// FIXEDMANUAL; the metadata is switched to the scaling factor of the raised level and the difference is absorbed by
+// the constant. The result is then rescaled, as CoeffsToSlots is precomputed for a degree 1 input in that case.
+Ciphertext<DCRTPoly> FHECKKSRNS::EvalFuncModRaise(Ciphertext<DCRTPoly> ciphertext, double pre) const {
+    BootstrapStageTimer timer(m_bootStats, "ModRaise");
+
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
+
+    auto cc     = ciphertext->GetCryptoContext();
+    auto algo   = cc->GetScheme();
+    uint32_t M  = cc->GetCyclotomicOrder();
+    uint32_t N  = cc->GetRingDimension();
+    uint32_t L0 = cryptoParams->GetElementParams()->GetParams().size();
+
+    auto elementParamsRaised = *(cryptoParams->GetElementParams());
+
+    // For FLEXIBLEAUTOEXT the raised ciphertext does not include the extra modulus
+    if (cryptoParams->GetScalingTechnique() == FLEXIBLEAUTOEXT) {
+        elementParamsRaised.PopLastParam();
+    }
+
+    auto paramsQ = elementParamsRaised.GetParams();
+    usint sizeQ  = paramsQ.size();
+
+    std::vector<NativeInteger> moduli(sizeQ);
+    std::vector<NativeInteger> roots(sizeQ);
+    for (size_t i = 0; i < sizeQ; i++) {
+        moduli[i] = paramsQ[i]->GetModulus();
+        roots[i]  = paramsQ[i]->GetRootOfUnity();
+    }
+    auto elementParamsRaisedPtr = std::make_shared<ILDCRTParams<DCRTPoly::Integer>>(M, moduli, roots);
+
+    Ciphertext<DCRTPoly> raised = ciphertext;
+    algo->ModReduceInternalInPlace(raised, raised->GetNoiseScaleDeg() - 1);
+
+    auto ctxtDCRT = raised->GetElements();
+
+    for (size_t i = 0; i < ctxtDCRT.size(); i++) {
+        DCRTPoly temp(elementParamsRaisedPtr, COEFFICIENT);
+        ctxtDCRT[i].SetFormat(COEFFICIENT);
+        temp = ctxtDCRT[i].GetElementAtIndex(0);
+        temp.SetFormat(EVALUATION);
+        ctxtDCRT[i] = temp;
+    }
+
+    raised->SetLevel(L0 - ctxtDCRT[0].GetNumOfElements());
+    raised->SetElements(std::move(ctxtDCRT));
+
+    if (m_bootStats)
+        m_bootStats->UpdatePeakTowers(raised->GetElements()[0].GetNumOfElements());
+
+    double constantEvalMult = pre / N;
+
+    if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL) {
+        double powP     = pow(2, cryptoParams->GetPlaintextModulus());
+        double targetSF = cryptoParams->GetScalingFactorReal(raised->GetLevel());
+        constantEvalMult *= targetSF / powP;
+        raised->SetScalingFactor(targetSF);
+    }
+
+    cc->EvalMultInPlace(raised, constantEvalMult);
+
+    if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL) {
+        algo->ModReduceInternalInPlace(raised, BASE_NUM_LEVELS_TO_DROP);
+    }
+
+    return raised;
+}
+
+// Sparsely packed front end of functional bootstrapping: SlotsToCoeffs, ModRaise, PartialSum and CoeffsToSlots.
+// The real and imaginary parts of slot i are returned as real values in slots i and i + slots of a ciphertext
+// with period 2 * slots, so the LUT only has to be evaluated once instead of once per part.
+Ciphertext<DCRTPoly> FHECKKSRNS::EvalFuncSparseCoeffsToSlots(ConstCiphertext<DCRTPoly> ciphertext, double pre) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
+
+    auto cc        = ciphertext->GetCryptoContext();
+    auto algo      = cc->GetScheme();
+    uint32_t N     = cc->GetRingDimension();
+    uint32_t slots = ciphertext->GetSlots();
+
+    const std::shared_ptr<CKKSBootstrapPrecom> precom = m_bootPrecomMap.find(slots)->second;
+
+    //------------------------------------------------------------------------------
+    // Running SlotToCoeff
+    //------------------------------------------------------------------------------
+
+    auto ctxtStC = TimeBootstrapStage(m_bootStats, "SlotsToCoeffs", [&] { return EvalSlotsToCoeffs(precom->m_U0PreFFT, ciphertext); });
+
+    //------------------------------------------------------------------------------
+    // RAISING THE MODULUS
+    //------------------------------------------------------------------------------
+
+    auto raised = EvalFuncModRaise(ctxtStC, pre);
+
+    //------------------------------------------------------------------------------
+    // Running PartialSum
+    //------------------------------------------------------------------------------
+
+    TimeBootstrapStage(m_bootStats, "PartialSum", [&] {
+        for (uint32_t j = 1; j < N / (2 * slots); j <<= 1) {
+            auto temp = cc->EvalRotate(raised, j * slots);
+            cc->EvalAddInPlace(raised, temp);
+        }
+    });
+
+    //------------------------------------------------------------------------------
+    // Running CoeffToSlot
+    //------------------------------------------------------------------------------
+
+    auto ctxtCtS = TimeBootstrapStage(m_bootStats, "CoeffsToSlots", [&] { return EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised); });
+
+    auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ctxtCtS->GetKeyTag());
+    auto conj       = Conjugate(ctxtCtS, evalKeyMap);
+    cc->EvalAddInPlace(ctxtCtS, conj);
+
+    if (cryptoParams->GetScalingTechnique() == FIXEDMANUAL) {
+        while (ctxtCtS->GetNoiseScaleDeg() > 1) {
+            cc->ModReduceInPlace(ctxtCtS);
+        }
+    }
+    else {
+        if (ctxtCtS->GetNoiseScaleDeg() == 2) {
+            algo->ModReduceInternalInPlace(ctxtCtS, BASE_NUM_LEVELS_TO_DROP);
+        }
+    }
+
+    return ctxtCtS;
+}
+
+// Sparsely packed back end of functional bootstrapping: folds the 2 * slots real values back into slots values,
+// slot i + slots being multiplied by factor (i for the imaginary parts, 0 to discard the upper half).
+// This consumes one level for the mask.
+Ciphertext<DCRTPoly> FHECKKSRNS::EvalFuncSparseMerge(ConstCiphertext<DCRTPoly> ciphertext,
+                                                     std::complex<double> factor) const {
+    auto cc        = ciphertext->GetCryptoContext();
+    uint32_t slots = ciphertext->GetSlots();
+
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
+
+    // The mask is encoded at the level of its multiplicand, so pending rescalings are done first
+    auto result = ciphertext->Clone();
+    if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL && result->GetNoiseScaleDeg() == 2) {
+        cc->GetScheme()->ModReduceInternalInPlace(result, BASE_NUM_LEVELS_TO_DROP);
+    }
+
+    std::vector<std::complex<double>> mask(2 * slots, factor);
+    std::fill(mask.begin(), mask.begin() + slots, std::complex<double>(1, 0));
+    Plaintext ptxtMask = cc->MakeCKKSPackedPlaintext(mask, 1, result->GetLevel(), nullptr, 2 * slots);
+
+    result = cc->EvalMult(result, ptxtMask);
+    if (cryptoParams->GetScalingTechnique() == FIXEDMANUAL) {
+        while (result->GetNoiseScaleDeg() > 1) {
+            cc->ModReduceInPlace(result);
+        }
+    }
+
+    cc->EvalAddInPlace(result, cc->EvalRotate(result, slots));
+
+    return result;
+}
+
+const std::vector<ConstPlaintext>& FHECKKSRNS::GetTransformDiagonals(
+    const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::vector<ConstPlaintext>>& A,
+    const std::vector<std::vector<CKKSDiagonalSeed>>& seeds, uint32_t s, std::vector<ConstPlaintext>& buffer) const {
+    if (seeds.empty())
+        return A[s];
+
+    buffer.resize(seeds[s].size());
+#pragma omp parallel for
+    for (size_t k = 0; k < seeds[s].size(); k++) {
+        const auto& seed = seeds[s][k];
+        if (seed.values.empty())
+            continue;
+        auto encode = [&]() -> ConstPlaintext {
+            return MakeAuxPlaintext(cc, seed.params, seed.values, 1, seed.level, seed.values.size());
+        };
+        buffer[k] = (m_diagCache) ? m_diagCache->Get(seed, encode) : encode();
+    }
+
+    return buffer;
+}
+
+Ciphertext<DCRTPoly> FHECKKSRNS::EvalBSGSLevelExt(ConstCiphertext<DCRTPoly> ctxt, const std::vector<ConstPlaintext>& As,
+                                                  const std::vector<int32_t>& rotIn,
+                                                  const std::vector<int32_t>& rotOut, int32_t g, int32_t b,
+                                                  int32_t numRotations) const {
+    // the diagonal numRotations is skipped in the baby steps, except for the first one of a giant step
+    const int32_t numDiagonals = (g > 1 && g * b - 1 == numRotations) ? g * b - 1 : g * b;
+    if (g < 1 || b < 1 || int32_t(rotIn.size()) < g || int32_t(rotOut.size()) < b ||
+        int32_t(As.size()) < numDiagonals) {
+        OPENFHE_THROW("Inconsistent baby-step giant-step parameters: g = " + std::to_string(g) +
+                      ", b = " + std::to_string(b) + ", " + std::to_string(rotIn.size()) + " baby-step and " +
+                      std::to_string(rotOut.size()) + " giant-step rotations, " + std::to_string(As.size()) +
+                      " diagonals");
+    }
+
+    const auto cc = ctxt->GetCryptoContext();
+
+    // computes the NTTs for each CRT limb (for the hoisted automorphisms used later on)
+    auto digits = cc->EvalFastRotationPrecompute(ctxt);
+
+    std::vector<Ciphertext<DCRTPoly>> fastRotation(g);
+#pragma omp parallel for
+    for (int32_t j = 0; j < g; j++) {
+        if (rotIn[j] != 0) {
+            fastRotation[j] = cc->EvalFastRotationExt(ctxt, rotIn[j], digits, true);
+        }
+        else {
+            fastRotation[j] = cc->KeySwitchExt(ctxt, true);
+        }
+    }
+
+    // double hoisting: the giant steps are accumulated in the extended basis P*Q, so that there is
+    // a single ModDown of both elements per level
+    const auto paramsQl = ctxt->GetElements()[0].GetParams();
+    Ciphertext<DCRTPoly> outer;
+    for (int32_t i = 0; i < b; i++) {
+        // for the first iteration with j=0:
+        int32_t G = g * i;
+        std::vector<ConstCiphertext<DCRTPoly>> babySteps{fastRotation[0]};
+        std::vector<ConstPlaintext> babyDiagonals{As[G]};
+        // continue the loop
+        for (int32_t j = 1; j < g; j++) {
+            if ((G + j) != numRotations) {
+                babySteps.push_back(fastRotation[j]);
+                babyDiagonals.push_back(As[G + j]);
+            }
+        }
+        Ciphertext<DCRTPoly> inner = EvalMultSumExt(babySteps, babyDiagonals);
+
+        if (i == 0) {
+            outer = inner;
+        }
+        else if (rotOut[i] != 0) {
+            EvalAddExtInPlace(outer, EvalRotateExt(inner, rotOut[i], paramsQl));
+        }
+        else {
+            EvalAddExtInPlace(outer, inner);
+        }
+    }
+
+    return cc->KeySwitchDown(outer);
+}
+
 #if NATIVEINT == 128 && !defined(__EMSCRIPTEN__)
 Plaintext FHECKKSRNS::MakeAuxPlaintext(const CryptoContextImpl<DCRTPoly>& cc, const std::shared_ptr<ParmType> params,
                                        const std::vector<std::complex<double>>& value, size_t noiseScaleDeg,
@@ -4015,6 +4048,36 @@ void FHECKKSRNS::EvalAddExtInPlace(Ciphertext<DCRTPoly>& ciphertext1, ConstCiphe
     }
 }
 
+Ciphertext<DCRTPoly> FHECKKSRNS::EvalMultSumExt(const std::vector<ConstCiphertext<DCRTPoly>>& ciphertexts,
+                                                const std::vector<ConstPlaintext>& plaintexts) const {
+    // the products are accumulated without reduction, and each coefficient of the sum is reduced once
+    const std::vector<DCRTPoly>& cv0 = ciphertexts[0]->GetElements();
+    std::vector<DCRTPolyAccumulator> sums;
+    sums.reserve(cv0.size());
+    for (const auto& c : cv0)
+        sums.emplace_back(c.GetParams());
+
+    for (size_t i = 0; i < ciphertexts.size(); ++i) {
+        DCRTPoly pt = plaintexts[i]->GetElement<DCRTPoly>();
+        pt.SetFormat(Format::EVALUATION);
+
+        const std::vector<DCRTPoly>& cv = ciphertexts[i]->GetElements();
+        for (size_t j = 0; j < cv.size(); ++j)
+            sums[j].AddProduct(cv[j], pt);
+    }
+
+    std::vector<DCRTPoly> elements;
+    elements.reserve(sums.size());
+    for (const auto& sum : sums)
+        elements.push_back(sum.GetElement());
+
+    Ciphertext<DCRTPoly> result = ciphertexts[0]->CloneZero();
+    result->SetElements(std::move(elements));
+    result->SetNoiseScaleDeg(result->GetNoiseScaleDeg() + plaintexts[0]->GetNoiseScaleDeg());
+    result->SetScalingFactor(result->GetScalingFactor() * plaintexts[0]->GetScalingFactor());
+    return result;
+}
+
 Ciphertext<DCRTPoly> FHECKKSRNS::EvalAddExt(ConstCiphertext<DCRTPoly> ciphertext1,
                                             ConstCiphertext<DCRTPoly> ciphertext2) const {
     Ciphertext<DCRTPoly> result = ciphertext1->Clone();
@@ -4022,6 +4085,44 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalAddExt(ConstCiphertext<DCRTPoly> ciphertext
     return result;
 }
 
+Ciphertext<DCRTPoly> FHECKKSRNS::EvalRotateExt(ConstCiphertext<DCRTPoly> ciphertext, int32_t index,
+                                               const std::shared_ptr<ParmType>& paramsQl) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
+
+    auto cc    = ciphertext->GetCryptoContext();
+    auto algo  = cc->GetScheme();
+    uint32_t N = cc->GetRingDimension();
+
+    usint autoIndex      = FindAutomorphismIndex2nComplex(index, cc->GetCyclotomicOrder());
+    const auto& evalKeys = CryptoContextImpl<DCRTPoly>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
+    auto evalKeyIterator = evalKeys.find(autoIndex);
+    if (evalKeyIterator == evalKeys.end()) {
+        OPENFHE_THROW("EvalKey for index [" + std::to_string(autoIndex) + "] is not found.");
+    }
+
+    const std::vector<DCRTPoly>& cv = ciphertext->GetElements();
+
+    PlaintextModulus t = (cryptoParams->GetNoiseScale() == 1) ? 0 : cryptoParams->GetPlaintextModulus();
+    DCRTPoly c1 = cv[1].ApproxModDown(paramsQl, cryptoParams->GetParamsP(), cryptoParams->GetPInvModq(),
+                                      cryptoParams->GetPInvModqPrecon(), cryptoParams->GetPHatInvModp(),
+                                      cryptoParams->GetPHatInvModpPrecon(), cryptoParams->GetPHatModq(),
+                                      cryptoParams->GetModqBarrettMu(), cryptoParams->GettInvModp(),
+                                      cryptoParams->GettInvModpPrecon(), t, cryptoParams->GettModqPrecon());
+
+    auto digits = algo->EvalKeySwitchPrecomputeCore(c1, cryptoParams);
+    auto cTilda = algo->EvalFastKeySwitchCoreExt(digits, ResolveEvalKey(evalKeyIterator->second), paramsQl);
+
+    std::vector<usint> map(N);
+    PrecomputeAutoMap(N, autoIndex, &map);
+
+    // the first element is already scaled by P, as the output of the key switching; it is added to the
+    // key-switched one in the same pass as the permutation
+    Ciphertext<DCRTPoly> result = ciphertext->CloneZero();
+    result->SetElements({(*cTilda)[0].AutomorphismTransformOfSum(cv[0], autoIndex, map),
+                         (*cTilda)[1].AutomorphismTransform(autoIndex, map)});
+    return result;
+}
+
 EvalKey<DCRTPoly> FHECKKSRNS::ConjugateKeyGen(const PrivateKey<DCRTPoly> privateKey) const {
     const auto cc = privateKey->GetCryptoContext();
     auto algo     = cc->GetScheme();
@@ -4045,6 +4146,8 @@ EvalKey<DCRTPoly> FHECKKSRNS::ConjugateKeyGen(const PrivateKey<DCRTPoly> private
 
 Ciphertext<DCRTPoly> FHECKKSRNS::Conjugate(ConstCiphertext<DCRTPoly> ciphertext,
                                            const std::map<usint, EvalKey<DCRTPoly>>& evalKeyMap) const {
+    BootstrapStageTimer timer(m_bootStats, "Conjugation");
+
     const std::vector<DCRTPoly>& cv = ciphertext->GetElements();
     usint N                         = cv[0].GetRingDimension();
 
@@ -4055,7 +4158,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::Conjugate(ConstCiphertext<DCRTPoly> ciphertext,
 
     Ciphertext<DCRTPoly> result = ciphertext->Clone();
 
-    algo->KeySwitchInPlace(result, evalKeyMap.at(2 * N - 1));
+    algo->KeySwitchInPlace(result, ResolveEvalKey(evalKeyMap.at(2 * N - 1)));
 
     std::vector<DCRTPoly>& rcv = result->GetElements();
 
@@ -43,12 +43,14 @@ CKKS implementation. See https://eprint.iacr.org/2020/1118 for details.
 #include "cryptocontext.h"
 
 #include "encoding/ckkspackedencoding.h"
+#include "key/evalkeystore.h"
 #include "lattice/hal/lat-backend.h"
 #include "lattice/matrix-lattice-impl.h"
 #include "math/hal/basicint.h"
 
 #include "scheme/ckksrns/ckksrns-cryptoparameters.h"
 #include "scheme/ckksrns/ckksrns-leveledshe.h"
+#include "utils/opcounters.h"
 #include <typeinfo>
 
 #include "schemebase/base-scheme.h"
@@ -79,7 +81,7 @@ void LeveledSHECKKSRNS::EvalAddInPlace(Ciphertext<DCRTPoly>& ciphertext, double
 void LeveledSHECKKSRNS::EvalAddInPlace(Ciphertext<DCRTPoly>& ciphertext, std::complex<double> operand) const {
     const auto cc = ciphertext->GetCryptoContext();
     std::vector<std::complex<double>> v(ciphertext->GetSlots(), operand);
-    Plaintext ptx = cc->MakeCKKSPackedPlaintext(v);
+    Plaintext ptx = cc->MakeCKKSPackedPlaintext(v, 1, 0, nullptr, ciphertext->GetSlots());
     ciphertext = cc->EvalAdd(ciphertext, ptx);
 }
 
@@ -107,7 +109,7 @@ void LeveledSHECKKSRNS::EvalSubInPlace(Ciphertext<DCRTPoly>& ciphertext, double
 void LeveledSHECKKSRNS::EvalSubInPlace(Ciphertext<DCRTPoly>& ciphertext, std::complex<double> operand) const {
     const auto cc = ciphertext->GetCryptoContext();
     std::vector<std::complex<double>> v(ciphertext->GetSlots(), operand);
-    Plaintext ptx = cc->MakeCKKSPackedPlaintext(v);
+    Plaintext ptx = cc->MakeCKKSPackedPlaintext(v, 1, 0, nullptr, ciphertext->GetSlots());
     ciphertext = cc->EvalSub(ciphertext, ptx);
 }
 
@@ -142,10 +144,43 @@ void LeveledSHECKKSRNS::EvalMultInPlace(Ciphertext<DCRTPoly>& ciphertext, double
 void LeveledSHECKKSRNS::EvalMultInPlace(Ciphertext<DCRTPoly>& ciphertext, std::complex<double> operand) const {
     const auto cc = ciphertext->GetCryptoContext();
     std::vector<std::complex<double>> v(ciphertext->GetSlots(), operand);
-    Plaintext ptx = cc->MakeCKKSPackedPlaintext(v);
+    Plaintext ptx = cc->MakeCKKSPackedPlaintext(v, 1, 0, nullptr, ciphertext->GetSlots());
     ciphertext = cc->EvalMult(ciphertext, ptx);
 }
 
+Ciphertext<DCRTPoly> LeveledSHECKKSRNS::EvalLinearWSumCore(const std::vector<Ciphertext<DCRTPoly>>& ciphertexts,
+                                                           const std::vector<double>& constants) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertexts[0]->GetCryptoParameters());
+
+    // the products by the scaled weights are accumulated without reduction, and each coefficient of the sum is
+    // reduced once
+    const std::vector<DCRTPoly>& cv0 = ciphertexts[0]->GetElements();
+    std::vector<DCRTPolyAccumulator> sums;
+    sums.reserve(cv0.size());
+    for (const auto& c : cv0)
+        sums.emplace_back(c.GetParams());
+
+    for (size_t i = 0; i < ciphertexts.size(); ++i) {
+        std::vector<DCRTPoly::Integer> factors = GetElementForEvalMult(ciphertexts[i], constants[i]);
+        const std::vector<DCRTPoly>& cv        = ciphertexts[i]->GetElements();
+        for (size_t j = 0; j < cv.size(); ++j)
+            sums[j].AddProduct(cv[j], factors);
+    }
+
+    std::vector<DCRTPoly> elements;
+    elements.reserve(sums.size());
+    for (const auto& sum : sums)
+        elements.push_back(sum.GetElement());
+
+    Ciphertext<DCRTPoly> result = ciphertexts[0]->CloneZero();
+    result->SetElements(std::move(elements));
+    result->SetNoiseScaleDeg(result->GetNoiseScaleDeg() + 1);
+
+    double scFactor = cryptoParams->GetScalingFactorReal(result->GetLevel());
+    result->SetScalingFactor(result->GetScalingFactor() * scFactor);
+    return result;
+}
+
 /////////////////////////////////////////
 // SHE MULTIPLICATION PLAINTEXT
 /////////////////////////////////////////
@@ -170,6 +205,8 @@ void LeveledSHECKKSRNS::ModReduceInternalInPlace(Ciphertext<DCRTPoly>& ciphertex
         }
     }
 
+    OpCounters::Add(RESCALE_COUNTER, levels);
+
     ciphertext->SetNoiseScaleDeg(ciphertext->GetNoiseScaleDeg() - levels);
     ciphertext->SetLevel(ciphertext->GetLevel() + levels);
 
@@ -832,7 +869,7 @@ Ciphertext<DCRTPoly> LeveledSHECKKSRNS::EvalFastRotationExt(ConstCiphertext<DCRT
     if (evalKeyIterator == evalKeys.end()) {
         OPENFHE_THROW("EvalKey for index [" + std::to_string(autoIndex) + "] is not found.");
     }
-    auto evalKey = evalKeyIterator->second;
+    auto evalKey = ResolveEvalKey(evalKeyIterator->second);
 
     const std::vector<DCRTPoly>& cv = ciphertext->GetElements();
     const auto paramsQl             = cv[0].GetParams();
@@ -841,21 +878,18 @@ Ciphertext<DCRTPoly> LeveledSHECKKSRNS::EvalFastRotationExt(ConstCiphertext<DCRT
 
     std::shared_ptr<std::vector<DCRTPoly>> cTilda = algo->EvalFastKeySwitchCoreExt(digits, evalKey, paramsQl);
 
-    if (addFirst) {
-        const auto paramsQlP = (*cTilda)[0].GetParams();
-        size_t sizeQl        = paramsQl->GetParams().size();
-        DCRTPoly psiC0       = DCRTPoly(paramsQlP, Format::EVALUATION, true);
-        auto cMult           = ciphertext->GetElements()[0].TimesNoCheck(cryptoParams->GetPModq());
-        for (usint i = 0; i < sizeQl; i++) {
-            psiC0.SetElementAtIndex(i, std::move(cMult.GetElementAtIndex(i)));
-        }
-        (*cTilda)[0] += psiC0;
-    }
-
     std::vector<usint> vec(N);
     PrecomputeAutoMap(N, autoIndex, &vec);
 
-    (*cTilda)[0] = (*cTilda)[0].AutomorphismTransform(autoIndex, vec);
+    if (addFirst) {
+        // P*c0 only has towers in Ql: the towers of P are left unchanged by the sum, which is done in the
+        // same pass as the permutation
+        auto cMult   = ciphertext->GetElements()[0].TimesNoCheck(cryptoParams->GetPModq());
+        (*cTilda)[0] = (*cTilda)[0].AutomorphismTransformOfSum(cMult, autoIndex, vec);
+    }
+    else {
+        (*cTilda)[0] = (*cTilda)[0].AutomorphismTransform(autoIndex, vec);
+    }
     (*cTilda)[1] = (*cTilda)[1].AutomorphismTransform(autoIndex, vec);
 
     Ciphertext<DCRTPoly> result = ciphertext->CloneZero();
@@ -39,6 +39,7 @@
 
 #include "cryptocontext.h"
 #include "gen-cryptocontext.h"
+#include "key/evalkeystore.h"
 #include "scheme/ckksrns/gen-cryptocontext-ckksrns.h"
 
 #include "math/dftransform.h"
@@ -529,7 +530,7 @@ Ciphertext<DCRTPoly> SWITCHCKKSRNS::Conjugate(ConstCiphertext<DCRTPoly> cipherte
 
     Ciphertext<DCRTPoly> result = ciphertext->Clone();
 
-    algo->KeySwitchInPlace(result, evalKeyMap.at(2 * N - 1));
+    algo->KeySwitchInPlace(result, ResolveEvalKey(evalKeyMap.at(2 * N - 1)));
 
     std::vector<DCRTPoly>& rcv = result->GetElements();
 
@@ -551,6 +551,20 @@ uint32_t GetMultiplicativeDepthByCoeffVector(const std::vector<double>& vec, boo
 
 
 
+uint32_t GetMultiplicativeDepthByCoeffVector(const std::vector<std::complex<double>>& vec, bool isNormalized) {
+    size_t vecSize = vec.size();
+    if (!vecSize) {
+        OPENFHE_THROW("Cannot perform operation on empty vector. vec.size() == 0");
+    }
+
+    size_t degree      = vecSize - 1;
+    uint32_t multDepth = GetDepthByDegree(degree);
+
+    return (isNormalized) ? (multDepth - 1) : multDepth;
+}
+
+
+
 std::vector<std::complex<double>> ExtractShiftedDiagonal(const std::vector<std::vector<std::complex<double>>>& A,
                                                          int index) {
     uint32_t cols = A[0].size();
@@ -1022,7 +1036,7 @@ std::vector<uint32_t> SelectLayers(uint32_t logSlots, uint32_t budget) {
 
 
 
-std::vector<int32_t> GetCollapsedFFTParams(uint32_t slots, uint32_t levelBudget, uint32_t dim1) {
+std::vector<int32_t> GetCollapsedFFTParams(uint32_t slots, uint32_t levelBudget, uint32_t dim1, double outerCost) {
     uint32_t logSlots = std::log2(slots);
     // even for the case of a single slot we need one level for rescaling
     if (logSlots == 0) {
@@ -1043,7 +1057,10 @@ std::vector<int32_t> GetCollapsedFFTParams(uint32_t slots, uint32_t levelBudget,
 
     // Computing the baby-step b and the giant-step g for the collapsed layers for decoding.
     int32_t g;
-    if (dim1 == 0 || dim1 > numRotations) {
+    if ((dim1 == 0 || dim1 > numRotations) && outerCost > 0) {
+        g = SelectBSGSDim(numRotations, outerCost);
+    }
+    else if (dim1 == 0 || dim1 > numRotations) {
         if (numRotations > 7) {
             g = (1 << (int32_t(layersCollapse / 2) + 2));
         }
@@ -1059,7 +1076,10 @@ std::vector<int32_t> GetCollapsedFFTParams(uint32_t slots, uint32_t levelBudget,
     int32_t bRem = 0;
     int32_t gRem = 0;
     if (flagRem) {
-        if (numRotationsRem > 7) {
+        if (outerCost > 0) {
+            gRem = SelectBSGSDim(numRotationsRem, outerCost);
+        }
+        else if (numRotationsRem > 7) {
             gRem = (1 << (int32_t(remCollapse / 2) + 2));
         }
         else {
@@ -1073,6 +1093,21 @@ std::vector<int32_t> GetCollapsedFFTParams(uint32_t slots, uint32_t levelBudget,
             int32_t(numRotationsRem), bRem,           gRem};
 }
 
+uint32_t SelectBSGSDim(uint32_t numRotations, double outerCost) {
+    // numRotations + 1 is a power of two, g has to divide it
+    uint32_t best   = 2;
+    double bestCost = -1;
+    for (uint32_t g = 2; g <= numRotations + 1; g <<= 1) {
+        uint32_t b  = (numRotations + 1) / g;
+        double cost = (g - 1) + (b - 1) * outerCost;
+        if (bestCost < 0 || cost < bestCost) {
+            best     = g;
+            bestCost = cost;
+        }
+    }
+    return best;
+}
+
 
 
 uint32_t getRatioBSGSLT(uint32_t slots) {  // returns powers of two
@@ -0,0 +1,61 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2025, CEA-List
+//
+// All rights reserved.
+//
+// Author TPOC: jules.dumezy@cea.fr
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#include "scheme/hermite-lut.h"
+#include "scheme/ckksrns/ckksrns-utils.h"
+#include "math/hermite.h"
+
+#include <cmath>
+
+namespace lbcrypto {
+
+HermiteLUT::HermiteLUT(std::function<double(double)> func, uint32_t numPoints, uint32_t order)
+    : m_numPoints(numPoints), m_order(order) {
+    m_coefficients = hermiteInterpCoeff(func, numPoints, order);
+    m_degree       = Degree(m_coefficients);
+
+    // the FFT gives exact zeros for vanishing high-order coefficients (e.g. LUTs with a smaller period), and
+    // the polynomial evaluations need a nonzero leading coefficient; a constant LUT keeps its constant term
+    // only and is not evaluated as a polynomial
+    m_coefficients.resize(m_degree + 1);
+
+    // same choice as EvalPoly for complex coefficients
+    m_isPS = (4 < m_degree && m_degree < 17);
+
+    if (m_isPS)
+        m_depth = GetMultiplicativeDepthByCoeffVector(m_coefficients, false);
+    else if (m_degree == 0)
+        m_depth = 0;
+    else
+        m_depth = (m_degree > 1) ? static_cast<uint32_t>(std::ceil(std::log2(m_degree))) + 1 : 1;
+}
+
+}  // namespace lbcrypto
@@ -38,9 +38,13 @@
 
 #include "schemebase/base-leveledshe.h"
 
+#include "key/evalkeystore.h"
 #include "key/privatekey.h"
 #include "cryptocontext.h"
 #include "schemebase/base-scheme.h"
+#include "math/distributiongenerator.h"
+#include "utils/parallel.h"
+#include "utils/prng/blake2engine.h"
 
 namespace lbcrypto {
 
@@ -450,8 +454,26 @@ std::shared_ptr<std::map<uint32_t, EvalKey<Element>>> LeveledSHEBase<Element>::E
         (*evalKeys)[indx];
     }
     size_t sz = indexList.size();
-#pragma omp parallel for if (sz >= 4)
+
+    // each key draws its randomness from its own stream, keyed by a seed drawn once from the PRNG and by the
+    // automorphism index: the keys do not depend on the number of threads nor on the order they are generated in
+    default_prng::Blake2Engine::blake2_seed_array_t seed{};
+    auto& prng = PseudoRandomNumberGenerator::GetPRNG();
+    for (size_t w = 0; w + 1 < seed.size(); ++w)
+        seed[w] = prng();
+#if defined(FIXED_SEED)
+    // the PRNG engine is shared by all threads
+    const bool parallel = false;
+#else
+    const bool parallel = sz >= 2;
+#endif
+
+#pragma omp parallel for schedule(dynamic) num_threads(OpenFHEParallelControls.GetThreadLimit(sz)) if (parallel)
     for (size_t i = 0; i < sz; ++i) {
+        auto keySeed   = seed;
+        keySeed.back() = indexList[i];
+        ScopedPRNG stream(std::make_shared<default_prng::Blake2Engine>(keySeed, 0));
+
         PrivateKey<Element> privateKeyPermuted = std::make_shared<PrivateKeyImpl<Element>>(cc);
 
         uint32_t index = NativeInteger(indexList[i]).ModInverse(2 * N).ConvertToInt();
@@ -459,6 +481,7 @@ std::shared_ptr<std::map<uint32_t, EvalKey<Element>>> LeveledSHEBase<Element>::E
         PrecomputeAutoMap(N, index, &vec);
 
         privateKeyPermuted->SetPrivateElement(s.AutomorphismTransform(index, vec));
+        privateKeyPermuted->SetKeyTag(privateKey->GetKeyTag());
         (*evalKeys)[indexList[i]] = algo->KeySwitchGen(privateKey, privateKeyPermuted);
     }
 
@@ -506,7 +529,7 @@ Ciphertext<Element> LeveledSHEBase<Element>::EvalAutomorphism(ConstCiphertext<El
 
     Ciphertext<Element> result = ciphertext->Clone();
 
-    algo->KeySwitchInPlace(result, evalKeyIterator->second);
+    algo->KeySwitchInPlace(result, ResolveEvalKey(evalKeyIterator->second));
 
     std::vector<Element>& rcv = result->GetElements();
 
@@ -544,7 +567,7 @@ Ciphertext<Element> LeveledSHEBase<Element>::EvalFastRotation(
     if (evalKeyIterator == evalKeyMap.end()) {
         OPENFHE_THROW("EvalKey for index [" + std::to_string(autoIndex) + "] is not found.");
     }
-    auto evalKey = evalKeyIterator->second;
+    auto evalKey = ResolveEvalKey(evalKeyIterator->second);
 
     auto algo                       = cc->GetScheme();
     const std::vector<DCRTPoly>& cv = ciphertext->GetElements();
@@ -557,9 +580,8 @@ Ciphertext<Element> LeveledSHEBase<Element>::EvalFastRotation(
     std::vector<usint> vec(N);
     PrecomputeAutoMap(N, autoIndex, &vec);
 
-    (*ba)[0] += cv[0];
-
-    (*ba)[0] = (*ba)[0].AutomorphismTransform(autoIndex, vec);
+    // the addition of c0 is done in the same pass as the permutation
+    (*ba)[0] = (*ba)[0].AutomorphismTransformOfSum(cv[0], autoIndex, vec);
     (*ba)[1] = (*ba)[1].AutomorphismTransform(autoIndex, vec);
 
     Ciphertext<Element> result = ciphertext->Clone();
@@ -174,6 +174,12 @@ void CryptoParametersRNS::PrecomputeCRTTables(KeySwitchTechnique ksTech, Scaling
 
         m_paramsQP = std::make_shared<ILDCRTParams<BigInteger>>(2 * n, moduliQP, rootsQP);
 
+        // Pre-compute the Barrett mu of the towers of QP
+        const auto BarrettBase128Bit(BigInteger(1).LShiftEq(128));
+        m_modQPBarrettMu.resize(sizeQ + sizeP);
+        for (size_t i = 0; i < sizeQ + sizeP; i++)
+            m_modQPBarrettMu[i] = (BarrettBase128Bit / BigInteger(moduliQP[i])).ConvertToInt<DoubleNativeInt>();
+
         // Pre-compute CRT::FFT values for P
         ChineseRemainderTransformFTT<NativeVector>().PreCompute(rootsP, 2 * n, moduliP);
 
@@ -39,7 +39,11 @@
 #include "scheme/ckksrns/ckksrns-utils.h"
 #include "cryptocontext-ser.h"
 #include "scheme/ckksrns/ckksrns-ser.h"
+#include "scheme/ckksrns/ckksrns-diagonal-cache.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <vector>
 #include "gtest/gtest.h"
@@ -56,6 +60,12 @@ enum TEST_CASE_TYPE {
     BOOTSTRAP_ITERATIVE,
     BOOTSTRAP_NUM_TOWERS,
     BOOTSTRAP_SERIALIZE,
+    FUNC_BOOTSTRAP,
+    FUNC_BOOTSTRAP_BATCH,
+    BOOTSTRAP_ON_THE_FLY,
+    BOOTSTRAP_PRECOM_FILE,
+    BOOTSTRAP_TUNER,
+    FUNC_MULTI_LUT,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -82,6 +92,24 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case BOOTSTRAP_SERIALIZE:
             typeName = "BOOTSTRAP_SERIALIZE";
             break;
+        case FUNC_BOOTSTRAP:
+            typeName = "FUNC_BOOTSTRAP";
+            break;
+        case FUNC_BOOTSTRAP_BATCH:
+            typeName = "FUNC_BOOTSTRAP_BATCH";
+            break;
+        case BOOTSTRAP_ON_THE_FLY:
+            typeName = "BOOTSTRAP_ON_THE_FLY";
+            break;
+        case BOOTSTRAP_PRECOM_FILE:
+            typeName = "BOOTSTRAP_PRECOM_FILE";
+            break;
+        case BOOTSTRAP_TUNER:
+            typeName = "BOOTSTRAP_TUNER";
+            break;
+        case FUNC_MULTI_LUT:
+            typeName = "FUNC_MULTI_LUT";
+            break;
         default:
             typeName = "UNKNOWN";
             break;
@@ -128,6 +156,14 @@ constexpr uint32_t MULT_DEPTH   = 25;
 constexpr uint32_t RDIM         = 64;
 constexpr uint32_t NUM_LRG_DIGS = 3;
 
+// functional bootstrapping of LUTs on FBT_BITS bits, with the level budgets {FBT_LB, FBT_LB}
+constexpr uint32_t FBT_RDIM  = 1 << 12;
+constexpr uint32_t FBT_BITS  = 2;
+constexpr uint32_t FBT_LB    = 2;
+constexpr uint32_t FBT_DEPTH = 2 * FBT_LB + 1 + 5 + 4 + FBT_BITS + 2;
+constexpr uint32_t FBT_SMOD  = 48;
+constexpr uint32_t FBT_FMOD  = 49;
+
 #if NATIVEINT == 128 && !defined(__EMSCRIPTEN__)
 constexpr uint32_t SMODSIZE = 78;
 constexpr uint32_t FMODSIZE = 89;
@@ -311,6 +347,39 @@ static std::vector<TEST_CASE_UTCKKSRNS_BOOT> testCases = {
     { BOOTSTRAP_SERIALIZE, "05", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 4, 4 },   RDIM/2 },
     { BOOTSTRAP_SERIALIZE, "06", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 4, 4 },   RDIM/2 },
     // ==========================================
+    // TestType,            Descr, Scheme,          RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,     Slots
+    { BOOTSTRAP_ON_THE_FLY, "01", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, RDIM/2},
+    { BOOTSTRAP_ON_THE_FLY, "02", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  8,       SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, 8},
+    // ==========================================
+    // TestType,             Descr, Scheme,          RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,     Slots
+    { BOOTSTRAP_PRECOM_FILE, "01", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, RDIM/2},
+    { BOOTSTRAP_PRECOM_FILE, "02", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  8,       SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 0, 0 }, 8},
+    // ==========================================
+    // level budget: the depth given to the tuner for the encoding and the decoding together
+    // TestType,       Descr, Scheme,          RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,     Slots
+    { BOOTSTRAP_TUNER, "01", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 5, 0 },  { 0, 0 }, RDIM/2},
+    { BOOTSTRAP_TUNER, "02", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  8,       SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 4, 0 },  { 0, 0 }, 8},
+    // ==========================================
+    // TestType,      Descr, Scheme,          RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,     Slots
+    { FUNC_MULTI_LUT, "01", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 0, 0 },  { 0, 0 }, RDIM/2},
+#if NATIVEINT != 128
+    { FUNC_MULTI_LUT, "02", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 0, 0 },  { 0, 0 }, RDIM/2},
+#endif
+    // ==========================================
+#if NATIVEINT != 128
+    // TestType,      Descr, Scheme,          RDim,     MultDepth, SModSize, DSize, BatchSz, SecKeyDist,     MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget,          Dim1,     Slots
+    { FUNC_BOOTSTRAP, "01", {CKKSRNS_SCHEME, FBT_RDIM, FBT_DEPTH, FBT_SMOD, DFLT,  DFLT,    SPARSE_TERNARY, DFLT,          FBT_FMOD, HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { FBT_LB, FBT_LB }, { 0, 0 }, FBT_RDIM/2 },
+    { FUNC_BOOTSTRAP, "02", {CKKSRNS_SCHEME, FBT_RDIM, FBT_DEPTH, FBT_SMOD, DFLT,  DFLT,    SPARSE_TERNARY, DFLT,          FBT_FMOD, HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { FBT_LB, FBT_LB }, { 0, 0 }, 256 },
+    { FUNC_BOOTSTRAP, "03", {CKKSRNS_SCHEME, FBT_RDIM, FBT_DEPTH, FBT_SMOD, DFLT,  DFLT,    SPARSE_TERNARY, DFLT,          FBT_FMOD, HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { FBT_LB, FBT_LB }, { 0, 0 }, FBT_RDIM/2 },
+    { FUNC_BOOTSTRAP, "04", {CKKSRNS_SCHEME, FBT_RDIM, FBT_DEPTH, FBT_SMOD, DFLT,  DFLT,    SPARSE_TERNARY, DFLT,          FBT_FMOD, HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { FBT_LB, FBT_LB }, { 0, 0 }, 256 },
+    { FUNC_BOOTSTRAP, "05", {CKKSRNS_SCHEME, FBT_RDIM, FBT_DEPTH, FBT_SMOD, DFLT,  DFLT,    SPARSE_TERNARY, DFLT,          FBT_FMOD, HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { FBT_LB, FBT_LB }, { 0, 0 }, FBT_RDIM/2 },
+    { FUNC_BOOTSTRAP, "06", {CKKSRNS_SCHEME, FBT_RDIM, FBT_DEPTH, FBT_SMOD, DFLT,  DFLT,    SPARSE_TERNARY, DFLT,          FBT_FMOD, HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { FBT_LB, FBT_LB }, { 0, 0 }, 256 },
+    // ==========================================
+    // TestType,            Descr, Scheme,          RDim,     MultDepth, SModSize, DSize, BatchSz, SecKeyDist,     MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget,          Dim1,     Slots
+    { FUNC_BOOTSTRAP_BATCH, "01", {CKKSRNS_SCHEME, FBT_RDIM, FBT_DEPTH, FBT_SMOD, DFLT,  DFLT,    SPARSE_TERNARY, DFLT,          FBT_FMOD, HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { FBT_LB, FBT_LB }, { 0, 0 }, FBT_RDIM/2 },
+    { FUNC_BOOTSTRAP_BATCH, "02", {CKKSRNS_SCHEME, FBT_RDIM, FBT_DEPTH, FBT_SMOD, DFLT,  DFLT,    SPARSE_TERNARY, DFLT,          FBT_FMOD, HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { FBT_LB, FBT_LB }, { 0, 0 }, 256 },
+#endif
+    // ==========================================
 };
 // clang-format on
 //===========================================================================================================
@@ -320,6 +389,8 @@ class UTCKKSRNS_BOOT : public ::testing::TestWithParam<TEST_CASE_UTCKKSRNS_BOOT>
     // The precision after which we consider two values equal.
     // This is necessary because CKKS works for approximate numbers.
     const double eps = 0.0001;
+    // The outputs of functional bootstrapping are integers, which only need to be rounded correctly.
+    const double epsFBT = 0.01;
 
     // CalculateApproximationError() calculates the precision number (or approximation error).
     // The higher the precision, the less the error.
@@ -346,6 +417,464 @@ protected:
         CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
     }
 
+    // Generates a functional bootstrapping context with its keys, as in the functional bootstrapping example.
+    KeyPair<Element> GenerateFuncBootstrapContext(CryptoContext<Element>& cc, const TEST_CASE_UTCKKSRNS_BOOT& testData) {
+        cc = UnitTestGenerateContext(testData.params);
+        cc->Enable(FBTS);
+        cc->EvalFuncBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots, FBT_BITS);
+
+        auto keyPair = cc->KeyGen();
+        cc->EvalMultKeyGen(keyPair.secretKey);
+        cc->EvalFuncBootstrapKeyGen(keyPair.secretKey, testData.slots);
+        return keyPair;
+    }
+
+    // Encrypts integers modulo 2^FBT_BITS in both the real and the imaginary parts of the slots, with an offset
+    // so that the ciphertexts of a batch differ.
+    Ciphertext<Element> EncryptFuncBootstrapInput(const CryptoContext<Element>& cc, const KeyPair<Element>& keyPair,
+                                                  const TEST_CASE_UTCKKSRNS_BOOT& testData, uint32_t offset = 0) {
+        uint32_t p = 1 << FBT_BITS;
+        std::vector<std::complex<double>> x(testData.slots);
+        for (uint32_t i = 0; i < testData.slots; ++i)
+            x[i] = std::complex<double>((i + offset) % p, (3 * i + offset + 1) % p);
+        Plaintext ptxt =
+            cc->MakeCKKSPackedPlaintext(x, 1, FBT_DEPTH - testData.levelBudget[1], nullptr, testData.slots);
+        return cc->Encrypt(keyPair.publicKey, ptxt);
+    }
+
+    // Checks that the real and the imaginary parts of the slots are func of the input of EncryptFuncBootstrapInput.
+    void CheckFuncBootstrapOutput(const CryptoContext<Element>& cc, const KeyPair<Element>& keyPair,
+                                  ConstCiphertext<Element> ciphertext, const std::function<double(double)>& func,
+                                  const TEST_CASE_UTCKKSRNS_BOOT& testData, const std::string& failmsg,
+                                  uint32_t offset = 0) {
+        uint32_t p = 1 << FBT_BITS;
+        std::vector<std::complex<double>> expected(testData.slots);
+        for (uint32_t i = 0; i < testData.slots; ++i)
+            expected[i] = std::complex<double>(func((i + offset) % p), func((3 * i + offset + 1) % p));
+
+        Plaintext result;
+        cc->Decrypt(keyPair.secretKey, ciphertext, &result);
+        result->SetLength(testData.slots);
+        checkEquality(result->GetCKKSPackedValue(), expected, epsFBT, failmsg);
+    }
+
+    // Encrypts exp(2*pi*i*m/numPoints) for the integers m = i mod numPoints of the slots, i.e. the input of the LUT
+    // evaluations after the exponential stage of the functional bootstrapping.
+    Ciphertext<Element> EncryptExpInput(const CryptoContext<Element>& cc, const KeyPair<Element>& keyPair,
+                                        const TEST_CASE_UTCKKSRNS_BOOT& testData, uint32_t numPoints) {
+        std::vector<std::complex<double>> x(testData.slots);
+        for (uint32_t i = 0; i < testData.slots; ++i)
+            x[i] = std::exp(std::complex<double>(0, 2 * M_PI * (i % numPoints) / numPoints));
+        Plaintext ptxt = cc->MakeCKKSPackedPlaintext(x, 1, 0, nullptr, testData.slots);
+        return cc->Encrypt(keyPair.publicKey, ptxt);
+    }
+
+    // Checks that the real parts of the slots are func of the input of EncryptExpInput.
+    void CheckMultiLUTOutput(const CryptoContext<Element>& cc, const KeyPair<Element>& keyPair,
+                             ConstCiphertext<Element> ciphertext, const std::function<double(double)>& func,
+                             const TEST_CASE_UTCKKSRNS_BOOT& testData, uint32_t numPoints, const std::string& failmsg) {
+        std::vector<double> expected(testData.slots);
+        for (uint32_t i = 0; i < testData.slots; ++i)
+            expected[i] = func(i % numPoints);
+
+        Plaintext result;
+        cc->Decrypt(keyPair.secretKey, ciphertext, &result);
+        result->SetLength(testData.slots);
+        checkEquality(result->GetRealPackedValue(), expected, epsFBT, failmsg);
+    }
+
+    void UnitTest_FuncBootstrap(const TEST_CASE_UTCKKSRNS_BOOT& testData, const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc;
+            auto keyPair = GenerateFuncBootstrapContext(cc, testData);
+
+            auto func = [](double x) -> double {
+                return static_cast<double>((static_cast<int64_t>(std::llround(x)) * 3 + 1) % (1 << FBT_BITS));
+            };
+            auto ciphertext = EncryptFuncBootstrapInput(cc, keyPair, testData);
+            CheckFuncBootstrapOutput(cc, keyPair, cc->EvalFuncBootstrap(ciphertext, func, 1 << FBT_BITS, 1), func,
+                                     testData, failmsg + " Functional bootstrapping fails");
+
+            // a constant LUT has no power to evaluate
+            auto constant = [](double x) -> double {
+                return 3;
+            };
+            HermiteLUT lut(constant, 1 << FBT_BITS);
+            EXPECT_EQ(lut.GetDegree(), 0u) << failmsg;
+            CheckFuncBootstrapOutput(cc, keyPair, cc->EvalFuncBootstrap(ciphertext, lut), constant, testData,
+                                     failmsg + " Functional bootstrapping of a constant LUT fails");
+
+            // the multi-value bootstrapping evaluates it next to a LUT that does use the shared powers
+            auto results = cc->EvalFuncMVBootstrap(ciphertext, {HermiteLUT(func, 1 << FBT_BITS), lut});
+            CheckFuncBootstrapOutput(cc, keyPair, results[0], func, testData,
+                                     failmsg + " Multi-value functional bootstrapping fails");
+            CheckFuncBootstrapOutput(cc, keyPair, results[1], constant, testData,
+                                     failmsg + " Multi-value functional bootstrapping of a constant LUT fails");
+
+            // 2 * 2^16 digit LUTs, each with its own ciphertext
+            EXPECT_THROW(cc->EvalFuncTreeMVB({ciphertext}, func, 16, 2), OpenFHEException)
+                << failmsg << " Tree evaluation with too many LUTs accepted";
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
+
+    void UnitTest_FuncMultiLUT(const TEST_CASE_UTCKKSRNS_BOOT& testData, const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+            auto keyPair = cc->KeyGen();
+            cc->EvalMultKeyGen(keyPair.secretKey);
+
+            // Hermite LUTs of order 2 and 3 have a degree above the number of points. Mixing orders 1, 2 and 3
+            // gives groups of LUTs of different degrees sharing the powers of the largest one: 2 points stay in the
+            // linear range, 4 points reach degree 7 evaluated with Paterson-Stockmeyer while the order 1 LUT alone is
+            // linear, and 16 points give degrees 15 to 31 evaluated linearly again
+            for (uint32_t numPoints : {2, 4, 16}) {
+                auto func = [numPoints](double x) -> double {
+                    return static_cast<double>((static_cast<int64_t>(std::llround(x)) * 3 + 1) % numPoints);
+                };
+                std::vector<HermiteLUT> luts = {HermiteLUT(func, numPoints, 1), HermiteLUT(func, numPoints, 2),
+                                                HermiteLUT(func, numPoints, 3)};
+                EXPECT_GE(luts[2].GetDegree(), numPoints) << failmsg << " Order 3 LUT degree below the points";
+
+                auto ciphertext = EncryptExpInput(cc, keyPair, testData, numPoints);
+                auto results    = cc->EvalFuncMultiLUT(ciphertext, luts);
+                ASSERT_EQ(results.size(), luts.size()) << failmsg;
+                for (size_t i = 0; i < luts.size(); ++i) {
+                    std::string lutmsg = failmsg + " Order " + std::to_string(luts[i].GetOrder()) + " LUT on " +
+                                         std::to_string(numPoints) + " points";
+                    CheckMultiLUTOutput(cc, keyPair, results[i], func, testData, numPoints, lutmsg + " fails");
+
+                    // the shared powers give the same values as evaluating the LUT on its own
+                    auto single = cc->EvalFuncMultiLUT(ciphertext, {luts[i]});
+                    ASSERT_EQ(single.size(), 1u) << failmsg;
+                    Plaintext resultMulti;
+                    Plaintext resultSingle;
+                    cc->Decrypt(keyPair.secretKey, results[i], &resultMulti);
+                    cc->Decrypt(keyPair.secretKey, single[0], &resultSingle);
+                    resultMulti->SetLength(testData.slots);
+                    resultSingle->SetLength(testData.slots);
+                    checkEquality(resultMulti->GetRealPackedValue(), resultSingle->GetRealPackedValue(), eps,
+                                  lutmsg + " differs from its single evaluation");
+                }
+            }
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
+
+    void UnitTest_FuncBootstrapBatch(const TEST_CASE_UTCKKSRNS_BOOT& testData,
+                                     const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc;
+            auto keyPair = GenerateFuncBootstrapContext(cc, testData);
+
+            auto func = [](double x) -> double {
+                return static_cast<double>((static_cast<int64_t>(std::llround(x)) * 3 + 1) % (1 << FBT_BITS));
+            };
+            HermiteLUT lut(func, 1 << FBT_BITS);
+
+            std::vector<ConstCiphertext<Element>> ciphertexts;
+            for (uint32_t offset = 0; offset < 3; ++offset)
+                ciphertexts.push_back(EncryptFuncBootstrapInput(cc, keyPair, testData, offset));
+
+            auto stats = std::make_shared<BootstrapStats>();
+            cc->SetBootstrapStats(stats);
+            auto results = cc->EvalFuncBootstrapBatch(ciphertexts, lut);
+            cc->SetBootstrapStats(nullptr);
+            ASSERT_EQ(results.size(), ciphertexts.size()) << failmsg;
+
+            // every ciphertext of the batch is recorded as a run of its own
+            auto runs = stats->GetRuns();
+            EXPECT_EQ(runs.size(), ciphertexts.size()) << failmsg << " Wrong number of recorded runs";
+            for (const auto& run : runs) {
+                EXPECT_EQ(run.method, "EvalFuncBootstrap") << failmsg;
+                EXPECT_GT(run.stages.count("CoeffsToSlots"), 0u) << failmsg << " Stages missing from a run";
+            }
+
+            // runs on concurrent threads only count their own operations, as many as a bootstrap run alone
+            auto serialStats = std::make_shared<BootstrapStats>();
+            cc->SetBootstrapStats(serialStats);
+            cc->EvalFuncBootstrap(ciphertexts[0], lut);
+            auto concurrentStats = std::make_shared<BootstrapStats>();
+            cc->SetBootstrapStats(concurrentStats);
+#pragma omp parallel for num_threads(2)
+            for (size_t i = 0; i < 2; ++i)
+                cc->EvalFuncBootstrap(ciphertexts[i], lut);
+            cc->SetBootstrapStats(nullptr);
+
+            auto serial = serialStats->GetRuns();
+            ASSERT_EQ(serial.size(), 1u) << failmsg;
+            EXPECT_GT(serial[0].keySwitches, 0u) << failmsg << " No key switch counted";
+            auto concurrent = concurrentStats->GetRuns();
+            concurrent.insert(concurrent.end(), runs.begin(), runs.end());
+            EXPECT_EQ(concurrent.size(), 2 + ciphertexts.size()) << failmsg;
+            for (const auto& run : concurrent) {
+                EXPECT_EQ(run.keySwitches, serial[0].keySwitches) << failmsg << " Wrong key switch count";
+                EXPECT_EQ(run.ntts, serial[0].ntts) << failmsg << " Wrong NTT count";
+                EXPECT_EQ(run.rescales, serial[0].rescales) << failmsg << " Wrong rescale count";
+            }
+
+            for (uint32_t offset = 0; offset < ciphertexts.size(); ++offset) {
+                std::string msg = failmsg + " Batch output " + std::to_string(offset);
+                CheckFuncBootstrapOutput(cc, keyPair, results[offset], func, testData, msg + " fails", offset);
+
+                Plaintext batch, single;
+                cc->Decrypt(keyPair.secretKey, results[offset], &batch);
+                cc->Decrypt(keyPair.secretKey, cc->EvalFuncBootstrap(ciphertexts[offset], lut), &single);
+                batch->SetLength(testData.slots);
+                single->SetLength(testData.slots);
+                checkEquality(batch->GetCKKSPackedValue(), single->GetCKKSPackedValue(), epsFBT,
+                              msg + " differs from EvalFuncBootstrap");
+            }
+
+            // the keys and the precomputations of a batch are those of its first ciphertext
+            auto otherKeyPair = cc->KeyGen();
+            ciphertexts.push_back(EncryptFuncBootstrapInput(cc, otherKeyPair, testData));
+            EXPECT_THROW(cc->EvalFuncBootstrapBatch(ciphertexts, lut), OpenFHEException)
+                << failmsg << " Batch with different keys accepted";
+
+            // without the bootstrapping keys, the batch throws instead of aborting in its parallel section
+            auto keylessPair = cc->KeyGen();
+            cc->EvalRotateKeyGen(keylessPair.secretKey, {1});
+            std::vector<ConstCiphertext<Element>> keyless;
+            for (uint32_t offset = 0; offset < 2; ++offset)
+                keyless.push_back(EncryptFuncBootstrapInput(cc, keylessPair, testData, offset));
+            EXPECT_THROW(cc->EvalFuncBootstrapBatch(keyless, lut), OpenFHEException)
+                << failmsg << " Batch without bootstrapping keys accepted";
+            EXPECT_THROW(cc->EvalFuncBootstrap(keyless[0], lut), OpenFHEException)
+                << failmsg << " Bootstrapping without bootstrapping keys accepted";
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
+
+    void UnitTest_Bootstrap_OnTheFly(const TEST_CASE_UTCKKSRNS_BOOT& testData,
+                                     const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots);
+
+            auto keyPair = cc->KeyGen();
+            cc->EvalBootstrapKeyGen(keyPair.secretKey, testData.slots);
+            cc->EvalMultKeyGen(keyPair.secretKey);
+
+            std::vector<std::complex<double>> input =
+                Fill({0.111111, 0.222222, 0.333333, 0.444444, 0.555555, 0.666666, 0.777777, 0.888888}, testData.slots);
+            Plaintext plaintext = cc->MakeCKKSPackedPlaintext(input, 1, MULT_DEPTH - 1, nullptr, testData.slots);
+            auto ciphertext     = cc->Encrypt(keyPair.publicKey, plaintext);
+
+            Plaintext precomputed;
+            cc->Decrypt(keyPair.secretKey, cc->EvalBootstrap(ciphertext), &precomputed);
+            precomputed->SetLength(testData.slots);
+
+            // the same diagonals, encoded from their seeds with a cache smaller than the number of diagonals
+            // and then with no cache at all
+            for (uint32_t cacheSize : {4u, 0u}) {
+                cc->SetBootstrapDiagonalsOnTheFly(true, cacheSize);
+                cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots);
+                for (uint32_t i = 0; i < 2; ++i) {
+                    Plaintext onTheFly;
+                    cc->Decrypt(keyPair.secretKey, cc->EvalBootstrap(ciphertext), &onTheFly);
+                    onTheFly->SetLength(testData.slots);
+                    checkEquality(onTheFly->GetCKKSPackedValue(), precomputed->GetCKKSPackedValue(), eps,
+                                  failmsg + " Bootstrapping with diagonals encoded on the fly (cache size " +
+                                      std::to_string(cacheSize) + ") differs from precomputed diagonals");
+                }
+            }
+            cc->SetBootstrapDiagonalsOnTheFly(false);
+
+            // the cache keeps the most recently used diagonals, within its capacity
+            std::vector<CKKSDiagonalSeed> seeds;
+            for (uint32_t i = 0; i < 3; ++i)
+                seeds.emplace_back(std::vector<std::complex<double>>(testData.slots, i), nullptr, 0);
+            uint32_t encodings = 0;
+            auto encode        = [&]() -> ConstPlaintext {
+                encodings++;
+                return plaintext;
+            };
+
+            CKKSDiagonalCache cache(2);
+            for (const auto& seed : seeds)
+                cache.Get(seed, encode);
+            EXPECT_EQ(cache.Size(), 2u) << failmsg << " Diagonal cache exceeds its capacity";
+            cache.Get(seeds[2], encode);
+            cache.Get(seeds[1], encode);
+            EXPECT_EQ(encodings, 3u) << failmsg << " Recently used diagonals were evicted";
+            cache.Get(seeds[0], encode);
+            EXPECT_EQ(encodings, 4u) << failmsg << " Least recently used diagonal was kept";
+            EXPECT_EQ(cache.GetHits(), 2u) << failmsg;
+            EXPECT_EQ(cache.GetMisses(), 4u) << failmsg;
+
+            cache.SetCapacity(1);
+            EXPECT_EQ(cache.Size(), 1u) << failmsg << " Diagonal cache not shrunk to its new capacity";
+            cache.SetCapacity(0);
+            cache.Get(seeds[0], encode);
+            EXPECT_EQ(cache.Size(), 0u) << failmsg << " Diagonal cache of capacity 0 keeps diagonals";
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
+
+    void UnitTest_Bootstrap_PrecomFile(const TEST_CASE_UTCKKSRNS_BOOT& testData,
+                                       const std::string& failmsg = std::string()) {
+        const std::string filename  = ::testing::TempDir() + "bootstrap-" + testData.buildTestName() + ".precom";
+        const std::string truncated = filename + ".truncated";
+        const std::string corrupted = filename + ".corrupted";
+        try {
+            CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+
+            CryptoContext<Element> ccInit(UnitTestGenerateContext(testData.params));
+            ccInit->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots);
+            ccInit->SaveBootstrapPrecomputations(filename);
+
+            CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+
+            // a fresh context, without any precomputation until the file is loaded
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+            auto keyPair = cc->KeyGen();
+            EXPECT_THROW(cc->EvalBootstrapKeyGen(keyPair.secretKey, testData.slots), OpenFHEException)
+                << failmsg << " Unexpected precomputations";
+
+            cc->LoadBootstrapPrecomputations(filename);
+            cc->EvalBootstrapKeyGen(keyPair.secretKey, testData.slots);
+            cc->EvalMultKeyGen(keyPair.secretKey);
+
+            std::vector<std::complex<double>> input =
+                Fill({0.111111, 0.222222, 0.333333, 0.444444, 0.555555, 0.666666, 0.777777, 0.888888}, testData.slots);
+            Plaintext plaintext = cc->MakeCKKSPackedPlaintext(input, 1, MULT_DEPTH - 1, nullptr, testData.slots);
+            auto ciphertext     = cc->Encrypt(keyPair.publicKey, plaintext);
+
+            Plaintext loaded;
+            cc->Decrypt(keyPair.secretKey, cc->EvalBootstrap(ciphertext), &loaded);
+            loaded->SetLength(testData.slots);
+            plaintext->SetLength(testData.slots);
+            checkEquality(loaded->GetCKKSPackedValue(), plaintext->GetCKKSPackedValue(), eps,
+                          failmsg + " Bootstrapping with loaded precomputations fails");
+
+            cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots);
+            Plaintext computed;
+            cc->Decrypt(keyPair.secretKey, cc->EvalBootstrap(ciphertext), &computed);
+            computed->SetLength(testData.slots);
+            checkEquality(loaded->GetCKKSPackedValue(), computed->GetCKKSPackedValue(), eps,
+                          failmsg + " Loaded precomputations differ from computed ones");
+
+            // a truncated file is rejected
+            {
+                std::ifstream in(filename, std::ios::binary);
+                std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+                std::ofstream out(truncated, std::ios::binary | std::ios::trunc);
+                out.write(content.data(), content.size() / 2);
+            }
+            EXPECT_THROW(cc->LoadBootstrapPrecomputations(truncated), OpenFHEException)
+                << failmsg << " Truncated precomputations accepted";
+
+            // as is a file with a tower value that is not reduced modulo its tower
+            {
+                std::ifstream in(filename, std::ios::binary);
+                std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+                std::fill(content.end() - sizeof(NativeInteger::Integer), content.end(), char(0xff));
+                std::ofstream out(corrupted, std::ios::binary | std::ios::trunc);
+                out.write(content.data(), content.size());
+            }
+            EXPECT_THROW(cc->LoadBootstrapPrecomputations(corrupted), OpenFHEException)
+                << failmsg << " Unreduced precomputations accepted";
+
+            // as is a file written for other moduli
+            auto params = testData.params;
+            params.scalingModSize -= 1;
+            CryptoContext<Element> ccOther(UnitTestGenerateContext(params));
+            EXPECT_THROW(ccOther->LoadBootstrapPrecomputations(filename), OpenFHEException)
+                << failmsg << " Precomputations for other moduli accepted";
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+        std::remove(filename.c_str());
+        std::remove(truncated.c_str());
+        std::remove(corrupted.c_str());
+    }
+
+    void UnitTest_Bootstrap_Tuner(const TEST_CASE_UTCKKSRNS_BOOT& testData,
+                                  const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            // the configurations and the setup both select the unset dimensions with the cost model
+            cc->SetBootstrapBSGSCostModel(true);
+            uint32_t depth = testData.levelBudget[0];
+            auto configs   = cc->TuneBootstrapParameters(testData.slots, depth);
+            ASSERT_FALSE(configs.empty()) << failmsg << " No bootstrapping configuration";
+            for (size_t i = 0; i < configs.size(); ++i) {
+                EXPECT_EQ(configs[i].levelBudget.size(), 2u) << failmsg;
+                EXPECT_EQ(configs[i].dim1.size(), 2u) << failmsg;
+                EXPECT_LE(configs[i].levelBudget[0] + configs[i].levelBudget[1], depth) << failmsg;
+                if (i > 0) {
+                    EXPECT_LE(configs[i - 1].cost, configs[i].cost) << failmsg << " Configurations not sorted";
+                }
+            }
+
+            // the fastest configuration is set up as is
+            cc->EvalBootstrapSetup(configs[0].levelBudget, configs[0].dim1, testData.slots);
+
+            auto keyPair = cc->KeyGen();
+            cc->EvalBootstrapKeyGen(keyPair.secretKey, testData.slots);
+            cc->EvalMultKeyGen(keyPair.secretKey);
+
+            std::vector<std::complex<double>> input =
+                Fill({0.111111, 0.222222, 0.333333, 0.444444, 0.555555, 0.666666, 0.777777, 0.888888}, testData.slots);
+            Plaintext plaintext = cc->MakeCKKSPackedPlaintext(input, 1, MULT_DEPTH - 1, nullptr, testData.slots);
+            auto ciphertext     = cc->Encrypt(keyPair.publicKey, plaintext);
+
+            Plaintext result;
+            cc->Decrypt(keyPair.secretKey, cc->EvalBootstrap(ciphertext), &result);
+            result->SetLength(testData.slots);
+            plaintext->SetLength(testData.slots);
+            checkEquality(result->GetCKKSPackedValue(), plaintext->GetCKKSPackedValue(), eps,
+                          failmsg + " Bootstrapping with the tuned configuration fails");
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
+
     void UnitTest_Bootstrap(const TEST_CASE_UTCKKSRNS_BOOT& testData, const std::string& failmsg = std::string()) {
         try {
             CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
@@ -726,6 +1255,24 @@ TEST_P(UTCKKSRNS_BOOT, CKKSRNS) {
         case BOOTSTRAP_SERIALIZE:
             UnitTest_Bootstrap_Serialize(test, test.buildTestName());
             break;
+        case FUNC_BOOTSTRAP:
+            UnitTest_FuncBootstrap(test, test.buildTestName());
+            break;
+        case FUNC_BOOTSTRAP_BATCH:
+            UnitTest_FuncBootstrapBatch(test, test.buildTestName());
+            break;
+        case BOOTSTRAP_ON_THE_FLY:
+            UnitTest_Bootstrap_OnTheFly(test, test.buildTestName());
+            break;
+        case BOOTSTRAP_PRECOM_FILE:
+            UnitTest_Bootstrap_PrecomFile(test, test.buildTestName());
+            break;
+        case BOOTSTRAP_TUNER:
+            UnitTest_Bootstrap_Tuner(test, test.buildTestName());
+            break;
+        case FUNC_MULTI_LUT:
+            UnitTest_FuncMultiLUT(test, test.buildTestName());
+            break;
         default:
             break;
     }
@@ -37,11 +37,13 @@
 #include "UnitTestCCParams.h"
 #include "UnitTestCryptoContext.h"
 #include "UnitTestMetadataTest.h"
+#include "math/chebyshev.h"
 
 #include <iostream>
 #include <vector>
 #include "gtest/gtest.h"
 #include <iterator>
+#include <functional>
 
 using namespace lbcrypto;
 
@@ -58,6 +60,7 @@ enum TEST_CASE_TYPE {
     EVAL_LINEAR_WSUM,
     RE_ENCRYPTION,
     EVAL_POLY,
+    EVAL_CHEBYSHEV_MULTI,
     METADATA,
     ADD_PACKED_PRECISION,
     MULT_PACKED_PRECISION,
@@ -101,6 +104,9 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case EVAL_POLY:
             typeName = "EVAL_POLY";
             break;
+        case EVAL_CHEBYSHEV_MULTI:
+            typeName = "EVAL_CHEBYSHEV_MULTI";
+            break;
         case METADATA:
             typeName = "METADATA";
             break;
@@ -494,6 +500,16 @@ static std::vector<TEST_CASE_UTCKKSRNS> testCases = {
     { EVAL_POLY, "06", {CKKSRNS_SCHEME, RING_DIM, 5,     DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
     { EVAL_POLY, "07", {CKKSRNS_SCHEME, RING_DIM, 7,     DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
     { EVAL_POLY, "08", {CKKSRNS_SCHEME, RING_DIM, 7,     DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+#endif
+    // ==========================================
+    // TestType,              Descr, Scheme,        RDim,     MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode
+    { EVAL_CHEBYSHEV_MULTI, "01", {CKKSRNS_SCHEME, RING_DIM, 8,         DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { EVAL_CHEBYSHEV_MULTI, "02", {CKKSRNS_SCHEME, RING_DIM, 8,         DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { EVAL_CHEBYSHEV_MULTI, "03", {CKKSRNS_SCHEME, RING_DIM, 8,         DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { EVAL_CHEBYSHEV_MULTI, "04", {CKKSRNS_SCHEME, RING_DIM, 8,         DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+#if NATIVEINT != 128
+    { EVAL_CHEBYSHEV_MULTI, "05", {CKKSRNS_SCHEME, RING_DIM, 8,         DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { EVAL_CHEBYSHEV_MULTI, "06", {CKKSRNS_SCHEME, RING_DIM, 9,         DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
 #endif
     // ==========================================
     // TestType, Descr, Scheme,        RDim, MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode
@@ -1869,6 +1885,88 @@ protected:
         }
     }
 
+    /***
+     * Evaluates several Chebyshev series sharing one set of Chebyshev polynomials and
+     * compares every result with the same series evaluated on its own
+     */
+    void UnitTest_EvalChebyshevMulti(const TEST_CASE_UTCKKSRNS& testData, const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            std::vector<double> input{-0.9, -0.55, -0.2, 0.0, 0.3, 0.65, 0.8, 0.95};
+            const size_t encodedLength = input.size();
+            const double a             = -1.0;
+            const double b             = 1.0;
+
+            KeyPair<Element> kp = cc->KeyGen();
+            cc->EvalMultKeyGen(kp.secretKey);
+
+            Plaintext plaintext            = cc->MakeCKKSPackedPlaintext(input);
+            Ciphertext<Element> ciphertext = cc->Encrypt(kp.publicKey, plaintext);
+
+            auto check = [&](const std::vector<Ciphertext<Element>>& multi,
+                             const std::vector<Ciphertext<Element>>& single, const std::string& name) {
+                ASSERT_EQ(multi.size(), single.size()) << failmsg << " " << name;
+                for (size_t i = 0; i < multi.size(); i++) {
+                    Plaintext resultMulti;
+                    Plaintext resultSingle;
+                    cc->Decrypt(kp.secretKey, multi[i], &resultMulti);
+                    cc->Decrypt(kp.secretKey, single[i], &resultSingle);
+                    resultMulti->SetLength(encodedLength);
+                    resultSingle->SetLength(encodedLength);
+                    checkEquality(resultSingle->GetCKKSPackedValue(), resultMulti->GetCKKSPackedValue(), epsHigh,
+                                  failmsg + " " + name + " differs from the single evaluation for series " +
+                                      std::to_string(i));
+                }
+            };
+
+            // all degrees below 5: the linear method computes T_1..T_4 once
+            std::vector<std::vector<double>> linear{
+                {0.1, 0.5},
+                {0.25, -0.5, 0.75, 0.125},
+                {-0.3, 0.2, 0.4, -0.1, 0.35},
+            };
+            // mixed degrees with the largest one in the Paterson-Stockmeyer range
+            std::function<double(double)> sin3      = [](double x) -> double { return std::sin(3 * x); };
+            std::function<double(double)> logistic4 = [](double x) -> double { return 1 / (1 + std::exp(-4 * x)); };
+            std::vector<std::vector<double>> ps{
+                {0.25, -0.5, 0.75, 0.125},
+                EvalChebyshevCoefficients(sin3, a, b, 12),
+                {-0.3, 0.2, 0.4, -0.1, 0.35},
+                EvalChebyshevCoefficients(logistic4, a, b, 30),
+            };
+
+            for (const auto& coefficients : {linear, ps}) {
+                auto multi = cc->EvalChebyshevSeriesMulti(ciphertext, coefficients, a, b);
+                std::vector<Ciphertext<Element>> single;
+                for (const auto& series : coefficients)
+                    single.push_back(cc->EvalChebyshevSeries(ciphertext, series, a, b));
+                check(multi, single, "EvalChebyshevSeriesMulti");
+            }
+
+            std::vector<std::function<double(double)>> funcs{
+                [](double x) -> double { return std::sin(x); },
+                [](double x) -> double { return std::cos(x); },
+                [](double x) -> double { return 1 / (1 + std::exp(-x)); },
+            };
+            for (uint32_t degree : {4u, 20u}) {
+                auto multi = cc->EvalChebyshevFunctionMulti(funcs, ciphertext, a, b, degree);
+                std::vector<Ciphertext<Element>> single;
+                for (const auto& func : funcs)
+                    single.push_back(cc->EvalChebyshevFunction(func, ciphertext, a, b, degree));
+                check(multi, single, "EvalChebyshevFunctionMulti of degree " + std::to_string(degree));
+            }
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
+
     /***
      * Tests whether metadata is carried over for several operations in CKKS
      */
@@ -2145,6 +2243,9 @@ TEST_P(UTCKKSRNS, CKKSRNS) {
         case EVAL_POLY:
             UnitTest_EvalPoly(test, test.buildTestName());
             break;
+        case EVAL_CHEBYSHEV_MULTI:
+            UnitTest_EvalChebyshevMulti(test, test.buildTestName());
+            break;
         case METADATA:
             UnitTest_Metadata(test, test.buildTestName());
             break;
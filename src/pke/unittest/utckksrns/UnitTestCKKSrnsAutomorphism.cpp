@@ -35,6 +35,7 @@
 #include "UnitTestUtils.h"
 #include "UnitTestCCParams.h"
 #include "UnitTestCryptoContext.h"
+#include "utils/prng/blake2engine.h"
 
 #include <iostream>
 #include <vector>
@@ -48,6 +49,7 @@ enum TEST_CASE_TYPE {
     EVAL_SUM_PACKED_ARRAY,
     EVAL_SUM_ROWS,
     EVAL_SUM_COLS,
+    EVAL_KEYGEN_THREADS,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -65,6 +67,9 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case EVAL_SUM_COLS:
             typeName = "EVAL_SUM_COLS";
             break;
+        case EVAL_KEYGEN_THREADS:
+            typeName = "EVAL_KEYGEN_THREADS";
+            break;
         default:
             typeName = "UNKNOWN_UTCKKSRNS_AUTOMORPHISM";
             break;
@@ -193,6 +198,10 @@ static std::vector<TEST_CASE_UTCKKSRNS_AUTOMORPHISM> testCasesUTCKKSRNS_AUTOMORP
     // ==========================================
     // TestType,    Descr,  Scheme,         RDim,     MultDepth,  SModSize, DSize,BatchSz,    SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,  KSTech, ScalTech, LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, Error,               indexList
     { EVAL_SUM_COLS, "01", {CKKSRNS_SCHEME, RING_DIM, DFLT,       DFLT,     DFLT, RING_DIM/2, DFLT,       DFLT,          DFLT,     SEC_LVL, DFLT,   DFLT,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   SUCCESS },
+    // ==========================================
+    // TestType,          Descr,  Scheme,         RDim,     MultDepth,  SModSize, DSize,BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,  KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, Error,               indexList
+    { EVAL_KEYGEN_THREADS, "01", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DFLT, BATCH,   DFLT,       DFLT,          DFLT,     SEC_LVL, DFLT,   FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   SUCCESS,             initIndexList },
+    { EVAL_KEYGEN_THREADS, "02", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DFLT, BATCH,   DFLT,       DFLT,          DFLT,     SEC_LVL, BV,     FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   SUCCESS,             initIndexList },
 };
 // clang-format on
 //===========================================================================================================
@@ -440,6 +449,51 @@ protected:
             UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
         }
     }
+
+    // the keys generated in parallel only depend on the PRNG of the calling thread, not on the number of threads
+    void UnitTest_EvalKeyGenThreads(const TEST_CASE_UTCKKSRNS_AUTOMORPHISM& testData,
+                                    const std::string& failmsg = std::string()) {
+        const int numThreads = OpenFHEParallelControls.GetNumThreads();
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            KeyPair<Element> kp = cc->KeyGen();
+
+            default_prng::Blake2Engine::blake2_seed_array_t seed{};
+            for (size_t i = 0; i < seed.size(); ++i)
+                seed[i] = i + 1;
+
+            auto generateKeys = [&](int threads) {
+                OpenFHEParallelControls.SetNumThreads(threads);
+                ScopedPRNG prng(std::make_shared<default_prng::Blake2Engine>(seed, 0));
+                cc->EvalAtIndexKeyGen(kp.secretKey, testData.indexList);
+                // the keys are shared pointers: the map holds them after the keys of the crypto context are cleared
+                auto keys = cc->GetEvalAutomorphismKeyMap(kp.secretKey->GetKeyTag());
+                cc->ClearEvalAutomorphismKeys();
+                return keys;
+            };
+            auto serialKeys   = generateKeys(1);
+            auto parallelKeys = generateKeys(OpenFHEParallelControls.GetMachineThreads());
+            OpenFHEParallelControls.SetNumThreads(numThreads);
+
+            ASSERT_EQ(serialKeys.size(), parallelKeys.size()) << failmsg;
+            for (const auto& [index, key] : serialKeys) {
+                auto it = parallelKeys.find(index);
+                ASSERT_TRUE(it != parallelKeys.end()) << failmsg << " Key " << index << " missing";
+                EXPECT_TRUE(*key == *it->second) << failmsg << " Key " << index << " depends on the number of threads";
+            }
+        }
+        catch (std::exception& e) {
+            OpenFHEParallelControls.SetNumThreads(numThreads);
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            OpenFHEParallelControls.SetNumThreads(numThreads);
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
 };
 //===========================================================================================================
 TEST_P(UTCKKSRNS_AUTOMORPHISM, Automorphism) {
@@ -459,6 +513,9 @@ TEST_P(UTCKKSRNS_AUTOMORPHISM, Automorphism) {
         case EVAL_SUM_COLS:
             UnitTest_EvalSumCols(test, test.buildTestName());
             break;
+        case EVAL_KEYGEN_THREADS:
+            UnitTest_EvalKeyGenThreads(test, test.buildTestName());
+            break;
         default:
             break;
     }
@@ -34,6 +34,7 @@
 #include "UnitTestCCParams.h"
 #include "UnitTestCryptoContext.h"
 
+#include <cstdio>
 #include <iostream>
 #include <vector>
 #include "gtest/gtest.h"
@@ -41,15 +42,31 @@
 #include "ciphertext-ser.h"
 #include "cryptocontext-ser.h"
 #include "scheme/ckksrns/ckksrns-ser.h"
+#include "scheme/hermite-lut.h"
+#include "key/evalkeystore.h"
 #include "globals.h"  // for SERIALIZE_PRECOMPUTE
 
 using namespace lbcrypto;
 
+// writes an EvalKeyRelin the way version 1 did, with the "a" polynomials of seeded keys in full
+struct EvalKeyRelinV1 {
+    const EvalKeyRelinImpl<DCRTPoly>& key;
+
+    template <class Archive>
+    void save(Archive& ar, std::uint32_t const version) const {
+        key.save(ar, version);
+    }
+};
+CEREAL_CLASS_VERSION(EvalKeyRelinV1, 1);
+
 //===========================================================================================================
 enum TEST_CASE_TYPE {
     CONTEXT_WITH_SERTYPE = 0,
     KEYS_AND_CIPHERTEXTS,
     NO_CRT_TABLES,
+    HERMITE_LUT,
+    EVAL_KEY_RELIN,
+    EVAL_KEY_STORE,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -64,6 +81,15 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case NO_CRT_TABLES:
             typeName = "NO_CRT_TABLES";
             break;
+        case HERMITE_LUT:
+            typeName = "HERMITE_LUT";
+            break;
+        case EVAL_KEY_RELIN:
+            typeName = "EVAL_KEY_RELIN";
+            break;
+        case EVAL_KEY_STORE:
+            typeName = "EVAL_KEY_STORE";
+            break;
         default:
             typeName = "UNKNOWN";
             break;
@@ -168,6 +194,19 @@ static std::vector<TEST_CASE_UTCKKSRNS_SER> testCases = {
     { NO_CRT_TABLES, "08", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
 #endif
     // ==========================================
+    // TestType,  Descr,  Scheme,         RDim,     MultDepth,  SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech,  EncTech, PREMode
+    { HERMITE_LUT, "01", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    // ==========================================
+    // TestType,     Descr, Scheme,         RDim,     MultDepth,  SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech,  EncTech, PREMode
+    { EVAL_KEY_RELIN, "01", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+#if NATIVEINT != 128
+    { EVAL_KEY_RELIN, "02", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+#endif
+    // ==========================================
+    // TestType,     Descr, Scheme,         RDim,     MultDepth,  SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech,  EncTech, PREMode
+    { EVAL_KEY_STORE, "01", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    { EVAL_KEY_STORE, "02", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    // ==========================================
 };
 // clang-format on
 //===========================================================================================================
@@ -455,6 +494,257 @@ protected:
         TestDecryptionSerNoCRTTables(testData, SerType::JSON, "json");
         TestDecryptionSerNoCRTTables(testData, SerType::BINARY, "binary");
     }
+
+    template <typename ST>
+    void TestHermiteLUT(const HermiteLUT& lut, const ST& sertype, const std::string& failmsg = std::string()) {
+        std::stringstream s;
+        Serial::Serialize(lut, s, sertype);
+
+        HermiteLUT newLut;
+        Serial::Deserialize(newLut, s, sertype);
+
+        EXPECT_EQ(lut.GetCoefficients(), newLut.GetCoefficients()) << failmsg << " Coefficients mismatch";
+        EXPECT_EQ(lut.GetNumPoints(), newLut.GetNumPoints()) << failmsg << " Number of points mismatch";
+        EXPECT_EQ(lut.GetOrder(), newLut.GetOrder()) << failmsg << " Order mismatch";
+        EXPECT_EQ(lut.GetDegree(), newLut.GetDegree()) << failmsg << " Degree mismatch";
+        EXPECT_EQ(lut.IsPS(), newLut.IsPS()) << failmsg << " Evaluation method mismatch";
+        EXPECT_EQ(lut.GetDepth(), newLut.GetDepth()) << failmsg << " Depth mismatch";
+    }
+    void UnitTestHermiteLUT(const TEST_CASE_UTCKKSRNS_SER& testData, const std::string& failmsg = std::string()) {
+        try {
+            // a linear and a Paterson-Stockmeyer LUT, and a constant one without a polynomial to evaluate
+            std::vector<HermiteLUT> luts = {
+                HermiteLUT([](double x) -> double { return static_cast<uint64_t>(3 * x + 1) % 4; }, 4),
+                HermiteLUT([](double x) -> double { return static_cast<uint64_t>(x * x) % 8; }, 8),
+                HermiteLUT([](double x) -> double { return 3; }, 4),
+            };
+            EXPECT_FALSE(luts[0].IsPS()) << failmsg << " Small LUT should be evaluated linearly";
+            EXPECT_TRUE(luts[1].IsPS()) << failmsg << " Large LUT should be evaluated with Paterson-Stockmeyer";
+            EXPECT_EQ(luts[2].GetDegree(), 0u) << failmsg << " Constant LUT should have degree 0";
+
+            for (const auto& lut : luts) {
+                TestHermiteLUT(lut, SerType::JSON, failmsg + " json");
+                TestHermiteLUT(lut, SerType::BINARY, failmsg + " binary");
+            }
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
+
+    template <typename ST>
+    void TestEvalKeyRelin(const TEST_CASE_UTCKKSRNS_SER& testData, const ST& sertype,
+                          const std::string& failmsg = std::string()) {
+        try {
+            CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            KeyPair<Element> kp = cc->KeyGen();
+            const std::vector<int32_t> indices{1, -2};
+            cc->EvalRotateKeyGen(kp.secretKey, indices);
+
+            const auto& keyMap = CryptoContextImpl<DCRTPoly>::GetEvalAutomorphismKeyMap(kp.secretKey->GetKeyTag());
+            ASSERT_FALSE(keyMap.empty()) << failmsg << " No rotation keys generated";
+            EvalKey<DCRTPoly> evalKey = keyMap.begin()->second;
+            auto key                  = std::dynamic_pointer_cast<EvalKeyRelinImpl<DCRTPoly>>(evalKey);
+            ASSERT_TRUE(key) << failmsg << " Rotation key is not an EvalKeyRelin";
+            EXPECT_EQ(key->GetAVectorSeed().size(), EVAL_KEY_SEED_SIZE) << failmsg << " Single-key key is not seeded";
+
+            // a seeded key only keeps the seed of its "a" polynomials, which are expanded again on load
+            std::stringstream s;
+            Serial::Serialize(evalKey, s, sertype);
+            const size_t seededSize = s.str().size();
+            EvalKey<DCRTPoly> newKey;
+            Serial::Deserialize(newKey, s, sertype);
+            ASSERT_TRUE(newKey) << failmsg << " Seeded key deserialize failed";
+            // until it is used, it only holds its "b" polynomials, half of the packed key it was generated as
+            auto newRelin = std::dynamic_pointer_cast<EvalKeyRelinImpl<DCRTPoly>>(newKey);
+            ASSERT_TRUE(newRelin) << failmsg << " Deserialized key is not an EvalKeyRelin";
+            EXPECT_EQ(2 * newRelin->GetResidentMemory(), key->GetResidentMemory())
+                << failmsg << " Seeded key expanded on load";
+            EXPECT_TRUE(*key == *newKey) << failmsg << " Seeded key mismatch";
+
+            // the polynomials accessed before its deferred packing stay valid after it
+            const auto& bv                    = newRelin->GetBVector();
+            const std::vector<DCRTPoly> bCopy = bv;
+            newRelin->GetPackedKey();
+            EXPECT_TRUE(bv == bCopy) << failmsg << " Polynomials released by the deferred packing";
+
+            // archives of version 1 store the "a" polynomials in full and must still be readable
+            std::stringstream s1;
+            Serial::Serialize(EvalKeyRelinV1{*key}, s1, sertype);
+            EXPECT_LT(seededSize, s1.str().size()) << failmsg << " Seeded key is not smaller than version 1";
+            EvalKeyRelinImpl<DCRTPoly> oldKey;
+            Serial::Deserialize(oldKey, s1, sertype);
+            EXPECT_TRUE(*key == oldKey) << failmsg << " Version 1 key mismatch";
+
+            // threshold keys reuse the "a" polynomials of another key and have no seed to store
+            KeyPair<Element> kp2           = cc->KeyGen();
+            EvalKey<DCRTPoly> thresholdKey = cc->MultiKeySwitchGen(kp2.secretKey, kp2.secretKey, evalKey);
+            auto thresholdRelin            = std::dynamic_pointer_cast<EvalKeyRelinImpl<DCRTPoly>>(thresholdKey);
+            ASSERT_TRUE(thresholdRelin) << failmsg << " Threshold key is not an EvalKeyRelin";
+            EXPECT_TRUE(thresholdRelin->GetAVectorSeed().empty()) << failmsg << " Threshold key is seeded";
+            std::stringstream s2;
+            Serial::Serialize(thresholdKey, s2, sertype);
+            EvalKey<DCRTPoly> newThresholdKey;
+            Serial::Deserialize(newThresholdKey, s2, sertype);
+            ASSERT_TRUE(newThresholdKey) << failmsg << " Threshold key deserialize failed";
+            EXPECT_TRUE(*thresholdKey == *newThresholdKey) << failmsg << " Threshold key mismatch";
+            auto newThresholdRelin = std::dynamic_pointer_cast<EvalKeyRelinImpl<DCRTPoly>>(newThresholdKey);
+            ASSERT_TRUE(newThresholdRelin) << failmsg << " Deserialized threshold key is not an EvalKeyRelin";
+            EXPECT_TRUE(newThresholdRelin->GetAVectorSeed().empty())
+                << failmsg << " Threshold key is seeded after deserialization";
+
+            // rotate with the reloaded keys
+            std::stringstream ser;
+            EXPECT_TRUE(CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKey(ser, sertype,
+                                                                                  kp.secretKey->GetKeyTag()))
+                << failmsg << " Rotation keys serialization failed";
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            EXPECT_TRUE(CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKey(ser, sertype))
+                << failmsg << " Rotation keys deserialization failed";
+
+            std::vector<std::complex<double>> vals = {1.0, 3.0, 5.0, 7.0, 9.0, 2.0, 4.0, 6.0,
+                                                      8.0, 11.0, 0.5, 1.5, 2.5, 3.5, 4.5, 5.5};
+            Plaintext plaintext             = cc->MakeCKKSPackedPlaintext(vals);
+            Ciphertext<DCRTPoly> ciphertext = cc->Encrypt(kp.publicKey, plaintext);
+            for (int32_t index : indices) {
+                std::vector<std::complex<double>> expected(vals.size());
+                for (size_t i = 0; i < vals.size(); ++i)
+                    expected[i] = vals[(i + vals.size() + index) % vals.size()];
+
+                Plaintext result;
+                cc->Decrypt(kp.secretKey, cc->EvalRotate(ciphertext, index), &result);
+                result->SetLength(vals.size());
+                checkEquality(expected, result->GetCKKSPackedValue(), eps,
+                              failmsg + " Rotation by " + std::to_string(index) + " with reloaded keys fails");
+            }
+
+            CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
+    void UnitTestEvalKeyRelin(const TEST_CASE_UTCKKSRNS_SER& testData, const std::string& failmsg = std::string()) {
+        TestEvalKeyRelin(testData, SerType::JSON, failmsg + " json");
+        TestEvalKeyRelin(testData, SerType::BINARY, failmsg + " binary");
+    }
+
+    // rotates by every index with the keys of a store and checks the results
+    void RotateWithKeyStore(const CryptoContext<Element>& cc, const KeyPair<Element>& kp,
+                            const std::vector<int32_t>& indices, const std::string& failmsg) {
+        std::vector<std::complex<double>> vals = {1.0, 3.0, 5.0, 7.0, 9.0, 2.0, 4.0, 6.0,
+                                                  8.0, 11.0, 0.5, 1.5, 2.5, 3.5, 4.5, 5.5};
+        Plaintext plaintext             = cc->MakeCKKSPackedPlaintext(vals);
+        Ciphertext<DCRTPoly> ciphertext = cc->Encrypt(kp.publicKey, plaintext);
+        for (int32_t index : indices) {
+            std::vector<std::complex<double>> expected(vals.size());
+            for (size_t i = 0; i < vals.size(); ++i)
+                expected[i] = vals[(i + vals.size() + index) % vals.size()];
+
+            Plaintext result;
+            cc->Decrypt(kp.secretKey, cc->EvalRotate(ciphertext, index), &result);
+            result->SetLength(vals.size());
+            // the key switching noise of BV with large digits is above EPSILON
+            checkEquality(expected, result->GetCKKSPackedValue(), EPSILON_HIGH,
+                          failmsg + " Rotation by " + std::to_string(index) + " with stored keys fails");
+        }
+    }
+
+    void TestEvalKeyStore(const TEST_CASE_UTCKKSRNS_SER& testData, bool useMmap,
+                          const std::string& failmsg = std::string()) {
+        const std::string filename = ::testing::TempDir() + "evalkeystore_" + testData.buildTestName() + ".bin";
+        try {
+            CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            KeyPair<Element> kp = cc->KeyGen();
+            const std::vector<int32_t> indices{1, 2, 3, -1};
+            cc->EvalRotateKeyGen(kp.secretKey, indices);
+            CryptoContextImpl<DCRTPoly>::SaveEvalAutomorphismKeyStore(filename, kp.secretKey->GetKeyTag());
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+
+            // a budget below the size of a key keeps only the most recently used one in memory
+            auto store = cc->LoadEvalAutomorphismKeyStore(filename, 1, useMmap);
+            EXPECT_EQ(store->GetKeyTag(), kp.secretKey->GetKeyTag()) << failmsg << " Key tag mismatch";
+            EXPECT_EQ(store->GetIndices().size(), indices.size()) << failmsg << " Number of stored keys mismatch";
+            EXPECT_EQ(store->GetNumLoads(), 0u) << failmsg << " Keys loaded before use";
+            EXPECT_EQ(store->GetResidentMemory(), 0u) << failmsg << " Memory held before use";
+
+            RotateWithKeyStore(cc, kp, {indices[0]}, failmsg);
+            EXPECT_EQ(store->GetNumLoads(), 1u) << failmsg << " First rotation loads one key";
+            const uint64_t keyMemory = store->GetResidentMemory();
+            EXPECT_GT(keyMemory, 0u) << failmsg << " No memory held by the loaded key";
+
+            RotateWithKeyStore(cc, kp, indices, failmsg);
+            EXPECT_EQ(store->GetNumLoads(), indices.size()) << failmsg << " Resident key loaded again";
+            EXPECT_EQ(store->GetResidentMemory(), keyMemory) << failmsg << " More than one key held";
+
+            // the first key has been released and is loaded again
+            RotateWithKeyStore(cc, kp, {indices[0]}, failmsg);
+            EXPECT_EQ(store->GetNumLoads(), indices.size() + 1) << failmsg << " Released key not loaded again";
+            EXPECT_EQ(store->GetResidentMemory(), keyMemory) << failmsg << " More than one key held";
+
+            // without a limit every key stays in memory once loaded
+            store->SetMemoryBudget(0);
+            RotateWithKeyStore(cc, kp, indices, failmsg);
+            RotateWithKeyStore(cc, kp, indices, failmsg);
+            EXPECT_EQ(store->GetNumLoads(), 2 * indices.size()) << failmsg << " Keys loaded more than once";
+            EXPECT_EQ(store->GetResidentMemory(), indices.size() * keyMemory) << failmsg << " Not every key held";
+
+            store->SetMemoryBudget(1);
+            EXPECT_EQ(store->GetResidentMemory(), keyMemory) << failmsg << " Keys not released by a lower budget";
+            store->Release();
+            EXPECT_EQ(store->GetResidentMemory(), 0u) << failmsg << " Keys held after release";
+
+            // a key read directly through its stand-in is dropped by the next key switching
+            const auto& keyMap = CryptoContextImpl<DCRTPoly>::GetEvalAutomorphismKeyMap(kp.secretKey->GetKeyTag());
+            const auto stored  = std::dynamic_pointer_cast<EvalKeyStoredImpl>(keyMap.begin()->second);
+            EXPECT_EQ(stored->GetAVector().size(), stored->GetBVector().size())
+                << failmsg << " Key not read through its stand-in";
+            std::weak_ptr<EvalKeyImpl<DCRTPoly>> pinned = stored->Load();
+            RotateWithKeyStore(cc, kp, {indices[0]}, failmsg);
+            store->Release();
+            EXPECT_TRUE(pinned.expired()) << failmsg << " Key kept by its stand-in";
+
+            store.reset();
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+        CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+        std::remove(filename.c_str());
+    }
+    void UnitTestEvalKeyStore(const TEST_CASE_UTCKKSRNS_SER& testData, const std::string& failmsg = std::string()) {
+        TestEvalKeyStore(testData, true, failmsg + " mmap");
+        TestEvalKeyStore(testData, false, failmsg + " read");
+    }
 };
 //===========================================================================================================
 TEST_P(UTCKKSRNS_SER, CKKSSer) {
@@ -467,6 +757,12 @@ TEST_P(UTCKKSRNS_SER, CKKSSer) {
         UnitTestKeysAndCiphertexts(test, test.buildTestName());
     else if (test.testCaseType == NO_CRT_TABLES)
         UnitTestDecryptionSerNoCRTTables(test, test.buildTestName());
+    else if (test.testCaseType == HERMITE_LUT)
+        UnitTestHermiteLUT(test, test.buildTestName());
+    else if (test.testCaseType == EVAL_KEY_RELIN)
+        UnitTestEvalKeyRelin(test, test.buildTestName());
+    else if (test.testCaseType == EVAL_KEY_STORE)
+        UnitTestEvalKeyStore(test, test.buildTestName());
 }
 
 INSTANTIATE_TEST_SUITE_P(UnitTests, UTCKKSRNS_SER, ::testing::ValuesIn(testCases), testName);